@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cstdint>
+#include <memory>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/stack/fixed_stack.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+using pmr_allocator = std::pmr::polymorphic_allocator<std::int64_t>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::size_t BENCHMARK_ITEMS = 1 << 20;
+const std::size_t FIXED_STACK_SIZE = 64;
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / BENCHMARK_ITEMS;
+}
+
+// every run gets a fresh resource, a monotonic buffer gives back its memory only when it is destroyed
+template <typename Resource, typename F>
+double with_resource (F workload)
+{
+  return average_ns([workload] {
+    Resource resource;
+    workload(pmr_allocator{&resource});
+  });
+}
+
+// workload(allocator) runs BENCHMARK_ITEMS operations on containers that allocate through allocator
+template <typename F>
+void compare (char const* container, F workload)
+{
+  std::cout << container << ";std::allocator;" << BENCHMARK_ITEMS << ';'
+            << average_ns([workload] { workload(std::allocator<std::int64_t>{}); }) << ';' << std::endl;
+  std::cout << container << ";new_delete_resource;" << BENCHMARK_ITEMS << ';'
+            << average_ns([workload] { workload(pmr_allocator{std::pmr::new_delete_resource()}); }) << ';'
+            << std::endl;
+  std::cout << container << ";monotonic_buffer_resource;" << BENCHMARK_ITEMS << ';'
+            << with_resource<std::pmr::monotonic_buffer_resource>(workload) << ';' << std::endl;
+  std::cout << container << ";unsynchronized_pool_resource;" << BENCHMARK_ITEMS << ';'
+            << with_resource<std::pmr::unsynchronized_pool_resource>(workload) << ';' << std::endl;
+}
+
+int main ()
+{
+  std::cout << "container;resource;items;ns per item;" << std::endl;
+
+  // one node allocated and deallocated per item
+  compare("linked_stack push/pop", [] (auto allocator) {
+    algol::ds::linked_stack<std::int64_t, decltype(allocator)> stack {allocator};
+    for (std::size_t i = 0; i < BENCHMARK_ITEMS; ++i)
+      stack.push(static_cast<std::int64_t>(i));
+    while (!stack.empty())
+      stack.pop();
+  });
+
+  // the queue never holds more than 64 items, a pool reuses the same few blocks
+  compare("linked_queue enqueue/dequeue", [] (auto allocator) {
+    algol::ds::linked_queue<std::int64_t, decltype(allocator)> queue {allocator};
+    for (std::size_t i = 0; i < BENCHMARK_ITEMS; ++i) {
+      queue.enqueue(static_cast<std::int64_t>(i));
+      if (i % 64 == 63)
+        while (!queue.empty())
+          queue.dequeue();
+    }
+  });
+
+  // many short lived stacks, the cost is the allocation of the array
+  compare("fixed_stack construction", [] (auto allocator) {
+    for (std::size_t i = 0; i < BENCHMARK_ITEMS; ++i) {
+      algol::ds::fixed_stack<std::int64_t, FIXED_STACK_SIZE, decltype(allocator)> stack {allocator};
+      stack.push(static_cast<std::int64_t>(i));
+    }
+  });
+
+  return 0;
+}
+
+#else
+
+int main ()
+{
+  std::cout << "std::pmr is not available with this standard library" << std::endl;
+  return 0;
+}
+
+#endif
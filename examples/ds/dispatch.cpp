@@ -0,0 +1,92 @@
+#include <iostream>
+#include <cstdint>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/stack/fixed_stack.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "algol/ds/queue/fixed_queue.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::size_t BENCHMARK_ITEMS = 1 << 20;
+const std::size_t CONTAINER_SIZE = 1024;
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / BENCHMARK_ITEMS;
+}
+
+// the optimizer cannot see the dynamic type of the container behind the reference returned,
+// the calls through it go through the virtual table
+template <typename Base, typename C>
+Base& opaque (C& container)
+{
+  Base* volatile base = &container;
+  return *base;
+}
+
+std::int64_t sink = 0;
+
+// S is a stack type, BENCHMARK_ITEMS items are pushed and popped CONTAINER_SIZE at a time
+template <typename S>
+void push_pop (S& stack)
+{
+  for (std::size_t round = 0; round < BENCHMARK_ITEMS / CONTAINER_SIZE; ++round) {
+    for (std::size_t i = 0; i < CONTAINER_SIZE; ++i)
+      stack.push(static_cast<std::int64_t>(i));
+    while (!stack.empty()) {
+      sink += stack.top();
+      stack.pop();
+    }
+  }
+}
+
+// Q is a queue type, BENCHMARK_ITEMS items are enqueued and dequeued CONTAINER_SIZE at a time
+template <typename Q>
+void enqueue_dequeue (Q& queue)
+{
+  for (std::size_t round = 0; round < BENCHMARK_ITEMS / CONTAINER_SIZE; ++round) {
+    for (std::size_t i = 0; i < CONTAINER_SIZE; ++i)
+      queue.enqueue(static_cast<std::int64_t>(i));
+    while (!queue.empty()) {
+      sink += queue.front();
+      queue.dequeue();
+    }
+  }
+}
+
+template <typename S>
+void compare_stack (char const* container)
+{
+  S stack;
+  std::cout << container << ";dynamic;" << BENCHMARK_ITEMS << ';'
+            << average_ns([&stack] { push_pop(opaque<algol::ds::stack<std::int64_t>>(stack)); }) << ';' << std::endl;
+  std::cout << container << ";static;" << BENCHMARK_ITEMS << ';'
+            << average_ns([&stack] { push_pop(stack); }) << ';' << std::endl;
+}
+
+template <typename Q>
+void compare_queue (char const* container)
+{
+  Q queue;
+  std::cout << container << ";dynamic;" << BENCHMARK_ITEMS << ';'
+            << average_ns([&queue] { enqueue_dequeue(opaque<algol::ds::queue<std::int64_t>>(queue)); }) << ';'
+            << std::endl;
+  std::cout << container << ";static;" << BENCHMARK_ITEMS << ';'
+            << average_ns([&queue] { enqueue_dequeue(queue); }) << ';' << std::endl;
+}
+
+int main ()
+{
+  std::cout << "container;dispatch;items;ns per item;" << std::endl;
+
+  compare_stack<algol::ds::fixed_stack<std::int64_t, CONTAINER_SIZE>>("fixed_stack");
+  compare_stack<algol::ds::linked_stack<std::int64_t>>("linked_stack");
+  compare_queue<algol::ds::fixed_queue<std::int64_t, CONTAINER_SIZE>>("fixed_queue");
+  compare_queue<algol::ds::linked_queue<std::int64_t>>("linked_queue");
+
+  return static_cast<int>(sink & 1);
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <list>
+#include <forward_list>
+#include <vector>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/list/list.hpp"
+#include "algol/algorithms/sort/bubble_sort.hpp"
+#include "algol/algorithms/sort/selection_sort.hpp"
+#include "algol/algorithms/sort/insertion_sort.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::size_t ITEMS = 1 << 18;
+const std::size_t SORT_ITEMS = 256;
+
+std::uint64_t sink = 0;
+
+// a run before the measure, the first allocations after freeing many nodes are slow
+template <typename F>
+double average_ns (F f, std::size_t items)
+{
+  f();
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / static_cast<double>(items);
+}
+
+std::vector<std::uint32_t> random_values (std::size_t n)
+{
+  std::mt19937 gen(42);
+  std::vector<std::uint32_t> values(n);
+  for (auto& value : values)
+    value = gen();
+  return values;
+}
+
+template <typename List>
+void traversal_benchmark (char const* container, List const& list)
+{
+  std::cout << container << ";traversal;" << ITEMS << ';' << average_ns([&] {
+    for (auto value : list)
+      sink ^= value;
+  }, ITEMS) << ';' << std::endl;
+}
+
+// L is a list with push_back, push_front and insert
+template <typename L>
+void insertion_benchmark (char const* container)
+{
+  std::cout << container << ";push_back;" << ITEMS << ';' << average_ns([] {
+    L list;
+    for (std::uint32_t i = 0; i < ITEMS; ++i)
+      list.push_back(i);
+    sink ^= list.back();
+  }, ITEMS) << ';' << std::endl;
+  std::cout << container << ";push_front;" << ITEMS << ';' << average_ns([] {
+    L list;
+    for (std::uint32_t i = 0; i < ITEMS; ++i)
+      list.push_front(i);
+    sink ^= list.front();
+  }, ITEMS) << ';' << std::endl;
+  // every item is inserted in the middle of the items inserted before
+  std::cout << container << ";insert_middle;" << ITEMS << ';' << average_ns([] {
+    L list;
+    list.push_back(0);
+    auto middle = list.begin();
+    for (std::uint32_t i = 1; i < ITEMS; ++i) {
+      list.insert(middle, i);
+      if (i % 2 == 0)
+        --middle;
+    }
+    sink ^= *middle;
+  }, ITEMS) << ';' << std::endl;
+}
+
+// L is a container constructible from an iterator range
+template <typename L>
+void sort_benchmark (char const* container, std::vector<std::uint32_t> const& values)
+{
+  auto sort = [&] (char const* name, auto algorithm) {
+    std::cout << container << ';' << name << ';' << SORT_ITEMS << ';' << average_ns([&] {
+      L list(std::begin(values), std::end(values));
+      algorithm(std::begin(list), std::end(list));
+      sink ^= *std::begin(list);
+    }, SORT_ITEMS) << ';' << std::endl;
+  };
+  sort("insertion_sort", [] (auto first, auto last) { algol::algorithms::sort::insertion_sort(first, last); });
+  sort("selection_sort", [] (auto first, auto last) { algol::algorithms::sort::selection_sort(first, last); });
+  sort("bubble_sort", [] (auto first, auto last) { algol::algorithms::sort::bubble_sort(first, last); });
+}
+
+int main ()
+{
+  auto values = random_values(ITEMS);
+  std::cout << "container;operation;items;ns per item;" << std::endl;
+
+  // the lists appended to are stored in traversal order
+  algol::ds::list<std::uint32_t> list(std::begin(values), std::end(values));
+  std::list<std::uint32_t> std_list(std::begin(values), std::end(values));
+  traversal_benchmark("ds::list appended", list);
+  traversal_benchmark("std::list appended", std_list);
+  // sorting relinks the nodes, the traversal jumps around the memory
+  list.sort();
+  std_list.sort();
+  traversal_benchmark("ds::list sorted", list);
+  traversal_benchmark("std::list sorted", std_list);
+  list.compact();
+  traversal_benchmark("ds::list compacted", list);
+
+  insertion_benchmark<algol::ds::list<std::uint32_t>>("ds::list");
+  insertion_benchmark<std::list<std::uint32_t>>("std::list");
+
+  auto sort_values = random_values(SORT_ITEMS);
+  sort_benchmark<algol::ds::list<std::uint32_t>>("ds::list", sort_values);
+  sort_benchmark<std::list<std::uint32_t>>("std::list", sort_values);
+  sort_benchmark<std::forward_list<std::uint32_t>>("std::forward_list", sort_values);
+
+  return static_cast<int>(sink & 1);
+}
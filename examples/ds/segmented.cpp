@@ -0,0 +1,107 @@
+#include <iostream>
+#include <cstdint>
+#include <deque>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/stack/fixed_stack.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "algol/ds/stack/segmented_stack.hpp"
+#include "algol/ds/queue/fixed_queue.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+#include "algol/ds/queue/segmented_deque.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::size_t BENCHMARK_ITEMS = 1 << 20;
+const std::size_t CONTAINER_SIZE = 1 << 16;
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / BENCHMARK_ITEMS;
+}
+
+std::int64_t sink = 0;
+
+// S is a stack type, BENCHMARK_ITEMS items are pushed and popped CONTAINER_SIZE at a time
+template <typename S>
+void push_pop (S& stack)
+{
+  for (std::size_t round = 0; round < BENCHMARK_ITEMS / CONTAINER_SIZE; ++round) {
+    for (std::size_t i = 0; i < CONTAINER_SIZE; ++i)
+      stack.push(static_cast<std::int64_t>(i));
+    while (!stack.empty()) {
+      sink += stack.top();
+      stack.pop();
+    }
+  }
+}
+
+// Q is a queue type, CONTAINER_SIZE items are enqueued, then BENCHMARK_ITEMS items are enqueued and dequeued
+// one at a time, the queue slides along the memory
+template <typename Q>
+void sliding_window (Q& queue)
+{
+  for (std::size_t i = 0; i < CONTAINER_SIZE; ++i)
+    queue.enqueue(static_cast<std::int64_t>(i));
+  for (std::size_t i = 0; i < BENCHMARK_ITEMS; ++i) {
+    queue.enqueue(static_cast<std::int64_t>(i));
+    sink += queue.front();
+    queue.dequeue();
+  }
+  queue.clear();
+}
+
+// the adaptors of std::deque with the member functions used by the benchmarks
+struct std_deque_stack {
+  std::deque<std::int64_t> deque;
+
+  void push (std::int64_t value) { deque.push_back(value); }
+  void pop () { deque.pop_back(); }
+  std::int64_t top () const { return deque.back(); }
+  bool empty () const { return deque.empty(); }
+};
+
+struct std_deque_queue {
+  std::deque<std::int64_t> deque;
+
+  void enqueue (std::int64_t value) { deque.push_back(value); }
+  void dequeue () { deque.pop_front(); }
+  std::int64_t front () const { return deque.front(); }
+  void clear () { deque.clear(); }
+};
+
+template <typename S>
+void stack_benchmark (char const* container)
+{
+  S stack;
+  std::cout << container << ";push pop;" << BENCHMARK_ITEMS << ';'
+            << average_ns([&stack] { push_pop(stack); }) << ';' << std::endl;
+}
+
+template <typename Q>
+void queue_benchmark (char const* container)
+{
+  Q queue;
+  std::cout << container << ";sliding window;" << BENCHMARK_ITEMS << ';'
+            << average_ns([&queue] { sliding_window(queue); }) << ';' << std::endl;
+}
+
+int main ()
+{
+  std::cout << "container;operations;items;ns per item;" << std::endl;
+
+  // fixed_* hold CONTAINER_SIZE + 1 items allocated once, the bound every other container grows to
+  stack_benchmark<algol::ds::fixed_stack<std::int64_t, CONTAINER_SIZE + 1>>("fixed_stack");
+  stack_benchmark<algol::ds::linked_stack<std::int64_t>>("linked_stack");
+  stack_benchmark<algol::ds::segmented_stack<std::int64_t>>("segmented_stack");
+  stack_benchmark<std_deque_stack>("std::deque");
+
+  queue_benchmark<algol::ds::fixed_queue<std::int64_t, CONTAINER_SIZE + 1>>("fixed_queue");
+  queue_benchmark<algol::ds::linked_queue<std::int64_t>>("linked_queue");
+  queue_benchmark<algol::ds::segmented_deque<std::int64_t>>("segmented_deque");
+  queue_benchmark<std_deque_queue>("std::deque");
+
+  return static_cast<int>(sink & 1);
+}
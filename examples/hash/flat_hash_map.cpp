@@ -0,0 +1,141 @@
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "algol/perf/benchmark.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "algol/ds/hash/flat_hash_map.hpp"
+
+namespace ds = algol::ds;
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+using operation_counter = algol::perf::operation_counter<std::uint64_t, std::uint64_t>;
+
+const std::size_t BENCHMARK_RUNS = 3;
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count());
+}
+
+std::uint64_t sink = 0;
+
+// the keys present and the keys missing, in random order
+template <typename Key, typename Make>
+std::pair<std::vector<Key>, std::vector<Key>> make_keys (std::size_t n, Make make)
+{
+  std::mt19937_64 generator {42};
+  std::vector<Key> present, missing;
+  for (std::size_t i = 0; i < n; ++i) {
+    present.push_back(make(generator()));
+    missing.push_back(make(generator()));
+  }
+  return {present, missing};
+}
+
+// the nanoseconds per operation of insert, successful find, failed find and erase
+template <typename Map, typename Key>
+void run (std::string const& name, std::size_t n, std::vector<Key> const& present, std::vector<Key> const& missing)
+{
+  auto per_op = [n] (double ns) {
+    return ns / static_cast<double>(n);
+  };
+  Map map;
+  auto insert = average_ns([&map, &present] {
+    map = Map{};
+    for (auto const& key : present)
+      map.emplace(key, 1);
+  });
+  auto hit = average_ns([&map, &present] {
+    for (auto const& key : present)
+      sink += map.find(key) != map.end();
+  });
+  auto miss = average_ns([&map, &missing] {
+    for (auto const& key : missing)
+      sink += map.find(key) != map.end();
+  });
+  auto erase = average_ns([&map, &present] {
+    for (auto const& key : present)
+      sink += map.erase(key);
+    for (auto const& key : present)
+      map.emplace(key, 1);
+  });
+  std::cout << name << ';' << n << ';' << per_op(insert) << ';' << per_op(hit) << ';' << per_op(miss) << ';'
+            << per_op(erase) << ';' << std::endl;
+}
+
+struct counter_hash {
+  std::size_t operator() (operation_counter const& key) const noexcept
+  {
+    return ds::murmur3_hash<std::uint64_t>{}(key.value());
+  }
+};
+
+// the key comparisons and the moves of the keys counted with operation_counter
+template <typename Map>
+void instrument (std::string const& name, std::size_t n)
+{
+  std::vector<std::uint64_t> keys(2 * n);
+  std::mt19937_64 generator {7};
+  for (auto& key : keys)
+    key = generator();
+
+  operation_counter::reset();
+  Map map;
+  for (std::size_t i = 0; i < n; ++i)
+    map.emplace(keys[i], 1);
+  auto moves = operation_counter::moves() + operation_counter::constructions();
+  operation_counter::reset();
+  for (std::size_t i = 0; i < n; ++i)
+    sink += map.find(keys[i]) != map.end();
+  auto hit = operation_counter::equal_comparisons();
+  operation_counter::reset();
+  for (std::size_t i = n; i < 2 * n; ++i)
+    sink += map.find(keys[i]) != map.end();
+  auto miss = operation_counter::equal_comparisons();
+
+  auto per_op = [n] (std::uint64_t count) {
+    return static_cast<double>(count) / static_cast<double>(n);
+  };
+  std::cout << name << ';' << n << ';' << per_op(moves) << ';' << per_op(hit) << ';' << per_op(miss) << ';'
+            << std::endl;
+}
+
+int main ()
+{
+  using flat_int = ds::flat_hash_map<std::uint64_t, int>;
+  using flat_int_std_hash = ds::flat_hash_map<std::uint64_t, int, std::hash<std::uint64_t>>;
+  using std_int = std::unordered_map<std::uint64_t, int>;
+  using flat_string = ds::flat_hash_map<std::string, int>;
+  using std_string = std::unordered_map<std::string, int>;
+
+  std::cout << "map;items;insert ns;find hit ns;find miss ns;erase and insert ns;" << std::endl;
+  for (std::size_t n : {1000, 100000, 1000000}) {
+    auto [present, missing] = make_keys<std::uint64_t>(n, [] (std::uint64_t x) {
+      return x;
+    });
+    run<flat_int>("flat_hash_map<uint64_t> murmur3", n, present, missing);
+    // the identity hash of the integers fills the control bytes with the low bits of the keys
+    run<flat_int_std_hash>("flat_hash_map<uint64_t> std::hash", n, present, missing);
+    run<std_int>("std::unordered_map<uint64_t>", n, present, missing);
+
+    auto [present_strings, missing_strings] = make_keys<std::string>(n, [] (std::uint64_t x) {
+      return "key:" + std::to_string(x);
+    });
+    run<flat_string>("flat_hash_map<string>", n, present_strings, missing_strings);
+    run<std_string>("std::unordered_map<string>", n, present_strings, missing_strings);
+  }
+
+  std::cout << std::endl << "map;items;key constructions and moves per insert;comparisons per hit;"
+            << "comparisons per miss;" << std::endl;
+  for (std::size_t n : {1000, 100000}) {
+    instrument<ds::flat_hash_map<operation_counter, int, counter_hash>>("flat_hash_map", n);
+    instrument<std::unordered_map<operation_counter, int, counter_hash>>("std::unordered_map", n);
+  }
+
+  return sink == 0;
+}
@@ -1,14 +1,22 @@
 #include <array>
 #include <vector>
+#include <random>
 #include <iostream>
 #include <algorithm>
 #include "algol/io/pprint.hpp"
 #include "algol/perf/stopwatch.hpp"
 #include "algol/perf/operation_counter.hpp"
+#include "algol/algorithms/selection/introselect.hpp"
+#include "algol/algorithms/selection/floyd_rivest.hpp"
+#include "algol/algorithms/selection/partial_sort.hpp"
+#include "algol/algorithms/selection/top_k.hpp"
 
 #define COMMA ,
 PPRINT_DEFAULT_DECORATION(std::array<T COMMA N>, "[", "; ", "]", class T, std::size_t N)
 
+using stopwatch = algol::perf::stopwatch<std::chrono::microseconds>;
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
 template <typename T>
 T kth_largest (std::vector<T> xs, std::size_t k)
 {
@@ -31,11 +39,47 @@ T kth_largest2 (std::vector<T> xs, std::size_t k)
   return xs[k - 1];
 }
 
-int main ()
+template <typename T>
+T kth_largest_introselect (std::vector<T> xs, std::size_t k)
+{
+  algol::algorithms::selection::introselect(std::begin(xs), std::begin(xs) + k - 1, std::end(xs), std::greater<T>());
+  return xs[k - 1];
+}
+
+template <typename T>
+T kth_largest_floyd_rivest (std::vector<T> xs, std::size_t k)
+{
+  algol::algorithms::selection::floyd_rivest_select(std::begin(xs), std::begin(xs) + k - 1, std::end(xs),
+                                                    std::greater<T>());
+  return xs[k - 1];
+}
+
+template <typename T>
+T kth_largest_partial_sort (std::vector<T> xs, std::size_t k)
+{
+  algol::algorithms::selection::partial_sort(std::begin(xs), std::begin(xs) + k, std::end(xs), std::greater<T>());
+  return xs[k - 1];
+}
+
+template <typename T>
+T kth_largest_top_k (std::vector<T> const& xs, std::size_t k)
 {
-  using stopwatch = algol::perf::stopwatch<std::chrono::microseconds>;
-  using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+  return algol::algorithms::selection::top_k(std::begin(xs), std::end(xs), k, std::greater<T>()).back();
+}
 
+template <typename F>
+void run (std::string const& name, F f, std::vector<operation_counter> const& xs, std::size_t k)
+{
+  operation_counter::reset();
+  stopwatch sw;
+  auto kth = f(xs, k);
+  auto elapsed = sw.elapsed();
+  std::cout << name << ';' << xs.size() << ';' << k << ';' << kth << ';' << elapsed.count() << ';'
+            << operation_counter::great_comparisons() << ';' << operation_counter::swaps() << ';' << std::endl;
+}
+
+int main ()
+{
   std::vector<operation_counter> xs {5, 6, 9, 10, 23, 3, 8, 0, 22, 21};
 
   std::cout << "kth-largest" << std::endl;
@@ -58,5 +102,35 @@ int main ()
   std::cout << "3rd largest: " << k << std::endl;
   std::cout << operation_counter::report;
 
+  std::cout << "kth-largest introselect" << std::endl;
+  operation_counter::reset();
+  sw.restart();
+
+  k = kth_largest_introselect(xs, 3);
+
+  std::cout << sw << std::endl;
+  std::cout << "3rd largest: " << k << std::endl;
+  std::cout << operation_counter::report;
+
+  // comparisons grow as N log N for sort, N k for repeated prefix sort,
+  // N for selection and N log k for the bounded heap
+  std::mt19937 gen(std::random_device{}());
+  std::cout << std::endl << "algorithm;size;k;kth;elapsed (us);comparisons;swaps;" << std::endl;
+  for (auto n : {1000u, 10000u, 100000u}) {
+    std::uniform_int_distribution<std::int32_t> distribution(0, static_cast<std::int32_t>(n));
+    std::vector<operation_counter> values(n);
+    for (auto& v : values)
+      v = distribution(gen);
+
+    for (auto kth : {std::size_t{10}, std::size_t{n / 100}}) {
+      run("sort", kth_largest<operation_counter>, values, kth);
+      run("prefix sort", kth_largest2<operation_counter>, values, kth);
+      run("introselect", kth_largest_introselect<operation_counter>, values, kth);
+      run("floyd-rivest", kth_largest_floyd_rivest<operation_counter>, values, kth);
+      run("partial sort", kth_largest_partial_sort<operation_counter>, values, kth);
+      run("top-k", kth_largest_top_k<operation_counter>, values, kth);
+    }
+  }
+
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/queue/work_stealing_deque.hpp"
+#include "algol/parallel/task_scheduler.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const unsigned FIBONACCI_N = 25;
+const std::size_t DEQUE_ITEMS = 1 << 20;
+
+std::uint64_t sink = 0;
+
+template <typename F>
+double average_ns (F f, std::size_t items)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / static_cast<double>(items);
+}
+
+std::uint64_t fibonacci (unsigned n)
+{
+  return n < 2 ? n : fibonacci(n - 1) + fibonacci(n - 2);
+}
+
+// a task is spawned for every call, the work of a task is only an addition
+std::uint64_t fibonacci (algol::parallel::task_scheduler& scheduler, unsigned n)
+{
+  if (n < 2)
+    return n;
+  std::uint64_t a = 0;
+  algol::parallel::task_group group {scheduler};
+  group.spawn([&] { a = fibonacci(scheduler, n - 1); });
+  auto b = fibonacci(scheduler, n - 2);
+  group.sync();
+  return a + b;
+}
+
+void spawn_benchmark (std::size_t workers)
+{
+  // fibonacci(n) spawns fibonacci(n + 1) - 1 tasks
+  auto tasks = fibonacci(FIBONACCI_N + 1) - 1;
+  algol::parallel::task_scheduler scheduler {workers};
+  std::cout << "task_scheduler<" << workers << ">;spawn;" << tasks << ';' << average_ns([&] {
+    algol::parallel::task_group group {scheduler};
+    group.spawn([&] { sink ^= fibonacci(scheduler, FIBONACCI_N); });
+    group.sync();
+  }, tasks) << ';' << std::endl;
+}
+
+// the owner pushes the items and then takes its share while the thieves steal the others
+void steal_benchmark (std::size_t thieves)
+{
+  std::size_t stolen = 0;
+  auto ns = average_ns([&] {
+    algol::ds::work_stealing_deque<std::uint32_t> deque;
+    std::atomic<bool> ready {false};
+    std::atomic<std::size_t> thief_items {0};
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thieves; ++t)
+      threads.emplace_back([&] {
+        std::size_t count = 0;
+        while (!ready.load(std::memory_order_acquire))
+          std::this_thread::yield();
+        while (!deque.empty())
+          if (deque.try_steal())
+            ++count;
+        thief_items.fetch_add(count, std::memory_order_relaxed);
+      });
+    for (std::uint32_t i = 0; i < DEQUE_ITEMS; ++i)
+      deque.push(i);
+    ready.store(true, std::memory_order_release);
+    while (auto value = deque.try_pop())
+      sink ^= *value;
+    for (auto& thread : threads)
+      thread.join();
+    stolen = thief_items.load();
+  }, DEQUE_ITEMS);
+  std::cout << "work_stealing_deque;push+take " << thieves << " thieves;" << DEQUE_ITEMS << ';' << ns << ';'
+            << "stolen " << stolen << std::endl;
+}
+
+int main ()
+{
+  std::cout << "container;operations;items;ns per item;" << std::endl;
+
+  std::cout << "sequential;call;" << fibonacci(FIBONACCI_N + 1) - 1 << ';'
+            << average_ns([] { sink ^= fibonacci(FIBONACCI_N); }, fibonacci(FIBONACCI_N + 1) - 1) << ';'
+            << std::endl;
+  auto hardware = std::max(std::thread::hardware_concurrency(), 1u);
+  spawn_benchmark(1);
+  if (hardware > 1)
+    spawn_benchmark(hardware);
+
+  steal_benchmark(0);
+  steal_benchmark(1);
+  steal_benchmark(3);
+
+  return static_cast<int>(sink & 1);
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <queue>
+#include <vector>
+#include "algol/perf/benchmark.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "algol/ds/priority_queue/d_ary_heap.hpp"
+#include "algol/ds/priority_queue/pairing_heap.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+using operation_counter = algol::perf::operation_counter<std::int64_t, std::uint64_t>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::size_t BENCHMARK_ITEMS = 1 << 18;
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / BENCHMARK_ITEMS;
+}
+
+std::int64_t sink = 0;
+
+// the adaptor of std::priority_queue with the range constructor used by the benchmarks
+template <typename T>
+struct std_priority_queue : std::priority_queue<T> {
+  std_priority_queue () = default;
+
+  template <typename InputIt>
+  std_priority_queue (InputIt first, InputIt last) : std::priority_queue<T>(first, last)
+  {}
+};
+
+// H is a heap type, the items are heapified at once then popped
+template <typename H, typename T>
+void heapify_pop (std::vector<T> const& items)
+{
+  H heap {std::begin(items), std::end(items)};
+  while (!heap.empty()) {
+    sink ^= static_cast<std::int64_t>(heap.top());
+    heap.pop();
+  }
+}
+
+// H is a heap type, the items are pushed one at a time then popped
+template <typename H, typename T>
+void push_pop (std::vector<T> const& items)
+{
+  H heap;
+  for (auto const& item : items)
+    heap.push(item);
+  while (!heap.empty()) {
+    sink ^= static_cast<std::int64_t>(heap.top());
+    heap.pop();
+  }
+}
+
+// the comparisons of one run over items wrapped by operation_counter and the time of a run over plain items
+template <template <typename> typename H>
+void heap_benchmark (char const* container, std::vector<std::int64_t> const& items,
+                     std::vector<operation_counter> const& counted_items)
+{
+  operation_counter::reset();
+  heapify_pop<H<operation_counter>>(counted_items);
+  std::cout << container << ";heapify pop;" << BENCHMARK_ITEMS << ';'
+            << operation_counter::less_comparisons() << ';'
+            << average_ns([&items] { heapify_pop<H<std::int64_t>>(items); }) << ';' << std::endl;
+
+  operation_counter::reset();
+  push_pop<H<operation_counter>>(counted_items);
+  std::cout << container << ";push pop;" << BENCHMARK_ITEMS << ';'
+            << operation_counter::less_comparisons() << ';'
+            << average_ns([&items] { push_pop<H<std::int64_t>>(items); }) << ';' << std::endl;
+}
+
+template <typename T>
+using binary_heap = algol::ds::binary_heap<T>;
+template <typename T>
+using quaternary_heap = algol::ds::d_ary_heap<T, 4>;
+template <typename T>
+using octonary_heap = algol::ds::d_ary_heap<T, 8>;
+template <typename T>
+using pairing_heap = algol::ds::pairing_heap<T>;
+
+int main ()
+{
+  std::mt19937_64 gen(42);
+  std::vector<std::int64_t> items(BENCHMARK_ITEMS);
+  for (auto& item : items)
+    item = static_cast<std::int64_t>(gen() >> 1);
+  std::vector<operation_counter> counted_items(std::begin(items), std::end(items));
+
+  std::cout << "container;operations;items;less comparisons;ns per item;" << std::endl;
+
+  heap_benchmark<binary_heap>("binary_heap", items, counted_items);
+  heap_benchmark<quaternary_heap>("d_ary_heap<4>", items, counted_items);
+  heap_benchmark<octonary_heap>("d_ary_heap<8>", items, counted_items);
+  heap_benchmark<pairing_heap>("pairing_heap", items, counted_items);
+  heap_benchmark<std_priority_queue>("std::priority_queue", items, counted_items);
+
+  return static_cast<int>(sink & 1);
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <functional>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/priority_queue/d_ary_heap.hpp"
+#include "algol/ds/priority_queue/radix_heap.hpp"
+#include "algol/ds/priority_queue/bucket_queue.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+using key_interval = algol::integer::integer_interval<std::uint32_t>;
+using item = std::pair<std::uint32_t, std::uint32_t>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::uint32_t VERTICES = 1 << 16;
+const std::uint32_t EDGES_PER_VERTEX = 8;
+const std::uint32_t MAX_WEIGHT = 100;
+const std::size_t EVENTS = 1 << 14;
+const std::size_t HOLD_OPERATIONS = 1 << 20;
+
+std::uint64_t sink = 0;
+
+struct edge {
+  std::uint32_t to;
+  std::uint32_t weight;
+};
+
+using graph = std::vector<std::vector<edge>>;
+
+template <typename F>
+double average_ns (F f, std::size_t items)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / static_cast<double>(items);
+}
+
+// Q is a monotone priority queue of (distance, vertex), the stale items are skipped when popped
+template <typename Q>
+std::size_t dijkstra (Q& queue, graph const& g)
+{
+  std::vector<std::uint32_t> distance(g.size(), std::numeric_limits<std::uint32_t>::max());
+  std::size_t pops = 0;
+  distance[0] = 0;
+  queue.push({0, 0});
+  while (!queue.empty()) {
+    auto [d, u] = queue.top();
+    queue.pop();
+    ++pops;
+    if (d > distance[u])
+      continue;
+    for (auto const& e : g[u]) {
+      if (d + e.weight < distance[e.to]) {
+        distance[e.to] = d + e.weight;
+        queue.push({d + e.weight, e.to});
+      }
+    }
+  }
+  for (auto d : distance)
+    sink += d;
+  return pops;
+}
+
+// Q is a monotone priority queue of (time, event), every event popped schedules a new one at a later time
+template <typename Q>
+void hold (Q& queue)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::uint32_t> delay(1, MAX_WEIGHT);
+  for (std::uint32_t i = 0; i < EVENTS; ++i)
+    queue.push({delay(gen), i});
+  for (std::size_t i = 0; i < HOLD_OPERATIONS; ++i) {
+    auto [time, event] = queue.top();
+    queue.pop();
+    queue.push({time + delay(gen), event});
+  }
+  sink += queue.top().first;
+  queue.clear();
+}
+
+// F makes an empty queue
+template <typename F>
+void queue_benchmark (char const* container, graph const& g, F make_queue)
+{
+  auto queue = make_queue();
+  auto pops = dijkstra(queue, g);
+  std::cout << container << ";dijkstra;" << pops << ';'
+            << average_ns([&] { auto q = make_queue(); dijkstra(q, g); }, pops) << ';' << std::endl;
+  std::cout << container << ";hold;" << HOLD_OPERATIONS << ';'
+            << average_ns([&] { auto q = make_queue(); hold(q); }, HOLD_OPERATIONS) << ';' << std::endl;
+}
+
+int main ()
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::uint32_t> vertex(0, VERTICES - 1);
+  std::uniform_int_distribution<std::uint32_t> weight(1, MAX_WEIGHT);
+  graph g(VERTICES);
+  for (auto& edges : g)
+    for (std::uint32_t i = 0; i < EDGES_PER_VERTEX; ++i)
+      edges.push_back({vertex(gen), weight(gen)});
+
+  std::cout << "container;operations;items;ns per item;" << std::endl;
+
+  queue_benchmark("binary_heap", g, [] { return algol::ds::binary_heap<item, std::greater<>>{}; });
+  queue_benchmark("d_ary_heap<4>", g, [] { return algol::ds::d_ary_heap<item, 4, std::greater<>>{}; });
+  // every std::uint32_t key, 33 buckets
+  queue_benchmark("radix_heap", g, [] { return algol::ds::radix_heap<std::uint32_t, std::uint32_t>{}; });
+  // the keys pushed are at most MAX_WEIGHT greater than the last key popped
+  queue_benchmark("bucket_queue", g, [] {
+    return algol::ds::bucket_queue<std::uint32_t, std::uint32_t>{key_interval{0, MAX_WEIGHT}};
+  });
+
+  return static_cast<int>(sink & 1);
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "algol/ds/queue/blocking_queue.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+const std::size_t BENCHMARK_ITEMS = 1 << 20;
+const std::size_t QUEUE_SIZE = 1024;
+
+// the items carry the time they were enqueued
+using queue_type = algol::ds::blocking_queue<clock_type::rep, QUEUE_SIZE>;
+
+// voluntary and involuntary context switches of the process, zero where getrusage is missing
+long context_switches ()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_nvcsw + usage.ru_nivcsw;
+#else
+  return 0;
+#endif
+}
+
+struct result {
+  double ns_per_item;
+  double average_latency_ns;
+  double max_latency_ns;
+  long context_switches;
+};
+
+// a producer enqueues BENCHMARK_ITEMS items in batches of batch items, a consumer dequeues them in batches
+result transfer (std::size_t batch)
+{
+  queue_type queue;
+  double total_latency = 0;
+  clock_type::rep max_latency = 0;
+  auto switches = context_switches();
+  auto start = clock_type::now();
+
+  std::thread consumer {[&queue, &total_latency, &max_latency, batch] {
+    std::vector<clock_type::rep> items(batch);
+    std::size_t n;
+    while ((n = queue.wait_dequeue_n(std::begin(items), batch)) > 0) {
+      auto now = clock_type::now().time_since_epoch().count();
+      for (std::size_t i = 0; i < n; ++i) {
+        total_latency += static_cast<double>(now - items[i]);
+        max_latency = std::max(max_latency, now - items[i]);
+      }
+    }
+  }};
+
+  std::vector<clock_type::rep> items(batch);
+  for (std::size_t sent = 0; sent < BENCHMARK_ITEMS; sent += batch) {
+    auto now = clock_type::now().time_since_epoch().count();
+    std::fill(std::begin(items), std::end(items), now);
+    if (batch == 1)
+      queue.wait_enqueue(items[0]);
+    else
+      queue.wait_enqueue_range(std::begin(items), std::end(items));
+  }
+  queue.close();
+  consumer.join();
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::duration{max_latency}).count();
+  return {static_cast<double>(elapsed) / BENCHMARK_ITEMS,
+          std::chrono::duration<double, std::nano>(clock_type::duration{1}).count() * total_latency / BENCHMARK_ITEMS,
+          static_cast<double>(ns), context_switches() - switches};
+}
+
+int main ()
+{
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "batch;items;ns per item;average latency ns;max latency ns;context switches;" << std::endl;
+
+  for (std::size_t batch : {1u, 8u, 64u, 256u}) {
+    auto r = transfer(batch);
+    std::cout << batch << ';' << BENCHMARK_ITEMS << ';' << r.ns_per_item << ';' << r.average_latency_ns << ';'
+              << r.max_latency_ns << ';' << r.context_switches << ';' << std::endl;
+  }
+
+  return 0;
+}
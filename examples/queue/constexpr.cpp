@@ -0,0 +1,113 @@
+#include <iostream>
+#include <array>
+#include <cstddef>
+#include "algol/ds/queue/array_queue.hpp"
+
+namespace ds = algol::ds;
+
+constexpr std::size_t BOARD = 8;
+
+using board = std::array<std::array<int, BOARD>, BOARD>;
+
+// the number of knight moves from the square (row, column) to every square, computed by a breadth first search
+constexpr board knight_distances (int row, int column)
+{
+  constexpr int moves[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+  board distance {};
+  for (auto& r : distance)
+    for (auto& d : r)
+      d = -1;
+
+  // every square is enqueued once
+  ds::array_queue<std::array<int, 2>, BOARD * BOARD> queue;
+  distance[static_cast<std::size_t>(row)][static_cast<std::size_t>(column)] = 0;
+  queue.enqueue({row, column});
+  // loop invariant: the squares dequeued have their final distance, the ones enqueued are one move further
+  while (!queue.empty()) {
+    auto [r, c] = queue.front();
+    queue.dequeue();
+    for (auto const& move : moves) {
+      auto nr = r + move[0], nc = c + move[1];
+      if (nr < 0 || nr >= static_cast<int>(BOARD) || nc < 0 || nc >= static_cast<int>(BOARD))
+        continue;
+      auto& d = distance[static_cast<std::size_t>(nr)][static_cast<std::size_t>(nc)];
+      if (d != -1)
+        continue;
+      d = distance[static_cast<std::size_t>(r)][static_cast<std::size_t>(c)] + 1;
+      queue.enqueue({nr, nc});
+    }
+  }
+  return distance;
+}
+
+constexpr std::size_t VERTICES = 8;
+
+using graph = std::array<std::array<bool, VERTICES>, VERTICES>;
+
+// a small fixed undirected graph: a ring 0-1-2-3-4-5-0, a chord 1-4 and a tail 5-6-7
+constexpr graph make_graph ()
+{
+  constexpr int edges[][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 0}, {1, 4}, {5, 6}, {6, 7}};
+  graph g {};
+  for (auto const& e : edges) {
+    g[static_cast<std::size_t>(e[0])][static_cast<std::size_t>(e[1])] = true;
+    g[static_cast<std::size_t>(e[1])][static_cast<std::size_t>(e[0])] = true;
+  }
+  return g;
+}
+
+// the table of the shortest distances between every pair of vertices, a breadth first search per vertex
+constexpr std::array<std::array<int, VERTICES>, VERTICES> all_distances (graph const& g)
+{
+  std::array<std::array<int, VERTICES>, VERTICES> table {};
+  for (std::size_t source = 0; source < VERTICES; ++source) {
+    auto& distance = table[source];
+    for (auto& d : distance)
+      d = -1;
+    ds::array_queue<std::size_t, VERTICES> queue;
+    distance[source] = 0;
+    queue.enqueue(source);
+    // loop invariant: the vertices dequeued have their final distance
+    while (!queue.empty()) {
+      auto v = queue.front();
+      queue.dequeue();
+      for (std::size_t w = 0; w < VERTICES; ++w)
+        if (g[v][w] && distance[w] == -1) {
+          distance[w] = distance[v] + 1;
+          queue.enqueue(w);
+        }
+    }
+  }
+  return table;
+}
+
+// the tables are part of the program, no search runs at runtime
+constexpr auto knight = knight_distances(0, 0);
+constexpr auto distances = all_distances(make_graph());
+
+static_assert(knight[0][0] == 0);
+static_assert(knight[1][2] == 1);
+static_assert(knight[1][1] == 4);
+static_assert(knight[7][7] == 6);
+static_assert(distances[0][3] == 3);
+static_assert(distances[2][4] == 2);
+static_assert(distances[0][7] == 3);
+static_assert(distances[3][7] == 4);
+
+int main ()
+{
+  std::cout << "knight moves from a1:" << std::endl;
+  for (auto r = BOARD; r > 0; --r) {
+    for (auto d : knight[r - 1])
+      std::cout << d << ' ';
+    std::cout << std::endl;
+  }
+
+  std::cout << "graph distances:" << std::endl;
+  for (auto const& row : distances) {
+    for (auto d : row)
+      std::cout << d << ' ';
+    std::cout << std::endl;
+  }
+  return 0;
+}
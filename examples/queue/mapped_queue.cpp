@@ -0,0 +1,104 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <unistd.h>
+#include "algol/ds/queue/mapped_queue.hpp"
+
+namespace ds = algol::ds;
+
+using clock_type = std::chrono::steady_clock;
+
+const std::size_t QUEUE_SIZE = 1 << 16;
+
+// a spilled item: an id and a small payload
+struct record {
+  std::uint64_t id;
+  std::uint64_t payload[7];
+};
+
+std::string policy_name (ds::sync_policy policy)
+{
+  switch (policy) {
+    case ds::sync_policy::none:
+      return "none";
+    case ds::sync_policy::each:
+      return "each";
+    case ds::sync_policy::batch:
+      return "batch";
+  }
+  return "";
+}
+
+// items records enqueued and then dequeued, the nanoseconds per operation
+double spill (std::string const& path, ds::sync_policy policy, std::size_t batch, std::size_t items)
+{
+  std::filesystem::remove(path);
+  std::uint64_t sum = 0;
+  auto start = clock_type::now();
+  {
+    ds::mapped_queue<record> queue {path, QUEUE_SIZE, policy, batch};
+    for (std::uint64_t i = 0; i < items; ++i)
+      queue.enqueue({i, {i, i, i, i, i, i, i}});
+    // loop invariant: the records dequeued are added to sum
+    while (!queue.empty()) {
+      sum += queue.front().id;
+      queue.dequeue();
+    }
+  }
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+  std::filesystem::remove(path);
+  if (sum != items * (items - 1) / 2)
+    std::cerr << "wrong sum" << std::endl;
+  return static_cast<double>(ns) / static_cast<double>(2 * items);
+}
+
+// the same with records of variable length
+double spill_records (std::string const& path, ds::sync_policy policy, std::size_t batch, std::size_t items)
+{
+  std::filesystem::remove(path);
+  std::size_t bytes = 0;
+  auto start = clock_type::now();
+  {
+    ds::mapped_record_queue queue {path, QUEUE_SIZE * sizeof(record), policy, batch};
+    for (std::size_t i = 0; i < items; ++i)
+      queue.enqueue(std::string(i % 100, 'x'));
+    // loop invariant: the lengths of the records dequeued are added to bytes
+    while (!queue.empty()) {
+      bytes += queue.front().size();
+      queue.dequeue();
+    }
+  }
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+  std::filesystem::remove(path);
+  if (bytes == 0 && items > 1)
+    std::cerr << "no records" << std::endl;
+  return static_cast<double>(ns) / static_cast<double>(2 * items);
+}
+
+// the cost of a durable operation is the cost of a flush: the policies differ by how many operations share one
+int main (int argc, char* argv[])
+{
+  auto directory = argc > 1 ? std::filesystem::path{argv[1]} : std::filesystem::temp_directory_path();
+  auto path = (directory / ("mapped_queue_" + std::to_string(::getpid()))).string();
+
+  std::cout << "queue;policy;batch;items;ns/op;" << std::endl;
+  struct run {
+    ds::sync_policy policy;
+    std::size_t batch;
+    std::size_t items;
+  };
+  // every operation of each flushes a page, it runs on less items
+  std::vector<run> runs {{ds::sync_policy::none, 0, QUEUE_SIZE}, {ds::sync_policy::each, 0, 2000},
+                         {ds::sync_policy::batch, 16, 20000}, {ds::sync_policy::batch, 256, QUEUE_SIZE},
+                         {ds::sync_policy::batch, 4096, QUEUE_SIZE}};
+  for (auto const& r : runs)
+    std::cout << "mapped_queue;" << policy_name(r.policy) << ';' << r.batch << ';' << r.items << ';'
+              << spill(path, r.policy, r.batch, r.items) << ';' << std::endl;
+  for (auto const& r : runs)
+    std::cout << "mapped_record_queue;" << policy_name(r.policy) << ';' << r.batch << ';' << r.items << ';'
+              << spill_records(path, r.policy, r.batch, r.items) << ';' << std::endl;
+  return 0;
+}
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/queue/fixed_queue.hpp"
+#include "algol/ds/queue/mpmc_queue.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 3;
+const std::size_t BENCHMARK_ITEMS = 1 << 21;
+const std::size_t QUEUE_SIZE = 1024;
+
+// fixed_queue is not thread safe, every operation takes the lock
+template <typename T, std::size_t N>
+class locked_fixed_queue {
+public:
+  bool try_enqueue (T const& value)
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    if (queue_.full())
+      return false;
+    queue_.enqueue(value);
+    return true;
+  }
+
+  bool try_dequeue (T& value)
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    if (queue_.empty())
+      return false;
+    value = queue_.front();
+    queue_.dequeue();
+    return true;
+  }
+
+private:
+  std::mutex mutex_;
+  algol::ds::fixed_queue<T, N> queue_;
+};
+
+template <typename Queue>
+struct spin {
+  static void enqueue (Queue& queue, std::int64_t value)
+  {
+    while (!queue.try_enqueue(value))
+      std::this_thread::yield();
+  }
+
+  static std::int64_t dequeue (Queue& queue)
+  {
+    std::int64_t value;
+    while (!queue.try_dequeue(value))
+      std::this_thread::yield();
+    return value;
+  }
+};
+
+template <typename Queue>
+struct block {
+  static void enqueue (Queue& queue, std::int64_t value)
+  {
+    queue.wait_enqueue(value);
+  }
+
+  static std::int64_t dequeue (Queue& queue)
+  {
+    std::int64_t value;
+    queue.wait_dequeue(value);
+    return value;
+  }
+};
+
+// threads / 2 producers and threads / 2 consumers transfer BENCHMARK_ITEMS items
+template <typename Queue, template <typename> class Access>
+void transfer (std::size_t threads)
+{
+  Queue queue;
+  auto pairs = threads / 2;
+  auto items = BENCHMARK_ITEMS / pairs;
+  std::vector<std::int64_t> sums(pairs);
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < pairs; ++t) {
+    workers.emplace_back([&queue, items] {
+      for (std::size_t i = 0; i < items; ++i)
+        Access<Queue>::enqueue(queue, static_cast<std::int64_t>(i));
+    });
+    workers.emplace_back([&queue, &sums, items, t] {
+      for (std::size_t i = 0; i < items; ++i)
+        sums[t] += Access<Queue>::dequeue(queue);
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+
+  std::int64_t sum = 0;
+  for (auto s : sums)
+    sum += s;
+  if (sum != static_cast<std::int64_t>(pairs * items * (items - 1) / 2))
+    std::cerr << "lost items" << std::endl;
+}
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / BENCHMARK_ITEMS;
+}
+
+int main ()
+{
+  using locked_queue = locked_fixed_queue<std::int64_t, QUEUE_SIZE>;
+  using lock_free_queue = algol::ds::mpmc_queue<std::int64_t, QUEUE_SIZE>;
+
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "queue;threads;items;ns per item;" << std::endl;
+
+  for (std::size_t threads : {2u, 4u, 8u, 16u, 32u, 64u}) {
+    std::cout << "mutex fixed_queue;" << threads << ';' << BENCHMARK_ITEMS << ';'
+              << average_ns([threads] { transfer<locked_queue, spin>(threads); }) << ';' << std::endl;
+    std::cout << "mpmc_queue try;" << threads << ';' << BENCHMARK_ITEMS << ';'
+              << average_ns([threads] { transfer<lock_free_queue, spin>(threads); }) << ';' << std::endl;
+    std::cout << "mpmc_queue wait;" << threads << ';' << BENCHMARK_ITEMS << ';'
+              << average_ns([threads] { transfer<lock_free_queue, block>(threads); }) << ';' << std::endl;
+  }
+
+  return 0;
+}
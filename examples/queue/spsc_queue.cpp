@@ -0,0 +1,157 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/queue/fixed_queue.hpp"
+#include "algol/ds/queue/spsc_queue.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::size_t THROUGHPUT_ITEMS = 1 << 22;
+const std::size_t LATENCY_ROUND_TRIPS = 1 << 16;
+const std::size_t QUEUE_SIZE = 1024;
+const std::size_t BATCH_SIZE = 64;
+
+// fixed_queue is not thread safe, every operation takes the lock
+template <typename T, std::size_t N>
+class locked_fixed_queue {
+public:
+  bool try_enqueue (T const& value)
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    if (queue_.full())
+      return false;
+    queue_.enqueue(value);
+    return true;
+  }
+
+  bool try_dequeue (T& value)
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    if (queue_.empty())
+      return false;
+    value = queue_.front();
+    queue_.dequeue();
+    return true;
+  }
+
+private:
+  std::mutex mutex_;
+  algol::ds::fixed_queue<T, N> queue_;
+};
+
+template <typename Queue>
+void enqueue (Queue& queue, std::int64_t value)
+{
+  while (!queue.try_enqueue(value))
+    std::this_thread::yield();
+}
+
+template <typename Queue>
+std::int64_t dequeue (Queue& queue)
+{
+  std::int64_t value;
+  while (!queue.try_dequeue(value))
+    std::this_thread::yield();
+  return value;
+}
+
+// producer and consumer transfer THROUGHPUT_ITEMS items one at a time
+template <typename Queue>
+void throughput ()
+{
+  Queue queue;
+  std::thread producer {[&queue] {
+    for (std::size_t i = 0; i < THROUGHPUT_ITEMS; ++i)
+      enqueue(queue, static_cast<std::int64_t>(i));
+  }};
+  std::int64_t sum = 0;
+  for (std::size_t i = 0; i < THROUGHPUT_ITEMS; ++i)
+    sum += dequeue(queue);
+  producer.join();
+  if (sum != static_cast<std::int64_t>(THROUGHPUT_ITEMS * (THROUGHPUT_ITEMS - 1) / 2))
+    std::cerr << "lost items" << std::endl;
+}
+
+// producer and consumer transfer THROUGHPUT_ITEMS items BATCH_SIZE at a time
+template <typename Queue>
+void batch_throughput ()
+{
+  Queue queue;
+  std::thread producer {[&queue] {
+    std::vector<std::int64_t> batch(BATCH_SIZE);
+    for (std::size_t i = 0; i < THROUGHPUT_ITEMS; i += BATCH_SIZE) {
+      for (std::size_t j = 0; j < BATCH_SIZE; ++j)
+        batch[j] = static_cast<std::int64_t>(i + j);
+      for (std::size_t done = 0; done < BATCH_SIZE;) {
+        auto count = queue.try_enqueue_n(std::begin(batch) + static_cast<std::ptrdiff_t>(done), BATCH_SIZE - done);
+        if (count == 0)
+          std::this_thread::yield();
+        done += count;
+      }
+    }
+  }};
+  std::vector<std::int64_t> batch(BATCH_SIZE);
+  std::int64_t sum = 0;
+  for (std::size_t i = 0; i < THROUGHPUT_ITEMS;) {
+    auto count = queue.try_dequeue_n(std::begin(batch), BATCH_SIZE);
+    if (count == 0)
+      std::this_thread::yield();
+    for (std::size_t j = 0; j < count; ++j)
+      sum += batch[j];
+    i += count;
+  }
+  producer.join();
+  if (sum != static_cast<std::int64_t>(THROUGHPUT_ITEMS * (THROUGHPUT_ITEMS - 1) / 2))
+    std::cerr << "lost items" << std::endl;
+}
+
+// an item goes back and forth between two threads through two queues
+template <typename Queue>
+void round_trip ()
+{
+  Queue ping, pong;
+  std::thread echo {[&ping, &pong] {
+    for (std::size_t i = 0; i < LATENCY_ROUND_TRIPS; ++i)
+      enqueue(pong, dequeue(ping));
+  }};
+  for (std::size_t i = 0; i < LATENCY_ROUND_TRIPS; ++i) {
+    enqueue(ping, static_cast<std::int64_t>(i));
+    if (dequeue(pong) != static_cast<std::int64_t>(i))
+      std::cerr << "wrong item" << std::endl;
+  }
+  echo.join();
+}
+
+template <typename F>
+double average_ns (F f, std::size_t operations)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / operations;
+}
+
+int main ()
+{
+  using locked_queue = locked_fixed_queue<std::int64_t, QUEUE_SIZE>;
+  using lock_free_queue = algol::ds::spsc_queue<std::int64_t, QUEUE_SIZE>;
+
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "queue;benchmark;operations;ns per operation;" << std::endl;
+
+  std::cout << "mutex fixed_queue;throughput;" << THROUGHPUT_ITEMS << ';'
+            << average_ns(throughput<locked_queue>, THROUGHPUT_ITEMS) << ';' << std::endl;
+  std::cout << "spsc_queue;throughput;" << THROUGHPUT_ITEMS << ';'
+            << average_ns(throughput<lock_free_queue>, THROUGHPUT_ITEMS) << ';' << std::endl;
+  std::cout << "spsc_queue batch " << BATCH_SIZE << ";throughput;" << THROUGHPUT_ITEMS << ';'
+            << average_ns(batch_throughput<lock_free_queue>, THROUGHPUT_ITEMS) << ';' << std::endl;
+
+  std::cout << "mutex fixed_queue;round trip latency;" << LATENCY_ROUND_TRIPS << ';'
+            << average_ns(round_trip<locked_queue>, LATENCY_ROUND_TRIPS) << ';' << std::endl;
+  std::cout << "spsc_queue;round trip latency;" << LATENCY_ROUND_TRIPS << ';'
+            << average_ns(round_trip<lock_free_queue>, LATENCY_ROUND_TRIPS) << ';' << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <thread>
+#include <cassert>
+#include <algorithm>
+#include "pcg_random.hpp"
+#include "algol/perf/benchmark.hpp"
+#include "algol/algorithms/sort/sample_sort.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::milliseconds>;
+
+const std::size_t BENCHMARK_RUNS = 3;
+const std::size_t BENCHMARK_SIZE = 1 << 23;
+
+template <typename URBG>
+std::vector<std::int64_t> build_random_vector (std::size_t n, URBG&& gen)
+{
+  std::uniform_int_distribution<std::int64_t> distribution;
+  std::vector<std::int64_t> values(n);
+  for (auto& v : values)
+    v = distribution(gen);
+  return values;
+}
+
+int main ()
+{
+  pcg_extras::seed_seq_from<std::random_device> seed_source;
+  pcg32 rng(seed_source);
+
+  auto values = build_random_vector(BENCHMARK_SIZE, rng);
+
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "algorithm;threads;size;elapsed (ms);speedup;" << std::endl;
+
+  auto average = [&values] (auto f) {
+    std::vector<std::vector<std::int64_t>> inputs(BENCHMARK_RUNS, values);
+    auto run_num = 0;
+    auto result = benchmark::run_n(BENCHMARK_RUNS, [&run_num, &inputs, &f] () {
+      f(inputs[run_num]);
+      assert(std::is_sorted(std::begin(inputs[run_num]), std::end(inputs[run_num])));
+      ++run_num;
+    });
+    return benchmark::run_average(result).duration.count();
+  };
+
+  auto sequential = average([] (auto& xs) { std::sort(std::begin(xs), std::end(xs)); });
+  std::cout << "std::sort;1;" << BENCHMARK_SIZE << ';' << sequential << ";1;" << std::endl;
+
+  for (std::size_t threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    auto elapsed = average([threads] (auto& xs) {
+      algol::algorithms::sort::parallel_sample_sort(std::begin(xs), std::end(xs), std::less<>{}, threads);
+    });
+    std::cout << "parallel_sample_sort;" << threads << ';' << BENCHMARK_SIZE << ';' << elapsed << ';'
+              << (elapsed > 0 ? static_cast<double>(sequential) / elapsed : 0.0) << ';' << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,309 @@
+// sort benchmark matrix
+// every algorithm of algorithms/sort is run on every combination of container, element type,
+// input distribution and size; the time is measured on the plain element type, the operations are counted
+// in a second run on the same input wrapped in operation_counter.
+// The output is CSV, one row for each combination:
+// algorithm,container,type,distribution,size,runs,time_ns,comparisons,swaps,moves
+//
+// usage: sort.benchmark_matrix [--filter REGEX] [--sizes N,N,...] [--runs N] [--max-quadratic N]
+// --filter          run only the combinations whose "algorithm/container/type/distribution" matches REGEX
+// --sizes           sizes of the input ranges, default 8,64,512,4096,32768, the size 0 is skipped
+// --runs            timed runs for each combination, the average is reported, default 3
+// --max-quadratic   maximum size for the O(N^2) algorithms, default 4096
+#include <iostream>
+#include <array>
+#include <deque>
+#include <list>
+#include <forward_list>
+#include <vector>
+#include <string>
+#include <regex>
+#include <random>
+#include <tuple>
+#include <chrono>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include "pcg_random.hpp"
+#include "algol/perf/stopwatch.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "algol/algorithms/sort/bogo_sort.hpp"
+#include "algol/algorithms/sort/bubble_sort.hpp"
+#include "algol/algorithms/sort/selection_sort.hpp"
+#include "algol/algorithms/sort/insertion_sort.hpp"
+#include "algol/algorithms/sort/shell_sort.hpp"
+#include "algol/algorithms/sort/cached_key_sort.hpp"
+#include "algol/algorithms/sort/sample_sort.hpp"
+
+using stopwatch = algol::perf::stopwatch<std::chrono::nanoseconds>;
+
+namespace sort = algol::algorithms::sort;
+
+struct small_struct {
+  int key;
+  int payload;
+
+  friend bool operator< (small_struct const& x, small_struct const& y)
+  { return x.key < y.key; }
+};
+
+struct large_struct {
+  int key;
+  std::array<char, 252> payload;
+
+  friend bool operator< (large_struct const& x, large_struct const& y)
+  { return x.key < y.key; }
+};
+
+template <typename T>
+T make_value (int value)
+{
+  if constexpr (std::is_same_v<T, std::string>)
+    return std::to_string(value);
+  else if constexpr (std::is_same_v<T, small_struct>)
+    return small_struct {value, value};
+  else if constexpr (std::is_same_v<T, large_struct>)
+    return large_struct {value, {}};
+  else
+    return static_cast<T>(value);
+}
+
+template <typename T>
+char const* type_name ()
+{
+  if constexpr (std::is_same_v<T, int>) return "int";
+  else if constexpr (std::is_same_v<T, double>) return "double";
+  else if constexpr (std::is_same_v<T, std::string>) return "string";
+  else if constexpr (std::is_same_v<T, small_struct>) return "small_struct";
+  else return "large_struct";
+}
+
+template <typename T> char const* container_name (std::vector<T> const*) { return "vector"; }
+template <typename T> char const* container_name (std::deque<T> const*) { return "deque"; }
+template <typename T> char const* container_name (std::list<T> const*) { return "list"; }
+template <typename T> char const* container_name (std::forward_list<T> const*) { return "forward_list"; }
+
+enum class complexity { factorial, quadratic, linearithmic };
+
+// RandomAccess: needs random access iterators
+template <bool RandomAccess, typename F>
+struct algorithm {
+  static constexpr bool random_access = RandomAccess;
+  char const* name;
+  complexity cost;
+  bool counted;  // operation_counter is not thread safe, the parallel algorithms are not counted
+  F sort;
+};
+
+template <bool RandomAccess = false, typename F>
+algorithm<RandomAccess, F> make_algorithm (char const* name, complexity cost, F f, bool counted = true)
+{
+  return algorithm<RandomAccess, F> {name, cost, counted, f};
+}
+
+auto algorithms = std::make_tuple(
+    make_algorithm("bogo_sort_random", complexity::factorial,
+                   [] (auto first, auto last) { sort::bogo_sort_random(first, last); }),
+    // permutations checks first > last, it needs random access iterators
+    make_algorithm<true>("bogo_sort_deterministic", complexity::factorial,
+                         [] (auto first, auto last) { sort::bogo_sort_deterministic(first, last); }),
+    make_algorithm("bubble_sort", complexity::quadratic,
+                   [] (auto first, auto last) { sort::bubble_sort(first, last); }),
+    make_algorithm("bubble_sort_optimized", complexity::quadratic,
+                   [] (auto first, auto last) { sort::bubble_sort_optimized(first, last); }),
+    make_algorithm("bubble_sort_fast", complexity::quadratic,
+                   [] (auto first, auto last) { sort::bubble_sort_fast(first, last); }),
+    make_algorithm("comb_sort", complexity::quadratic,
+                   [] (auto first, auto last) { sort::comb_sort(first, last); }),
+    make_algorithm("selection_sort", complexity::quadratic,
+                   [] (auto first, auto last) { sort::selection_sort(first, last); }),
+    make_algorithm("selection_sort_stl", complexity::quadratic,
+                   [] (auto first, auto last) { sort::selection_sort_stl(first, last); }),
+    make_algorithm("insertion_sort", complexity::quadratic,
+                   [] (auto first, auto last) { sort::insertion_sort(first, last); }),
+    make_algorithm("insertion_sort_stl", complexity::quadratic,
+                   [] (auto first, auto last) { sort::insertion_sort_stl(first, last); }),
+    make_algorithm("shell_sort", complexity::quadratic,
+                   [] (auto first, auto last) { sort::shell_sort(first, last); }),
+    make_algorithm("shell_sort_ciura_gaps", complexity::quadratic,
+                   [] (auto first, auto last) { sort::shell_sort_ciura_gaps(first, last); }),
+    make_algorithm("shell_sort_hibbard_gaps", complexity::quadratic,
+                   [] (auto first, auto last) { sort::shell_sort_hibbard_gaps(first, last); }),
+    make_algorithm("shell_sort_sedgewick_gaps", complexity::quadratic,
+                   [] (auto first, auto last) { sort::shell_sort_sedgewick_gaps(first, last); }),
+    make_algorithm<true>("cached_key_sort", complexity::linearithmic,
+                         [] (auto first, auto last) {
+                           sort::cached_key_sort(first, last, [] (auto const& x) { return x; });
+                         }),
+    make_algorithm<true>("parallel_sample_sort", complexity::linearithmic,
+                         [] (auto first, auto last) { sort::parallel_sample_sort(first, last); }, false),
+    make_algorithm<true>("std::sort", complexity::linearithmic,
+                         [] (auto first, auto last) { std::sort(first, last); }));
+
+struct distribution {
+  char const* name;
+  int values;     // the elements are drawn from [0, values), 0 means [0, size)
+  enum { random, sorted, reversed, nearly_sorted } order;
+};
+
+std::array<distribution, 5> distributions {{
+  {"random", 0, distribution::random},
+  {"sorted", 0, distribution::sorted},
+  {"reversed", 0, distribution::reversed},
+  {"nearly_sorted", 0, distribution::nearly_sorted},
+  {"few_unique", 8, distribution::random}}};
+
+struct options {
+  std::regex filter {".*"};
+  std::vector<std::size_t> sizes {8, 64, 512, 4096, 32768};
+  std::size_t runs = 3;
+  std::size_t max_quadratic = 4096;
+  std::size_t max_factorial = 8;
+};
+
+template <typename T, typename URBG>
+std::vector<T> make_input (distribution const& dist, std::size_t size, URBG& gen)
+{
+  auto values = dist.values > 0 ? dist.values : static_cast<int>(size);
+  std::uniform_int_distribution<int> draw(0, values - 1);
+  std::vector<T> input;
+  input.reserve(size);
+  for (std::size_t i = 0; i < size; ++i)
+    input.push_back(make_value<T>(draw(gen)));
+
+  switch (dist.order) {
+    case distribution::random:
+      break;
+    case distribution::sorted:
+      std::sort(std::begin(input), std::end(input));
+      break;
+    case distribution::reversed:
+      std::sort(std::begin(input), std::end(input));
+      std::reverse(std::begin(input), std::end(input));
+      break;
+    case distribution::nearly_sorted: {
+      // 1% of the elements out of place
+      std::sort(std::begin(input), std::end(input));
+      std::uniform_int_distribution<std::size_t> position(0, size - 1);
+      for (std::size_t i = 0; i < std::max<std::size_t>(1, size / 100); ++i)
+        std::iter_swap(std::begin(input) + position(gen), std::begin(input) + position(gen));
+      break;
+    }
+  }
+  return input;
+}
+
+template <template <typename...> class Container, typename T, typename Algorithm>
+void run (Algorithm const& algo, distribution const& dist, std::vector<T> const& input, options const& opts)
+{
+  using counter = algol::perf::operation_counter<T, std::uint64_t>;
+  using iterator_category = typename std::iterator_traits<typename Container<T>::iterator>::iterator_category;
+
+  if constexpr (!Algorithm::random_access || std::is_same_v<iterator_category, std::random_access_iterator_tag>) {
+    auto size = input.size();
+    if (algo.cost == complexity::factorial && size > opts.max_factorial)
+      return;
+    if (algo.cost == complexity::quadratic && size > opts.max_quadratic)
+      return;
+
+    auto container = container_name(static_cast<Container<T> const*>(nullptr));
+    auto name = std::string(algo.name) + '/' + container + '/' + type_name<T>() + '/' + dist.name;
+    if (!std::regex_search(name, opts.filter))
+      return;
+
+    std::chrono::nanoseconds elapsed {0};
+    for (std::size_t run = 0; run < opts.runs; ++run) {
+      Container<T> values(std::begin(input), std::end(input));
+      stopwatch sw;
+      algo.sort(std::begin(values), std::end(values));
+      elapsed += sw.elapsed();
+      if (!std::is_sorted(std::begin(values), std::end(values)))
+        std::cerr << "error: " << name << " output not sorted" << std::endl;
+    }
+
+    std::cout << algo.name << ',' << container << ',' << type_name<T>() << ',' << dist.name << ',' << size << ','
+              << opts.runs << ',' << elapsed.count() / static_cast<long long>(opts.runs) << ',';
+
+    if (algo.counted) {
+      Container<counter> values(std::begin(input), std::end(input));
+      counter::reset();
+      algo.sort(std::begin(values), std::end(values));
+      std::cout << counter::less_comparisons() + counter::great_comparisons() + counter::less_eq_comparisons()
+                   + counter::great_eq_comparisons() + counter::equal_comparisons() << ','
+                << counter::swaps() << ',' << counter::moves() << std::endl;
+    }
+    else {
+      std::cout << ",," << std::endl;
+    }
+  }
+}
+
+template <template <typename...> class Container, typename T, typename URBG>
+void run_type (options const& opts, URBG& gen)
+{
+  for (auto const& dist : distributions) {
+    for (auto size : opts.sizes) {
+      auto input = make_input<T>(dist, size, gen);
+      std::apply([&] (auto const& ... algo) { (run<Container>(algo, dist, input, opts), ...); }, algorithms);
+    }
+  }
+}
+
+template <template <typename...> class Container, typename URBG>
+void run_container (options const& opts, URBG& gen)
+{
+  run_type<Container, int>(opts, gen);
+  run_type<Container, double>(opts, gen);
+  run_type<Container, std::string>(opts, gen);
+  run_type<Container, small_struct>(opts, gen);
+  run_type<Container, large_struct>(opts, gen);
+}
+
+// an empty range has nothing to measure and no values to draw, the size 0 is skipped
+std::vector<std::size_t> parse_sizes (std::string const& arg)
+{
+  std::vector<std::size_t> sizes;
+  std::size_t first = 0;
+  while (first < arg.size()) {
+    auto last = arg.find(',', first);
+    if (last == std::string::npos)
+      last = arg.size();
+    auto size = std::stoul(arg.substr(first, last - first));
+    if (size > 0)
+      sizes.push_back(size);
+    first = last + 1;
+  }
+  return sizes;
+}
+
+int main (int argc, char* argv[])
+{
+  options opts;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string arg = argv[i];
+    if (arg == "--filter")
+      opts.filter = std::regex(argv[i + 1]);
+    else if (arg == "--sizes")
+      opts.sizes = parse_sizes(argv[i + 1]);
+    else if (arg == "--runs")
+      opts.runs = std::max<std::size_t>(1, std::stoul(argv[i + 1]));
+    else if (arg == "--max-quadratic")
+      opts.max_quadratic = std::stoul(argv[i + 1]);
+    else {
+      std::cerr << "usage: " << argv[0] << " [--filter REGEX] [--sizes N,N,...] [--runs N] [--max-quadratic N]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  pcg_extras::seed_seq_from<std::random_device> seed_source;
+  pcg32 rng(seed_source);
+
+  std::cout << "algorithm,container,type,distribution,size,runs,time_ns,comparisons,swaps,moves" << std::endl;
+  run_container<std::vector>(opts, rng);
+  run_container<std::deque>(opts, rng);
+  run_container<std::list>(opts, rng);
+  run_container<std::forward_list>(opts, rng);
+
+  return 0;
+}
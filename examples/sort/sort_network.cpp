@@ -0,0 +1,77 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <random>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "pcg_random.hpp"
+#include "algol/perf/benchmark.hpp"
+#include "algol/algorithms/sort/insertion_sort.hpp"
+#include "algol/algorithms/sort/sort_network.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::microseconds>;
+
+using namespace algol::algorithms::sort;
+
+const std::size_t BENCHMARK_ARRAYS = 100000;
+
+// sorted at compile time
+constexpr auto constexpr_sorted = [] {
+  std::array<int, 8> values {42, -7, 19, 0, 3, 3, -100, 8};
+  sort_network<8>{}(values);
+  return values;
+}();
+
+static_assert(constexpr_sorted[0] == -100 && constexpr_sorted[7] == 42);
+
+template <std::size_t N, typename URBG>
+void run (URBG&& gen)
+{
+  std::uniform_int_distribution<int> distribution;
+  std::vector<std::array<int, N>> input(BENCHMARK_ARRAYS);
+  for (auto& values : input)
+    for (auto& v : values)
+      v = distribution(gen);
+
+  auto network_input = input;
+  auto network = benchmark::run([&network_input] () {
+    for (auto& values : network_input)
+      sort_network<N>{}(values);
+  });
+
+  auto insertion_input = input;
+  auto insertion = benchmark::run([&insertion_input] () {
+    for (auto& values : insertion_input)
+      insertion_sort(std::begin(values), std::end(values));
+  });
+
+  assert(network_input == insertion_input);
+  std::cout << N << ';' << sort_network<N>::comparators.size() << ';' << network.duration.count() << ';'
+            << insertion.duration.count() << ';'
+            << static_cast<double>(insertion.duration.count()) / std::max<long long>(network.duration.count(), 1)
+            << ';' << std::endl;
+}
+
+template <typename URBG, std::size_t ...N>
+void run (URBG&& gen, std::index_sequence<N...>)
+{
+  (run<N + 3>(gen), ...);
+}
+
+int main ()
+{
+  pcg_extras::seed_seq_from<std::random_device> seed_source;
+  pcg32 rng(seed_source);
+
+  std::cout << "sorted at compile time: ";
+  for (auto v : constexpr_sorted)
+    std::cout << v << ' ';
+  std::cout << std::endl;
+
+  std::cout << BENCHMARK_ARRAYS << " arrays" << std::endl;
+  std::cout << "N;comparators;sort_network (us);insertion_sort (us);speedup;" << std::endl;
+  run(rng, std::make_index_sequence<30>{});
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cstdint>
+#include <vector>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "algol/ds/stack/intrusive_stack.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+#include "algol/ds/queue/intrusive_queue.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 5;
+const std::size_t BENCHMARK_ITEMS = 1 << 16;
+const std::size_t BENCHMARK_ROUNDS = 16;
+
+// an object that lives elsewhere, the linked containers store pointers to it
+struct job : algol::ds::intrusive_hook<> {
+  std::int64_t payload[4] {};
+};
+
+std::vector<job> jobs(BENCHMARK_ITEMS);
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / (BENCHMARK_ITEMS * BENCHMARK_ROUNDS);
+}
+
+std::int64_t sink = 0;
+
+int main ()
+{
+  std::cout << "container;items;ns per push/pop;" << std::endl;
+
+  std::cout << "linked_stack<job*>;" << BENCHMARK_ITEMS << ';' << average_ns([] {
+    algol::ds::linked_stack<job*> stack;
+    for (std::size_t r = 0; r < BENCHMARK_ROUNDS; ++r) {
+      for (auto& j : jobs)
+        stack.push(&j);
+      while (!stack.empty()) {
+        sink += stack.top()->payload[0];
+        stack.pop();
+      }
+    }
+  }) << ';' << std::endl;
+
+  std::cout << "intrusive_stack<job>;" << BENCHMARK_ITEMS << ';' << average_ns([] {
+    algol::ds::intrusive_stack<job> stack;
+    for (std::size_t r = 0; r < BENCHMARK_ROUNDS; ++r) {
+      for (auto& j : jobs)
+        stack.push(j);
+      while (auto j = stack.try_pop())
+        sink += j->payload[0];
+    }
+  }) << ';' << std::endl;
+
+  std::cout << "linked_queue<job*>;" << BENCHMARK_ITEMS << ';' << average_ns([] {
+    algol::ds::linked_queue<job*> queue;
+    for (std::size_t r = 0; r < BENCHMARK_ROUNDS; ++r) {
+      for (auto& j : jobs)
+        queue.enqueue(&j);
+      while (!queue.empty()) {
+        sink += queue.front()->payload[0];
+        queue.dequeue();
+      }
+    }
+  }) << ';' << std::endl;
+
+  std::cout << "intrusive_queue<job>;" << BENCHMARK_ITEMS << ';' << average_ns([] {
+    algol::ds::intrusive_queue<job> queue;
+    for (std::size_t r = 0; r < BENCHMARK_ROUNDS; ++r) {
+      for (auto& j : jobs)
+        queue.enqueue(j);
+      while (auto j = queue.try_dequeue())
+        sink += j->payload[0];
+    }
+  }) << ';' << std::endl;
+
+  return static_cast<int>(sink);
+}
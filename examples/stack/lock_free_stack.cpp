@@ -0,0 +1,86 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "algol/ds/stack/lock_free_stack.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 3;
+const std::size_t BENCHMARK_OPERATIONS = 1 << 20;
+
+// linked_stack is not thread safe, every operation takes the lock
+template <typename T>
+class locked_linked_stack {
+public:
+  void push (T const& value)
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    stack_.push(value);
+  }
+
+  std::optional<T> try_pop ()
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    if (stack_.empty())
+      return std::nullopt;
+    std::optional<T> value {stack_.top()};
+    stack_.pop();
+    return value;
+  }
+
+private:
+  std::mutex mutex_;
+  algol::ds::linked_stack<T> stack_;
+};
+
+// every thread pushes and pops BENCHMARK_OPERATIONS / threads items, the stack is never deep
+template <typename Stack>
+void push_pop (std::size_t threads)
+{
+  Stack stack;
+  auto operations = BENCHMARK_OPERATIONS / threads;
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t)
+    workers.emplace_back([&stack, operations] {
+      for (std::size_t i = 0; i < operations; ++i) {
+        stack.push(static_cast<std::int64_t>(i));
+        while (!stack.try_pop())
+          std::this_thread::yield();
+      }
+    });
+  for (auto& worker : workers)
+    worker.join();
+}
+
+template <typename F>
+double average_ns (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / BENCHMARK_OPERATIONS;
+}
+
+int main ()
+{
+  using locked_stack = locked_linked_stack<std::int64_t>;
+  using treiber_stack = algol::ds::lock_free_stack<std::int64_t, 0>;
+  using elimination_stack = algol::ds::lock_free_stack<std::int64_t>;
+
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "stack;threads;push/pop pairs;ns per pair;" << std::endl;
+
+  for (std::size_t threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    std::cout << "mutex linked_stack;" << threads << ';' << BENCHMARK_OPERATIONS << ';'
+              << average_ns([threads] { push_pop<locked_stack>(threads); }) << ';' << std::endl;
+    std::cout << "lock_free_stack;" << threads << ';' << BENCHMARK_OPERATIONS << ';'
+              << average_ns([threads] { push_pop<treiber_stack>(threads); }) << ';' << std::endl;
+    std::cout << "lock_free_stack elimination;" << threads << ';' << BENCHMARK_OPERATIONS << ';'
+              << average_ns([threads] { push_pop<elimination_stack>(threads); }) << ';' << std::endl;
+  }
+
+  return 0;
+}
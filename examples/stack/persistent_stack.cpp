@@ -0,0 +1,103 @@
+#include <iostream>
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+#include "algol/perf/benchmark.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "algol/ds/stack/persistent_stack.hpp"
+
+using benchmark = algol::perf::benchmark<std::chrono::nanoseconds>;
+
+const std::size_t BENCHMARK_RUNS = 3;
+
+// a search state: the columns of the queens placed so far and the attacked columns and diagonals
+template <typename Stack>
+struct state {
+  Stack placed;
+  std::uint32_t columns;
+  std::uint32_t left;
+  std::uint32_t right;
+};
+
+// the n queens solutions found by a depth first search with an explicit frontier, every state keeps its own
+// stack of placed queens, a snapshot of the path from the root
+template <typename Stack, typename Branch>
+std::int64_t queens (int n, Stack empty, Branch branch)
+{
+  std::int64_t solutions = 0;
+  auto all = (std::uint32_t{1} << n) - 1;
+  std::vector<state<Stack>> frontier;
+  frontier.push_back({empty, 0, 0, 0});
+  // loop invariant: the states removed from the frontier have been expanded
+  while (!frontier.empty()) {
+    auto s = std::move(frontier.back());
+    frontier.pop_back();
+    if (s.columns == all) {
+      solutions += s.placed.top() + 1;
+      continue;
+    }
+    auto free = all & ~(s.columns | s.left | s.right);
+    while (free != 0) {
+      auto bit = free & (~free + 1);
+      free ^= bit;
+      auto column = __builtin_ctz(bit);
+      frontier.push_back({branch(s.placed, column), s.columns | bit, ((s.left | bit) << 1) & all,
+                          (s.right | bit) >> 1});
+    }
+  }
+  return solutions;
+}
+
+template <typename F>
+double average_ms (F f)
+{
+  auto result = benchmark::run_n(BENCHMARK_RUNS, f);
+  return static_cast<double>(benchmark::run_average(result).duration.count()) / 1e6;
+}
+
+std::int64_t sink = 0;
+
+int main ()
+{
+  using linked = algol::ds::linked_stack<int>;
+  using persistent = algol::ds::persistent_stack<int>;
+  using single_thread = algol::ds::persistent_stack<int, std::allocator<int>, false>;
+  using arena = algol::ds::pmr::persistent_stack<int, false>;
+
+  std::cout << "stack;queens;ms;" << std::endl;
+
+  for (auto n : {8, 10, 12}) {
+    // the copy of the stack of the parent takes O(depth)
+    std::cout << "linked_stack copy;" << n << ';' << average_ms([n] {
+      sink += queens(n, linked{}, [] (linked const& parent, int column) {
+        linked child {parent};
+        child.push(column);
+        return child;
+      });
+    }) << ';' << std::endl;
+
+    // the child shares the nodes of the parent
+    std::cout << "persistent_stack;" << n << ';' << average_ms([n] {
+      sink += queens(n, persistent{}, [] (persistent const& parent, int column) {
+        return parent.push(column);
+      });
+    }) << ';' << std::endl;
+
+    // plain reference counts
+    std::cout << "persistent_stack single thread;" << n << ';' << average_ms([n] {
+      sink += queens(n, single_thread{}, [] (single_thread const& parent, int column) {
+        return parent.push(column);
+      });
+    }) << ';' << std::endl;
+
+    // plain reference counts and the nodes carved from an arena released at the end of the search
+    std::cout << "pmr::persistent_stack arena;" << n << ';' << average_ms([n] {
+      std::pmr::monotonic_buffer_resource pool;
+      sink += queens(n, arena{&pool}, [] (arena const& parent, int column) {
+        return parent.push(column);
+      });
+    }) << ';' << std::endl;
+  }
+
+  return sink == 0;
+}
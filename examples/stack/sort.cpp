@@ -9,6 +9,7 @@
 #include "algol/func/function.hpp"
 #include "algol/io/pprint.hpp"
 #include "algol/perf/benchmark.hpp"
+#include "algol/perf/operation_counter.hpp"
 
 const size_t N = 100;
 const size_t M = N * 20;
@@ -130,6 +131,24 @@ void hmr ()
   algol::algorithms::stack::stack_sort(stack);
 }
 
+void inr ()
+{
+  algol::ds::fixed_stack<std::size_t, N> stack;
+  for (const auto& v : rarray_n)
+    stack.push(v);
+
+  algol::algorithms::stack::merge_sort(stack);
+}
+
+void imr ()
+{
+  algol::ds::fixed_stack<std::size_t, M> stack;
+  for (const auto& v : rarray_m)
+    stack.push(v);
+
+  algol::algorithms::stack::merge_sort(stack);
+}
+
 void ins_sort ()
 {
   algol::ds::fixed_stack<std::size_t, N> stack {2, 4, 3, 5, 6, 1};
@@ -284,6 +303,48 @@ void stk_sort_r ()
   std::cout << "Input size ratio: " << M / N << ", average execution ratio: " << ratio << std::endl;
 }
 
+void mrg_sort_r ()
+{
+  using operation_counter = algol::perf::operation_counter<std::size_t, std::uint64_t>;
+
+  algol::ds::fixed_stack<std::size_t, N> stack {};
+  for (const auto& v : rarray_n)
+    stack.push(v);
+
+  auto sort = [&stack] () { algol::algorithms::stack::merge_sort(stack); };
+  auto r1 = benchmark::run(sort);
+  std::cout << "One run: " << r1;
+  assert(std::size(stack) == 100);
+  std::cout << stack.to_vector() << std::endl;
+
+  auto result = benchmark::run_n(100, inr);
+  assert(result.size() == 100);
+  auto average_n = benchmark::run_average(result);
+  std::cout << "Input size: " << N << " " << average_n;
+  result = benchmark::run_n(100, imr);
+  assert(result.size() == 100);
+  auto average_m = benchmark::run_average(result);
+  std::cout << "Input size: " << M << " " << average_m;
+
+  auto ratio = average_m.duration / average_n.duration;
+  std::cout << "Input size ratio: " << M / N << ", average execution ratio: " << ratio << std::endl;
+
+  // the items are moved, the insertion sort copies them
+  algol::ds::fixed_stack<operation_counter, M> op_count_stack {};
+  for (const auto& v : rarray_m)
+    op_count_stack.push(v);
+  operation_counter::reset();
+  algol::algorithms::stack::merge_sort(op_count_stack);
+  std::cout << "Merge sort, input size: " << M << std::endl << operation_counter::report;
+
+  op_count_stack.clear();
+  for (const auto& v : rarray_m)
+    op_count_stack.push(v);
+  operation_counter::reset();
+  algol::algorithms::stack::insertion_sort(op_count_stack);
+  std::cout << "Insertion sort, input size: " << M << std::endl << operation_counter::report;
+}
+
 int main ()
 {
   fill_rarray();
@@ -301,6 +362,9 @@ int main ()
   std::cout << std::endl;
   std::cout << "Stack sort random values" << std::endl;
   stk_sort_r();
+  std::cout << std::endl;
+  std::cout << "Merge sort random values" << std::endl;
+  mrg_sort_r();
 
   return 0;
 }
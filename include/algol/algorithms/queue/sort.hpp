@@ -0,0 +1,161 @@
+#ifndef ALGOL_ALGORITHMS_QUEUE_SORT_HPP
+#define ALGOL_ALGORITHMS_QUEUE_SORT_HPP
+
+#include <array>
+#include <climits>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "algol/ds/queue/concepts.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+
+namespace algol::algorithms::queue {
+  namespace detail {
+    // move the front item of from onto the rear of to
+    // the item is moved out of the queue through a const_cast: front() gives a constant reference
+    // to an item that is not constant and that is dequeued right after
+    template <algol::concepts::Queue From, algol::concepts::Queue To>
+    void move_front (From& from, To& to)
+    {
+      to.enqueue(std::move(const_cast<typename From::reference>(from.front())));
+      from.dequeue();
+    }
+
+    // the key as unsigned integer, signed keys are biased so that the negative ones come first
+    template <typename Key>
+    constexpr auto radix_key (Key key)
+    {
+      using unsigned_key = std::make_unsigned_t<Key>;
+      if constexpr (std::is_signed_v<Key>) {
+        constexpr auto sign_bit = static_cast<unsigned_key>(unsigned_key{1} << (sizeof(Key) * CHAR_BIT - 1));
+        return static_cast<unsigned_key>(static_cast<unsigned_key>(key) ^ sign_bit);
+      }
+      else
+        return static_cast<unsigned_key>(key);
+    }
+  }
+
+  /**
+   * \brief Sorts a queue using LSD radix sort algorithm
+   * \details The items are distributed in 2^RadixBits bucket queues by a digit of their key, starting from the
+   * least significant, and the buckets are concatenated back in the input queue. Every pass is stable so after
+   * the pass on the most significant digit the queue is sorted. The items are moved, never copied.
+   * The buckets are linked queues: their nodes hold only the items distributed, a bounded input queue such as
+   * fixed_queue does not make every bucket as large as its capacity.
+   * \tparam RadixBits number of bits of each digit
+   * \tparam Q A container implementing the Queue concept
+   * \tparam Key Key extraction type, it returns an integral key other than bool
+   * \precondition None
+   * \postcondition The input queue becomes sorted by ascending key, the items with equal keys keep their order
+   * \complexity O(N*W/RadixBits) moves, W the number of bits of the key, no comparisons
+   * \param queue The queue to sort
+   * \param key Key extraction invokable
+   * \return None
+   */
+  template <std::size_t RadixBits = 8, algol::concepts::Queue Q, typename Key>
+  void radix_sort (Q& queue, Key key)
+  {
+    using key_type = std::decay_t<std::invoke_result_t<Key&, typename Q::const_reference>>;
+    static_assert(std::is_integral_v<key_type> && !std::is_same_v<key_type, bool>,
+                  "the key must be an integral type other than bool");
+    static_assert(RadixBits > 0 && RadixBits < 16, "RadixBits must be in range [1, 16)");
+
+    constexpr auto key_bits = sizeof(key_type) * CHAR_BIT;
+    constexpr auto radix = std::size_t{1} << RadixBits;
+    constexpr auto mask = radix - 1;
+
+    if (std::size(queue) < 2)
+      return;
+
+    std::array<algol::ds::linked_queue<typename Q::value_type>, radix> buckets {};
+    for (std::size_t shift = 0; shift < key_bits; shift += RadixBits) {
+      // loop invariant (holds also at the end of this loop)
+      // queue is a permutation of the input queue sorted by the lowest shift bits of the key
+      while (!std::empty(queue)) {
+        auto digit = static_cast<std::size_t>((detail::radix_key(std::invoke(key, queue.front())) >> shift) & mask);
+        detail::move_front(queue, buckets[digit]);
+      }
+      for (auto& bucket : buckets)
+        while (!std::empty(bucket))
+          detail::move_front(bucket, queue);
+    }
+  }
+
+  /**
+   * \brief Sorts a queue of integral items using LSD radix sort algorithm
+   * \details see [radix_sort](@ref radix_sort) with key
+   * \tparam RadixBits number of bits of each digit
+   * \tparam Q A container implementing the Queue concept
+   * \precondition None
+   * \postcondition The input queue becomes sorted in ascending order
+   * \complexity O(N*W/RadixBits) moves, W the number of bits of the items, no comparisons
+   * \param queue The queue to sort
+   * \return None
+   */
+  template <std::size_t RadixBits = 8, algol::concepts::Queue Q>
+  void radix_sort (Q& queue)
+  {
+    radix_sort<RadixBits>(queue, [] (typename Q::const_reference value) { return value; });
+  }
+
+  /**
+   * \brief Sorts a queue using bottom-up merge sort algorithm
+   * \details Uses two temporary queues. At each pass the input queue is split in runs of width items
+   * that are enqueued alternately onto the two temporary queues, then the pairs of runs at the fronts
+   * of the temporary queues are merged back onto the input queue, so the runs double at each pass.
+   * Queues keep the order of the items so the merge is stable. The items are moved, never copied.
+   * \tparam Q A container implementing the Queue concept
+   * \precondition The temporary queues of type Q can hold std::size(queue) items
+   * \postcondition The input queue becomes sorted in the order specified by the compare functor passed,
+   * the equal items keep their order
+   * \complexity O(N*LOG2 N) comparisons and moves
+   * \param queue The queue to sort
+   * \return None
+   */
+  template <algol::concepts::Queue Q, typename Compare = std::less<typename Q::value_type>>
+  void merge_sort (Q& queue, Compare comp = Compare{})
+  {
+    auto n = std::size(queue);
+    if (n < 2)
+      return;
+
+    Q left {};
+    Q right {};
+
+    for (typename Q::size_type width = 1; width < n; width *= 2) {
+      // loop invariant (holds also at the end of this loop)
+      // queue is a permutation of the input queue made of sorted runs of width items, the last may be shorter
+
+      // split the runs alternately, only the last run may be shorter than width
+      for (auto to_left = true; !std::empty(queue); to_left = !to_left)
+        for (typename Q::size_type i = 0; i < width && !std::empty(queue); ++i)
+          detail::move_front(queue, to_left ? left : right);
+
+      while (!std::empty(left)) {
+        auto n_left = std::min(width, std::size(left));
+        auto n_right = std::min(width, std::size(right));
+        while (n_left > 0 && n_right > 0) {
+          // loop invariant (holds also at the end of this loop)
+          // the items enqueued onto queue from the current runs are not greater than
+          // the remaining n_left + n_right items of the runs
+          if (comp(right.front(), left.front())) {
+            detail::move_front(right, queue);
+            --n_right;
+          }
+          else {
+            detail::move_front(left, queue);
+            --n_left;
+          }
+        }
+        for (; n_left > 0; --n_left)
+          detail::move_front(left, queue);
+        for (; n_right > 0; --n_right)
+          detail::move_front(right, queue);
+      }
+    }
+    // postcondition
+    // queue is a permutation of the input queue it has the same elements in sorted order
+  }
+}
+#endif //ALGOL_ALGORITHMS_QUEUE_SORT_HPP
@@ -0,0 +1,124 @@
+/**
+ * \brief Floyd-Rivest selection implementation
+ * \details From Wikipedia
+ * The Floyd-Rivest algorithm is a selection algorithm, it uses sampling to pick two elements that,
+ * with high probability, bracket the k-th smallest element: the sample is selected recursively
+ * and the range is partitioned around it, so the element searched ends up in a small subrange.
+ * The expected number of comparisons is N + min(k, N - k) + O(sqrt(N log N)),
+ * it is faster than quickselect, that needs about 2N-3.4N comparisons, on large ranges.
+ * It is in-place and not stable
+ * \note see Floyd, Rivest "Algorithm 489: the algorithm SELECT" Communications of the ACM 18(3) 1975
+ */
+#ifndef ALGOL_ALGORITHMS_SELECTION_FLOYD_RIVEST_HPP
+#define ALGOL_ALGORITHMS_SELECTION_FLOYD_RIVEST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include "stl2/concepts.hpp"
+
+namespace algol::algorithms::selection {
+
+  namespace concepts = std::experimental::ranges;
+
+  namespace detail {
+    // ranges longer than this are reduced using a recursive sample selection
+    constexpr std::ptrdiff_t floyd_rivest_sample_threshold = 600;
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    void floyd_rivest_select (RandomIt base, std::ptrdiff_t left, std::ptrdiff_t right, std::ptrdiff_t k,
+                              Compare comp)
+    {
+      while (right > left) {
+        // loop invariant (holds also at the end of this loop)
+        // k in range [left, right]
+        // every element before left is not greater than every element in range [left, right]
+        // every element after right is not less than every element in range [left, right]
+        if (right - left > floyd_rivest_sample_threshold) {
+          // select the k-th element of a sample of size s with a small bias towards the side of k,
+          // so that the selected element brackets the k-th element of the whole range
+          auto n = static_cast<double>(right - left + 1);
+          auto i = static_cast<double>(k - left + 1);
+          auto z = std::log(n);
+          auto s = 0.5 * std::exp(2.0 * z / 3.0);
+          auto sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i - n / 2.0 < 0 ? -1.0 : 1.0);
+          auto new_left = std::max(left, static_cast<std::ptrdiff_t>(k - i * s / n + sd));
+          auto new_right = std::min(right, static_cast<std::ptrdiff_t>(k + (n - i) * s / n + sd));
+          floyd_rivest_select(base, new_left, new_right, k, comp);
+        }
+
+        // partition [left, right] around the element in k-th position
+        // the pivot is moved on one of the two ends, the other end holds an element that stops the scans
+        std::iter_swap(base + left, base + k);
+        auto pivot = base + left;
+        if (!comp(*(base + left), *(base + right))) {
+          std::iter_swap(base + left, base + right);
+          pivot = base + right;
+        }
+
+        auto i = left + 1;
+        auto j = right - 1;
+        while (comp(*(base + i), *pivot))
+          ++i;
+        while (comp(*pivot, *(base + j)))
+          --j;
+        while (i < j) {
+          // loop invariant (holds also at the end of this loop)
+          // every element in range (left, i) is not greater than the pivot
+          // every element in range (j, right) is not less than the pivot
+          std::iter_swap(base + i, base + j);
+          ++i;
+          --j;
+          while (comp(*(base + i), *pivot))
+            ++i;
+          while (comp(*pivot, *(base + j)))
+            --j;
+        }
+
+        if (pivot == base + left) {
+          std::iter_swap(base + left, base + j);
+        }
+        else {
+          ++j;
+          std::iter_swap(base + j, base + right);
+        }
+
+        // j is the final position of the pivot
+        if (j <= k)
+          left = j + 1;
+        if (k <= j)
+          right = j - 1;
+      }
+    }
+  }
+
+  /**
+   * \brief Floyd-Rivest selection
+   * \details see file description
+   * \complexity O(N) average, N + min(k, N - k) + O(sqrt(N log N)) expected comparisons
+   * \precondition last should be reachable from first and nth in range [first, last]
+   * otherwise undefined behavior
+   * \postcondition the element pointed by nth is the element that would be in that position if [first, last)
+   * were sorted according to comp, every element in [first, nth) is not greater than *nth and every element
+   * in (nth, last) is not less than *nth
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param nth iterator to the element to select
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void floyd_rivest_select (RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare{})
+  {
+    if (nth == last || last - first < 2)
+      return;
+
+    detail::floyd_rivest_select(first, std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(last - first - 1),
+                                static_cast<std::ptrdiff_t>(nth - first), comp);
+  }
+}
+
+#endif //ALGOL_ALGORITHMS_SELECTION_FLOYD_RIVEST_HPP
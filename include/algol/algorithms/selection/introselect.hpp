@@ -0,0 +1,246 @@
+/**
+ * \brief introselect implementation
+ * \details selection algorithms find the k-th smallest element of a range (the element that would be in k-th
+ * position if the range were sorted) without sorting the whole range.
+ * From Wikipedia
+ * Quickselect uses the same overall approach as quicksort, choosing one element as a pivot and partitioning
+ * the data in two based on the pivot, accordingly as less than or greater than the pivot.
+ * However, instead of recursing into both sides, as in quicksort, quickselect only recurses into one side
+ * the side with the element it is searching for. This reduces the average complexity from O(n log n) to O(n),
+ * with a worst case of O(n^2).
+ * Introselect is a hybrid: it starts with quickselect and switches to the median of medians pivot rule,
+ * that guarantees a linear worst case, when the recursion depth exceeds a budget proportional to log n.
+ * It is in-place and not stable
+ */
+#ifndef ALGOL_ALGORITHMS_SELECTION_INTROSELECT_HPP
+#define ALGOL_ALGORITHMS_SELECTION_INTROSELECT_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include "stl2/concepts.hpp"
+
+namespace algol::algorithms::selection {
+
+  namespace concepts = std::experimental::ranges;
+
+  namespace detail {
+    // ranges shorter than this are sorted with insertion sort instead of being partitioned
+    constexpr std::ptrdiff_t small_select_threshold = 16;
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    void small_sort (RandomIt first, RandomIt last, Compare comp)
+    {
+      if (last - first < 2)
+        return;
+
+      for (auto next = first + 1; next != last; ++next) {
+        for (auto it = next; it != first && comp(*it, *(it - 1)); --it)
+          std::iter_swap(it, it - 1);
+      }
+    }
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    RandomIt median_of_three (RandomIt a, RandomIt b, RandomIt c, Compare comp)
+    {
+      if (comp(*a, *b)) {
+        if (comp(*b, *c))
+          return b;
+        return comp(*a, *c) ? c : a;
+      }
+      if (comp(*a, *c))
+        return a;
+      return comp(*b, *c) ? c : b;
+    }
+
+    /**
+     * \brief partitions [first, last) around the element pointed by pivot
+     * \details Sedgewick partition, the scans stop on elements equivalent to the pivot
+     * so that ranges with many duplicates are split in halves
+     * \return iterator to the final position of the pivot, every element before it is not greater
+     * and every element after it is not less than the pivot
+     */
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    RandomIt partition (RandomIt first, RandomIt last, RandomIt pivot, Compare comp)
+    {
+      std::iter_swap(first, pivot);
+      auto i = first;
+      auto j = last;
+      for (;;) {
+        // loop invariant (holds also at the end of this loop)
+        // every element in range (first, i] is not greater than *first
+        // every element in range [j, last) is not less than *first
+        while (++i != last && comp(*i, *first)) {}
+        while (comp(*first, *--j)) {}
+        if (i >= j)
+          break;
+        std::iter_swap(i, j);
+      }
+      std::iter_swap(first, j);
+      return j;
+    }
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    void select (RandomIt first, RandomIt last, RandomIt nth, Compare comp, int depth_limit);
+
+    /**
+     * \brief median of medians pivot rule
+     * \details the median of each group of 5 elements is moved at the beginning of the range
+     * and the median of these medians is selected recursively
+     * \return iterator to an element that is greater than at least 3/10 and less than at least 3/10 of the range
+     */
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    RandomIt median_of_medians (RandomIt first, RandomIt last, Compare comp)
+    {
+      auto n = last - first;
+      if (n <= 5) {
+        small_sort(first, last, comp);
+        return first + n / 2;
+      }
+
+      auto medians = first;
+      for (auto group = first; group < last; group += std::min<decltype(n)>(5, last - group)) {
+        // loop invariant (holds also at the end of this loop)
+        // range [first, medians) contains the medians of the groups in range [first, group)
+        auto group_last = group + std::min<decltype(n)>(5, last - group);
+        small_sort(group, group_last, comp);
+        std::iter_swap(medians++, group + (group_last - group) / 2);
+      }
+
+      auto mid = first + (medians - first) / 2;
+      // a depth limit of 0 keeps using the median of medians rule: linear worst case
+      select(first, medians, mid, comp, 0);
+      return mid;
+    }
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    void select (RandomIt first, RandomIt last, RandomIt nth, Compare comp, int depth_limit)
+    {
+      while (last - first > small_select_threshold) {
+        // loop invariant (holds also at the end of this loop)
+        // nth in range [first, last)
+        // every element before first is not greater than every element in range [first, last)
+        // every element from last is not less than every element in range [first, last)
+        RandomIt pivot;
+        if (depth_limit > 0) {
+          --depth_limit;
+          pivot = median_of_three(first, first + (last - first) / 2, last - 1, comp);
+        }
+        else {
+          pivot = median_of_medians(first, last, comp);
+        }
+
+        auto cut = partition(first, last, pivot, comp);
+        if (cut == nth)
+          return;
+        if (nth < cut)
+          last = cut;
+        else
+          first = cut + 1;
+      }
+      small_sort(first, last, comp);
+    }
+
+    template <typename Size>
+    int log2 (Size n)
+    {
+      auto log = 0;
+      while (n > 1) {
+        n >>= 1;
+        ++log;
+      }
+      return log;
+    }
+  }
+
+  /**
+   * \brief introselect
+   * \details quickselect with median of three pivot, it falls back on median of medians pivot
+   * when the number of partition steps exceeds 2 * log2(N)
+   * \complexity O(N) average and worst case
+   * \precondition last should be reachable from first and nth in range [first, last]
+   * otherwise undefined behavior
+   * \postcondition the element pointed by nth is the element that would be in that position if [first, last)
+   * were sorted according to comp, every element in [first, nth) is not greater than *nth and every element
+   * in (nth, last) is not less than *nth
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param nth iterator to the element to select
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void introselect (RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare{})
+  {
+    if (nth == last || last - first < 2)
+      return;
+
+    detail::select(first, last, nth, comp, 2 * detail::log2(last - first));
+  }
+
+  /**
+   * \brief quickselect
+   * \details selection with median of three pivot and no worst case guarantee
+   * \complexity O(N) average O(N^2) worst case
+   * \precondition last should be reachable from first and nth in range [first, last]
+   * otherwise undefined behavior
+   * \postcondition the element pointed by nth is the element that would be in that position if [first, last)
+   * were sorted according to comp, every element in [first, nth) is not greater than *nth and every element
+   * in (nth, last) is not less than *nth
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param nth iterator to the element to select
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void quickselect (RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare{})
+  {
+    if (nth == last || last - first < 2)
+      return;
+
+    while (last - first > detail::small_select_threshold) {
+      auto pivot = detail::median_of_three(first, first + (last - first) / 2, last - 1, comp);
+      auto cut = detail::partition(first, last, pivot, comp);
+      if (cut == nth)
+        return;
+      if (nth < cut)
+        last = cut;
+      else
+        first = cut + 1;
+    }
+    detail::small_sort(first, last, comp);
+  }
+
+  /**
+   * \brief median of medians selection
+   * \details every partition step uses the median of medians pivot rule
+   * \complexity O(N) worst case, with a greater constant factor than introselect
+   * \precondition last should be reachable from first and nth in range [first, last]
+   * otherwise undefined behavior
+   * \postcondition the element pointed by nth is the element that would be in that position if [first, last)
+   * were sorted according to comp, every element in [first, nth) is not greater than *nth and every element
+   * in (nth, last) is not less than *nth
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param nth iterator to the element to select
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void median_of_medians_select (RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare{})
+  {
+    if (nth == last || last - first < 2)
+      return;
+
+    detail::select(first, last, nth, comp, 0);
+  }
+}
+
+#endif //ALGOL_ALGORITHMS_SELECTION_INTROSELECT_HPP
@@ -0,0 +1,144 @@
+/**
+ * \brief partial sort implementations
+ * \details a partial sort rearranges a range so that the first k positions hold, in sorted order,
+ * the k elements that would be there if the whole range were sorted.
+ * The order of the remaining elements is unspecified.
+ * It is in-place and not stable
+ */
+#ifndef ALGOL_ALGORITHMS_SELECTION_PARTIAL_SORT_HPP
+#define ALGOL_ALGORITHMS_SELECTION_PARTIAL_SORT_HPP
+
+#include <functional>
+#include <iterator>
+#include "stl2/concepts.hpp"
+#include "algol/algorithms/selection/introselect.hpp"
+
+namespace algol::algorithms::selection {
+
+  namespace concepts = std::experimental::ranges;
+
+  namespace detail {
+    // binary heap helpers, the element on top is the greatest according to comp
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    void sift_down (RandomIt first, std::ptrdiff_t size, std::ptrdiff_t hole, Compare comp)
+    {
+      for (auto child = 2 * hole + 1; child < size; child = 2 * hole + 1) {
+        // loop invariant (holds also at the end of this loop)
+        // the subtrees rooted at the children of hole are heaps
+        if (child + 1 < size && comp(*(first + child), *(first + child + 1)))
+          ++child;
+        if (!comp(*(first + hole), *(first + child)))
+          return;
+        std::iter_swap(first + hole, first + child);
+        hole = child;
+      }
+    }
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    void make_heap (RandomIt first, RandomIt last, Compare comp)
+    {
+      auto size = static_cast<std::ptrdiff_t>(last - first);
+      for (auto hole = size / 2; hole-- > 0;)
+        sift_down(first, size, hole, comp);
+    }
+
+    template <concepts::RandomAccessIterator RandomIt, typename Compare>
+    void sort_heap (RandomIt first, RandomIt last, Compare comp)
+    {
+      for (auto size = static_cast<std::ptrdiff_t>(last - first); size > 1; --size) {
+        // loop invariant (holds also at the end of this loop)
+        // range [first, first + size) is a heap
+        // range [first + size, last) is sorted and not less than every element of the heap
+        std::iter_swap(first, first + size - 1);
+        sift_down(first, size - 1, 0, comp);
+      }
+    }
+  }
+
+  /**
+   * \brief heap sort
+   * \complexity O(N*LOG2 N) worst, average and best case
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void heap_sort (RandomIt first, RandomIt last, Compare comp = Compare{})
+  {
+    if (last - first < 2)
+      return;
+
+    detail::make_heap(first, last, comp);
+    detail::sort_heap(first, last, comp);
+  }
+
+  /**
+   * \brief partial sort using selection
+   * \details introselect moves the k smallest elements in [first, middle) that are then heap sorted
+   * \complexity O(N + K*LOG2 K) worst case, K = middle - first
+   * \precondition last should be reachable from first and middle in range [first, last]
+   * otherwise undefined behavior
+   * \postcondition range [first, middle) contains the smallest middle - first elements of [first, last)
+   * sorted according to comp, the order of elements in [middle, last) is unspecified
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param middle iterator to the one past last element to be sorted
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void partial_sort (RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare{})
+  {
+    if (first == middle)
+      return;
+
+    introselect(first, middle - 1, last, comp);
+    heap_sort(first, middle - 1, comp);
+  }
+
+  /**
+   * \brief partial sort using a bounded heap
+   * \details the k smallest elements seen so far are kept in a heap in [first, middle),
+   * every element in [middle, last) that is less than the heap top replaces it
+   * \complexity O(N*LOG2 K) worst case, K = middle - first
+   * \precondition last should be reachable from first and middle in range [first, last]
+   * otherwise undefined behavior
+   * \postcondition range [first, middle) contains the smallest middle - first elements of [first, last)
+   * sorted according to comp, the order of elements in [middle, last) is unspecified
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param middle iterator to the one past last element to be sorted
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void heap_partial_sort (RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare{})
+  {
+    if (first == middle)
+      return;
+
+    auto size = static_cast<std::ptrdiff_t>(middle - first);
+    detail::make_heap(first, middle, comp);
+    for (auto it = middle; it != last; ++it) {
+      // loop invariant (holds also at the end of this loop)
+      // range [first, middle) is a heap with the smallest elements of range [first, it)
+      if (comp(*it, *first)) {
+        std::iter_swap(it, first);
+        detail::sift_down(first, size, 0, comp);
+      }
+    }
+    detail::sort_heap(first, middle, comp);
+  }
+}
+
+#endif //ALGOL_ALGORITHMS_SELECTION_PARTIAL_SORT_HPP
@@ -0,0 +1,240 @@
+/**
+ * \brief streaming top-k selection
+ * \details keeps the first k elements, in the order induced by a comparison, of a sequence of unknown length
+ * The elements are stored in a bounded binary heap whose top is the greatest of the kept elements,
+ * so every new element is compared with it and, if less, it replaces it.
+ * Only k elements are stored and the input is read only once, so it works with input iterators
+ * Using std::greater as comparison it keeps the k largest elements
+ */
+#ifndef ALGOL_ALGORITHMS_SELECTION_TOP_K_HPP
+#define ALGOL_ALGORITHMS_SELECTION_TOP_K_HPP
+
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "stl2/concepts.hpp"
+#include "algol/algorithms/selection/partial_sort.hpp"
+
+namespace algol::algorithms::selection {
+
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief bounded heap accumulating the first k elements pushed according to Compare
+   * \tparam T type of the elements
+   * \tparam Compare comparison type
+   * \invariant size() <= capacity() and the element on top is not less than every other element kept
+   */
+  template <concepts::CopyConstructible T, typename Compare = std::less<T>>
+  class top_k_accumulator {
+  public:
+    using value_type = T;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+
+    /**
+     * \brief Construct an empty accumulator
+     * \precondition None
+     * \postcondition The accumulator is empty and keeps at most k elements
+     * \complexity O(1) plus the allocation of k elements
+     * \param k The number of elements to keep
+     * \param comp comparison invokable
+     */
+    explicit top_k_accumulator (size_type k, Compare comp = Compare{}) : k_ {k}, comp_ {comp}
+    {
+      heap_.reserve(k_);
+    }
+
+    /**
+     * \brief Offer an element to the accumulator
+     * \details The element is kept if less than the greatest element kept or if less than k elements are kept
+     * \precondition None
+     * \postcondition The accumulator keeps the first k elements of the elements pushed so far
+     * \complexity O(LOG2 K)
+     * \param value The element offered
+     * \return True if the element is kept, false otherwise
+     */
+    bool push (value_type const& value)
+    {
+      return push_(value);
+    }
+
+    /**
+     * \brief Offer an element to the accumulator with move operation
+     * \details The element is kept if less than the greatest element kept or if less than k elements are kept
+     * \precondition None
+     * \postcondition The accumulator keeps the first k elements of the elements pushed so far
+     * \complexity O(LOG2 K)
+     * \param value The element offered
+     * \return True if the element is kept, false otherwise
+     */
+    bool push (value_type&& value)
+    {
+      return push_(std::move(value));
+    }
+
+    /**
+     * \brief The greatest element kept, the k-th element once k elements are pushed
+     * \precondition The accumulator is not empty, otherwise undefined behavior
+     * \postcondition The accumulator is unchanged
+     * \complexity O(1)
+     * \return The greatest element kept
+     */
+    const_reference top () const
+    {
+      return heap_.front();
+    }
+
+    /**
+     * \brief The accumulator is empty?
+     * \precondition None
+     * \postcondition The accumulator is unchanged
+     * \complexity O(1)
+     * \return True if no element is kept, false otherwise
+     */
+    bool empty () const
+    {
+      return heap_.empty();
+    }
+
+    /**
+     * \brief The accumulator is full?
+     * \details A full accumulator keeps a pushed element only if it is less than top()
+     * \precondition None
+     * \postcondition The accumulator is unchanged
+     * \complexity O(1)
+     * \return True if k elements are kept, false otherwise
+     */
+    bool full () const
+    {
+      return heap_.size() == k_;
+    }
+
+    /**
+     * \brief The number of elements kept
+     * \precondition None
+     * \postcondition The accumulator is unchanged
+     * \complexity O(1)
+     * \return The number of elements kept, at most k
+     */
+    size_type size () const
+    {
+      return heap_.size();
+    }
+
+    /**
+     * \brief The maximum number of elements kept
+     * \precondition None
+     * \postcondition The accumulator is unchanged
+     * \complexity O(1)
+     * \return k
+     */
+    size_type capacity () const
+    {
+      return k_;
+    }
+
+    /**
+     * \brief The elements kept in sorted order
+     * \precondition None
+     * \postcondition The accumulator is unchanged
+     * \complexity O(K*LOG2 K)
+     * \return A vector with the elements kept sorted according to comp
+     */
+    std::vector<value_type> sorted () const&
+    {
+      auto values = heap_;
+      detail::sort_heap(std::begin(values), std::end(values), comp_);
+      return values;
+    }
+
+    /**
+     * \brief The elements kept in sorted order, they are moved out of the accumulator
+     * \precondition None
+     * \postcondition The accumulator is empty
+     * \complexity O(K*LOG2 K)
+     * \return A vector with the elements kept sorted according to comp
+     */
+    std::vector<value_type> sorted ()&&
+    {
+      auto values = std::move(heap_);
+      heap_.clear();
+      detail::sort_heap(std::begin(values), std::end(values), comp_);
+      return values;
+    }
+
+    /**
+     * \brief Remove all the elements kept
+     * \precondition None
+     * \postcondition The accumulator is empty, the capacity is unchanged
+     * \complexity O(K)
+     */
+    void clear ()
+    {
+      heap_.clear();
+    }
+
+  private:
+    template <typename U>
+    bool push_ (U&& value)
+    {
+      if (k_ == size_type{0})
+        return false;
+
+      if (heap_.size() < k_) {
+        heap_.push_back(std::forward<U>(value));
+        sift_up_(static_cast<std::ptrdiff_t>(heap_.size()) - 1);
+        return true;
+      }
+
+      if (!comp_(value, heap_.front()))
+        return false;
+
+      heap_.front() = std::forward<U>(value);
+      detail::sift_down(std::begin(heap_), static_cast<std::ptrdiff_t>(heap_.size()), 0, comp_);
+      return true;
+    }
+
+    void sift_up_ (std::ptrdiff_t hole)
+    {
+      while (hole > 0) {
+        auto parent = (hole - 1) / 2;
+        if (!comp_(heap_[parent], heap_[hole]))
+          return;
+        std::iter_swap(std::begin(heap_) + parent, std::begin(heap_) + hole);
+        hole = parent;
+      }
+    }
+
+    size_type k_;
+    Compare comp_;
+    std::vector<value_type> heap_;
+  };
+
+  /**
+   * \brief top-k selection over an input range
+   * \details the range is read only once, at most k elements are stored
+   * \complexity O(N*LOG2 K) worst case, O(N + K*LOG2 K*LOG2 N) average for random input
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is consumed
+   * \tparam InputIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param k the number of elements to select
+   * \param comp comparison invokable
+   * \return A vector with the first min(k, N) elements of the range sorted according to comp
+   */
+  template <concepts::InputIterator InputIt,
+      typename Compare = std::less<typename std::iterator_traits<InputIt>::value_type>>
+  auto top_k (InputIt first, InputIt last, std::size_t k, Compare comp = Compare{})
+  {
+    top_k_accumulator<typename std::iterator_traits<InputIt>::value_type, Compare> accumulator {k, comp};
+    for (; first != last; ++first)
+      accumulator.push(*first);
+    return std::move(accumulator).sorted();
+  }
+}
+
+#endif //ALGOL_ALGORITHMS_SELECTION_TOP_K_HPP
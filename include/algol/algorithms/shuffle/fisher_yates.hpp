@@ -31,8 +31,7 @@ namespace algol::algorithms::shuffle {
     if (n < 2)
       return;
 
-    auto end = std::prev(last);
-    for (auto it = first; it != end; ++it) {
+    for (auto it = first; std::next(it) != last; ++it) {
       std::uniform_int_distribution<difference_type> distribution(std::distance(first, it), n - 1);
       std::iter_swap(it, std::next(first, distribution(gen)));
     }
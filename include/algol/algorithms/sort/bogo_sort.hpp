@@ -5,6 +5,7 @@
 #include <iterator>
 #include <random>
 #include "stl2/concepts.hpp"
+#include "algol/algorithms/sort/projection.hpp"
 #include "algol/algorithms/shuffle/fisher_yates.hpp"
 #include "algol/algorithms/recursion/permutation.hpp"
 
@@ -67,6 +68,44 @@ namespace algol::algorithms::sort {
       }
     }
   }
+
+  /**
+   * \brief random bogo sort with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void bogo_sort_random (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    bogo_sort_random(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief deterministic bogo sort with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void bogo_sort_deterministic (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    bogo_sort_deterministic(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
 }
 
 #endif //ALGOL_ALGORITHMS_SORT_BOGO_SORT_HPP
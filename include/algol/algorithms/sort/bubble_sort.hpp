@@ -11,6 +11,7 @@
 
 #include <iterator>
 #include "stl2/concepts.hpp"
+#include "algol/algorithms/sort/projection.hpp"
 
 namespace algol::algorithms::sort {
 
@@ -230,6 +231,82 @@ namespace algol::algorithms::sort {
     // loop postcondition
     // the range {first, old last) is a permutation of the input range it has the same elements in sorted order
   }
+
+  /**
+   * \brief standard bubble sort with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void bubble_sort (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    bubble_sort(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief optimized bubble sort with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void bubble_sort_optimized (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    bubble_sort_optimized(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief fast bubble sort with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void bubble_sort_fast (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    bubble_sort_fast(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief comb sort with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void comb_sort (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    comb_sort(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
 }
 
 #endif //ALGOL_ALGORITHMS_SORT_BUBBLE_SORT_HPP
@@ -0,0 +1,111 @@
+/**
+ * \brief cached-key sort implementation (decorate-sort-undecorate)
+ * \details the key of every element is computed once into a side array of (key, index) pairs,
+ * the pairs are sorted and then the elements are permuted in place following the cycles of the permutation.
+ * It is worth when the key is expensive to compute, e.g. a parsed field or a normalized string,
+ * or when the elements are expensive to move: the elements are never compared nor swapped,
+ * each cycle of length L costs L + 1 moves and the elements already in place are not moved at all.
+ * The index is used to break ties between equal keys so the sort is stable.
+ * It needs O(N) extra memory for the keys and the indices
+ */
+#ifndef ALGOL_ALGORITHMS_SORT_CACHED_KEY_SORT_HPP
+#define ALGOL_ALGORITHMS_SORT_CACHED_KEY_SORT_HPP
+
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "stl2/concepts.hpp"
+#include "algol/algorithms/sort/projection.hpp"
+#include "algol/algorithms/selection/partial_sort.hpp"
+
+namespace algol::algorithms::sort {
+
+  namespace concepts = std::experimental::ranges;
+
+  namespace detail {
+    template <typename Key>
+    struct keyed_index {
+      Key key;
+      std::size_t index;
+    };
+
+    /**
+     * \brief rearrange the range so that the element in position i is the one that was in position indices[i]
+     * \postcondition indices[i] == i for each i
+     */
+    template <concepts::RandomAccessIterator RandomIt, typename Indices>
+    void apply_permutation (RandomIt first, Indices& indices)
+    {
+      for (std::size_t i = 0; i < indices.size(); ++i) {
+        // loop invariant (holds also at the end of this loop)
+        // every position in a cycle already followed holds its final element and its index is fixed
+        if (indices[i] == i)
+          continue;
+
+        auto tmp = std::move(*(first + i));
+        auto hole = i;
+        while (indices[hole] != i) {
+          // loop invariant (holds also at the end of this loop)
+          // hole is the only moved-from position of the cycle
+          auto next = indices[hole];
+          *(first + hole) = std::move(*(first + next));
+          indices[hole] = hole;
+          hole = next;
+        }
+        *(first + hole) = std::move(tmp);
+        indices[hole] = hole;
+      }
+    }
+  }
+
+  /**
+   * \brief cached-key sort
+   * \details see file description
+   * \complexity O(N*LOG2 N) comparisons of keys, N key computations, at most 3N/2 element moves
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the keys, equal keys keep
+   * their relative order
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Projection key extraction type
+   * \tparam Compare key comparison type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param key key extraction invokable, called once for each element
+   * \param comp key comparison invokable
+   */
+  template <concepts::RandomAccessIterator RandomIt, typename Projection,
+      typename Compare = std::less<projected_key_t<RandomIt, Projection>>>
+  void cached_key_sort (RandomIt first, RandomIt last, Projection key, Compare comp = Compare{})
+  {
+    using key_type = projected_key_t<RandomIt, Projection>;
+
+    auto size = static_cast<std::size_t>(last - first);
+    if (size < 2)
+      return;
+
+    std::vector<detail::keyed_index<key_type>> keys;
+    keys.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+      keys.push_back({std::invoke(key, *(first + i)), i});
+
+    selection::heap_sort(std::begin(keys), std::end(keys),
+                         [&comp] (auto const& lhs, auto const& rhs) {
+                           if (comp(lhs.key, rhs.key))
+                             return true;
+                           if (comp(rhs.key, lhs.key))
+                             return false;
+                           return lhs.index < rhs.index;
+                         });
+
+    std::vector<std::size_t> indices;
+    indices.reserve(size);
+    for (auto const& k : keys)
+      indices.push_back(k.index);
+    keys.clear();
+
+    detail::apply_permutation(first, indices);
+  }
+}
+
+#endif //ALGOL_ALGORITHMS_SORT_CACHED_KEY_SORT_HPP
@@ -0,0 +1,48 @@
+/**
+ * \brief projection support for sort algorithms
+ * \details a projection is an invokable applied to the elements before they are compared,
+ * e.g. a pointer to data member or a function extracting a field. Every sort algorithm has an overload
+ * taking a comparison and a projection that compares proj(a) with proj(b).
+ * The projection is invoked on every comparison: when computing the key is expensive
+ * see [cached_key_sort](@ref cached_key_sort) that computes every key once.
+ */
+#ifndef ALGOL_ALGORITHMS_SORT_PROJECTION_HPP
+#define ALGOL_ALGORITHMS_SORT_PROJECTION_HPP
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace algol::algorithms::sort {
+  /**
+   * \brief comparison of projected elements
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   */
+  template <typename Compare, typename Projection>
+  class projected_compare {
+  public:
+    projected_compare (Compare comp, Projection proj) : comp_ {std::move(comp)}, proj_ {std::move(proj)}
+    {}
+
+    template <typename T, typename U>
+    bool operator() (T&& lhs, U&& rhs)
+    {
+      return std::invoke(comp_, std::invoke(proj_, std::forward<T>(lhs)), std::invoke(proj_, std::forward<U>(rhs)));
+    }
+
+  private:
+    Compare comp_;
+    Projection proj_;
+  };
+
+  /**
+   * \brief the type of the key obtained projecting the elements pointed by It
+   */
+  template <typename It, typename Projection>
+  using projected_key_t =
+  std::decay_t<std::invoke_result_t<Projection&, typename std::iterator_traits<It>::reference>>;
+}
+
+#endif //ALGOL_ALGORITHMS_SORT_PROJECTION_HPP
@@ -0,0 +1,228 @@
+/**
+ * \brief parallel sample sort implementation
+ * \details From Wikipedia
+ * Samplesort is a sorting algorithm that is a divide and conquer algorithm often used in parallel processing
+ * systems. It generalizes quicksort partitioning using many pivots (splitters) chosen from an oversampled
+ * random sample, so that every bucket receives about N / K elements with high probability.
+ * The implementation has four phases:
+ * - sampling: K * OVERSAMPLING random elements are sorted and every OVERSAMPLING-th is taken as splitter
+ * - classification: every thread classifies a block of the range descending a splitter tree,
+ *   the tree is a complete binary tree stored as an array so the descent does not branch on the comparison
+ *   and takes exactly LOG2 K comparisons, every thread counts the elements of its block for each bucket
+ * - distribution: the counts are prefix summed bucket by bucket so every thread has its own offset inside
+ *   each bucket and the elements are moved in a buffer without synchronization
+ * - bucket sort: the buckets are sorted concurrently with std::sort and moved back in the range
+ * It is not in-place, it needs a buffer of N elements, and not stable.
+ * \note see Sanders, Winkel "Super Scalar Sample Sort" ESA 2004
+ */
+#ifndef ALGOL_ALGORITHMS_SORT_SAMPLE_SORT_HPP
+#define ALGOL_ALGORITHMS_SORT_SAMPLE_SORT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+#include "stl2/concepts.hpp"
+
+namespace algol::algorithms::sort {
+
+  namespace concepts = std::experimental::ranges;
+
+  namespace detail {
+    // ranges shorter than this are sorted sequentially
+    constexpr std::ptrdiff_t sample_sort_threshold = 1 << 14;
+    // samples taken for each bucket
+    constexpr std::size_t sample_sort_oversampling = 16;
+    // buckets for each thread, more buckets than threads balance the bucket sort phase
+    constexpr std::size_t sample_sort_buckets_per_thread = 4;
+    // the bucket index is stored in 16 bits
+    constexpr std::size_t sample_sort_max_log_buckets = 16;
+
+    /**
+     * \brief complete binary search tree of K - 1 splitters, K a power of two
+     * \details the node i has children 2i and 2i + 1, the root is the node 1 and the leaves are the buckets
+     * K..2K-1, so the bucket index is computed adding the comparison result at every level.
+     * The bucket b holds the elements in (splitters[b - 1], splitters[b]]
+     */
+    template <typename T, typename Compare>
+    class splitter_tree {
+    public:
+      splitter_tree (std::vector<T> const& splitters, std::size_t log_buckets, Compare comp)
+          : log_buckets_ {log_buckets}, tree_(std::size_t{1} << log_buckets_, splitters.front()), comp_ {comp}
+      {
+        build_(splitters, 1, 0, splitters.size());
+      }
+
+      std::size_t classify (T const& value) const
+      {
+        std::size_t i = 1;
+        for (std::size_t level = 0; level < log_buckets_; ++level)
+          i = 2 * i + static_cast<std::size_t>(comp_(tree_[i], value));
+        return i - tree_.size();
+      }
+
+    private:
+      // in-order layout of the sorted splitters [first, last)
+      void build_ (std::vector<T> const& splitters, std::size_t node, std::size_t first, std::size_t last)
+      {
+        if (first >= last)
+          return;
+        auto middle = first + (last - first) / 2;
+        tree_[node] = splitters[middle];
+        build_(splitters, 2 * node, first, middle);
+        build_(splitters, 2 * node + 1, middle + 1, last);
+      }
+
+      std::size_t log_buckets_;
+      std::vector<T> tree_;
+      Compare comp_;
+    };
+
+    // run f(0), ..., f(threads - 1) concurrently, f(0) is run by the calling thread
+    template <typename F>
+    void run_on_threads (std::size_t threads, F f)
+    {
+      std::vector<std::thread> workers;
+      workers.reserve(threads - 1);
+      for (std::size_t t = 1; t < threads; ++t)
+        workers.emplace_back(f, t);
+      f(std::size_t{0});
+      for (auto& worker : workers)
+        worker.join();
+    }
+  }
+
+  /**
+   * \brief parallel sample sort
+   * \details see file description
+   * \complexity O(N*LOG2 N / P) average time with P threads, O(N) extra memory
+   * \precondition last should be reachable from first otherwise undefined behavior,
+   * comp should not throw
+   * \postcondition range [first, last) is sorted according to comp
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable, it is invoked concurrently
+   * \param threads number of threads, the calling thread included
+   */
+  template <concepts::RandomAccessIterator RandomIt, typename Compare>
+  void parallel_sample_sort (RandomIt first, RandomIt last, Compare comp, std::size_t threads)
+  {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+
+    auto n = last - first;
+    if (threads < 2 || n < detail::sample_sort_threshold) {
+      std::sort(first, last, comp);
+      return;
+    }
+
+    // the number of buckets is a power of two, a few for each thread, and the sample is less than half the range
+    auto size = static_cast<std::size_t>(n);
+    std::size_t log_buckets = 1;
+    while (log_buckets < detail::sample_sort_max_log_buckets
+           && (std::size_t{1} << log_buckets) < threads * detail::sample_sort_buckets_per_thread
+           && (std::size_t{2} << log_buckets) * detail::sample_sort_oversampling < size)
+      ++log_buckets;
+    auto buckets = std::size_t{1} << log_buckets;
+
+    // sampling
+    std::vector<value_type> sample;
+    sample.reserve(buckets * detail::sample_sort_oversampling);
+    std::minstd_rand gen {static_cast<std::minstd_rand::result_type>(size)};
+    std::uniform_int_distribution<std::ptrdiff_t> distribution(0, n - 1);
+    for (std::size_t i = 0; i < buckets * detail::sample_sort_oversampling; ++i)
+      sample.push_back(*(first + distribution(gen)));
+    std::sort(std::begin(sample), std::end(sample), comp);
+
+    std::vector<value_type> splitters;
+    splitters.reserve(buckets - 1);
+    for (std::size_t i = 1; i < buckets; ++i)
+      splitters.push_back(std::move(sample[i * detail::sample_sort_oversampling]));
+    sample.clear();
+    sample.shrink_to_fit();
+
+    detail::splitter_tree<value_type, Compare> tree {splitters, log_buckets, comp};
+
+    // classification: thread t classifies the block [t * size / threads, (t + 1) * size / threads)
+    std::vector<std::uint16_t> oracle(size);
+    std::vector<std::size_t> offsets(threads * buckets);
+    auto block_first = [size, threads] (std::size_t t) { return t * size / threads; };
+
+    detail::run_on_threads(threads, [&] (std::size_t t) {
+      auto count = std::begin(offsets) + static_cast<std::ptrdiff_t>(t * buckets);
+      for (auto i = block_first(t); i < block_first(t + 1); ++i) {
+        auto bucket = tree.classify(*(first + static_cast<std::ptrdiff_t>(i)));
+        oracle[i] = static_cast<std::uint16_t>(bucket);
+        ++count[bucket];
+      }
+    });
+
+    // exclusive prefix sum in bucket major order: the elements of bucket b classified by thread t are
+    // after the ones of the buckets before b and the ones of bucket b classified by the threads before t
+    std::vector<std::size_t> bucket_first(buckets + 1);
+    std::size_t sum = 0;
+    for (std::size_t b = 0; b < buckets; ++b) {
+      bucket_first[b] = sum;
+      for (std::size_t t = 0; t < threads; ++t) {
+        auto count = offsets[t * buckets + b];
+        offsets[t * buckets + b] = sum;
+        sum += count;
+      }
+    }
+    bucket_first[buckets] = sum;
+
+    // distribution in an uninitialized buffer, every thread writes in its own disjoint slots
+    std::allocator<value_type> allocator;
+    auto buffer = allocator.allocate(size);
+
+    detail::run_on_threads(threads, [&] (std::size_t t) {
+      auto offset = std::begin(offsets) + static_cast<std::ptrdiff_t>(t * buckets);
+      for (auto i = block_first(t); i < block_first(t + 1); ++i)
+        ::new (static_cast<void*>(buffer + offset[oracle[i]]++))
+            value_type(std::move(*(first + static_cast<std::ptrdiff_t>(i))));
+    });
+
+    // bucket sort, the buckets are taken dynamically to balance the load
+    std::atomic<std::size_t> next_bucket {0};
+    detail::run_on_threads(threads, [&] (std::size_t) {
+      for (auto b = next_bucket++; b < buckets; b = next_bucket++) {
+        auto bucket_begin = buffer + bucket_first[b];
+        auto bucket_end = buffer + bucket_first[b + 1];
+        std::sort(bucket_begin, bucket_end, comp);
+        std::move(bucket_begin, bucket_end, first + static_cast<std::ptrdiff_t>(bucket_first[b]));
+        std::destroy(bucket_begin, bucket_end);
+      }
+    });
+
+    allocator.deallocate(buffer, size);
+  }
+
+  /**
+   * \brief parallel sample sort using all the hardware threads
+   * \details see file description
+   * \complexity O(N*LOG2 N / P) average time with P hardware threads, O(N) extra memory
+   * \precondition last should be reachable from first otherwise undefined behavior,
+   * comp should not throw
+   * \postcondition range [first, last) is sorted according to comp
+   * \tparam RandomIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable, it is invoked concurrently
+   */
+  template <concepts::RandomAccessIterator RandomIt,
+      typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+  void parallel_sample_sort (RandomIt first, RandomIt last, Compare comp = Compare{})
+  {
+    parallel_sample_sort(first, last, comp, std::max(1u, std::thread::hardware_concurrency()));
+  }
+}
+
+#endif //ALGOL_ALGORITHMS_SORT_SAMPLE_SORT_HPP
@@ -17,6 +17,7 @@
 
 #include <iterator>
 #include "stl2/concepts.hpp"
+#include "algol/algorithms/sort/projection.hpp"
 
 namespace algol::algorithms::sort {
 
@@ -78,6 +79,44 @@ namespace algol::algorithms::sort {
     // loop postcondition
     // the range [old first, last) is a permutation of the input range it has the same elements in sorted order
   }
+
+  /**
+   * \brief selection sort using STL algorithms with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void selection_sort_stl (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    selection_sort_stl(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief selection sort with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void selection_sort (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    selection_sort(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
 }
 
 #endif //ALGOL_ALGORITHMS_SORT_SELECTION_SORT_HPP
@@ -3,6 +3,7 @@
 
 #include <iterator>
 #include "stl2/concepts.hpp"
+#include "algol/algorithms/sort/projection.hpp"
 #include "algol/sequence/generator/halving_generator.hpp"
 #include "algol/sequence/generator/ciura_gap_sequence_generator.hpp"
 #include "algol/sequence/generator/hibbard_gap_sequence_generator.hpp"
@@ -116,6 +117,82 @@ namespace algol::algorithms::sort {
     using sedgewick_gap_seq = algol::sequence::sedgewick_gap_seq<typename std::iterator_traits<BidirIt>::difference_type>;
     detail::shell_sort(first, last, sedgewick_gap_seq{std::distance(first, last)}, comp);
   }
+
+  /**
+   * \brief shell sort (halving gaps) with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void shell_sort (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    shell_sort(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief shell sort (Ciura gaps) with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void shell_sort_ciura_gaps (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    shell_sort_ciura_gaps(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief shell sort (Hibbard gaps) with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void shell_sort_hibbard_gaps (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    shell_sort_hibbard_gaps(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
+
+  /**
+   * \brief shell sort (Sedgewick gaps) with projection
+   * \details the elements are compared as comp(proj(a), proj(b)), the projection is invoked on every comparison
+   * \precondition last should be reachable from first otherwise undefined behavior
+   * \postcondition range [first, last) is sorted according to comp applied to the projected elements
+   * \tparam ForwardIt iterator type for [first, last) range
+   * \tparam Compare comparison type
+   * \tparam Projection projection type
+   * \param first iterator to the first element of the range
+   * \param last iterator to the one past last element of the range
+   * \param comp comparison invokable
+   * \param proj projection invokable
+   */
+  template <concepts::ForwardIterator ForwardIt, typename Compare, typename Projection>
+  void shell_sort_sedgewick_gaps (ForwardIt first, ForwardIt last, Compare comp, Projection proj)
+  {
+    shell_sort_sedgewick_gaps(first, last, projected_compare<Compare, Projection>{comp, proj});
+  }
 }
 
 #endif //ALGOL_ALGORITHMS_SORT_SHELL_SORT_HPP
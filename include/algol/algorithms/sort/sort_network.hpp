@@ -0,0 +1,167 @@
+/**
+ * \brief sorting network implementation for fixed size ranges
+ * \details From Wikipedia
+ * A sorting network is an abstract mathematical model of a network of wires and comparator modules
+ * that is used to sort a sequence of numbers. Each comparator connects two wires and sorts the values
+ * by outputting the smaller value to one wire, and the larger to the other.
+ * The sequence of comparisons does not depend on the values so the network for N elements is generated
+ * at compile time, Batcher odd-even merge sort, and every comparator is expanded inline:
+ * for arithmetic types the comparator is a branchless min/max pair.
+ * Batcher networks are optimal in the number of comparators for N <= 8 and near-optimal up to 32,
+ * they need O(N*LOG2^2 N) comparators.
+ * It is in-place and not stable
+ */
+#ifndef ALGOL_ALGORITHMS_SORT_SORT_NETWORK_HPP
+#define ALGOL_ALGORITHMS_SORT_SORT_NETWORK_HPP
+
+#include <array>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "stl2/concepts.hpp"
+
+namespace algol::algorithms::sort {
+
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief comparator module of a sorting network, it puts the least element in position first
+   */
+  struct comparator {
+    std::size_t first;
+    std::size_t second;
+  };
+
+  namespace detail {
+    // Batcher odd-even merge sort for arbitrary n, see Knuth TAOCP vol 3, 5.3.4
+    template <typename F>
+    constexpr void batcher_comparators (std::size_t n, F f)
+    {
+      for (std::size_t p = 1; p < n; p *= 2)
+        for (std::size_t k = p; k >= 1; k /= 2)
+          for (std::size_t j = k % p; j + k < n; j += 2 * k)
+            for (std::size_t i = 0; i < k && i + j + k < n; ++i)
+              if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                f(i + j, i + j + k);
+    }
+
+    template <std::size_t N>
+    constexpr std::size_t batcher_size ()
+    {
+      std::size_t count = 0;
+      batcher_comparators(N, [&count] (std::size_t, std::size_t) { ++count; });
+      return count;
+    }
+
+    template <std::size_t N>
+    constexpr auto batcher_network ()
+    {
+      std::array<comparator, batcher_size<N>()> network {};
+      std::size_t count = 0;
+      batcher_comparators(N, [&network, &count] (std::size_t first, std::size_t second) {
+        network[count++] = comparator {first, second};
+      });
+      return network;
+    }
+
+    template <typename T, typename Compare>
+    constexpr void compare_exchange (T& lhs, T& rhs, Compare& comp)
+    {
+      if constexpr (std::is_arithmetic_v<T> || std::is_pointer_v<T>) {
+        // select both values before storing them so the compiler emits conditional moves
+        auto less = comp(rhs, lhs);
+        auto min = less ? rhs : lhs;
+        auto max = less ? lhs : rhs;
+        lhs = min;
+        rhs = max;
+      }
+      else {
+        if (comp(rhs, lhs)) {
+          T tmp = std::move(lhs);
+          lhs = std::move(rhs);
+          rhs = std::move(tmp);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief sorting network for N elements
+   * \details the comparators are generated at compile time and expanded inline,
+   * the sort can be used in constant expressions
+   * \tparam N number of elements sorted
+   */
+  template <std::size_t N>
+  struct sort_network {
+    /**
+     * \brief the comparators in the order they are applied
+     */
+    static constexpr auto comparators = detail::batcher_network<N>();
+
+    /**
+     * \brief sort an array
+     * \complexity O(N*LOG2^2 N) comparisons, comparators.size() exactly
+     * \precondition None
+     * \postcondition values is sorted according to comp
+     * \tparam T type of the elements
+     * \tparam Compare comparison type
+     * \param values the array to sort
+     * \param comp comparison invokable
+     */
+    template <typename T, typename Compare = std::less<T>>
+    constexpr void operator() (std::array<T, N>& values, Compare comp = Compare{}) const
+    {
+      sort_(values, comp, std::make_index_sequence<comparators.size()>{});
+    }
+
+    /**
+     * \brief sort a range of N elements
+     * \complexity O(N*LOG2^2 N) comparisons, comparators.size() exactly
+     * \precondition range [first, first + N) is valid otherwise undefined behavior
+     * \postcondition range [first, first + N) is sorted according to comp
+     * \tparam RandomIt iterator type for [first, first + N) range
+     * \tparam Compare comparison type
+     * \param first iterator to the first element of the range
+     * \param comp comparison invokable
+     */
+    template <concepts::RandomAccessIterator RandomIt,
+        typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+    constexpr void operator() (RandomIt first, Compare comp = Compare{}) const
+    {
+      sort_(first, comp, std::make_index_sequence<comparators.size()>{});
+    }
+
+  private:
+    template <typename T, typename Compare, std::size_t ...I>
+    static constexpr void sort_ (std::array<T, N>& values, Compare& comp, std::index_sequence<I...>)
+    {
+      (detail::compare_exchange(values[comparators[I].first], values[comparators[I].second], comp), ...);
+    }
+
+    template <typename RandomIt, typename Compare, std::size_t ...I>
+    static constexpr void sort_ (RandomIt first, Compare& comp, std::index_sequence<I...>)
+    {
+      (detail::compare_exchange(first[comparators[I].first], first[comparators[I].second], comp), ...);
+    }
+  };
+
+  /**
+   * \brief sort an array using a sorting network
+   * \complexity O(N*LOG2^2 N) comparisons
+   * \precondition None
+   * \postcondition values is sorted according to comp
+   * \tparam T type of the elements
+   * \tparam N number of elements
+   * \tparam Compare comparison type
+   * \param values the array to sort
+   * \param comp comparison invokable
+   */
+  template <typename T, std::size_t N, typename Compare = std::less<T>>
+  constexpr void network_sort (std::array<T, N>& values, Compare comp = Compare{})
+  {
+    sort_network<N>{}(values, comp);
+  }
+}
+
+#endif //ALGOL_ALGORITHMS_SORT_SORT_NETWORK_HPP
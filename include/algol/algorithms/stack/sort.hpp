@@ -3,9 +3,68 @@
 
 #include <iterator>
 #include <functional>
+#include <utility>
 #include "algol/ds/stack/concepts.hpp"
 
 namespace algol::algorithms::stack {
+  namespace detail {
+    // move the top item of from onto to
+    // the item is moved out of the stack through a const_cast: top() gives a constant reference
+    // to an item that is not constant and that is popped right after
+    template <algol::concepts::Stack S>
+    void move_top (S& from, S& to)
+    {
+      to.push(std::move(const_cast<typename S::reference>(from.top())));
+      from.pop();
+    }
+
+    // merge the runs of length n_x and n_y on top of x and y onto to
+    // if the runs have the least item on top the merged run has the greatest item on top and vice versa
+    template <algol::concepts::Stack S, typename Compare>
+    void merge_runs (S& x, typename S::size_type n_x, S& y, typename S::size_type n_y, S& to, bool least_on_top,
+                     Compare& comp)
+    {
+      while (n_x > 0 && n_y > 0) {
+        // loop invariant (holds also at the end of this loop)
+        // the items pushed onto to are not after, according to the direction of the runs,
+        // the remaining n_x + n_y items of the runs
+        auto take_y = least_on_top ? comp(y.top(), x.top()) : comp(x.top(), y.top());
+        if (take_y) {
+          move_top(y, to);
+          --n_y;
+        }
+        else {
+          move_top(x, to);
+          --n_x;
+        }
+      }
+      for (; n_x > 0; --n_x)
+        move_top(x, to);
+      for (; n_y > 0; --n_y)
+        move_top(y, to);
+    }
+
+    // pop n items from the top of from and push them onto to as a sorted run,
+    // with the least item on top if least_on_top, using x and y as temporary stacks
+    // the items already in to, x and y are not touched
+    template <algol::concepts::Stack S, typename Compare>
+    void merge_sort (S& from, S& to, S& x, S& y, typename S::size_type n, bool least_on_top, Compare& comp)
+    {
+      if (n == 0)
+        return;
+      if (n == 1) {
+        move_top(from, to);
+        return;
+      }
+
+      // runs of the halves are in the opposite direction because merging reverses it
+      auto half = n / 2;
+      merge_sort(from, x, to, y, half, !least_on_top, comp);
+      merge_sort(from, y, to, x, n - half, !least_on_top, comp);
+      merge_runs(x, half, y, n - half, to, !least_on_top, comp);
+    }
+  }
+
   /**
    * \brief Sorts a stack using (optimized?) insertion sort algorithm
    * \details Uses temporary stack to store the elements popped from input stack
@@ -179,5 +238,40 @@ namespace algol::algorithms::stack {
     // stack is a permutation of the input stack it has the same elements in different order
     // starting from bottom of the stack there are stack.size sorted elements
   }
+
+  /**
+   * \brief Sorts a stack using merge sort algorithm
+   * \details Uses three temporary stacks. The items are split recursively in halves, each half is sorted
+   * as a run on top of a temporary stack and the two runs are merged popping the two tops.
+   * Pushing reverses the order of the items so the runs of each level of recursion are sorted in the opposite
+   * direction of the runs of the level above. The items are moved, never copied, from a stack to another.
+   * It is not stable
+   * \tparam S A container implementing the Stack concept
+   * \precondition The temporary stacks of type S can hold std::size(stack) items
+   * \postcondition The input stack becomes sorted in the order specified by the compare functor passed
+   * \complexity O(N*LOG2 N) comparisons and moves, O(LOG2 N) recursion depth
+   * \param stack The stack to sort
+   * \return None
+   */
+  template <algol::concepts::Stack S, typename Compare = std::less<typename S::value_type>>
+  void merge_sort (S& stack, Compare comp = Compare{})
+  {
+    auto n = std::size(stack);
+    if (n < 2)
+      return;
+
+    S sorted {};
+    S x {};
+    S y {};
+
+    // the greatest item on top of the sorted stack, moving it back onto the input stack
+    // puts the greatest items first as the other sorts do
+    detail::merge_sort(stack, sorted, x, y, n, false, comp);
+    while (!std::empty(sorted))
+      detail::move_top(sorted, stack);
+    // postcondition
+    // stack is a permutation of the input stack it has the same elements in different order
+    // starting from bottom of the stack there are stack.size sorted elements
+  }
 }
 #endif //ALGOL_ALGORITHMS_STACK_SORT_HPP
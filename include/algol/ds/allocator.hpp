@@ -0,0 +1,248 @@
+/**
+ * \file
+ * Allocation helpers shared by the containers that accept an allocator.
+ */
+
+#ifndef ALGOL_DS_ALLOCATOR_HPP
+#define ALGOL_DS_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algol::ds {
+  /**
+   * \brief Storage tag that replaces the allocator of the fixed containers
+   * \details A fixed container whose Allocator is inline_storage keeps its items inside the container object
+   * and never allocates, for example fixed_stack<std::string, 100, inline_storage>
+   */
+  struct inline_storage {};
+}
+
+namespace algol::ds::detail {
+  /**
+   * \brief Allocate an array of n items default constructed through the allocator
+   * \details If a construction throws the items already constructed are destroyed and the storage is given back
+   * \tparam Allocator allocator of the items, its pointer type must be a raw pointer
+   * \param allocator The allocator used for the storage and the constructions
+   * \param n The number of items
+   * \return The array allocated
+   */
+  template <typename Allocator>
+  auto allocate_array (Allocator& allocator, std::size_t n)
+  {
+    using alloc_traits = std::allocator_traits<Allocator>;
+    static_assert(std::is_pointer_v<typename alloc_traits::pointer>, "fancy pointers are not supported");
+
+    auto array = alloc_traits::allocate(allocator, n);
+    auto constructed = std::size_t{0};
+    try {
+      for (; constructed < n; ++constructed)
+        alloc_traits::construct(allocator, array + constructed);
+    }
+    catch (...) {
+      while (constructed > 0)
+        alloc_traits::destroy(allocator, array + --constructed);
+      alloc_traits::deallocate(allocator, array, n);
+      throw;
+    }
+    return array;
+  }
+
+  /**
+   * \brief Destroy the n items of an array obtained from allocate_array and give back its storage
+   * \param allocator An allocator equal to the one that allocated the array
+   * \param array The array, nothing is done if it is nullptr
+   * \param n The number of items
+   */
+  template <typename Allocator>
+  void deallocate_array (Allocator& allocator, typename std::allocator_traits<Allocator>::pointer array,
+                         std::size_t n) noexcept
+  {
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    if (array == nullptr)
+      return;
+    for (auto i = std::size_t{0}; i < n; ++i)
+      alloc_traits::destroy(allocator, array + i);
+    alloc_traits::deallocate(allocator, array, n);
+  }
+
+  /**
+   * \brief Allocate the storage for n items through the allocator without constructing them
+   * \tparam Allocator allocator of the items, its pointer type must be a raw pointer
+   * \param allocator The allocator used for the storage
+   * \param n The number of items
+   * \return The uninitialized storage
+   */
+  template <typename Allocator>
+  auto allocate_storage (Allocator& allocator, std::size_t n)
+  {
+    using alloc_traits = std::allocator_traits<Allocator>;
+    static_assert(std::is_pointer_v<typename alloc_traits::pointer>, "fancy pointers are not supported");
+
+    return alloc_traits::allocate(allocator, n);
+  }
+
+  /**
+   * \brief Give back the storage obtained from allocate_storage, the items must be already destroyed
+   * \param allocator An allocator equal to the one that allocated the storage
+   * \param storage The storage, nothing is done if it is nullptr
+   * \param n The number of items
+   */
+  template <typename Allocator>
+  void deallocate_storage (Allocator& allocator, typename std::allocator_traits<Allocator>::pointer storage,
+                           std::size_t n) noexcept
+  {
+    if (storage != nullptr)
+      std::allocator_traits<Allocator>::deallocate(allocator, storage, n);
+  }
+
+  /**
+   * \brief The items read through InputIt can be copied with memcpy in the storage of Allocator
+   * \details The items are trivially copyable, InputIt points to contiguous items of the same type (a pointer or
+   * an iterator of std::vector) and the allocator is std::allocator, whose construct is a placement new.
+   * Any other allocator may customize construct and is always called.
+   */
+  template <typename Allocator, typename InputIt, typename T = typename Allocator::value_type>
+  constexpr bool is_memcpy_copyable =
+      std::is_trivially_copyable_v<T> && std::is_same_v<Allocator, std::allocator<T>>
+      && (std::is_same_v<InputIt, T*> || std::is_same_v<InputIt, T const*>
+          || std::is_same_v<InputIt, typename std::vector<T>::iterator>
+          || std::is_same_v<InputIt, typename std::vector<T>::const_iterator>);
+
+  /**
+   * \brief Copy construct n items read from first in the uninitialized storage at destination
+   * \details The items are copied with one memcpy if is_memcpy_copyable, otherwise they are constructed one
+   * by one through the allocator. If a construction throws the items already constructed are destroyed
+   * \param allocator The allocator used for the constructions
+   * \param first The iterator to the first item to copy
+   * \param n The number of items
+   * \param destination The uninitialized storage for n items
+   * \return The iterator past the last item copied
+   */
+  template <typename Allocator, typename InputIt>
+  InputIt uninitialized_copy_n (Allocator& allocator, InputIt first, std::size_t n,
+                                typename std::allocator_traits<Allocator>::pointer destination)
+  {
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    if constexpr (is_memcpy_copyable<Allocator, InputIt>) {
+      if (n > 0)
+        std::memcpy(destination, std::addressof(*first), n * sizeof(typename Allocator::value_type));
+      return first + static_cast<typename std::iterator_traits<InputIt>::difference_type>(n);
+    }
+    else {
+      auto constructed = std::size_t{0};
+      try {
+        // loop invariant: the items before constructed are copied and first points to the next one
+        for (; constructed < n; ++constructed, ++first)
+          alloc_traits::construct(allocator, destination + constructed, *first);
+      }
+      catch (...) {
+        while (constructed > 0)
+          alloc_traits::destroy(allocator, destination + --constructed);
+        throw;
+      }
+      return first;
+    }
+  }
+
+  /**
+   * \brief Uninitialized storage for N items kept inside the object that owns it
+   * \details The items are constructed and destroyed by the owner, the storage only provides the memory.
+   * data() is the address where the items are constructed, the items are reached with operator[] through
+   * std::launder: the storage is not an array of T, and an item with const or reference members could not
+   * be reached through the address of the storage otherwise
+   * \tparam T type of the items
+   * \tparam N number of the items
+   */
+  template <typename T, std::size_t N>
+  class inline_array {
+  public:
+    // the storage is left uninitialized, also when the owner value-initializes it
+    inline_array () noexcept
+    {}
+
+    // the address of the storage, whether the items are constructed there or not
+    T* data () noexcept
+    {
+      return reinterpret_cast<T*>(buffer_);
+    }
+
+    T const* data () const noexcept
+    {
+      return reinterpret_cast<T const*>(buffer_);
+    }
+
+    // the item i, it is constructed
+    T& operator[] (std::size_t i) noexcept
+    {
+      return *std::launder(data() + i);
+    }
+
+    T const& operator[] (std::size_t i) const noexcept
+    {
+      return *std::launder(data() + i);
+    }
+
+  private:
+    alignas(T) std::byte buffer_[sizeof(T) * N];
+  };
+
+  /**
+   * \brief Allocate a node through the allocator rebound to Node, construct it and construct its value
+   * \details The node is constructed by the rebound allocator, its links get their default member initializers.
+   * Its value_ member is an inline_array of one item whose value is constructed by the allocator of the items,
+   * so that an allocator aware item gets it (uses-allocator construction)
+   * \tparam Node type of the node, it has a value_ member of type inline_array<T, 1>
+   * \tparam Allocator allocator of the items
+   * \param allocator The allocator of the items
+   * \param args The arguments forwarded to the constructor of the value
+   * \return The node allocated
+   */
+  template <typename Node, typename Allocator, typename... Args>
+  Node* allocate_node (Allocator& allocator, Args&& ... args)
+  {
+    using node_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_alloc_traits = std::allocator_traits<node_alloc>;
+    static_assert(std::is_pointer_v<typename node_alloc_traits::pointer>, "fancy pointers are not supported");
+
+    node_alloc nodes {allocator};
+    auto node = node_alloc_traits::allocate(nodes, 1);
+    node_alloc_traits::construct(nodes, node);
+    try {
+      std::allocator_traits<Allocator>::construct(allocator, node->value_.data(), std::forward<Args>(args)...);
+    }
+    catch (...) {
+      node_alloc_traits::destroy(nodes, node);
+      node_alloc_traits::deallocate(nodes, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  /**
+   * \brief Destroy the value and the node obtained from allocate_node and give back its storage
+   * \param allocator An allocator equal to the one that allocated the node
+   * \param node The node
+   */
+  template <typename Node, typename Allocator>
+  void deallocate_node (Allocator& allocator, Node* node) noexcept
+  {
+    using node_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_alloc_traits = std::allocator_traits<node_alloc>;
+
+    std::allocator_traits<Allocator>::destroy(allocator, node->value_.data());
+    node_alloc nodes {allocator};
+    node_alloc_traits::destroy(nodes, node);
+    node_alloc_traits::deallocate(nodes, node, 1);
+  }
+}
+
+#endif //ALGOL_DS_ALLOCATOR_HPP
@@ -0,0 +1,21 @@
+/**
+ * \file
+ * Cache line size used to lay out the concurrent data structures.
+ */
+
+#ifndef ALGOL_DS_CACHE_LINE_HPP
+#define ALGOL_DS_CACHE_LINE_HPP
+
+#include <cstddef>
+
+namespace algol::ds {
+  /**
+   * \brief Size in bytes of a cache line
+   * \details Data written by different threads is aligned to this size to avoid false sharing.
+   * std::hardware_destructive_interference_size is not available on every supported compiler,
+   * 64 bytes is the line size of x86-64 and of most ARMv8 cores.
+   */
+  constexpr std::size_t cache_line_size = 64;
+}
+
+#endif //ALGOL_DS_CACHE_LINE_HPP
@@ -0,0 +1,163 @@
+/**
+ * \file
+ * Fixed size chunks of items and a pool recycling them, shared by the segmented containers.
+ */
+
+#ifndef ALGOL_DS_CHUNK_HPP
+#define ALGOL_DS_CHUNK_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "algol/ds/allocator.hpp"
+
+namespace algol::ds::detail {
+  /**
+   * \brief The number of items of a chunk of about 4 KiB, at least one
+   * \tparam T type of the items
+   */
+  template <typename T>
+  constexpr std::size_t default_chunk_size = 4096 > sizeof(T) + 2 * sizeof(void*)
+                                             ? (4096 - 2 * sizeof(void*)) / sizeof(T) : 1;
+
+  /**
+   * \brief A chunk of uninitialized storage for ChunkSize items linked to its neighbours
+   * \tparam T type of the items
+   * \tparam ChunkSize number of the items
+   */
+  template <typename T, std::size_t ChunkSize>
+  struct chunk {
+    chunk* prev_ {nullptr};
+    chunk* next_ {nullptr};
+    inline_array<T, ChunkSize> items_;
+  };
+
+  /**
+   * \brief A free list of chunks
+   * \details The chunks given back to the pool are kept and handed out again instead of being deallocated,
+   * a container that shrinks and grows again does not allocate.
+   * The pool does not keep the allocator, the owner passes it and it gives back the chunks with release
+   * before the pool is destroyed.
+   * \tparam T type of the items
+   * \tparam ChunkSize number of the items of a chunk
+   */
+  template <typename T, std::size_t ChunkSize>
+  class chunk_pool {
+  public:
+    using chunk_type = chunk<T, ChunkSize>;
+
+    chunk_pool () noexcept = default;
+
+    chunk_pool (chunk_pool const&) = delete;
+    chunk_pool& operator= (chunk_pool const&) = delete;
+
+    chunk_pool (chunk_pool&& rhs) noexcept
+        : free_ {std::exchange(rhs.free_, nullptr)}, size_ {std::exchange(rhs.size_, std::size_t{0})}
+    {}
+
+    chunk_pool& operator= (chunk_pool&&) = delete;
+
+    ~chunk_pool ()
+    {
+      assert(free_ == nullptr && "the chunks are given back with release before the pool is destroyed");
+    }
+
+    /**
+     * \brief A chunk from the free list, or a new one if the free list is empty
+     * \details The links of the chunk are null, its storage is uninitialized
+     * \param allocator The allocator of the items, rebound to the chunk type
+     * \return The chunk
+     */
+    template <typename Allocator>
+    chunk_type* acquire (Allocator& allocator)
+    {
+      if (free_ == nullptr)
+        return allocate_(allocator);
+
+      auto c = free_;
+      free_ = c->next_;
+      --size_;
+      c->next_ = nullptr;
+      return c;
+    }
+
+    /**
+     * \brief Put a chunk whose items are destroyed on the free list
+     * \param c The chunk
+     */
+    void recycle (chunk_type* c) noexcept
+    {
+      c->prev_ = nullptr;
+      c->next_ = free_;
+      free_ = c;
+      ++size_;
+    }
+
+    /**
+     * \brief Allocate new chunks until the free list holds at least n chunks
+     * \param allocator The allocator of the items, rebound to the chunk type
+     * \param n The number of the free chunks
+     */
+    template <typename Allocator>
+    void reserve (Allocator& allocator, std::size_t n)
+    {
+      // invariant: the chunks allocated so far are on the free list
+      while (size_ < n)
+        recycle(allocate_(allocator));
+    }
+
+    /**
+     * \brief Deallocate the chunks on the free list
+     * \param allocator An allocator equal to the one that allocated the chunks
+     */
+    template <typename Allocator>
+    void release (Allocator& allocator) noexcept
+    {
+      using chunk_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<chunk_type>;
+
+      chunk_alloc chunks {allocator};
+      // invariant: the chunks before free_ are deallocated
+      while (free_ != nullptr) {
+        auto c = std::exchange(free_, free_->next_);
+        c->~chunk_type();
+        std::allocator_traits<chunk_alloc>::deallocate(chunks, c, 1);
+      }
+      size_ = 0;
+    }
+
+    /**
+     * \brief The number of chunks on the free list
+     */
+    std::size_t size () const noexcept
+    {
+      return size_;
+    }
+
+    void swap (chunk_pool& rhs) noexcept
+    {
+      using std::swap;
+      swap(free_, rhs.free_);
+      swap(size_, rhs.size_);
+    }
+
+  private:
+    template <typename Allocator>
+    static chunk_type* allocate_ (Allocator& allocator)
+    {
+      using chunk_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<chunk_type>;
+      using chunk_alloc_traits = std::allocator_traits<chunk_alloc>;
+      static_assert(std::is_pointer_v<typename chunk_alloc_traits::pointer>, "fancy pointers are not supported");
+
+      chunk_alloc chunks {allocator};
+      auto c = chunk_alloc_traits::allocate(chunks, 1);
+      return ::new (static_cast<void*>(c)) chunk_type{};
+    }
+
+    chunk_type* free_ {nullptr};
+    std::size_t size_ {0};
+  };
+}
+
+#endif //ALGOL_DS_CHUNK_HPP
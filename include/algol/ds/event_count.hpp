@@ -0,0 +1,121 @@
+/**
+ * \file
+ * Event count used to block the threads of the concurrent data structures.
+ */
+
+#ifndef ALGOL_DS_EVENT_COUNT_HPP
+#define ALGOL_DS_EVENT_COUNT_HPP
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace algol::ds {
+  /**
+   * \brief Lets threads sleep until a condition checked without locks may have become true
+   * \details A waiter announces itself with prepare_wait, checks the condition again and calls wait only if
+   * it is still false; wait returns as soon as a notify happened after prepare_wait.
+   * A notifier makes the condition true and then calls notify: when nobody is waiting notify is a fence and
+   * a load, so the fast path of the lock-free structures does not pay for the blocking operations.
+   * On Linux the sleeping threads wait on a futex, elsewhere they yield.
+   * \note see Vyukov "Eventcount" 1024cores.net
+   */
+  class event_count {
+  public:
+    event_count () = default;
+    event_count (event_count const&) = delete;
+    event_count& operator= (event_count const&) = delete;
+
+    /**
+     * \brief Announce a wait, the condition must be checked again before calling wait
+     * \return The key to be passed to wait
+     */
+    std::uint32_t prepare_wait () noexcept
+    {
+      // the check of the condition that follows cannot be reordered before the announcement
+      waiters_.fetch_add(1, std::memory_order_seq_cst);
+      return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * \brief Withdraw the announced wait, the condition became true
+     */
+    void cancel_wait () noexcept
+    {
+      waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Sleep until a notify happens after the prepare_wait that returned key
+     * \param key The value returned by prepare_wait
+     */
+    void wait (std::uint32_t key) noexcept
+    {
+      while (epoch_.load(std::memory_order_acquire) == key)
+        sleep_(key);
+      waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Wake one waiting thread, to be called after the condition is made true
+     */
+    void notify_one () noexcept
+    {
+      notify_(1);
+    }
+
+    /**
+     * \brief Wake all the waiting threads, to be called after the condition is made true
+     */
+    void notify_all () noexcept
+    {
+      notify_(INT_MAX);
+    }
+
+  private:
+    void notify_ (int count) noexcept
+    {
+      // the change of the condition that precedes cannot be reordered after the load of the waiters,
+      // thread sanitizer does not understand fences so a read-modify-write is used
+#if defined(__SANITIZE_THREAD__)
+      if (waiters_.fetch_add(0, std::memory_order_seq_cst) == 0)
+        return;
+#else
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (waiters_.load(std::memory_order_relaxed) == 0)
+        return;
+#endif
+
+      epoch_.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+      syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+      static_cast<void>(count);
+#endif
+    }
+
+    void sleep_ (std::uint32_t key) noexcept
+    {
+#if defined(__linux__)
+      syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, key, nullptr, nullptr, 0);
+#else
+      static_cast<void>(key);
+      std::this_thread::yield();
+#endif
+    }
+
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex needs a plain 32 bits word");
+
+    std::atomic<std::uint32_t> epoch_ {0};
+    std::atomic<std::uint32_t> waiters_ {0};
+  };
+}
+
+#endif //ALGOL_DS_EVENT_COUNT_HPP
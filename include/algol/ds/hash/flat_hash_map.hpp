@@ -0,0 +1,223 @@
+/**
+ * \file
+ * Flat hash map implementation
+ */
+
+#ifndef ALGOL_DS_FLAT_HASH_MAP_HPP
+#define ALGOL_DS_FLAT_HASH_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "flat_hash_table.hpp"
+#include "hash_table.hpp"
+#include "murmur3.hpp"
+
+namespace algol::ds {
+  /**
+   * \brief Hash map that stores its items in one array of slots, with open addressing
+   * \details An unordered map from the keys to the mapped values whose items are stored in the slots of the
+   * table instead of a node each as std::unordered_map: a lookup reads a group of 16 control bytes (8 without
+   * SSE2) and the slots whose byte matches the hash, in the common case one cache line of control bytes and
+   * one of items. See [flat_hash_table](@ref detail::flat_hash_table) for the probing and the growth.
+   * Unlike std::unordered_map a rehash moves the items: any insert can invalidate the references to the items
+   * and all the iterators, erase invalidates only the iterators and the references to the item removed.
+   * \tparam Key type of the keys
+   * \tparam T type of the mapped values
+   * \tparam Hash hash of the keys, a good hash is needed as the 7 low bits are stored in the control bytes
+   * \tparam KeyEqual equality of the keys
+   * \tparam Allocator allocator of the items
+   */
+  template <typename Key, typename T, typename Hash = murmur3_hash<Key>, typename KeyEqual = std::equal_to<Key>,
+            typename Allocator = std::allocator<std::pair<Key const, T>>>
+  class flat_hash_map final
+      : public detail::flat_hash_table<detail::flat_map_policy<Key, T>, Hash, KeyEqual, Allocator> {
+    using base = detail::flat_hash_table<detail::flat_map_policy<Key, T>, Hash, KeyEqual, Allocator>;
+
+  public:
+    using mapped_type = T;
+    using typename base::key_type;
+    using typename base::value_type;
+    using typename base::size_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+
+    using base::base;
+    using base::emplace;
+
+    /**
+     * \brief Inserts an item with the key and the mapped value if the key is not in the map
+     * \details The key is looked up before the item is constructed, the general emplace constructs the item to
+     * find its key
+     * \precondition None
+     * \postcondition The key is in the map
+     * \complexity O(1) on average
+     * \tparam K type of the key, key_type
+     * \tparam M type of the mapped value
+     * \param key The key
+     * \param value The mapped value
+     * \return The iterator to the item with the key and true if the item was inserted
+     */
+    template <typename K, typename M, typename = std::enable_if_t<std::is_same_v<std::decay_t<K>, key_type>>>
+    std::pair<iterator, bool> emplace (K&& key, M&& value)
+    {
+      return try_emplace(std::forward<K>(key), std::forward<M>(value));
+    }
+
+    /**
+     * \brief Inserts an item with the key and the mapped value constructed from the arguments, if the key
+     * is not in the map
+     * \details Nothing is constructed if the key is in the map
+     * \precondition None
+     * \postcondition The key is in the map
+     * \complexity O(1) on average
+     * \tparam Args types of the arguments
+     * \param key The key
+     * \param args The arguments of the constructor of the mapped value
+     * \return The iterator to the item with the key and true if the item was inserted
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace (key_type const& key, Args&& ... args)
+    {
+      return this->emplace_key_(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace (key_type&& key, Args&& ... args)
+    {
+      return this->emplace_key_(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * \brief Inserts an item with the key and the value, or assigns the value to the item with the key
+     * \precondition None
+     * \postcondition The key is mapped to the value
+     * \complexity O(1) on average
+     * \tparam M type of the value
+     * \param key The key
+     * \param value The mapped value
+     * \return The iterator to the item with the key and true if the item was inserted
+     */
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign (key_type const& key, M&& value)
+    {
+      auto result = try_emplace(key, std::forward<M>(value));
+      if (!result.second)
+        result.first->second = std::forward<M>(value);
+      return result;
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign (key_type&& key, M&& value)
+    {
+      auto result = try_emplace(std::move(key), std::forward<M>(value));
+      if (!result.second)
+        result.first->second = std::forward<M>(value);
+      return result;
+    }
+
+    /**
+     * \brief The mapped value of the key, a value initialized one is inserted if the key is not in the map
+     * \precondition None
+     * \postcondition The key is in the map
+     * \complexity O(1) on average
+     * \param key The key
+     * \return A reference to the mapped value
+     */
+    mapped_type& operator[] (key_type const& key)
+    {
+      return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[] (key_type&& key)
+    {
+      return try_emplace(std::move(key)).first->second;
+    }
+
+    /**
+     * \brief The mapped value of the key
+     * \precondition The key is in the map
+     * \postcondition Map is not changed
+     * \complexity O(1) on average
+     * \throws key_not_found_error if the key is not in the map
+     * \param key The key
+     * \return A reference to the mapped value
+     */
+    mapped_type& at (key_type const& key)
+    {
+      auto it = this->find(key);
+      if (it == this->end())
+        throw key_not_found_error{"Attempting at() with a key not in the map"};
+      return it->second;
+    }
+
+    mapped_type const& at (key_type const& key) const
+    {
+      auto it = this->find(key);
+      if (it == this->end())
+        throw key_not_found_error{"Attempting at() with a key not in the map"};
+      return it->second;
+    }
+
+    /**
+     * \brief Equality operator
+     * \details The maps are equal if they have the same keys mapped to equal values, the order of the slots
+     * does not matter
+     * \precondition None
+     * \postcondition The maps are not changed
+     * \complexity O(N) on average
+     * \param rhs The map to compare with
+     * \return True if the maps are equal
+     */
+    bool operator== (flat_hash_map const& rhs) const
+    {
+      if (this->size() != rhs.size())
+        return false;
+      for (auto const& value : *this) {
+        auto it = rhs.find(value.first);
+        if (it == rhs.end() || !(it->second == value.second))
+          return false;
+      }
+      return true;
+    }
+
+    bool operator!= (flat_hash_map const& rhs) const
+    {
+      return !(*this == rhs);
+    }
+  };
+
+  /**
+   * \brief Exchanges the contents of the map lhs with those of rhs
+   * \precondition The allocators are equal or they propagate on swap
+   * \postcondition The lhs map becomes the rhs map and viceversa.
+   * \complexity O(1)
+   * \param lhs Map to be exchanged with rhs.
+   * \param rhs Map to be exchanged with lhs.
+   */
+  template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  void swap (flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& lhs,
+             flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief flat_hash_map whose slots and control bytes are allocated from a std::pmr::memory_resource
+   */
+  template <typename Key, typename T, typename Hash = murmur3_hash<Key>, typename KeyEqual = std::equal_to<Key>>
+  using flat_hash_map = ds::flat_hash_map<Key, T, Hash, KeyEqual,
+                                          std::pmr::polymorphic_allocator<std::pair<Key const, T>>>;
+}
+#endif
+
+#endif //ALGOL_DS_FLAT_HASH_MAP_HPP
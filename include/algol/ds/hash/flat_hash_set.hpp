@@ -0,0 +1,91 @@
+/**
+ * \file
+ * Flat hash set implementation
+ */
+
+#ifndef ALGOL_DS_FLAT_HASH_SET_HPP
+#define ALGOL_DS_FLAT_HASH_SET_HPP
+
+#include <functional>
+#include <memory>
+#include "flat_hash_table.hpp"
+#include "murmur3.hpp"
+
+namespace algol::ds {
+  /**
+   * \brief Hash set that stores its keys in one array of slots, with open addressing
+   * \details The set version of [flat_hash_map](@ref flat_hash_map): the keys are the items, the iterators
+   * are constant. A rehash moves the keys, any insert can invalidate the references and all the iterators.
+   * \tparam Key type of the keys
+   * \tparam Hash hash of the keys, a good hash is needed as the 7 low bits are stored in the control bytes
+   * \tparam KeyEqual equality of the keys
+   * \tparam Allocator allocator of the keys
+   */
+  template <typename Key, typename Hash = murmur3_hash<Key>, typename KeyEqual = std::equal_to<Key>,
+            typename Allocator = std::allocator<Key>>
+  class flat_hash_set final : public detail::flat_hash_table<detail::flat_set_policy<Key>, Hash, KeyEqual, Allocator> {
+    using base = detail::flat_hash_table<detail::flat_set_policy<Key>, Hash, KeyEqual, Allocator>;
+
+  public:
+    using typename base::key_type;
+    using typename base::value_type;
+    using typename base::size_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+
+    using base::base;
+
+    /**
+     * \brief Equality operator
+     * \details The sets are equal if they have the same keys, the order of the slots does not matter
+     * \precondition None
+     * \postcondition The sets are not changed
+     * \complexity O(N) on average
+     * \param rhs The set to compare with
+     * \return True if the sets are equal
+     */
+    bool operator== (flat_hash_set const& rhs) const
+    {
+      if (this->size() != rhs.size())
+        return false;
+      for (auto const& key : *this)
+        if (!rhs.contains(key))
+          return false;
+      return true;
+    }
+
+    bool operator!= (flat_hash_set const& rhs) const
+    {
+      return !(*this == rhs);
+    }
+  };
+
+  /**
+   * \brief Exchanges the contents of the set lhs with those of rhs
+   * \precondition The allocators are equal or they propagate on swap
+   * \postcondition The lhs set becomes the rhs set and viceversa.
+   * \complexity O(1)
+   * \param lhs Set to be exchanged with rhs.
+   * \param rhs Set to be exchanged with lhs.
+   */
+  template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+  void swap (flat_hash_set<Key, Hash, KeyEqual, Allocator>& lhs, flat_hash_set<Key, Hash, KeyEqual, Allocator>& rhs)
+  noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief flat_hash_set whose slots and control bytes are allocated from a std::pmr::memory_resource
+   */
+  template <typename Key, typename Hash = murmur3_hash<Key>, typename KeyEqual = std::equal_to<Key>>
+  using flat_hash_set = ds::flat_hash_set<Key, Hash, KeyEqual, std::pmr::polymorphic_allocator<Key>>;
+}
+#endif
+
+#endif //ALGOL_DS_FLAT_HASH_SET_HPP
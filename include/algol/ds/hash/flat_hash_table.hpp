@@ -0,0 +1,1127 @@
+/**
+ * \file
+ * Open addressing hash table with control bytes and group probing, the base of flat_hash_map and flat_hash_set
+ */
+
+#ifndef ALGOL_DS_FLAT_HASH_TABLE_HPP
+#define ALGOL_DS_FLAT_HASH_TABLE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "hash_table.hpp"
+#include "algol/ds/allocator.hpp"
+#include "stl2/concepts.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+}
+
+namespace algol::ds::detail {
+  /**
+   * \brief The control byte of a slot
+   * \details A full slot has the 7 low bits of the hash of its key (h2), the other values have the high bit set:
+   * empty, deleted (a tombstone) and the sentinel that marks the end of the slots for the iterators
+   */
+  using ctrl_t = std::int8_t;
+
+  inline constexpr ctrl_t ctrl_empty = -128;
+  inline constexpr ctrl_t ctrl_deleted = -2;
+  inline constexpr ctrl_t ctrl_sentinel = -1;
+
+  template <typename T>
+  std::size_t trailing_zeros (T value) noexcept
+  {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(static_cast<unsigned long long>(value)));
+#else
+    std::size_t zeros = 0;
+    // loop invariant: the zeros low bits of the original value are 0
+    for (; (value & 1) == 0; value >>= 1)
+      zeros++;
+    return zeros;
+#endif
+  }
+
+  template <typename T>
+  std::size_t leading_zeros (T value) noexcept
+  {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_clzll(static_cast<unsigned long long>(value)))
+           - (std::numeric_limits<unsigned long long>::digits - std::numeric_limits<T>::digits);
+#else
+    std::size_t zeros = 0;
+    // loop invariant: the zeros high bits of the original value are 0
+    for (auto bit = T{1} << (std::numeric_limits<T>::digits - 1); (value & bit) == 0; bit >>= 1)
+      zeros++;
+    return zeros;
+#endif
+  }
+
+  /**
+   * \brief The slots of a group that match a probe, slot i is the bit i << Shift of the mask
+   * \tparam T unsigned type of the mask
+   * \tparam Width number of the slots of a group
+   * \tparam Shift the bits of a slot are 2^Shift
+   */
+  template <typename T, std::size_t Width, std::size_t Shift>
+  class bit_mask {
+  public:
+    explicit bit_mask (T mask) noexcept : mask_ {mask}
+    {}
+
+    explicit operator bool () const noexcept
+    {
+      return mask_ != 0;
+    }
+
+    // the first slot matched, the mask is not empty
+    std::size_t lowest () const noexcept
+    {
+      return trailing_zeros(mask_) >> Shift;
+    }
+
+    // the slots not matched before the first one matched, the mask is not empty
+    std::size_t trailing_empty () const noexcept
+    {
+      return trailing_zeros(mask_) >> Shift;
+    }
+
+    // the slots not matched after the last one matched, the mask is not empty
+    std::size_t leading_empty () const noexcept
+    {
+      constexpr auto extra = std::numeric_limits<T>::digits - (Width << Shift);
+      return (leading_zeros(mask_) - extra) >> Shift;
+    }
+
+    void clear_lowest () noexcept
+    {
+      mask_ &= mask_ - 1;
+    }
+
+  private:
+    T mask_;
+  };
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+  /**
+   * \brief The control bytes of 16 slots compared at once with the SSE2 instructions
+   */
+  class group {
+  public:
+    static constexpr std::size_t width = 16;
+    using mask_type = bit_mask<std::uint32_t, width, 0>;
+
+    explicit group (ctrl_t const* ctrl) noexcept
+        : ctrl_ {_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))}
+    {}
+
+    mask_type match (ctrl_t h2) const noexcept
+    {
+      return mask_type{static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)))};
+    }
+
+    mask_type match_empty () const noexcept
+    {
+      return match(ctrl_empty);
+    }
+
+    // empty and deleted are the control bytes less than the sentinel
+    mask_type match_empty_or_deleted () const noexcept
+    {
+      return mask_type{
+          static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl_)))};
+    }
+
+  private:
+    __m128i ctrl_;
+  };
+
+#else
+
+  /**
+   * \brief The control bytes of 8 slots compared at once in a 64 bits word
+   * \details The portable version of the SSE2 group, slot i is the high bit of the byte i. match can report a
+   * full slot whose byte differs from h2 after a slot that matches, the keys are compared anyway
+   */
+  class group {
+  public:
+    static constexpr std::size_t width = 8;
+    using mask_type = bit_mask<std::uint64_t, width, 3>;
+
+    explicit group (ctrl_t const* ctrl) noexcept
+    {
+      // loop invariant: the bytes before i are in the word, byte i in the bits from 8 * i, on any byte order
+      for (std::size_t i = 0; i < width; ++i)
+        ctrl_ |= std::uint64_t{static_cast<std::uint8_t>(ctrl[i])} << (8 * i);
+    }
+
+    mask_type match (ctrl_t h2) const noexcept
+    {
+      auto x = ctrl_ ^ (lsbs * static_cast<std::uint8_t>(h2));
+      return mask_type{(x - lsbs) & ~x & msbs};
+    }
+
+    mask_type match_empty () const noexcept
+    {
+      return mask_type{ctrl_ & (~ctrl_ << 6) & msbs};
+    }
+
+    mask_type match_empty_or_deleted () const noexcept
+    {
+      return mask_type{ctrl_ & (~ctrl_ << 7) & msbs};
+    }
+
+  private:
+    static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+    static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+
+    std::uint64_t ctrl_ {0};
+  };
+
+#endif
+
+  /**
+   * \brief The control bytes of a table without slots: the sentinel and a group of empty slots
+   * \details The lookups in an empty table stop at the first group without a branch on the capacity
+   */
+  alignas(16) inline constexpr ctrl_t empty_group[16] = {
+      ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+      ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty};
+
+  /**
+   * \brief The groups visited looking for a hash: a triangular sequence of groups that visits every group once
+   * when the number of the slots is a power of 2
+   */
+  class probe_sequence {
+  public:
+    probe_sequence (std::size_t hash, std::size_t mask) noexcept : mask_ {mask}, offset_ {hash & mask}
+    {}
+
+    std::size_t offset () const noexcept
+    {
+      return offset_;
+    }
+
+    // the slot i of the current group
+    std::size_t offset (std::size_t i) const noexcept
+    {
+      return (offset_ + i) & mask_;
+    }
+
+    void next () noexcept
+    {
+      index_ += group::width;
+      offset_ = (offset_ + index_) & mask_;
+    }
+
+  private:
+    std::size_t mask_;
+    std::size_t offset_;
+    std::size_t index_ {0};
+  };
+
+  /**
+   * \brief The items stored in a flat_hash_map
+   */
+  template <typename Key, typename T>
+  struct flat_map_policy {
+    static constexpr bool constant_iterator = false;
+    using key_type = Key;
+    using value_type = std::pair<Key const, T>;
+
+    static key_type const& key (value_type const& value) noexcept
+    {
+      return value.first;
+    }
+  };
+
+  /**
+   * \brief The items stored in a flat_hash_set
+   */
+  template <typename Key>
+  struct flat_set_policy {
+    static constexpr bool constant_iterator = true;
+    using key_type = Key;
+    using value_type = Key;
+
+    static key_type const& key (value_type const& value) noexcept
+    {
+      return value;
+    }
+  };
+
+  /**
+   * \brief Open addressing hash table with a control byte per slot, in the style of the Swiss tables
+   * \details The slots are an array of capacity items, capacity is a power of 2 minus 1, and the control bytes
+   * are a parallel array with the sentinel after the last slot and a copy of the first group::width - 1 bytes
+   * after it, so a group read at any slot is contiguous.
+   * The hash of a key is split in h1, the high bits, that selects the first group of the probe sequence, and h2,
+   * the 7 low bits, that is stored in the control byte. A lookup compares h2 with all the control bytes of a
+   * group with one instruction and compares the keys only of the slots that match: with a good hash the keys
+   * compared are almost always just the one looked for. The lookup stops at the first group with an empty slot.
+   * The erase of a key leaves the slot empty when no group with the slot saw the table full at its position,
+   * since then no probe sequence went past it; otherwise the slot becomes deleted, a tombstone that the lookups
+   * skip and the inserts reuse. The tombstones are dropped by the next rehash.
+   * The table grows when it is 7/8 full, items and tombstones, doubling the capacity or, when more than 3/32
+   * of the slots are tombstones, rehashing at the same capacity.
+   * Rehashing moves the items, all the iterators and the references are invalidated by an insert that rehashes.
+   * \tparam Policy key_type, value_type, the key of an item and if the items can be changed through the iterators
+   * \tparam Hash hash of the keys
+   * \tparam KeyEqual equality of the keys
+   * \tparam Allocator allocator of the items, the control bytes are allocated with it rebound
+   */
+  template <typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+  class flat_hash_table {
+  public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using pointer = value_type*;
+    using const_pointer = value_type const*;
+
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using ctrl_allocator = typename alloc_traits::template rebind_alloc<ctrl_t>;
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = typename Policy::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = std::conditional_t<Const, value_type const*, value_type*>;
+      using reference = std::conditional_t<Const, value_type const&, value_type&>;
+
+      basic_iterator () noexcept = default;
+
+      template <bool C = Const, typename = std::enable_if_t<C>>
+      basic_iterator (basic_iterator<!C> const& it) noexcept : ctrl_ {it.ctrl_}, slot_ {it.slot_}
+      {}
+
+      reference operator* () const noexcept
+      {
+        return *slot_;
+      }
+
+      pointer operator-> () const noexcept
+      {
+        return slot_;
+      }
+
+      basic_iterator& operator++ () noexcept
+      {
+        ++ctrl_;
+        ++slot_;
+        skip_empty_or_deleted_();
+        return *this;
+      }
+
+      basic_iterator operator++ (int) noexcept
+      {
+        auto it = *this;
+        ++*this;
+        return it;
+      }
+
+      friend bool operator== (basic_iterator const& lhs, basic_iterator const& rhs) noexcept
+      {
+        return lhs.ctrl_ == rhs.ctrl_;
+      }
+
+      friend bool operator!= (basic_iterator const& lhs, basic_iterator const& rhs) noexcept
+      {
+        return lhs.ctrl_ != rhs.ctrl_;
+      }
+
+    private:
+      friend class flat_hash_table;
+      friend class basic_iterator<true>;
+
+      basic_iterator (ctrl_t const* ctrl, pointer slot) noexcept : ctrl_ {ctrl}, slot_ {slot}
+      {}
+
+      // the sentinel stops the loop, it is not less than itself
+      void skip_empty_or_deleted_ () noexcept
+      {
+        // loop invariant: the slots before ctrl_ are not full
+        while (*ctrl_ < ctrl_sentinel) {
+          ++ctrl_;
+          ++slot_;
+        }
+      }
+
+      ctrl_t const* ctrl_ {nullptr};
+      pointer slot_ {nullptr};
+    };
+
+  public:
+    using iterator = basic_iterator<Policy::constant_iterator>;
+    using const_iterator = basic_iterator<true>;
+
+    /**
+     * \brief Constructor with enough room for bucket_count items
+     * \precondition None
+     * \postcondition An empty table that does not rehash until it holds bucket_count items
+     * \complexity O(bucket_count)
+     * \param bucket_count The number of the items inserted without a rehash
+     * \param hash The hash of the keys
+     * \param equal The equality of the keys
+     * \param allocator The allocator of the items
+     */
+    explicit flat_hash_table (size_type bucket_count, hasher const& hash = hasher{},
+                              key_equal const& equal = key_equal{}, allocator_type const& allocator = allocator_type{})
+        : hash_ {hash}, equal_ {equal}, allocator_ {allocator}
+    {
+      reserve(bucket_count);
+    }
+
+    /**
+     * \brief Default constructor, it does not allocate
+     * \precondition None
+     * \postcondition An empty table with capacity 0
+     * \complexity O(1)
+     */
+    flat_hash_table () : flat_hash_table(0)
+    {}
+
+    /**
+     * \brief Constructor with the allocator
+     * \precondition None
+     * \postcondition An empty table that uses the allocator
+     * \complexity O(1)
+     * \param allocator The allocator of the items
+     */
+    explicit flat_hash_table (allocator_type const& allocator) : flat_hash_table(0, hasher{}, key_equal{}, allocator)
+    {}
+
+    /**
+     * \brief Constructor from the items of a range, an item whose key is already in the table is not inserted
+     * \precondition None
+     * \postcondition The table has the items of the range with different keys
+     * \complexity O(N) on average, where N is the number of the items of the range
+     * \tparam InputIt iterator type of the range
+     * \param first iterator to the first item
+     * \param last iterator past the last item
+     * \param bucket_count The number of the items inserted without a rehash
+     * \param hash The hash of the keys
+     * \param equal The equality of the keys
+     * \param allocator The allocator of the items
+     */
+    template <concepts::InputIterator InputIt>
+    flat_hash_table (InputIt first, InputIt last, size_type bucket_count = 0, hasher const& hash = hasher{},
+                     key_equal const& equal = key_equal{}, allocator_type const& allocator = allocator_type{})
+        : flat_hash_table(bucket_count, hash, equal, allocator)
+    {
+      insert(first, last);
+    }
+
+    /**
+     * \brief Constructor from an initializer list, an item whose key is already in the table is not inserted
+     * \precondition None
+     * \postcondition The table has the items of the list with different keys
+     * \complexity O(N) on average, where N is the number of the items of the list
+     * \param ilist The initializer list
+     * \param bucket_count The number of the items inserted without a rehash
+     * \param hash The hash of the keys
+     * \param equal The equality of the keys
+     * \param allocator The allocator of the items
+     */
+    flat_hash_table (std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                     hasher const& hash = hasher{}, key_equal const& equal = key_equal{},
+                     allocator_type const& allocator = allocator_type{})
+        : flat_hash_table(ilist.begin(), ilist.end(), bucket_count, hash, equal, allocator)
+    {}
+
+    /**
+     * \brief Copy constructor
+     * \details The items are inserted again in a table sized for them, the tombstones of rhs are not copied
+     * \precondition None
+     * \postcondition This table is equal to rhs
+     * \complexity O(N) on average
+     * \param rhs The table to be copied
+     */
+    flat_hash_table (flat_hash_table const& rhs)
+        : flat_hash_table(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
+
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \details The items are inserted again in a table sized for them, the tombstones of rhs are not copied
+     * \precondition None
+     * \postcondition This table is equal to rhs
+     * \complexity O(N) on average
+     * \param rhs The table to be copied
+     * \param allocator The allocator of the items
+     */
+    flat_hash_table (flat_hash_table const& rhs, allocator_type const& allocator)
+        : flat_hash_table(rhs.size_, rhs.hash_, rhs.equal_, allocator)
+    {
+      // the keys of rhs are different, they are placed without comparing them
+      for (auto const& value : rhs)
+        insert_unique_(hash_(Policy::key(value)), value);
+    }
+
+    /**
+     * \brief Move constructor
+     * \precondition None
+     * \postcondition This table has the items of rhs that becomes empty with capacity 0
+     * \complexity O(1)
+     * \param rhs The table to be moved
+     */
+    flat_hash_table (flat_hash_table&& rhs) noexcept
+        : hash_ {rhs.hash_}, equal_ {rhs.equal_}, allocator_ {rhs.allocator_}
+    {
+      swap_items_(rhs);
+    }
+
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The slots are stolen if the allocators are equal, otherwise the items are moved one by one
+     * into slots allocated with the provided allocator
+     * \precondition None
+     * \postcondition This table has the items of rhs that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) on average otherwise
+     * \param rhs The table to be moved
+     * \param allocator The allocator of the items
+     */
+    flat_hash_table (flat_hash_table&& rhs, allocator_type const& allocator)
+        : hash_ {rhs.hash_}, equal_ {rhs.equal_}, allocator_ {allocator}
+    {
+      if (allocator_ == rhs.allocator_) {
+        swap_items_(rhs);
+        return;
+      }
+
+      // the members are initialized, if a move throws the destructor releases the slots
+      reserve(rhs.size_);
+      for (size_type i = 0; i < rhs.capacity_; ++i)
+        if (rhs.ctrl_[i] >= 0)
+          insert_unique_(hash_(Policy::key(rhs.slots_[i])), std::move(rhs.slots_[i]));
+      rhs.clear();
+    }
+
+    /**
+     * \brief Copy assignment operator
+     * \details The items of this table are destroyed and replaced with copies of the items of rhs,
+     * the allocator is replaced only if it propagates on copy assignment
+     * \precondition None
+     * \postcondition This table is equal to rhs
+     * \complexity O(N) on average
+     * \param rhs The table to be copied
+     * \return This table
+     */
+    flat_hash_table& operator= (flat_hash_table const& rhs)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      flat_hash_table temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Move assignment operator
+     * \details The items of this table are destroyed and replaced with the items of rhs, the slots are stolen
+     * if the allocator propagates on move assignment or the allocators are equal, otherwise the items are moved
+     * one by one
+     * \precondition None
+     * \postcondition This table has the items of rhs that becomes empty
+     * \complexity O(N) to destroy the items of this table, O(N) on average to move the items one by one
+     * \param rhs The table to be moved
+     * \return This table
+     */
+    flat_hash_table& operator= (flat_hash_table&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      flat_hash_table temp {std::move(rhs), propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Destructor
+     * \complexity O(capacity)
+     */
+    ~flat_hash_table ()
+    {
+      destroy_items_();
+      deallocate_(ctrl_, slots_, capacity_);
+    }
+
+    iterator begin () noexcept
+    {
+      iterator it {ctrl_, slots_};
+      it.skip_empty_or_deleted_();
+      return it;
+    }
+
+    const_iterator begin () const noexcept
+    {
+      const_iterator it {ctrl_, slots_};
+      it.skip_empty_or_deleted_();
+      return it;
+    }
+
+    const_iterator cbegin () const noexcept
+    {
+      return begin();
+    }
+
+    iterator end () noexcept
+    {
+      return {ctrl_ + capacity_, nullptr};
+    }
+
+    const_iterator end () const noexcept
+    {
+      return {ctrl_ + capacity_, nullptr};
+    }
+
+    const_iterator cend () const noexcept
+    {
+      return end();
+    }
+
+    /**
+     * \brief The table is empty?
+     * \precondition None
+     * \postcondition Table is not changed
+     * \complexity O(1)
+     * \return True if the table is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return size_ == 0;
+    }
+
+    /**
+     * \brief The number of the items
+     * \precondition None
+     * \postcondition Table is not changed
+     * \complexity O(1)
+     * \return The number of the items in the table
+     */
+    size_type size () const noexcept
+    {
+      return size_;
+    }
+
+    /**
+     * \brief The number of the slots
+     * \precondition None
+     * \postcondition Table is not changed
+     * \complexity O(1)
+     * \return The number of the slots, 0 or a power of 2 minus 1
+     */
+    size_type capacity () const noexcept
+    {
+      return capacity_;
+    }
+
+    /**
+     * \brief The ratio of the items to the slots
+     * \precondition None
+     * \postcondition Table is not changed
+     * \complexity O(1)
+     * \return The load factor, 0 for a table without slots
+     */
+    float load_factor () const noexcept
+    {
+      return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+    }
+
+    /**
+     * \brief The load factor that makes the table grow, the items and the tombstones are counted
+     * \complexity O(1)
+     * \return 7/8
+     */
+    static constexpr float max_load_factor () noexcept
+    {
+      return 0.875f;
+    }
+
+    hasher hash_function () const
+    {
+      return hash_;
+    }
+
+    key_equal key_eq () const
+    {
+      return equal_;
+    }
+
+    allocator_type get_allocator () const
+    {
+      return allocator_;
+    }
+
+    /**
+     * \brief Removes all the items, the slots are kept
+     * \precondition None
+     * \postcondition The table is empty, the capacity is unchanged
+     * \complexity O(capacity)
+     */
+    void clear () noexcept
+    {
+      if (capacity_ == 0)
+        return;
+      destroy_items_();
+      reset_ctrl_(ctrl_, capacity_);
+      size_ = 0;
+      growth_left_ = capacity_to_growth_(capacity_);
+    }
+
+    /**
+     * \brief Makes room for count items without a rehash
+     * \precondition None
+     * \postcondition count items can be inserted without a rehash
+     * \complexity O(N) if the table rehashes, O(1) otherwise
+     * \param count The number of the items
+     */
+    void reserve (size_type count)
+    {
+      if (count > size_ + growth_left_)
+        resize_(normalize_capacity_(growth_to_capacity_(count)));
+    }
+
+    /**
+     * \brief Rehashes the items in a table with at least count slots, dropping the tombstones
+     * \precondition None
+     * \postcondition The capacity is at least count and the one needed by the items
+     * \complexity O(N) on average
+     * \param count The number of the slots
+     */
+    void rehash (size_type count)
+    {
+      auto capacity = normalize_capacity_(std::max(count, growth_to_capacity_(size_)));
+      if (capacity != 0 || capacity_ != 0)
+        resize_(capacity);
+    }
+
+    /**
+     * \brief Inserts an item if its key is not in the table
+     * \precondition None
+     * \postcondition The key of value is in the table
+     * \complexity O(1) on average
+     * \param value The item
+     * \return The iterator to the item with the key of value and true if value was inserted
+     */
+    std::pair<iterator, bool> insert (value_type const& value)
+    {
+      return emplace_key_(Policy::key(value), value);
+    }
+
+    std::pair<iterator, bool> insert (value_type&& value)
+    {
+      return emplace_key_(Policy::key(value), std::move(value));
+    }
+
+    /**
+     * \brief Inserts the items of a range whose keys are not in the table
+     * \precondition None
+     * \postcondition The keys of the items of the range are in the table
+     * \complexity O(N) on average, where N is the number of the items of the range
+     * \tparam InputIt iterator type of the range
+     * \param first iterator to the first item
+     * \param last iterator past the last item
+     */
+    template <concepts::InputIterator InputIt>
+    void insert (InputIt first, InputIt last)
+    {
+      if constexpr (concepts::ForwardIterator<InputIt>)
+        reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+      for (; first != last; ++first)
+        insert(*first);
+    }
+
+    void insert (std::initializer_list<value_type> ilist)
+    {
+      insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * \brief Constructs an item from the arguments and inserts it if its key is not in the table
+     * \details The item is constructed before the lookup, to find its key
+     * \precondition None
+     * \postcondition The key of the item is in the table
+     * \complexity O(1) on average
+     * \tparam Args types of the arguments
+     * \param args The arguments of the constructor of the item
+     * \return The iterator to the item with the key and true if the item was inserted
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace (Args&& ... args)
+    {
+      value_type value(std::forward<Args>(args)...);
+      return emplace_key_(Policy::key(value), std::move(value));
+    }
+
+    /**
+     * \brief The iterator to the item with the key
+     * \precondition None
+     * \postcondition Table is not changed
+     * \complexity O(1) on average
+     * \param key The key to look for
+     * \return The iterator to the item, end if the key is not in the table
+     */
+    iterator find (key_type const& key)
+    {
+      auto index = find_index_(key, hash_(key));
+      return index == npos ? end() : iterator_at_(index);
+    }
+
+    const_iterator find (key_type const& key) const
+    {
+      auto index = find_index_(key, hash_(key));
+      return index == npos ? end() : const_iterator{ctrl_ + index, slots_ + index};
+    }
+
+    /**
+     * \brief The key is in the table?
+     * \precondition None
+     * \postcondition Table is not changed
+     * \complexity O(1) on average
+     * \param key The key to look for
+     * \return True if an item has the key
+     */
+    bool contains (key_type const& key) const
+    {
+      return find_index_(key, hash_(key)) != npos;
+    }
+
+    size_type count (key_type const& key) const
+    {
+      return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * \brief Removes the item at the position
+     * \details The slot becomes empty if no probe sequence went past it, deleted otherwise
+     * \precondition position is a valid iterator of this table different from end
+     * \postcondition The item is removed, the other iterators are valid
+     * \complexity O(1) on average
+     * \param position The iterator to the item
+     * \return The iterator to the item after the one removed
+     */
+    iterator erase (const_iterator position)
+    {
+      auto index = static_cast<size_type>(position.ctrl_ - ctrl_);
+      erase_at_(index);
+      auto it = iterator_at_(index);
+      it.skip_empty_or_deleted_();
+      return it;
+    }
+
+    /**
+     * \brief Removes the item with the key
+     * \precondition None
+     * \postcondition The key is not in the table
+     * \complexity O(1) on average
+     * \param key The key of the item
+     * \return The number of the items removed, 0 or 1
+     */
+    size_type erase (key_type const& key)
+    {
+      auto index = find_index_(key, hash_(key));
+      if (index == npos)
+        return 0;
+      erase_at_(index);
+      return 1;
+    }
+
+    /**
+     * \brief Exchanges the contents of the table with those of rhs
+     * \details The allocators are exchanged only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
+     * \postcondition The table has the items of rhs and viceversa
+     * \complexity O(1)
+     * \param rhs The table to exchange
+     */
+    void swap (flat_hash_table& rhs) noexcept
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+    /**
+     * \brief Creates a vector with the items of the table
+     * \precondition None
+     * \postcondition Table is not changed
+     * \complexity O(capacity)
+     * \return A vector with the items in the order of the slots
+     */
+    std::vector<value_type> to_vector () const
+    {
+      return std::vector<value_type>(begin(), end());
+    }
+
+  protected:
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    // the index of the item with the key, npos if the key is not in the table
+    size_type find_index_ (key_type const& key, size_type hash) const
+    {
+      probe_sequence sequence {h1_(hash), capacity_};
+      // loop invariant: the groups visited have not the key and have not an empty slot
+      while (true) {
+        group g {ctrl_ + sequence.offset()};
+        for (auto match = g.match(h2_(hash)); match; match.clear_lowest()) {
+          auto index = sequence.offset(match.lowest());
+          if (equal_(Policy::key(slots_[index]), key))
+            return index;
+        }
+        if (g.match_empty())
+          return npos;
+        sequence.next();
+      }
+    }
+
+    // the item constructed from args is inserted if the key is not in the table, key is not used after that
+    template <typename... Args>
+    std::pair<iterator, bool> emplace_key_ (key_type const& key, Args&& ... args)
+    {
+      auto hash = hash_(key);
+      auto index = find_index_(key, hash);
+      if (index != npos)
+        return {iterator_at_(index), false};
+      return {iterator_at_(insert_unique_(hash, std::forward<Args>(args)...)), true};
+    }
+
+    // the item constructed from args, whose key is not in the table, is inserted
+    template <typename... Args>
+    size_type insert_unique_ (size_type hash, Args&& ... args)
+    {
+      auto index = find_first_non_full_(hash);
+      if (growth_left_ == 0 && ctrl_[index] != ctrl_deleted) {
+        rehash_and_grow_();
+        index = find_first_non_full_(hash);
+      }
+      alloc_traits::construct(allocator_, slots_ + index, std::forward<Args>(args)...);
+      ++size_;
+      growth_left_ -= ctrl_[index] == ctrl_empty ? 1 : 0;
+      set_ctrl_(ctrl_, capacity_, index, h2_(hash));
+      return index;
+    }
+
+    iterator iterator_at_ (size_type index) noexcept
+    {
+      return {ctrl_ + index, slots_ + index};
+    }
+
+  private:
+    static size_type h1_ (size_type hash) noexcept
+    {
+      return hash >> 7;
+    }
+
+    static ctrl_t h2_ (size_type hash) noexcept
+    {
+      return static_cast<ctrl_t>(hash & 0x7f);
+    }
+
+    // the number of the items that fill a table of capacity slots, one slot of a group is always empty
+    static size_type capacity_to_growth_ (size_type capacity) noexcept
+    {
+      if (group::width == 8 && capacity == 7)
+        return 6;
+      return capacity - capacity / 8;
+    }
+
+    // the least capacity that holds growth items
+    static size_type growth_to_capacity_ (size_type growth) noexcept
+    {
+      if (group::width == 8 && growth == 7)
+        return 8;
+      return growth == 0 ? 0 : growth + (growth - 1) / 7;
+    }
+
+    // the least power of 2 minus 1 not less than capacity
+    static size_type normalize_capacity_ (size_type capacity) noexcept
+    {
+      return capacity == 0 ? 0 : std::numeric_limits<size_type>::max() >> leading_zeros(capacity);
+    }
+
+    // the control byte of a slot and its copy after the sentinel
+    static void set_ctrl_ (ctrl_t* ctrl, size_type capacity, size_type index, ctrl_t h) noexcept
+    {
+      constexpr auto cloned = group::width - 1;
+      ctrl[index] = h;
+      ctrl[((index - cloned) & capacity) + (cloned & capacity)] = h;
+    }
+
+    static void reset_ctrl_ (ctrl_t* ctrl, size_type capacity) noexcept
+    {
+      std::memset(ctrl, static_cast<unsigned char>(ctrl_empty), capacity + group::width);
+      ctrl[capacity] = ctrl_sentinel;
+    }
+
+    // the first slot empty or deleted in the probe sequence of hash
+    size_type find_first_non_full_ (size_type hash) const noexcept
+    {
+      probe_sequence sequence {h1_(hash), capacity_};
+      // loop invariant: the groups visited are full
+      while (true) {
+        auto match = group{ctrl_ + sequence.offset()}.match_empty_or_deleted();
+        if (match)
+          return sequence.offset(match.lowest());
+        sequence.next();
+      }
+    }
+
+    void erase_at_ (size_type index) noexcept
+    {
+      alloc_traits::destroy(allocator_, slots_ + index);
+      --size_;
+      // the slot was never seen full by a probe if no run of group::width full or deleted slots covers it
+      auto before = (index - group::width) & capacity_;
+      auto empty_after = group{ctrl_ + index}.match_empty();
+      auto empty_before = group{ctrl_ + before}.match_empty();
+      auto never_full = empty_before && empty_after
+                        && empty_after.trailing_empty() + empty_before.leading_empty() < group::width;
+      set_ctrl_(ctrl_, capacity_, index, never_full ? ctrl_empty : ctrl_deleted);
+      growth_left_ += never_full ? 1 : 0;
+    }
+
+    void rehash_and_grow_ ()
+    {
+      if (capacity_ > group::width && size_ * 32 <= capacity_ * 25)
+        resize_(capacity_);
+      else
+        resize_(capacity_ * 2 + 1);
+    }
+
+    // the items are moved in new slots, if a move can throw they are copied and the table is unchanged on failure
+    void resize_ (size_type capacity)
+    {
+      if (capacity == 0) {
+        assert(size_ == 0);
+        deallocate_(ctrl_, slots_, capacity_);
+        ctrl_ = const_cast<ctrl_t*>(empty_group);
+        slots_ = nullptr;
+        capacity_ = growth_left_ = 0;
+        return;
+      }
+
+      ctrl_allocator ctrl_alloc {allocator_};
+      auto ctrl = allocate_storage(ctrl_alloc, capacity + group::width);
+      value_type* slots;
+      try {
+        slots = allocate_storage(allocator_, capacity);
+      }
+      catch (...) {
+        deallocate_storage(ctrl_alloc, ctrl, capacity + group::width);
+        throw;
+      }
+      reset_ctrl_(ctrl, capacity);
+
+      try {
+        // loop invariant: the full slots before i are in the new slots
+        for (size_type i = 0; i < capacity_; ++i) {
+          if (ctrl_[i] < 0)
+            continue;
+          auto hash = hash_(Policy::key(slots_[i]));
+          probe_sequence sequence {h1_(hash), capacity};
+          auto match = group{ctrl + sequence.offset()}.match_empty_or_deleted();
+          // loop invariant: the groups visited are full
+          while (!match) {
+            sequence.next();
+            match = group{ctrl + sequence.offset()}.match_empty_or_deleted();
+          }
+          auto index = sequence.offset(match.lowest());
+          alloc_traits::construct(allocator_, slots + index, std::move_if_noexcept(slots_[i]));
+          set_ctrl_(ctrl, capacity, index, h2_(hash));
+        }
+      }
+      catch (...) {
+        for (size_type i = 0; i < capacity; ++i)
+          if (ctrl[i] >= 0)
+            alloc_traits::destroy(allocator_, slots + i);
+        deallocate_storage(ctrl_alloc, ctrl, capacity + group::width);
+        deallocate_storage(allocator_, slots, capacity);
+        throw;
+      }
+
+      destroy_items_();
+      deallocate_(ctrl_, slots_, capacity_);
+      ctrl_ = ctrl;
+      slots_ = slots;
+      capacity_ = capacity;
+      growth_left_ = capacity_to_growth_(capacity) - size_;
+    }
+
+    // the slots, the counts, the hash and the equality are exchanged, the allocators are not
+    void swap_items_ (flat_hash_table& rhs) noexcept
+    {
+      using std::swap;
+      swap(ctrl_, rhs.ctrl_);
+      swap(slots_, rhs.slots_);
+      swap(capacity_, rhs.capacity_);
+      swap(size_, rhs.size_);
+      swap(growth_left_, rhs.growth_left_);
+      swap(hash_, rhs.hash_);
+      swap(equal_, rhs.equal_);
+    }
+
+    void destroy_items_ () noexcept
+    {
+      if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        for (size_type i = 0; i < capacity_; ++i)
+          if (ctrl_[i] >= 0)
+            alloc_traits::destroy(allocator_, slots_ + i);
+      }
+    }
+
+    void deallocate_ (ctrl_t* ctrl, value_type* slots, size_type capacity) noexcept
+    {
+      if (capacity == 0)
+        return;
+      ctrl_allocator ctrl_alloc {allocator_};
+      deallocate_storage(ctrl_alloc, ctrl, capacity + group::width);
+      deallocate_storage(allocator_, slots, capacity);
+    }
+
+    ctrl_t* ctrl_ {const_cast<ctrl_t*>(empty_group)};
+    value_type* slots_ {nullptr};
+    size_type capacity_ {0};
+    size_type size_ {0};
+    size_type growth_left_ {0};
+    hasher hash_;
+    key_equal equal_;
+    allocator_type allocator_;
+  };
+}
+
+#endif //ALGOL_DS_FLAT_HASH_TABLE_HPP
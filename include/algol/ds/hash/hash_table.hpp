@@ -0,0 +1,41 @@
+/**
+ * \file
+ * Hash table errors
+ * A hash table is an unordered collection of items looked up by their key, the position of an item is given by
+ * the hash of its key
+ */
+
+#ifndef ALGOL_DS_HASH_TABLE_HPP
+#define ALGOL_DS_HASH_TABLE_HPP
+
+#include <stdexcept>
+#include <string>
+
+namespace algol::ds {
+  /**
+   * \brief Base hash table exception.
+   * \details Can be used to catch every hash table exceptions.
+   */
+  struct hash_table_error : public virtual std::logic_error {
+#if defined(__clang__)
+    using std::logic_error::logic_error;
+#else
+
+    explicit hash_table_error (std::string const& what_arg) : std::logic_error {what_arg}
+    {}
+
+#endif
+  };
+
+  /**
+   * \brief Throwed when the key is not in the hash table.
+   * \details Throwed from at operation.
+   */
+  struct key_not_found_error : public hash_table_error {
+    explicit key_not_found_error (std::string const& what_arg) : std::logic_error {what_arg},
+                                                                 hash_table_error {what_arg}
+    {}
+  };
+}
+
+#endif //ALGOL_DS_HASH_TABLE_HPP
@@ -0,0 +1,138 @@
+/**
+ * \file
+ * MurmurHash3 for the hash tables
+ */
+
+#ifndef ALGOL_DS_MURMUR3_HPP
+#define ALGOL_DS_MURMUR3_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace algol::ds {
+  /**
+   * \brief MurmurHash3 x86_32 of the bytes at key
+   * \details The runtime version of cx::murmur3_32 of lib/constexpr: the blocks are read 4 bytes at a time with
+   * one load and the loop is not recursive. The tail bytes are taken as unsigned like the reference
+   * implementation, cx::murmur3_32 sign extends them, the two agree on the strings of ASCII characters.
+   * \precondition key points to len readable bytes
+   * \complexity O(len)
+   * \param key The bytes to hash
+   * \param len The number of the bytes
+   * \param seed The seed of the hash
+   * \return The 32 bits hash
+   */
+  inline std::uint32_t murmur3_32 (void const* key, std::size_t len, std::uint32_t seed = 0) noexcept
+  {
+    constexpr std::uint32_t c1 = 0xcc9e2d51;
+    constexpr std::uint32_t c2 = 0x1b873593;
+    auto rotl = [] (std::uint32_t x, int r) {
+      return (x << r) | (x >> (32 - r));
+    };
+    auto mix = [c1, c2, rotl] (std::uint32_t k) {
+      return rotl(k * c1, 15) * c2;
+    };
+
+    auto bytes = static_cast<unsigned char const*>(key);
+    auto hash = seed;
+    auto blocks = len / 4;
+    // loop invariant: hash has been combined with the blocks before i
+    for (std::size_t i = 0; i < blocks; ++i) {
+      std::uint32_t k;
+      std::memcpy(&k, bytes + 4 * i, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      k = __builtin_bswap32(k);
+#endif
+      hash = rotl(hash ^ mix(k), 13) * 5 + 0xe6546b64;
+    }
+
+    auto tail = bytes + 4 * blocks;
+    std::uint32_t k = 0;
+    switch (len & 3) {
+      case 3:
+        k ^= static_cast<std::uint32_t>(tail[2]) << 16;
+        [[fallthrough]];
+      case 2:
+        k ^= static_cast<std::uint32_t>(tail[1]) << 8;
+        [[fallthrough]];
+      case 1:
+        k ^= static_cast<std::uint32_t>(tail[0]);
+        hash ^= mix(k);
+    }
+
+    hash ^= static_cast<std::uint32_t>(len);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+  }
+
+  /**
+   * \brief The 64 bits finalizer of MurmurHash3
+   * \details A bijection whose output bits depend on all the input bits, it turns an integer in a hash whose
+   * low and high bits can be used to index a table
+   * \complexity O(1)
+   * \param k The value to mix
+   * \return The mixed value
+   */
+  constexpr std::uint64_t murmur3_fmix64 (std::uint64_t k) noexcept
+  {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+  }
+
+  /**
+   * \brief The default hash of the flat hash tables
+   * \details The integers, the enumerations and the pointers are mixed with murmur3_fmix64, the strings are
+   * hashed with murmur3_32 and mixed to spread the 32 bits on the whole std::size_t, the floating point values
+   * are hashed by their bits with -0.0 equal to 0.0. Any other key is hashed by std::hash and then mixed, so a
+   * std::hash that is the identity, as the one of the integers of the standard libraries, still fills the
+   * control bytes of the table with different values.
+   * \tparam Key type of the keys
+   */
+  template <typename Key>
+  struct murmur3_hash {
+    std::size_t operator() (Key const& key) const noexcept(noexcept(std::hash<Key>{}(key)))
+    {
+      if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key>)
+        return static_cast<std::size_t>(murmur3_fmix64(static_cast<std::uint64_t>(key)));
+      else if constexpr (std::is_pointer_v<Key>)
+        return static_cast<std::size_t>(murmur3_fmix64(reinterpret_cast<std::uintptr_t>(key)));
+      else if constexpr (std::is_floating_point_v<Key>) {
+        auto value = key == Key{} ? Key{} : key;
+        return static_cast<std::size_t>(murmur3_fmix64(murmur3_32(&value, sizeof(Key))));
+      }
+      else
+        return static_cast<std::size_t>(murmur3_fmix64(std::hash<Key>{}(key)));
+    }
+  };
+
+  template <typename CharT, typename Traits, typename Allocator>
+  struct murmur3_hash<std::basic_string<CharT, Traits, Allocator>> {
+    std::size_t operator() (std::basic_string<CharT, Traits, Allocator> const& key) const noexcept
+    {
+      return static_cast<std::size_t>(murmur3_fmix64(murmur3_32(key.data(), key.size() * sizeof(CharT))));
+    }
+  };
+
+  template <typename CharT, typename Traits>
+  struct murmur3_hash<std::basic_string_view<CharT, Traits>> {
+    std::size_t operator() (std::basic_string_view<CharT, Traits> key) const noexcept
+    {
+      return static_cast<std::size_t>(murmur3_fmix64(murmur3_32(key.data(), key.size() * sizeof(CharT))));
+    }
+  };
+}
+
+#endif //ALGOL_DS_MURMUR3_HPP
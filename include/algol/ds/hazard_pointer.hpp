@@ -0,0 +1,254 @@
+/**
+ * \file
+ * Hazard pointers for the safe memory reclamation of the lock-free data structures.
+ */
+
+#ifndef ALGOL_DS_HAZARD_POINTER_HPP
+#define ALGOL_DS_HAZARD_POINTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "algol/ds/cache_line.hpp"
+
+namespace algol::ds {
+  namespace detail {
+    struct retired_pointer {
+      void* pointer;
+      void (* deleter) (void*);
+    };
+
+    // a published hazard pointer, owned by one thread at a time
+    struct alignas(cache_line_size) hazard_record {
+      std::atomic<void*> pointer {nullptr};
+      std::atomic<bool> active {true};
+      hazard_record* next {nullptr};
+    };
+
+    /**
+     * \brief The hazard records of the program and the retired pointers left by the exited threads
+     * \details The records are never freed while the program runs, an exited thread gives them back
+     * to be reused by the other threads.
+     */
+    class hazard_domain {
+    public:
+      static hazard_domain& instance ()
+      {
+        static hazard_domain domain;
+        return domain;
+      }
+
+      hazard_domain (hazard_domain const&) = delete;
+      hazard_domain& operator= (hazard_domain const&) = delete;
+
+      ~hazard_domain ()
+      {
+        for (auto const& r : orphans_)
+          r.deleter(r.pointer);
+        for (auto record = head_.load(std::memory_order_acquire); record != nullptr;) {
+          auto next = record->next;
+          delete record;
+          record = next;
+        }
+      }
+
+      hazard_record* acquire ()
+      {
+        for (auto record = head_.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+          auto active = false;
+          if (!record->active.load(std::memory_order_relaxed)
+              && record->active.compare_exchange_strong(active, true, std::memory_order_acquire))
+            return record;
+        }
+
+        auto record = new hazard_record;
+        record->next = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                            std::memory_order_relaxed));
+        records_.fetch_add(1, std::memory_order_relaxed);
+        return record;
+      }
+
+      void release (hazard_record* record) noexcept
+      {
+        record->pointer.store(nullptr, std::memory_order_release);
+        record->active.store(false, std::memory_order_release);
+      }
+
+      std::size_t records () const noexcept
+      {
+        return records_.load(std::memory_order_relaxed);
+      }
+
+      // delete the retired pointers that no thread protects, the others are left in retired
+      void reclaim (std::vector<retired_pointer>& retired)
+      {
+        if (has_orphans_.load(std::memory_order_acquire)) {
+          std::lock_guard<std::mutex> lock {orphans_mutex_};
+          retired.insert(std::end(retired), std::begin(orphans_), std::end(orphans_));
+          orphans_.clear();
+          has_orphans_.store(false, std::memory_order_relaxed);
+        }
+
+        std::vector<void*> hazards;
+        for (auto record = head_.load(std::memory_order_acquire); record != nullptr; record = record->next)
+          if (auto pointer = record->pointer.load(std::memory_order_seq_cst))
+            hazards.push_back(pointer);
+        std::sort(std::begin(hazards), std::end(hazards));
+
+        auto protected_end = std::partition(std::begin(retired), std::end(retired), [&hazards] (auto const& r) {
+          return std::binary_search(std::begin(hazards), std::end(hazards), r.pointer);
+        });
+        for (auto r = protected_end; r != std::end(retired); ++r)
+          r->deleter(r->pointer);
+        retired.erase(protected_end, std::end(retired));
+      }
+
+      // keep the retired pointers still protected when their thread exits
+      void orphan (std::vector<retired_pointer>& retired)
+      {
+        if (retired.empty())
+          return;
+
+        std::lock_guard<std::mutex> lock {orphans_mutex_};
+        orphans_.insert(std::end(orphans_), std::begin(retired), std::end(retired));
+        has_orphans_.store(true, std::memory_order_release);
+        retired.clear();
+      }
+
+    private:
+      hazard_domain () = default;
+
+      std::atomic<hazard_record*> head_ {nullptr};
+      std::atomic<std::size_t> records_ {0};
+      std::atomic<bool> has_orphans_ {false};
+      std::mutex orphans_mutex_;
+      std::vector<retired_pointer> orphans_;
+    };
+
+    // the records owned and the pointers retired by the calling thread
+    class hazard_thread {
+    public:
+      static hazard_thread& local ()
+      {
+        thread_local hazard_thread thread;
+        return thread;
+      }
+
+      hazard_thread (hazard_thread const&) = delete;
+      hazard_thread& operator= (hazard_thread const&) = delete;
+
+      ~hazard_thread ()
+      {
+        auto& domain = hazard_domain::instance();
+        domain.reclaim(retired_);
+        domain.orphan(retired_);
+        for (auto record : records_)
+          domain.release(record);
+      }
+
+      hazard_record* acquire ()
+      {
+        if (records_.empty())
+          return hazard_domain::instance().acquire();
+
+        auto record = records_.back();
+        records_.pop_back();
+        return record;
+      }
+
+      void release (hazard_record* record)
+      {
+        records_.push_back(record);
+      }
+
+      void retire (retired_pointer pointer)
+      {
+        retired_.push_back(pointer);
+        // the scan is amortized over a number of retired pointers proportional to the hazard pointers
+        auto& domain = hazard_domain::instance();
+        if (retired_.size() >= 2 * domain.records() + retire_threshold)
+          domain.reclaim(retired_);
+      }
+
+    private:
+      hazard_thread () = default;
+
+      static constexpr std::size_t retire_threshold = 64;
+
+      std::vector<hazard_record*> records_;
+      std::vector<retired_pointer> retired_;
+    };
+  }
+
+  /**
+   * \brief A pointer that the calling thread is going to dereference and no other thread can delete
+   * \details The thread publishes the pointer it loads from a shared location and loads the location again:
+   * if the pointer did not change it cannot be deleted until the hazard pointer is reset, because a pointer is
+   * deleted only after it has been removed from the shared location and [retired](@ref retire),
+   * and the retired pointers are deleted only when no hazard pointer publishes them.
+   * Since a protected node cannot be deleted it cannot be reused either, so a compare and swap on a protected
+   * pointer does not suffer the ABA problem.
+   * A hazard_pointer is owned by the thread that creates it.
+   * \note see Michael "Hazard Pointers: Safe Memory Reclamation for Lock-Free Objects" IEEE TPDS 2004
+   */
+  class hazard_pointer {
+  public:
+    hazard_pointer () : record_ {detail::hazard_thread::local().acquire()}
+    {}
+
+    hazard_pointer (hazard_pointer const&) = delete;
+    hazard_pointer& operator= (hazard_pointer const&) = delete;
+
+    ~hazard_pointer ()
+    {
+      reset();
+      detail::hazard_thread::local().release(record_);
+    }
+
+    /**
+     * \brief Load the pointer stored in source and protect it
+     * \complexity O(1) if source does not change
+     * \param source The shared location
+     * \return The pointer loaded, it can be dereferenced until the hazard pointer is reset or protects another one
+     */
+    template <typename T>
+    T* protect (std::atomic<T*> const& source) noexcept
+    {
+      auto pointer = source.load(std::memory_order_relaxed);
+      for (;;) {
+        record_->pointer.store(pointer, std::memory_order_seq_cst);
+        auto current = source.load(std::memory_order_seq_cst);
+        if (current == pointer)
+          return pointer;
+        pointer = current;
+      }
+    }
+
+    /**
+     * \brief Stop protecting the pointer
+     */
+    void reset () noexcept
+    {
+      record_->pointer.store(nullptr, std::memory_order_release);
+    }
+
+  private:
+    detail::hazard_record* record_;
+  };
+
+  /**
+   * \brief Delete pointer as soon as no hazard pointer protects it
+   * \details The pointer must be no longer reachable from the shared locations
+   * \tparam T type of the object pointed
+   * \param pointer The pointer to be deleted
+   */
+  template <typename T>
+  void retire (T* pointer)
+  {
+    detail::hazard_thread::local().retire({pointer, [] (void* p) { delete static_cast<T*>(p); }});
+  }
+}
+
+#endif //ALGOL_DS_HAZARD_POINTER_HPP
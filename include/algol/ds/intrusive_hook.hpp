@@ -0,0 +1,303 @@
+/**
+ * \file
+ * Link hook of the intrusive containers and the singly linked list they are built on.
+ */
+
+#ifndef ALGOL_DS_INTRUSIVE_HOOK_HPP
+#define ALGOL_DS_INTRUSIVE_HOOK_HPP
+
+#include <cassert>
+#include <cstddef>
+
+namespace algol::ds {
+  namespace detail {
+    template <typename Tag>
+    class intrusive_list;
+  }
+
+  /**
+   * \brief The link embedded in the items of the intrusive containers
+   * \details A type is stored in an [intrusive_stack](@ref intrusive_stack) or an
+   * [intrusive_queue](@ref intrusive_queue) with the same Tag by deriving publicly from intrusive_hook<Tag>,
+   * deriving from hooks with different tags an object can be linked in many containers at the same time.
+   * The hook is created unlinked and copying or assigning an object does not copy its link.
+   * In debug builds the hook records the container it is linked in and the destruction of a linked hook
+   * is asserted.
+   * \tparam Tag type that tells apart the hooks of the same object
+   */
+  template <typename Tag = void>
+  class intrusive_hook {
+  public:
+    /**
+     * \brief Default constructor
+     * \postcondition The hook is not linked
+     */
+    intrusive_hook () noexcept = default;
+
+    /**
+     * \brief Copy constructor
+     * \details The link is not copied
+     * \postcondition The hook is not linked
+     */
+    intrusive_hook (intrusive_hook const&) noexcept
+    {}
+
+    /**
+     * \brief Assignment operator
+     * \details The link is not copied, this hook stays in its container
+     * \return This hook
+     */
+    intrusive_hook& operator= (intrusive_hook const&) noexcept
+    {
+      return *this;
+    }
+
+    /**
+     * \brief Destructor
+     * \precondition The hook is not linked, the item has been removed from its container
+     */
+    ~intrusive_hook ()
+    {
+      assert(!is_linked() && "an item is destroyed while it is linked in an intrusive container");
+    }
+
+    /**
+     * \brief The item is linked in a container?
+     * \complexity O(1)
+     * \return True if the item is linked in a container, false otherwise
+     */
+    bool is_linked () const noexcept
+    {
+      return next_ != this;
+    }
+
+  private:
+    friend class detail::intrusive_list<Tag>;
+
+    // this when unlinked, nullptr for the last item of a list
+    intrusive_hook* next_ {this};
+#ifndef NDEBUG
+    void const* owner_ {nullptr};
+#endif
+  };
+
+  namespace detail {
+    /**
+     * \brief Singly linked list of hooks with a pointer to the last hook
+     * \details The list does not own the items, it only relinks their hooks: pushing, popping and splicing
+     * never allocate and are O(1), clearing unlinks every hook and is O(N).
+     * In debug builds every hook records the list it is linked in, the moves and the splices update the
+     * records so they are O(N).
+     * \tparam Tag the tag of the hooks
+     */
+    template <typename Tag>
+    class intrusive_list {
+    public:
+      using hook = intrusive_hook<Tag>;
+      using size_type = std::size_t;
+
+      intrusive_list () noexcept = default;
+
+      intrusive_list (intrusive_list const&) = delete;
+      intrusive_list& operator= (intrusive_list const&) = delete;
+
+      intrusive_list (intrusive_list&& rhs) noexcept
+          : head_ {rhs.head_}, tail_ {rhs.tail_}, size_ {rhs.size_}
+      {
+        rhs.reset_();
+        adopt_(head_);
+      }
+
+      intrusive_list& operator= (intrusive_list&& rhs) noexcept
+      {
+        if (this != &rhs) {
+          clear();
+          head_ = rhs.head_;
+          tail_ = rhs.tail_;
+          size_ = rhs.size_;
+          rhs.reset_();
+          adopt_(head_);
+        }
+        return *this;
+      }
+
+      ~intrusive_list ()
+      {
+        clear();
+      }
+
+      bool empty () const noexcept
+      {
+        return head_ == nullptr;
+      }
+
+      size_type size () const noexcept
+      {
+        return size_;
+      }
+
+      hook& front () const noexcept
+      {
+        assert(!empty());
+        assert(owns_(*head_));
+
+        return *head_;
+      }
+
+      void push_front (hook& h) noexcept
+      {
+        assert(!h.is_linked() && "the item is already linked in an intrusive container");
+
+        h.next_ = head_;
+        head_ = &h;
+        if (tail_ == nullptr)
+          tail_ = &h;
+        ++size_;
+        own_(h);
+      }
+
+      void push_back (hook& h) noexcept
+      {
+        assert(!h.is_linked() && "the item is already linked in an intrusive container");
+
+        h.next_ = nullptr;
+        if (tail_ != nullptr)
+          tail_->next_ = &h;
+        else
+          head_ = &h;
+        tail_ = &h;
+        ++size_;
+        own_(h);
+      }
+
+      hook& pop_front () noexcept
+      {
+        assert(!empty());
+        assert(owns_(*head_));
+
+        auto h = head_;
+        head_ = h->next_;
+        if (head_ == nullptr)
+          tail_ = nullptr;
+        --size_;
+        unlink_(*h);
+        return *h;
+      }
+
+      // the items of rhs are linked before the items of this list, rhs becomes empty
+      void splice_front (intrusive_list& rhs) noexcept
+      {
+        assert(this != &rhs);
+
+        if (rhs.empty())
+          return;
+        adopt_(rhs.head_);
+        rhs.tail_->next_ = head_;
+        head_ = rhs.head_;
+        if (tail_ == nullptr)
+          tail_ = rhs.tail_;
+        size_ += rhs.size_;
+        rhs.reset_();
+      }
+
+      // the items of rhs are linked after the items of this list, rhs becomes empty
+      void splice_back (intrusive_list& rhs) noexcept
+      {
+        assert(this != &rhs);
+
+        if (rhs.empty())
+          return;
+        adopt_(rhs.head_);
+        if (tail_ != nullptr)
+          tail_->next_ = rhs.head_;
+        else
+          head_ = rhs.head_;
+        tail_ = rhs.tail_;
+        size_ += rhs.size_;
+        rhs.reset_();
+      }
+
+      void clear () noexcept
+      {
+        while (head_ != nullptr) {
+          // loop invariant
+          // the hooks before head_ are unlinked, the ones from head_ on are still linked in order
+          auto next = head_->next_;
+          unlink_(*head_);
+          head_ = next;
+        }
+        tail_ = nullptr;
+        size_ = size_type{0};
+      }
+
+      void swap (intrusive_list& rhs) noexcept
+      {
+        auto head = head_;
+        auto tail = tail_;
+        auto size = size_;
+        head_ = rhs.head_;
+        tail_ = rhs.tail_;
+        size_ = rhs.size_;
+        rhs.head_ = head;
+        rhs.tail_ = tail;
+        rhs.size_ = size;
+        adopt_(head_);
+        rhs.adopt_(rhs.head_);
+      }
+
+      template <typename F>
+      void for_each (F f) const
+      {
+        for (auto h = head_; h != nullptr; h = h->next_)
+          f(*h);
+      }
+
+    private:
+      void reset_ () noexcept
+      {
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = size_type{0};
+      }
+
+      static void unlink_ (hook& h) noexcept
+      {
+        h.next_ = &h;
+#ifndef NDEBUG
+        h.owner_ = nullptr;
+#endif
+      }
+
+      void own_ ([[maybe_unused]] hook& h) const noexcept
+      {
+#ifndef NDEBUG
+        h.owner_ = this;
+#endif
+      }
+
+      bool owns_ ([[maybe_unused]] hook const& h) const noexcept
+      {
+#ifndef NDEBUG
+        return h.owner_ == this;
+#else
+        return true;
+#endif
+      }
+
+      // record this list as the owner of the hooks starting at first, only in debug builds
+      void adopt_ ([[maybe_unused]] hook* first) const noexcept
+      {
+#ifndef NDEBUG
+        for (auto h = first; h != nullptr; h = h->next_)
+          h->owner_ = this;
+#endif
+      }
+
+      hook* head_ {nullptr};
+      hook* tail_ {nullptr};
+      size_type size_ {0};
+    };
+  }
+}
+
+#endif //ALGOL_DS_INTRUSIVE_HOOK_HPP
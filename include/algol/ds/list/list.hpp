@@ -1,21 +1,1065 @@
 /**
  * \file
  * List ADT
+ * The nodes of the list live in chunks of contiguous storage and are linked with 32-bit indices instead of
+ * pointers, the node i is the slot i % ChunkSize of the chunk i / ChunkSize. The slots of the erased items go on
+ * a free list and are reused by the next insertions, so a list that is only appended to is traversed in the
+ * order of the memory. After many insertions and erasures in the middle compact() moves the items back in
+ * traversal order.
  */
 
 #ifndef ALGOL_DS_LIST_HPP
 #define ALGOL_DS_LIST_HPP
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "algol/ds/allocator.hpp"
+#include "stl2/concepts.hpp"
+
 namespace algol::ds {
-  template <typename T>
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Base list exception.
+   * \details Can be used to catch every list exceptions.
+   */
+  struct list_error : public virtual std::logic_error {
+#if defined(__clang__)
+    using std::logic_error::logic_error;
+#else
+
+    explicit list_error (std::string const& what_arg) : std::logic_error {what_arg}
+    {}
+
+#endif
+  };
+
+  /**
+   * \brief Throwed when the list is empty.
+   * \details Throwed from front, back, pop_front and pop_back operation.
+   */
+  struct list_empty_error : public list_error {
+    explicit list_empty_error (std::string const& what_arg) : std::logic_error {what_arg},
+                                                              list_error {what_arg}
+    {}
+  };
+
+  /**
+   * \brief Doubly linked list whose nodes are stored in chunks and linked by 32-bit indices
+   * \details The iterators are bidirectional and they stay valid until their item is erased as the ones of
+   * std::list, except that compact() invalidates every iterator and the iterators refer to the list object,
+   * so they do not follow the items when the list is moved or swapped
+   * \tparam T type of the items stored in the list
+   * \tparam ChunkSize number of nodes of a chunk, a power of two
+   * \tparam Allocator allocator of the items, the chunks are allocated with it rebound to the node type
+   * \invariant The items are linked from head to tail in the list order, the slots not used are on the free list
+   * or after the last slot ever used
+   */
+  template <concepts::CopyConstructible T, std::size_t ChunkSize = 256, typename Allocator = std::allocator<T>>
   class list {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "the chunk size is a power of two");
+
+    template <bool Const>
+    class iterator_;
+
   public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+    using index_type = std::uint32_t;
+    using iterator = iterator_<false>;
+    using const_iterator = iterator_<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The list is empty, no chunk is allocated
+     * \complexity O(1)
+     */
+    list () : list(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty list whose chunks are allocated with the provided allocator
+     * \precondition None
+     * \postcondition The list is empty, no chunk is allocated
+     * \complexity O(1)
+     * \param allocator The allocator of the items
+     */
+    explicit list (allocator_type const& allocator)
+        : allocator_ {allocator}, chunks_ {chunk_table_allocator{allocator}}, head_ {npos}, tail_ {npos},
+          free_ {npos}, used_ {0}, items_ {0}
+    {}
+
+    /**
+     * \brief Construct a list with the items of the range [first, last)
+     * \precondition last should be reachable from first otherwise undefined behavior
+     * \postcondition The list contains the items of the range in the same order
+     * \complexity O(N)
+     * \param first iterator to the first item of the range
+     * \param last iterator to the one past last item of the range
+     * \param allocator The allocator of the items
+     */
+    template <concepts::InputIterator InputIt>
+    list (InputIt first, InputIt last, allocator_type const& allocator = allocator_type{}) : list(allocator)
+    {
+      // the delegating constructor has completed, if a copy throws the destructor releases the chunks
+      insert(cend(), first, last);
+    }
+
+    /**
+     * \brief Construct a list with the values provided
+     * \precondition None
+     * \postcondition The list contains the values of the initializer_list in the same order
+     * \complexity O(N)
+     * \param values The items of the list
+     * \param allocator The allocator of the items
+     */
+    list (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : list(values.begin(), values.end(), allocator)
+    {}
+
+    /**
+     * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction,
+     * the copy is compact: its items are stored in traversal order
+     * \precondition None
+     * \postcondition This list is equal to the provided list
+     * \complexity O(N)
+     * \param rhs The list to be copied
+     */
+    list (list const& rhs) : list(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
+
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \precondition None
+     * \postcondition This list is equal to the provided list
+     * \complexity O(N)
+     * \param rhs The list to be copied
+     * \param allocator The allocator of the items
+     */
+    list (list const& rhs, allocator_type const& allocator) : list(allocator)
+    {
+      reserve(rhs.size());
+      insert(cend(), rhs.begin(), rhs.end());
+    }
+
+    /**
+     * \brief Move constructor
+     * \precondition None
+     * \postcondition This list is equal to the provided list that becomes empty, the iterators of rhs are invalid
+     * \complexity O(1)
+     * \param rhs The list to be moved
+     */
+    list (list&& rhs) noexcept
+        : allocator_ {rhs.allocator_}, chunks_ {std::move(rhs.chunks_)}, head_ {rhs.head_}, tail_ {rhs.tail_},
+          free_ {rhs.free_}, used_ {rhs.used_}, items_ {rhs.items_}
+    {
+      rhs.chunks_.clear();
+      rhs.reset_();
+    }
+
+    /**
+     * \brief Assignment operator
+     * \details The allocator is replaced only if it propagates on copy assignment
+     * \precondition None
+     * \postcondition This list is equal to the provided list
+     * \complexity O(N)
+     * \param rhs The list to be copied
+     * \return This list
+     */
+    list& operator= (list const& rhs)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      list temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Move assignment operator
+     * \details The chunks are stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
+     * \precondition None
+     * \postcondition This list is equal to the provided list that becomes empty
+     * \complexity O(1) if the chunks are stolen, O(N) otherwise
+     * \param rhs The list to be moved
+     * \return This list
+     */
+    list& operator= (list&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      if (propagate || allocator_ == rhs.allocator_) {
+        list temp {std::move(rhs)};
+        swap_items_(temp);
+        if constexpr (propagate) {
+          using std::swap;
+          swap(allocator_, temp.allocator_);
+        }
+      }
+      else {
+        list temp {allocator_};
+        temp.splice(temp.cend(), rhs);
+        swap_items_(temp);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Destructor
+     * \precondition None
+     * \postcondition The items are destroyed and the chunks deallocated
+     * \complexity O(N)
+     */
+    ~list ()
+    {
+      clear();
+      deallocate_chunks_(chunks_);
+    }
+
+    /**
+     * \brief The list is empty?
+     * \precondition None
+     * \postcondition The list is unchanged
+     * \complexity O(1)
+     * \return True if the list is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return items_ == 0;
+    }
+
+    /**
+     * \brief The number of items in the list
+     * \precondition None
+     * \postcondition The list is unchanged
+     * \complexity O(1)
+     * \return The number of items
+     */
+    size_type size () const noexcept
+    {
+      return items_;
+    }
+
+    /**
+     * \brief The maximum number of items, the indices are 32-bit
+     * \precondition None
+     * \postcondition The list is unchanged
+     * \complexity O(1)
+     * \return The maximum number of items
+     */
+    static constexpr size_type max_size () noexcept
+    {
+      return max_chunks * ChunkSize;
+    }
+
+    /**
+     * \brief The number of items the allocated chunks can hold
+     * \precondition None
+     * \postcondition The list is unchanged
+     * \complexity O(1)
+     * \return The number of slots of the chunks
+     */
+    size_type capacity () const noexcept
+    {
+      return chunks_.size() * ChunkSize;
+    }
+
+    /**
+     * \brief Allocate the chunks for n items
+     * \precondition n <= max_size()
+     * \postcondition capacity() >= n, the list is unchanged
+     * \complexity O(N / ChunkSize)
+     * \throws std::length_error if n > max_size()
+     * \param n The number of items
+     */
+    void reserve (size_type n)
+    {
+      if (n > max_size())
+        throw std::length_error{"Attempting reserve() beyond max_size() on list"};
+      while (capacity() < n)
+        add_chunk_();
+    }
+
+    /**
+     * \brief The first item
+     * \precondition The list is not empty
+     * \postcondition The list is unchanged
+     * \complexity O(1)
+     * \throws list_empty_error if the list is empty
+     * \return The first item
+     */
+    reference front ()
+    {
+      if (empty())
+        throw list_empty_error{"Attempting front() on empty list"};
+      return value_(head_);
+    }
+
+    const_reference front () const
+    {
+      if (empty())
+        throw list_empty_error{"Attempting front() on empty list"};
+      return value_(head_);
+    }
+
+    /**
+     * \brief The last item
+     * \precondition The list is not empty
+     * \postcondition The list is unchanged
+     * \complexity O(1)
+     * \throws list_empty_error if the list is empty
+     * \return The last item
+     */
+    reference back ()
+    {
+      if (empty())
+        throw list_empty_error{"Attempting back() on empty list"};
+      return value_(tail_);
+    }
+
+    const_reference back () const
+    {
+      if (empty())
+        throw list_empty_error{"Attempting back() on empty list"};
+      return value_(tail_);
+    }
+
+    iterator begin () noexcept
+    {
+      return iterator{this, head_};
+    }
+
+    const_iterator begin () const noexcept
+    {
+      return const_iterator{this, head_};
+    }
+
+    const_iterator cbegin () const noexcept
+    {
+      return begin();
+    }
+
+    iterator end () noexcept
+    {
+      return iterator{this, npos};
+    }
+
+    const_iterator end () const noexcept
+    {
+      return const_iterator{this, npos};
+    }
+
+    const_iterator cend () const noexcept
+    {
+      return end();
+    }
+
+    reverse_iterator rbegin () noexcept
+    {
+      return reverse_iterator{end()};
+    }
+
+    const_reverse_iterator rbegin () const noexcept
+    {
+      return const_reverse_iterator{end()};
+    }
+
+    reverse_iterator rend () noexcept
+    {
+      return reverse_iterator{begin()};
+    }
+
+    const_reverse_iterator rend () const noexcept
+    {
+      return const_reverse_iterator{begin()};
+    }
+
+    /**
+     * \brief Insert an item constructed in place from args before pos
+     * \details The slot is taken from the free list, or after the last slot used, or from a new chunk
+     * \precondition pos is an iterator of this list
+     * \postcondition The size of the list is increased by 1
+     * \complexity O(1)
+     * \throws std::length_error if the list has max_size() items
+     * \param pos The iterator before which the item is inserted
+     * \param args The arguments forwarded to the constructor of the item
+     * \return The iterator to the item inserted
+     */
+    template <typename... Args>
+    iterator emplace (const_iterator pos, Args&& ... args)
+    {
+      auto index = new_node_(std::forward<Args>(args)...);
+      link_before_(pos.index(), index);
+      return iterator{this, index};
+    }
+
+    iterator insert (const_iterator pos, value_type const& value)
+    {
+      return emplace(pos, value);
+    }
+
+    iterator insert (const_iterator pos, value_type&& value)
+    {
+      return emplace(pos, std::move(value));
+    }
+
+    /**
+     * \brief Insert the items of the range [first, last) before pos
+     * \details If a copy throws the items already inserted are erased
+     * \precondition pos is an iterator of this list, last should be reachable from first
+     * \postcondition The items of the range are inserted in the same order before pos
+     * \complexity O(K)
+     * \param pos The iterator before which the items are inserted
+     * \param first iterator to the first item of the range
+     * \param last iterator to the one past last item of the range
+     * \return The iterator to the first item inserted or pos if the range is empty
+     */
+    template <concepts::InputIterator InputIt>
+    iterator insert (const_iterator pos, InputIt first, InputIt last)
+    {
+      if (first == last)
+        return iterator{this, pos.index()};
+      auto first_inserted = emplace(pos, *first);
+      try {
+        // loop invariant: the items before first are inserted before pos
+        for (++first; first != last; ++first)
+          emplace(pos, *first);
+      }
+      catch (...) {
+        erase(first_inserted, pos);
+        throw;
+      }
+      return first_inserted;
+    }
+
+    template <typename... Args>
+    reference emplace_front (Args&& ... args)
+    {
+      return *emplace(cbegin(), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    reference emplace_back (Args&& ... args)
+    {
+      return *emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    void push_front (value_type const& value)
+    {
+      emplace(cbegin(), value);
+    }
+
+    void push_front (value_type&& value)
+    {
+      emplace(cbegin(), std::move(value));
+    }
+
+    void push_back (value_type const& value)
+    {
+      emplace(cend(), value);
+    }
+
+    void push_back (value_type&& value)
+    {
+      emplace(cend(), std::move(value));
+    }
+
+    /**
+     * \brief Erase the item at pos
+     * \details The slot of the item goes on the free list
+     * \precondition pos is a dereferenceable iterator of this list
+     * \postcondition The size of the list is decreased by 1, the iterators to the item are invalid
+     * \complexity O(1)
+     * \param pos The iterator to the item
+     * \return The iterator to the item after the one erased
+     */
+    iterator erase (const_iterator pos) noexcept
+    {
+      auto index = pos.index();
+      auto next = pos.current_->next_;
+      unlink_(index, index);
+      delete_node_(index);
+      return iterator{this, next};
+    }
+
+    /**
+     * \brief Erase the items of the range [first, last)
+     * \precondition [first, last) is a range of this list
+     * \postcondition The items of the range are erased
+     * \complexity O(K)
+     * \param first iterator to the first item to erase
+     * \param last iterator to the one past last item to erase
+     * \return last
+     */
+    iterator erase (const_iterator first, const_iterator last) noexcept
+    {
+      // loop invariant: the items before first in the range are erased
+      while (first != last)
+        first = erase(first);
+      return iterator{this, last.index()};
+    }
+
+    void pop_front ()
+    {
+      if (empty())
+        throw list_empty_error{"Attempting pop_front() on empty list"};
+      erase(cbegin());
+    }
+
+    void pop_back ()
+    {
+      if (empty())
+        throw list_empty_error{"Attempting pop_back() on empty list"};
+      erase(const_iterator{this, tail_});
+    }
+
+    /**
+     * \brief Erase all the items
+     * \precondition None
+     * \postcondition The list is empty, the chunks are kept and every slot is free
+     * \complexity O(N)
+     */
+    void clear () noexcept
+    {
+      // loop invariant: the items before index are destroyed
+      for (auto index = head_; index != npos; index = node_(index).next_)
+        alloc_traits::destroy(allocator_, node_(index).value_.data());
+      reset_();
+    }
+
+    /**
+     * \brief Move the items of [first, last) before pos, only the links of the nodes at the ends are changed
+     * \precondition [first, last) is a range of this list and pos is not in it
+     * \postcondition The items are in the same order before pos, the iterators stay valid
+     * \complexity O(1)
+     * \param pos The iterator before which the items are moved
+     * \param first iterator to the first item to move
+     * \param last iterator to the one past last item to move
+     */
+    void splice (const_iterator pos, const_iterator first, const_iterator last) noexcept
+    {
+      if (first == last || pos == last)
+        return;
+      auto first_index = first.index();
+      auto last_index = last.current_ == nullptr ? tail_ : last.current_->prev_;
+      auto moved = items_;
+      unlink_(first_index, last_index);
+      link_range_before_(pos.index(), first_index, last_index);
+      items_ = moved;
+    }
 
-    virtual ~list () = default;
-    list (list const&) = default;
-    list& operator= (list const&) = default;
-    list (list&&) = default;
-    list& operator= (list&&) = default;
+    /**
+     * \brief Move the item at it before pos
+     * \precondition it is a dereferenceable iterator of this list
+     * \postcondition The item is before pos, the iterators stay valid
+     * \complexity O(1)
+     * \param pos The iterator before which the item is moved
+     * \param it The iterator to the item
+     */
+    void splice (const_iterator pos, const_iterator it) noexcept
+    {
+      if (pos == it)
+        return;
+      splice(pos, it, std::next(it));
+    }
+
+    /**
+     * \brief Move the items of another list before pos
+     * \details The nodes of the two lists are in different chunks, so the items are moved in the chunks of
+     * this list one by one
+     * \precondition pos is an iterator of this list
+     * \postcondition The items of rhs are before pos in the same order, rhs is empty
+     * \complexity O(K)
+     * \param pos The iterator before which the items are moved
+     * \param rhs The list whose items are moved
+     */
+    void splice (const_iterator pos, list& rhs)
+    {
+      if (this == &rhs)
+        return;
+      // loop invariant: the items of rhs before item are moved before pos
+      for (auto& item : rhs)
+        emplace(pos, std::move_if_noexcept(item));
+      rhs.clear();
+    }
+
+    /**
+     * \brief Reverse the order of the items
+     * \precondition None
+     * \postcondition The items are in reverse order, the iterators stay valid
+     * \complexity O(N)
+     */
+    void reverse () noexcept
+    {
+      // loop invariant: the links of the nodes before index are swapped
+      for (auto index = head_; index != npos;) {
+        auto& n = node_(index);
+        std::swap(n.prev_, n.next_);
+        index = n.prev_;
+      }
+      std::swap(head_, tail_);
+    }
+
+    /**
+     * \brief Sort the items with a stable sort, only the links are changed
+     * \details The indices of the nodes are sorted and then the nodes are linked again in their order
+     * \precondition None
+     * \postcondition The items are sorted according to comp, the iterators stay valid
+     * \complexity O(N*LOG2 N) comparisons, O(N) extra memory
+     * \param comp comparison invokable
+     */
+    template <typename Compare = std::less<value_type>>
+    void sort (Compare comp = Compare{})
+    {
+      if (items_ < 2)
+        return;
+      std::vector<index_type> order;
+      order.reserve(items_);
+      for (auto index = head_; index != npos; index = node_(index).next_)
+        order.push_back(index);
+      std::stable_sort(std::begin(order), std::end(order), [this, &comp] (index_type lhs, index_type rhs) {
+        return comp(value_(lhs), value_(rhs));
+      });
+      link_in_order_(std::begin(order), std::end(order));
+    }
+
+    /**
+     * \brief Move the items in new chunks in traversal order and give back the old chunks
+     * \details After the compaction the item at position i is in the slot i, so a traversal reads the chunks
+     * sequentially, and only the chunks needed by the items are kept. If a move throws the list is unchanged
+     * \precondition None
+     * \postcondition The list is equal to the one before, every iterator is invalid
+     * \complexity O(N)
+     */
+    void compact ()
+    {
+      chunk_table compacted {chunk_table_allocator{allocator_}};
+      index_type moved = 0;
+      try {
+        compacted.reserve((items_ + ChunkSize - 1) / ChunkSize);
+        while (compacted.size() * ChunkSize < items_)
+          compacted.push_back(allocate_chunk_());
+        // loop invariant: the items before index are moved in the slots before moved
+        for (auto index = head_; index != npos; index = node_(index).next_, ++moved)
+          alloc_traits::construct(allocator_, node_(compacted, moved).value_.data(),
+                                  std::move_if_noexcept(value_(index)));
+      }
+      catch (...) {
+        while (moved > 0)
+          alloc_traits::destroy(allocator_, node_(compacted, --moved).value_.data());
+        deallocate_chunks_(compacted);
+        throw;
+      }
+      clear();
+      deallocate_chunks_(chunks_);
+      chunks_.swap(compacted);
+      for (index_type index = 0; index < moved; ++index) {
+        node_(index).prev_ = index == 0 ? npos : index - 1;
+        node_(index).next_ = index + 1 == moved ? npos : index + 1;
+      }
+      head_ = moved == 0 ? npos : 0;
+      tail_ = moved == 0 ? npos : moved - 1;
+      used_ = items_ = moved;
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The list is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
+
+    /**
+     * \brief Equality operator
+     * \precondition None
+     * \postcondition The lists are unchanged
+     * \complexity O(N)
+     * \param rhs The list to be compared with this
+     * \return True if the items are the same and in the same order, false otherwise
+     */
+    bool operator== (list const& rhs) const
+    {
+      return items_ == rhs.items_ && std::equal(begin(), end(), rhs.begin());
+    }
+
+    bool operator!= (list const& rhs) const
+    {
+      return !(*this == rhs);
+    }
+
+    /**
+     * \brief Less operator
+     * \precondition None
+     * \postcondition The lists are unchanged
+     * \complexity O(N)
+     * \param rhs The list to be compared with this
+     * \return True if the items of this list are lexicographically less than the items of rhs
+     */
+    bool operator< (list const& rhs) const
+    {
+      return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    bool operator<= (list const& rhs) const
+    {
+      return !(rhs < *this);
+    }
+
+    bool operator> (list const& rhs) const
+    {
+      return rhs < *this;
+    }
+
+    bool operator>= (list const& rhs) const
+    {
+      return !(*this < rhs);
+    }
+
+    /**
+     * \brief Swaps the items of this list with the items of the provided list
+     * \details The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
+     * \postcondition This list becomes the rhs list and viceversa, the iterators are invalid
+     * \complexity O(1)
+     * \param rhs The list to be swapped with this
+     */
+    void swap (list& rhs) noexcept
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+  private:
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+    // npos is never a slot
+    static constexpr size_type max_chunks = static_cast<size_type>(npos) / ChunkSize;
+
+    struct node {
+      index_type prev_ {npos};
+      index_type next_ {npos};
+      detail::inline_array<value_type, 1> value_;
+    };
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using node_allocator = typename alloc_traits::template rebind_alloc<node>;
+    using chunk_table_allocator = typename alloc_traits::template rebind_alloc<node*>;
+    using chunk_table = std::vector<node*, chunk_table_allocator>;
+
+    template <bool Const>
+    class iterator_ {
+      using list_pointer = std::conditional_t<Const, list const*, list*>;
+
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = std::conditional_t<Const, T const*, T*>;
+      using reference = std::conditional_t<Const, T const&, T&>;
+
+      iterator_ () noexcept : list_ {nullptr}, current_ {nullptr}
+      {}
+
+      // an iterator converts to a const_iterator
+      template <bool C = Const, typename = std::enable_if_t<C>>
+      iterator_ (iterator_<false> const& rhs) noexcept : list_ {rhs.list_}, current_ {rhs.current_}
+      {}
+
+      reference operator* () const
+      {
+        return current_->value_[0];
+      }
+
+      pointer operator-> () const
+      {
+        return std::addressof(current_->value_[0]);
+      }
+
+      iterator_& operator++ ()
+      {
+        current_ = list_->node_pointer_(current_->next_);
+        return *this;
+      }
+
+      iterator_ operator++ (int)
+      {
+        auto it = *this;
+        ++*this;
+        return it;
+      }
+
+      // the end iterator goes back to the tail
+      iterator_& operator-- ()
+      {
+        current_ = list_->node_pointer_(current_ == nullptr ? list_->tail_ : current_->prev_);
+        return *this;
+      }
+
+      iterator_ operator-- (int)
+      {
+        auto it = *this;
+        --*this;
+        return it;
+      }
+
+      friend bool operator== (iterator_ const& lhs, iterator_ const& rhs) noexcept
+      {
+        return lhs.current_ == rhs.current_;
+      }
+
+      friend bool operator!= (iterator_ const& lhs, iterator_ const& rhs) noexcept
+      {
+        return lhs.current_ != rhs.current_;
+      }
+
+    private:
+      friend class list;
+      friend class iterator_<!Const>;
+
+      iterator_ (list_pointer l, index_type index) noexcept : list_ {l}, current_ {l->node_pointer_(index)}
+      {}
+
+      index_type index () const noexcept
+      {
+        return list_->index_of_(current_);
+      }
+
+      list_pointer list_;
+      // the node is cached, the chunks never move
+      node* current_;
+    };
+
+    static node& node_ (chunk_table const& chunks, index_type index) noexcept
+    {
+      return chunks[index / ChunkSize][index % ChunkSize];
+    }
+
+    node& node_ (index_type index) const noexcept
+    {
+      return node_(chunks_, index);
+    }
+
+    value_type& value_ (index_type index) const noexcept
+    {
+      return node_(index).value_[0];
+    }
+
+    node* node_pointer_ (index_type index) const noexcept
+    {
+      return index == npos ? nullptr : &node_(index);
+    }
+
+    // the index of a linked node is the link to it from its previous node or the head
+    index_type index_of_ (node const* n) const noexcept
+    {
+      if (n == nullptr)
+        return npos;
+      return n->prev_ == npos ? head_ : node_(n->prev_).next_;
+    }
+
+    // the nodes of the chunk are constructed by the rebound allocator, their values are not
+    node* allocate_chunk_ ()
+    {
+      node_allocator nodes {allocator_};
+      return detail::allocate_array(nodes, ChunkSize);
+    }
+
+    void add_chunk_ ()
+    {
+      if (chunks_.size() == max_chunks)
+        throw std::length_error{"Attempting insert() on full list"};
+      chunks_.reserve(chunks_.size() + 1);
+      chunks_.push_back(allocate_chunk_());
+    }
+
+    // the values are already destroyed, the nodes are destroyed with their chunks
+    void deallocate_chunks_ (chunk_table& chunks) noexcept
+    {
+      node_allocator nodes {allocator_};
+      for (auto chunk : chunks)
+        detail::deallocate_array(nodes, chunk, ChunkSize);
+      chunks.clear();
+    }
+
+    // a slot with the value constructed from args, it is not linked
+    template <typename... Args>
+    index_type new_node_ (Args&& ... args)
+    {
+      index_type index;
+      if (free_ != npos) {
+        index = free_;
+        free_ = node_(index).next_;
+      }
+      else {
+        if (used_ == capacity())
+          add_chunk_();
+        index = used_++;
+      }
+      try {
+        alloc_traits::construct(allocator_, node_(index).value_.data(), std::forward<Args>(args)...);
+      }
+      catch (...) {
+        release_node_(index);
+        throw;
+      }
+      return index;
+    }
+
+    void release_node_ (index_type index) noexcept
+    {
+      node_(index).next_ = free_;
+      free_ = index;
+    }
+
+    void delete_node_ (index_type index) noexcept
+    {
+      alloc_traits::destroy(allocator_, node_(index).value_.data());
+      release_node_(index);
+    }
+
+    // link the node index before the node pos, npos is the end
+    void link_before_ (index_type pos, index_type index) noexcept
+    {
+      link_range_before_(pos, index, index);
+      items_++;
+    }
+
+    // link the chain of nodes [first, last] before the node pos, the size is not changed
+    void link_range_before_ (index_type pos, index_type first, index_type last) noexcept
+    {
+      auto prev = pos == npos ? tail_ : node_(pos).prev_;
+      node_(first).prev_ = prev;
+      node_(last).next_ = pos;
+      if (prev == npos)
+        head_ = first;
+      else
+        node_(prev).next_ = first;
+      if (pos == npos)
+        tail_ = last;
+      else
+        node_(pos).prev_ = last;
+    }
+
+    // unlink the chain of nodes [first, last], the size is decreased by one
+    void unlink_ (index_type first, index_type last) noexcept
+    {
+      auto prev = node_(first).prev_;
+      auto next = node_(last).next_;
+      if (prev == npos)
+        head_ = next;
+      else
+        node_(prev).next_ = next;
+      if (next == npos)
+        tail_ = prev;
+      else
+        node_(next).prev_ = prev;
+      items_--;
+    }
+
+    // link the nodes in the order of the indices of the range
+    template <typename It>
+    void link_in_order_ (It first, It last) noexcept
+    {
+      auto prev = npos;
+      head_ = *first;
+      // loop invariant: the nodes before first are linked in order and prev is the last one
+      for (; first != last; ++first) {
+        node_(*first).prev_ = prev;
+        if (prev != npos)
+          node_(prev).next_ = *first;
+        prev = *first;
+      }
+      node_(prev).next_ = npos;
+      tail_ = prev;
+    }
+
+    // the list is empty and every slot of the chunks is free
+    void reset_ () noexcept
+    {
+      head_ = tail_ = free_ = npos;
+      used_ = 0;
+      items_ = 0;
+    }
+
+    // swap the chunks and the links, not the allocators
+    void swap_items_ (list& rhs) noexcept
+    {
+      using std::swap;
+      chunks_.swap(rhs.chunks_);
+      swap(head_, rhs.head_);
+      swap(tail_, rhs.tail_);
+      swap(free_, rhs.free_);
+      swap(used_, rhs.used_);
+      swap(items_, rhs.items_);
+    }
+
+    allocator_type allocator_;
+    chunk_table chunks_;
+    index_type head_;
+    index_type tail_;
+    index_type free_;
+    size_type used_;
+    size_type items_;
   };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs lists.
+   * \details Non member function, noexcept it cannot fail.
+   * \precondition The allocators are equal or they propagate on swap.
+   * \postcondition The lhs list becomes the rhs list and viceversa.
+   * \complexity O(1)
+   * \param lhs List to be exchanged with rhs.
+   * \param rhs List to be exchanged with lhs.
+   */
+  template <typename T, std::size_t ChunkSize, typename Allocator>
+  void swap (list<T, ChunkSize, Allocator>& lhs, list<T, ChunkSize, Allocator>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief list whose chunks are allocated from a std::pmr::memory_resource
+   */
+  template <typename T, std::size_t ChunkSize = 256>
+  using list = ds::list<T, ChunkSize, std::pmr::polymorphic_allocator<T>>;
 }
+#endif
+
 #endif //ALGOL_DS_LIST_HPP
@@ -0,0 +1,300 @@
+/**
+ * \file
+ * Circular bucket queue implementation of the monotone priority queue ADT
+ * The keys pushed are in a window of C+1 consecutive keys starting at the last key popped, so an array of C+1
+ * buckets used circularly holds one key per bucket (Dial's algorithm, a calendar queue with one key per day).
+ * A push appends the item to the bucket of its key, a pop takes an item from the bucket of the least key and,
+ * when that bucket becomes empty, the cursor walks the buckets up to the next one not empty.
+ */
+
+#ifndef ALGOL_DS_BUCKET_QUEUE_HPP
+#define ALGOL_DS_BUCKET_QUEUE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "priority_queue.hpp"
+#include "algol/integer/integer_interval.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the monotone priority queue ADT using a circular array of buckets
+   * \details The items are pairs of a key and a value, the top is an item with the least key.
+   * The window of the keys is given by an integer_interval [lower, upper]: before the first pop the keys pushed
+   * are in [lower, upper], then in [k, k + upper - lower] with k the last key popped.
+   * If every key is in [lower, upper] the window never slides past upper and the queue is a plain bucket queue
+   * \tparam Key integer type of the keys
+   * \tparam T type of the values stored with the keys
+   * \tparam Allocator allocator of the items
+   * \invariant The keys of the items are in the window and the bucket k % (C+1) holds the items with the key k
+   */
+  template <concepts::Integral Key, concepts::CopyConstructible T,
+      typename Allocator = std::allocator<std::pair<Key, T>>>
+  class bucket_queue {
+  public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Comparison of the items, an item with a greater key has a lower priority
+     */
+    struct value_compare {
+      bool operator() (value_type const& lhs, value_type const& rhs) const
+      {
+        return rhs.first < lhs.first;
+      }
+    };
+
+    /**
+     * \brief Construct an empty queue whose window of the keys is [keys.lower(), keys.upper()]
+     * \precondition keys.lower() <= keys.upper()
+     * \postcondition The queue is empty
+     * \complexity O(C), C the width of the keys interval
+     * \throws priority_queue_key_error if keys.upper() < keys.lower()
+     * \param keys The first window of the keys
+     * \param allocator The allocator of the items
+     */
+    explicit bucket_queue (integer::integer_interval<Key> const& keys, allocator_type const& allocator = allocator_type{})
+        : lower_ {keys.lower()}, span_ {offset_(keys.upper())}, last_ {0}, top_ {0}, top_bucket_ {0}, items_ {0},
+          buckets_(check_span_(keys), bucket_type{allocator}, bucket_allocator_type{allocator})
+    {}
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return items_ == 0;
+    }
+
+    /**
+     * \brief The number of items in the queue
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return The number of items
+     */
+    size_type size () const noexcept
+    {
+      return items_;
+    }
+
+    /**
+     * \brief The item with the least key
+     * \precondition The queue is not empty
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \throws priority_queue_empty_error if the queue is empty
+     * \return The item on top of the queue
+     */
+    const_reference top () const
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting top() on empty queue"};
+      return buckets_[top_bucket_].back();
+    }
+
+    /**
+     * \brief The least key that can be pushed
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return The last key popped or the lower bound of the keys if no key is popped
+     */
+    key_type last_key () const noexcept
+    {
+      return key_(last_);
+    }
+
+    /**
+     * \brief The greatest key that can be pushed
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return last_key() plus the width of the window minus one
+     */
+    key_type max_key () const noexcept
+    {
+      return key_(last_ + span_);
+    }
+
+    /**
+     * \brief Add an item to the queue
+     * \precondition The key is in [last_key(), max_key()]
+     * \postcondition The size of the queue is increased by 1
+     * \complexity O(1)
+     * \throws priority_queue_key_error if the key is out of the window
+     * \param value The item to add
+     */
+    void push (value_type const& value)
+    {
+      push_(value);
+    }
+
+    /**
+     * \brief Add an item to the queue with move operation
+     * \precondition The key is in [last_key(), max_key()]
+     * \postcondition The size of the queue is increased by 1
+     * \complexity O(1)
+     * \throws priority_queue_key_error if the key is out of the window
+     * \param value The item to add
+     */
+    void push (value_type&& value)
+    {
+      push_(std::move(value));
+    }
+
+    /**
+     * \brief Add an item with the key provided and the value constructed in place from args
+     * \precondition The key is in [last_key(), max_key()]
+     * \postcondition The size of the queue is increased by 1
+     * \complexity O(1)
+     * \throws priority_queue_key_error if the key is out of the window
+     * \param key The key of the item
+     * \param args The arguments forwarded to the constructor of the value
+     */
+    template <typename... Args>
+    void emplace (key_type key, Args&& ... args)
+    {
+      push_(value_type{std::piecewise_construct, std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...)});
+    }
+
+    /**
+     * \brief Remove the item with the least key
+     * \details When the bucket of the least key becomes empty the cursor walks to the next bucket not empty
+     * \precondition The queue is not empty
+     * \postcondition The size of the queue is decreased by 1, last_key() is the key of the item removed
+     * \complexity O(1) amortized over the distance walked by the keys popped, O(C) worst case
+     * \throws priority_queue_empty_error if the queue is empty
+     */
+    void pop ()
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting pop() on empty queue"};
+      buckets_[top_bucket_].pop_back();
+      last_ = top_;
+      items_--;
+      if (items_ == 0)
+        return;
+      // loop invariant: the buckets of the keys in [last_, top_) are empty and top_bucket_ is the bucket of top_
+      while (buckets_[top_bucket_].empty()) {
+        top_++;
+        if (++top_bucket_ == buckets_.size())
+          top_bucket_ = 0;
+      }
+    }
+
+    /**
+     * \brief Remove all the items
+     * \precondition None
+     * \postcondition The queue is empty, last_key() is unchanged
+     * \complexity O(N + C)
+     */
+    void clear () noexcept
+    {
+      for (auto& bucket : buckets_)
+        bucket.clear();
+      items_ = 0;
+      top_ = last_;
+      top_bucket_ = bucket_(last_);
+    }
+
+    /**
+     * \brief The comparison of the items
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return The comparison by key
+     */
+    value_compare value_comp () const
+    {
+      return value_compare{};
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return buckets_.front().get_allocator();
+    }
+
+  private:
+    using unsigned_key = std::make_unsigned_t<Key>;
+    using bucket_type = std::vector<value_type, allocator_type>;
+    using bucket_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<bucket_type>;
+
+    // the number of buckets of the keys interval, it is checked before the buckets are allocated
+    static size_type check_span_ (integer::integer_interval<Key> const& keys)
+    {
+      if (keys.upper() < keys.lower())
+        throw priority_queue_key_error{"Attempting construction with an empty keys interval"};
+      auto span = static_cast<unsigned_key>(static_cast<unsigned_key>(keys.upper())
+                                            - static_cast<unsigned_key>(keys.lower()));
+      if (span >= std::numeric_limits<size_type>::max())
+        throw priority_queue_key_error{"Attempting construction with too many keys"};
+      return static_cast<size_type>(span) + 1;
+    }
+
+    // the distance of the key from the lower bound, the order of the keys is preserved
+    unsigned_key offset_ (key_type key) const noexcept
+    {
+      return static_cast<unsigned_key>(static_cast<unsigned_key>(key) - static_cast<unsigned_key>(lower_));
+    }
+
+    key_type key_ (unsigned_key offset) const noexcept
+    {
+      return static_cast<key_type>(static_cast<unsigned_key>(static_cast<unsigned_key>(lower_) + offset));
+    }
+
+    size_type bucket_ (unsigned_key offset) const noexcept
+    {
+      return static_cast<size_type>(offset % buckets_.size());
+    }
+
+    template <typename U>
+    void push_ (U&& value)
+    {
+      auto offset = offset_(value.first);
+      if (offset < last_ || offset - last_ > span_)
+        throw priority_queue_key_error{"Attempting push() with a key out of the window"};
+      auto bucket = bucket_(offset);
+      buckets_[bucket].push_back(std::forward<U>(value));
+      if (items_ == 0 || offset < top_) {
+        top_ = offset;
+        top_bucket_ = bucket;
+      }
+      items_++;
+    }
+
+    key_type lower_;
+    unsigned_key span_;
+    unsigned_key last_;
+    unsigned_key top_;
+    size_type top_bucket_;
+    size_type items_;
+    std::vector<bucket_type, bucket_allocator_type> buckets_;
+  };
+}
+
+#endif //ALGOL_DS_BUCKET_QUEUE_HPP
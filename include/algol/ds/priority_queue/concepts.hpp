@@ -0,0 +1,26 @@
+#ifndef ALGOL_DS_PRIORITY_QUEUE_CONCEPTS_HPP
+#define ALGOL_DS_PRIORITY_QUEUE_CONCEPTS_HPP
+
+#include "stl2/concepts.hpp"
+
+namespace algol::concepts {
+  template <typename P>
+  concept bool PriorityQueue ()
+  {
+    return requires(P
+    queue, typename P::value_type const&value) {
+      typename P::value_type;
+      typename P::size_type;
+      typename P::const_reference;
+      typename P::value_compare;
+      { queue.empty() } -> bool;
+      { queue.size() } ->  typename P::size_type;
+      { queue.top() } ->  typename P::const_reference;
+      { queue.value_comp() } ->  typename P::value_compare;
+      queue.push(value);
+      queue.pop();
+      queue.clear();
+    };
+  }
+}
+#endif //ALGOL_DS_PRIORITY_QUEUE_CONCEPTS_HPP
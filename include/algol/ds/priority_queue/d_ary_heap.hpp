@@ -0,0 +1,422 @@
+/**
+ * \file
+ * Implicit d-ary heap implementation of the priority queue ADT
+ * The items are kept in a vector, the children of the item at index i are at the indexes D*i+1 ... D*i+D.
+ * With D = 2 it is the classic binary heap, with D = 4 or D = 8 the tree is shallower and the children of an item
+ * share one or two cache lines, so a pop touches fewer cache lines at the cost of more comparisons per level.
+ */
+
+#ifndef ALGOL_DS_D_ARY_HEAP_HPP
+#define ALGOL_DS_D_ARY_HEAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "priority_queue.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the priority queue ADT using an implicit d-ary heap
+   * \details The comparison must not throw, if it throws the heap is left in a valid but unspecified state
+   * \tparam T type of the items stored in the heap
+   * \tparam D number of children of every item, at least 2
+   * \tparam Compare comparison type, the top is an item that is not less than every other item
+   * \tparam Allocator allocator of the items
+   * \invariant The item at index i is not less than its children at the indexes D*i+1 ... D*i+D
+   */
+  template <concepts::CopyConstructible T, std::size_t D = 2, typename Compare = std::less<T>,
+      typename Allocator = std::allocator<T>>
+  class d_ary_heap {
+    static_assert(D >= 2, "a d-ary heap has at least two children per item");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief The number of children of every item
+     */
+    static constexpr size_type arity = D;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The heap is empty
+     * \complexity O(1)
+     */
+    d_ary_heap () : d_ary_heap(value_compare{})
+    {}
+
+    /**
+     * \brief Construct an empty heap with the comparison and the allocator provided
+     * \precondition None
+     * \postcondition The heap is empty
+     * \complexity O(1)
+     * \param comp comparison invokable
+     * \param allocator The allocator of the items
+     */
+    explicit d_ary_heap (value_compare const& comp, allocator_type const& allocator = allocator_type{})
+        : comp_ {comp}, items_ {allocator}
+    {}
+
+    /**
+     * \brief Construct a heap with the items of the range [first, last)
+     * \details The items are copied as they are and then heapified bottom-up (Floyd's method)
+     * \precondition last should be reachable from first otherwise undefined behavior
+     * \postcondition The heap contains the items of the range
+     * \complexity O(N), at most D/(D-1)*N comparisons on average
+     * \param first iterator to the first item of the range
+     * \param last iterator to the one past last item of the range
+     * \param comp comparison invokable
+     * \param allocator The allocator of the items
+     */
+    template <concepts::InputIterator InputIt>
+    d_ary_heap (InputIt first, InputIt last, value_compare const& comp = value_compare{},
+                allocator_type const& allocator = allocator_type{})
+        : comp_ {comp}, items_ {first, last, allocator}
+    {
+      heapify_();
+    }
+
+    /**
+     * \brief Construct a heap with the values provided
+     * \precondition None
+     * \postcondition The heap contains the values of the initializer_list
+     * \complexity O(N)
+     * \param values The items of the heap
+     * \param comp comparison invokable
+     * \param allocator The allocator of the items
+     */
+    d_ary_heap (std::initializer_list<value_type> values, value_compare const& comp = value_compare{},
+                allocator_type const& allocator = allocator_type{})
+        : d_ary_heap(values.begin(), values.end(), comp, allocator)
+    {}
+
+    /**
+     * \brief Construct a heap taking the items of a vector
+     * \details The vector storage becomes the heap storage, no item is copied
+     * \precondition None
+     * \postcondition The heap contains the items of the vector
+     * \complexity O(N)
+     * \param items The items of the heap
+     * \param comp comparison invokable
+     */
+    explicit d_ary_heap (std::vector<value_type, allocator_type>&& items, value_compare const& comp = value_compare{})
+        : comp_ {comp}, items_ {std::move(items)}
+    {
+      heapify_();
+    }
+
+    /**
+     * \brief The heap is empty?
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return True if the heap is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return items_.empty();
+    }
+
+    /**
+     * \brief The number of items in the heap
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return The number of items
+     */
+    size_type size () const noexcept
+    {
+      return items_.size();
+    }
+
+    /**
+     * \brief The item with the highest priority
+     * \precondition The heap is not empty
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \throws priority_queue_empty_error if the heap is empty
+     * \return The item on top of the heap
+     */
+    const_reference top () const
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting top() on empty heap"};
+      return items_.front();
+    }
+
+    /**
+     * \brief Add an item to the heap
+     * \precondition None
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(LOG_D N) comparisons, O(1) on average for random items
+     * \param value The item to add
+     */
+    void push (value_type const& value)
+    {
+      items_.push_back(value);
+      sift_up_(items_.size() - 1);
+    }
+
+    /**
+     * \brief Add an item to the heap with move operation
+     * \precondition None
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(LOG_D N) comparisons, O(1) on average for random items
+     * \param value The item to add
+     */
+    void push (value_type&& value)
+    {
+      items_.push_back(std::move(value));
+      sift_up_(items_.size() - 1);
+    }
+
+    /**
+     * \brief Add an item constructed in place from args
+     * \precondition None
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(LOG_D N)
+     * \param args The arguments forwarded to the constructor of the item
+     */
+    template <typename... Args>
+    void emplace (Args&& ... args)
+    {
+      items_.emplace_back(std::forward<Args>(args)...);
+      sift_up_(items_.size() - 1);
+    }
+
+    /**
+     * \brief Add the items of the range [first, last)
+     * \details The items are appended, then the whole heap is rebuilt when the range is not smaller than the heap,
+     * otherwise every item is sifted up
+     * \precondition last should be reachable from first otherwise undefined behavior
+     * \postcondition The heap contains also the items of the range
+     * \complexity O(N + K) if the range is not smaller than the heap, O(K*LOG_D N) otherwise
+     * \param first iterator to the first item of the range
+     * \param last iterator to the one past last item of the range
+     */
+    template <concepts::InputIterator InputIt>
+    void push_range (InputIt first, InputIt last)
+    {
+      auto old_size = items_.size();
+      items_.insert(items_.end(), first, last);
+      if (items_.size() - old_size >= old_size) {
+        heapify_();
+        return;
+      }
+      // loop invariant: the items before i are a heap
+      for (auto i = old_size; i < items_.size(); ++i)
+        sift_up_(i);
+    }
+
+    /**
+     * \brief Remove the item with the highest priority
+     * \details Bottom-up deletion: the hole left by the top goes down to a leaf following the greatest children,
+     * then the last item is put in the hole and sifted up. The last item usually belongs near the leaves, so
+     * this takes about D-1 comparisons per level instead of the D of the classic sift down
+     * \precondition The heap is not empty
+     * \postcondition The size of the heap is decreased by 1
+     * \complexity O(D*LOG_D N) comparisons, (D-1)*LOG_D N on average
+     * \throws priority_queue_empty_error if the heap is empty
+     */
+    void pop ()
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting pop() on empty heap"};
+      auto last = items_.size() - 1;
+      if (last == 0) {
+        items_.pop_back();
+        return;
+      }
+      auto hole = size_type{0};
+      // loop invariant: the items on the path from the root to hole are in heap order without the last item
+      for (;;) {
+        auto first_child = D * hole + 1;
+        if (first_child >= last)
+          break;
+        auto best = greatest_child_(first_child, std::min(first_child + D, last));
+        items_[hole] = std::move(items_[best]);
+        hole = best;
+      }
+      // the hole is before the last item
+      items_[hole] = std::move(items_[last]);
+      items_.pop_back();
+      sift_up_(hole);
+    }
+
+    /**
+     * \brief Remove all the items
+     * \precondition None
+     * \postcondition The heap is empty, the capacity is unchanged
+     * \complexity O(N)
+     */
+    void clear () noexcept
+    {
+      items_.clear();
+    }
+
+    /**
+     * \brief Reserve the storage for n items
+     * \precondition None
+     * \postcondition The heap is unchanged, n items can be pushed without allocations
+     * \complexity O(N)
+     * \param n The number of items
+     */
+    void reserve (size_type n)
+    {
+      items_.reserve(n);
+    }
+
+    /**
+     * \brief The comparison of the heap
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return A copy of the comparison
+     */
+    value_compare value_comp () const
+    {
+      return comp_;
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return items_.get_allocator();
+    }
+
+    /**
+     * \brief Swaps the items of this heap with the items of the provided heap
+     * \precondition The allocators are equal or they propagate on swap
+     * \postcondition This heap becomes the rhs heap and viceversa
+     * \complexity O(1)
+     * \param rhs The heap to be swapped with this
+     */
+    void swap (d_ary_heap& rhs) noexcept(std::is_nothrow_swappable_v<value_compare>)
+    {
+      using std::swap;
+      swap(comp_, rhs.comp_);
+      items_.swap(rhs.items_);
+    }
+
+  private:
+    // the parent of the item at index i > 0
+    static constexpr size_type parent_ (size_type i) noexcept
+    {
+      return (i - 1) / D;
+    }
+
+    // Floyd's method: sift down every internal item starting from the last one
+    void heapify_ ()
+    {
+      if (items_.size() < 2)
+        return;
+      // loop invariant: the subtrees rooted after i are heaps
+      for (auto i = parent_(items_.size() - 1) + 1; i-- > 0;)
+        sift_down_(i);
+    }
+
+    // move the item at hole towards the root, the parents are moved down into the hole
+    void sift_up_ (size_type hole)
+    {
+      auto value = std::move(items_[hole]);
+      // loop invariant: the items on the path from hole to the last item sifted are not less than value
+      while (hole > 0) {
+        auto parent = parent_(hole);
+        if (!comp_(items_[parent], value))
+          break;
+        items_[hole] = std::move(items_[parent]);
+        hole = parent;
+      }
+      items_[hole] = std::move(value);
+    }
+
+    // the index of the greatest item in [first_child, last_child)
+    size_type greatest_child_ (size_type first_child, size_type last_child) const
+    {
+      auto best = first_child;
+      for (auto child = first_child + 1; child < last_child; ++child)
+        if (comp_(items_[best], items_[child]))
+          best = child;
+      return best;
+    }
+
+    // move the item at hole towards the leaves, the greatest child is moved up into the hole
+    void sift_down_ (size_type hole)
+    {
+      auto const n = items_.size();
+      auto value = std::move(items_[hole]);
+      // loop invariant: the subtree rooted at hole with value in place of the hole is a heap except at hole
+      for (;;) {
+        auto first_child = D * hole + 1;
+        if (first_child >= n)
+          break;
+        auto best = greatest_child_(first_child, std::min(first_child + D, n));
+        if (!comp_(value, items_[best]))
+          break;
+        items_[hole] = std::move(items_[best]);
+        hole = best;
+      }
+      items_[hole] = std::move(value);
+    }
+
+    value_compare comp_;
+    std::vector<value_type, allocator_type> items_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs heaps.
+   * \details Non member function.
+   * \precondition The allocators are equal or they propagate on swap.
+   * \postcondition The lhs heap becomes the rhs heap and viceversa.
+   * \complexity O(1)
+   * \param lhs Heap to be exchanged with rhs.
+   * \param rhs Heap to be exchanged with lhs.
+   */
+  template <typename T, std::size_t D, typename Compare, typename Allocator>
+  void swap (d_ary_heap<T, D, Compare, Allocator>& lhs, d_ary_heap<T, D, Compare, Allocator>& rhs)
+  noexcept(noexcept(lhs.swap(rhs)))
+  {
+    lhs.swap(rhs);
+  }
+
+  /**
+   * \brief Implicit binary heap, the d_ary_heap with two children per item
+   */
+  template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+  using binary_heap = d_ary_heap<T, 2, Compare, Allocator>;
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief d_ary_heap whose items are allocated from a std::pmr::memory_resource
+   */
+  template <typename T, std::size_t D = 2, typename Compare = std::less<T>>
+  using d_ary_heap = ds::d_ary_heap<T, D, Compare, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif //ALGOL_DS_D_ARY_HEAP_HPP
@@ -0,0 +1,634 @@
+/**
+ * \file
+ * Pairing heap implementation of the priority queue ADT
+ * A pairing heap is a heap-ordered multiway tree: push and merge link a new tree to the root in O(1),
+ * pop removes the root and merges its children in two passes (pairing left to right, then linking right to left)
+ * and a key moved towards the top is cut with its subtree and linked to the root.
+ * Every item has its own node, so the handle returned by push stays valid until the item is popped.
+ */
+
+#ifndef ALGOL_DS_PAIRING_HEAP_HPP
+#define ALGOL_DS_PAIRING_HEAP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "priority_queue.hpp"
+#include "algol/ds/allocator.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the priority queue ADT using a pairing heap
+   * \details The comparison must not throw
+   * \tparam T type of the items stored in the heap
+   * \tparam Compare comparison type, the top is an item that is not less than every other item
+   * \tparam Allocator allocator of the items, the nodes are allocated with it rebound to the node type
+   * \invariant Every item is not less than the items of its children subtrees
+   */
+  template <concepts::CopyConstructible T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+  class pairing_heap {
+    struct node;
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Reference to an item of the heap returned by push
+     * \details It is valid until the item is popped or the heap is cleared or destroyed,
+     * moving or swapping the heap and merging it into another heap keep it valid
+     */
+    class handle {
+    public:
+      /**
+       * \brief A handle that refers to no item
+       */
+      handle () noexcept : node_ {nullptr}
+      {}
+
+      /**
+       * \brief The item referred
+       * \precondition The handle is valid
+       * \return The item
+       */
+      const_reference operator* () const noexcept
+      {
+        return node_->value_[0];
+      }
+
+      value_type const* operator-> () const noexcept
+      {
+        return std::addressof(node_->value_[0]);
+      }
+
+      bool operator== (handle const& rhs) const noexcept
+      {
+        return node_ == rhs.node_;
+      }
+
+      bool operator!= (handle const& rhs) const noexcept
+      {
+        return node_ != rhs.node_;
+      }
+
+    private:
+      friend class pairing_heap;
+
+      explicit handle (node* n) noexcept : node_ {n}
+      {}
+
+      node* node_;
+    };
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The heap is empty
+     * \complexity O(1)
+     */
+    pairing_heap () : pairing_heap(value_compare{})
+    {}
+
+    /**
+     * \brief Construct an empty heap with the comparison and the allocator provided
+     * \precondition None
+     * \postcondition The heap is empty
+     * \complexity O(1)
+     * \param comp comparison invokable
+     * \param allocator The allocator of the nodes, it is rebound to the node type
+     */
+    explicit pairing_heap (value_compare const& comp, allocator_type const& allocator = allocator_type{})
+        : comp_ {comp}, allocator_ {allocator}, root_ {nullptr}, items_ {size_type{0}}
+    {}
+
+    /**
+     * \brief Construct a heap with the items of the range [first, last)
+     * \details Every item is linked to the root, linking is O(1) so the heap is built in linear time
+     * \precondition last should be reachable from first otherwise undefined behavior
+     * \postcondition The heap contains the items of the range
+     * \complexity O(N), N-1 comparisons
+     * \param first iterator to the first item of the range
+     * \param last iterator to the one past last item of the range
+     * \param comp comparison invokable
+     * \param allocator The allocator of the nodes
+     */
+    template <concepts::InputIterator InputIt>
+    pairing_heap (InputIt first, InputIt last, value_compare const& comp = value_compare{},
+                  allocator_type const& allocator = allocator_type{})
+        : pairing_heap(comp, allocator)
+    {
+      try {
+        push_range(first, last);
+      }
+      catch (...) {
+        clear();
+        throw;
+      }
+    }
+
+    /**
+     * \brief Construct a heap with the values provided
+     * \precondition None
+     * \postcondition The heap contains the values of the initializer_list
+     * \complexity O(N)
+     * \param values The items of the heap
+     * \param comp comparison invokable
+     * \param allocator The allocator of the nodes
+     */
+    pairing_heap (std::initializer_list<value_type> values, value_compare const& comp = value_compare{},
+                  allocator_type const& allocator = allocator_type{})
+        : pairing_heap(values.begin(), values.end(), comp, allocator)
+    {}
+
+    /**
+     * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction,
+     * the handles of rhs do not refer to the items of the copy
+     * \precondition None
+     * \postcondition This heap contains the items of the provided heap
+     * \complexity O(N)
+     * \param rhs The heap to be copied
+     */
+    pairing_heap (pairing_heap const& rhs)
+        : pairing_heap(rhs.comp_, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {
+      try {
+        copy_items_(rhs);
+      }
+      catch (...) {
+        clear();
+        throw;
+      }
+    }
+
+    /**
+     * \brief Move constructor
+     * \precondition None
+     * \postcondition This heap contains the items of the provided heap that becomes empty,
+     * the handles of rhs refer to the items of this heap
+     * \complexity O(1)
+     * \param rhs The heap to be moved
+     */
+    pairing_heap (pairing_heap&& rhs) noexcept
+        : comp_ {rhs.comp_}, allocator_ {rhs.allocator_}, root_ {rhs.root_}, items_ {rhs.items_}
+    {
+      rhs.root_ = nullptr;
+      rhs.items_ = size_type{0};
+    }
+
+    /**
+     * \brief Assignment operator
+     * \details The allocator is replaced only if it propagates on copy assignment
+     * \precondition None
+     * \postcondition This heap contains the items of the provided heap
+     * \complexity O(N)
+     * \param rhs The heap to be copied
+     * \return This heap
+     */
+    pairing_heap& operator= (pairing_heap const& rhs)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      pairing_heap temp {rhs.comp_, propagate ? rhs.allocator_ : allocator_};
+      temp.copy_items_(rhs);
+      swap_items_(temp);
+      comp_ = rhs.comp_;
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Move assignment operator
+     * \details The nodes are stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
+     * \precondition None
+     * \postcondition This heap contains the items of the provided heap that becomes empty
+     * \complexity O(N) to destroy the items of this heap
+     * \param rhs The heap to be moved
+     * \return This heap
+     */
+    pairing_heap& operator= (pairing_heap&& rhs)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      if (this == &rhs)
+        return *this;
+      clear();
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+      comp_ = rhs.comp_;
+      if (propagate || allocator_ == rhs.allocator_)
+        swap_items_(rhs);
+      else
+        merge(rhs);
+      return *this;
+    }
+
+    /**
+     * \brief Destructor
+     * \precondition None
+     * \postcondition The items are destroyed
+     * \complexity O(N)
+     */
+    ~pairing_heap ()
+    {
+      clear();
+    }
+
+    /**
+     * \brief The heap is empty?
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return True if the heap is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return items_ == 0;
+    }
+
+    /**
+     * \brief The number of items in the heap
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return The number of items
+     */
+    size_type size () const noexcept
+    {
+      return items_;
+    }
+
+    /**
+     * \brief The item with the highest priority
+     * \precondition The heap is not empty
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \throws priority_queue_empty_error if the heap is empty
+     * \return The item on top of the heap
+     */
+    const_reference top () const
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting top() on empty heap"};
+      return root_->value_[0];
+    }
+
+    /**
+     * \brief Add an item to the heap
+     * \precondition None
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(1), 1 comparison
+     * \param value The item to add
+     * \return The handle of the item
+     */
+    handle push (value_type const& value)
+    {
+      return push_(new_node_(value));
+    }
+
+    /**
+     * \brief Add an item to the heap with move operation
+     * \precondition None
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(1), 1 comparison
+     * \param value The item to add
+     * \return The handle of the item
+     */
+    handle push (value_type&& value)
+    {
+      return push_(new_node_(std::move(value)));
+    }
+
+    /**
+     * \brief Add an item constructed in place from args
+     * \precondition None
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(1)
+     * \param args The arguments forwarded to the constructor of the item
+     * \return The handle of the item
+     */
+    template <typename... Args>
+    handle emplace (Args&& ... args)
+    {
+      return push_(new_node_(std::forward<Args>(args)...));
+    }
+
+    /**
+     * \brief Add the items of the range [first, last)
+     * \precondition last should be reachable from first otherwise undefined behavior
+     * \postcondition The heap contains also the items of the range
+     * \complexity O(K)
+     * \param first iterator to the first item of the range
+     * \param last iterator to the one past last item of the range
+     */
+    template <concepts::InputIterator InputIt>
+    void push_range (InputIt first, InputIt last)
+    {
+      for (; first != last; ++first)
+        push(*first);
+    }
+
+    /**
+     * \brief Remove the item with the highest priority
+     * \details The children of the root are paired left to right and the pairs are linked right to left
+     * \precondition The heap is not empty
+     * \postcondition The size of the heap is decreased by 1, the handle of the item becomes invalid
+     * \complexity O(LOG2 N) amortized
+     * \throws priority_queue_empty_error if the heap is empty
+     */
+    void pop ()
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting pop() on empty heap"};
+      auto old_root = root_;
+      root_ = merge_pairs_(old_root->child_);
+      items_--;
+      detail::deallocate_node(allocator_, old_root);
+    }
+
+    /**
+     * \brief Move an item towards the top assigning it a value with a priority not lower than the actual one
+     * \details With std::greater the heap is a min-heap and the key of the item decreases.
+     * The node of the item is cut with its subtree and linked to the root
+     * \precondition The handle is valid and the value is not less than the item according to the comparison
+     * \postcondition The item has the new value, the handle is still valid
+     * \complexity O(1) amortized O(LOG2 N) on the following pop
+     * \throws priority_queue_key_error if the value is less than the item
+     * \param position The handle of the item
+     * \param value The new value of the item
+     */
+    void decrease_key (handle position, value_type const& value)
+    {
+      node* n = position.node_;
+      if (comp_(value, n->value_[0]))
+        throw priority_queue_key_error{"Attempting decrease_key() with a value of lower priority"};
+      n->value_[0] = value;
+      if (n == root_)
+        return;
+      cut_(n);
+      root_ = link_(root_, n);
+    }
+
+    /**
+     * \brief Move the items of the provided heap into this heap
+     * \details The root of rhs is linked to the root of this heap if the allocators are equal,
+     * otherwise the items are moved one by one
+     * \precondition None
+     * \postcondition This heap contains also the items of rhs that becomes empty, the handles of rhs refer to
+     * the items of this heap if the allocators are equal
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \param rhs The heap to be merged into this heap
+     */
+    void merge (pairing_heap& rhs)
+    {
+      if (this == &rhs || rhs.empty())
+        return;
+      if (allocator_ == rhs.allocator_) {
+        root_ = root_ ? link_(root_, rhs.root_) : rhs.root_;
+        items_ += rhs.items_;
+        rhs.root_ = nullptr;
+        rhs.items_ = size_type{0};
+        return;
+      }
+      // loop invariant: the items popped from rhs are pushed onto this heap
+      while (!rhs.empty()) {
+        push(std::move(rhs.root_->value_[0]));
+        rhs.pop();
+      }
+    }
+
+    /**
+     * \brief Remove all the items
+     * \details The tree is destroyed without recursion nor extra memory rotating the children on the right spine
+     * \precondition None
+     * \postcondition The heap is empty, every handle becomes invalid
+     * \complexity O(N)
+     */
+    void clear () noexcept
+    {
+      node* current = root_;
+      // loop invariant: the nodes reachable from current through child_ and sibling_ are the ones to destroy
+      while (current) {
+        if (current->child_) {
+          auto child = current->child_;
+          current->child_ = child->sibling_;
+          child->sibling_ = current;
+          current = child;
+        }
+        else {
+          auto next = current->sibling_;
+          detail::deallocate_node(allocator_, current);
+          current = next;
+        }
+      }
+      root_ = nullptr;
+      items_ = size_type{0};
+    }
+
+    /**
+     * \brief The comparison of the heap
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return A copy of the comparison
+     */
+    value_compare value_comp () const
+    {
+      return comp_;
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
+
+    /**
+     * \brief Swaps the items of this heap with the items of the provided heap
+     * \details The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
+     * \postcondition This heap becomes the rhs heap and viceversa, the handles follow their items
+     * \complexity O(1)
+     * \param rhs The heap to be swapped with this
+     */
+    void swap (pairing_heap& rhs) noexcept
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      using std::swap;
+      swap(comp_, rhs.comp_);
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value)
+        swap(allocator_, rhs.allocator_);
+    }
+
+  private:
+    // prev_ is the parent for the first child and the left sibling for the others, nullptr for the root
+    // the value is constructed by allocate_node with the allocator of the items
+    struct node {
+      detail::inline_array<value_type, 1> value_;
+      node* child_ {nullptr};
+      node* sibling_ {nullptr};
+      node* prev_ {nullptr};
+    };
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    // swap the nodes and the counter, not the allocators
+    void swap_items_ (pairing_heap& rhs) noexcept
+    {
+      using std::swap;
+      swap(root_, rhs.root_);
+      swap(items_, rhs.items_);
+    }
+
+    // a node whose value is constructed from args, it is not linked
+    template <typename... Args>
+    node* new_node_ (Args&& ... args)
+    {
+      return detail::allocate_node<node>(allocator_, std::forward<Args>(args)...);
+    }
+
+    handle push_ (node* n) noexcept
+    {
+      root_ = root_ ? link_(root_, n) : n;
+      items_++;
+      return handle{n};
+    }
+
+    // copy the items of rhs visiting its tree with an explicit stack
+    void copy_items_ (pairing_heap const& rhs)
+    {
+      if (rhs.root_ == nullptr)
+        return;
+      std::vector<node const*> pending {rhs.root_};
+      // loop invariant: the items of the nodes visited and not pending are copied
+      while (!pending.empty()) {
+        auto n = pending.back();
+        pending.pop_back();
+        push(n->value_[0]);
+        for (auto child = n->child_; child; child = child->sibling_)
+          pending.push_back(child);
+      }
+    }
+
+    // link two trees, the root with the lower priority becomes the first child of the other
+    node* link_ (node* lhs, node* rhs) noexcept
+    {
+      if (comp_(lhs->value_[0], rhs->value_[0]))
+        std::swap(lhs, rhs);
+      rhs->prev_ = lhs;
+      rhs->sibling_ = lhs->child_;
+      if (lhs->child_)
+        lhs->child_->prev_ = rhs;
+      lhs->child_ = rhs;
+      return lhs;
+    }
+
+    // unlink a node that is not the root from its parent or left sibling
+    void cut_ (node* n) noexcept
+    {
+      if (n->prev_->child_ == n)
+        n->prev_->child_ = n->sibling_;
+      else
+        n->prev_->sibling_ = n->sibling_;
+      if (n->sibling_)
+        n->sibling_->prev_ = n->prev_;
+      n->sibling_ = n->prev_ = nullptr;
+    }
+
+    // two-pass pairing of the list of siblings starting at first, the root of the merged tree is returned
+    node* merge_pairs_ (node* first) noexcept
+    {
+      if (first == nullptr)
+        return nullptr;
+
+      // first pass, the pairs are kept in a list through sibling_ in reverse order
+      node* pairs = nullptr;
+      // loop invariant: the siblings before first are linked in pairs and the pairs are in the list
+      while (first) {
+        auto lhs = first;
+        auto rhs = first->sibling_;
+        if (rhs == nullptr) {
+          lhs->prev_ = nullptr;
+          lhs->sibling_ = pairs;
+          pairs = lhs;
+          break;
+        }
+        first = rhs->sibling_;
+        lhs->sibling_ = rhs->sibling_ = lhs->prev_ = rhs->prev_ = nullptr;
+        auto pair = link_(lhs, rhs);
+        pair->sibling_ = pairs;
+        pairs = pair;
+      }
+
+      // second pass, the pairs are linked from the rightmost one
+      auto root = pairs;
+      pairs = pairs->sibling_;
+      root->sibling_ = nullptr;
+      // loop invariant: root is the tree of the pairs linked so far
+      while (pairs) {
+        auto next = pairs->sibling_;
+        pairs->sibling_ = nullptr;
+        root = link_(root, pairs);
+        pairs = next;
+      }
+      return root;
+    }
+
+    value_compare comp_;
+    allocator_type allocator_;
+    node* root_;
+    size_type items_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs heaps.
+   * \details Non member function, noexcept it cannot fail.
+   * \precondition The allocators are equal or they propagate on swap.
+   * \postcondition The lhs heap becomes the rhs heap and viceversa.
+   * \complexity O(1)
+   * \param lhs Heap to be exchanged with rhs.
+   * \param rhs Heap to be exchanged with lhs.
+   */
+  template <typename T, typename Compare, typename Allocator>
+  void swap (pairing_heap<T, Compare, Allocator>& lhs, pairing_heap<T, Compare, Allocator>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief pairing_heap whose nodes are allocated from a std::pmr::memory_resource
+   */
+  template <typename T, typename Compare = std::less<T>>
+  using pairing_heap = ds::pairing_heap<T, Compare, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif //ALGOL_DS_PAIRING_HEAP_HPP
@@ -0,0 +1,53 @@
+/**
+ * \file
+ * Priority queue ADT errors
+ * A priority queue is a collection whose only accessible item is the one with the highest priority,
+ * the priority is given by a comparison: with std::less the top is the greatest item (a max-heap),
+ * with std::greater it is the least item (a min-heap)
+ */
+
+#ifndef ALGOL_DS_PRIORITY_QUEUE_HPP
+#define ALGOL_DS_PRIORITY_QUEUE_HPP
+
+#include <stdexcept>
+#include <string>
+
+namespace algol::ds {
+  /**
+   * \brief Base priority queue exception.
+   * \details Can be used to catch every priority queue exceptions.
+   */
+  struct priority_queue_error : public virtual std::logic_error {
+#if defined(__clang__)
+    using std::logic_error::logic_error;
+#else
+
+    explicit priority_queue_error (std::string const& what_arg) : std::logic_error {what_arg}
+    {}
+
+#endif
+  };
+
+  /**
+   * \brief Throwed when the priority queue is empty.
+   * \details Throwed from top and pop operation.
+   */
+  struct priority_queue_empty_error : public priority_queue_error {
+    explicit priority_queue_empty_error (std::string const& what_arg) : std::logic_error {what_arg},
+                                                                        priority_queue_error {what_arg}
+    {}
+  };
+
+  /**
+   * \brief Throwed when a key is not accepted.
+   * \details Throwed from decrease_key when the new value has a lower priority than the actual one and from the
+   * push of the monotone priority queues when the key is less than the last key popped or out of their bounds.
+   */
+  struct priority_queue_key_error : public priority_queue_error {
+    explicit priority_queue_key_error (std::string const& what_arg) : std::logic_error {what_arg},
+                                                                      priority_queue_error {what_arg}
+    {}
+  };
+}
+
+#endif //ALGOL_DS_PRIORITY_QUEUE_HPP
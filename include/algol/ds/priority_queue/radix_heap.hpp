@@ -0,0 +1,324 @@
+/**
+ * \file
+ * Radix heap implementation of the monotone priority queue ADT
+ * A monotone priority queue pops the items in increasing order of an integer key and accepts only the keys that
+ * are not less than the last key popped, as the tentative distances of Dijkstra's algorithm or the times of
+ * the events of a simulation. The radix heap keeps B+1 buckets, B the number of bits of the keys: bucket 0 holds
+ * the keys equal to the last key popped and bucket i the keys whose highest bit different from it is the bit i-1.
+ * When the bucket 0 is empty the least key of the first bucket not empty is popped and the other items of that
+ * bucket are spread in the lower buckets, every item goes down at most B times.
+ */
+
+#ifndef ALGOL_DS_RADIX_HEAP_HPP
+#define ALGOL_DS_RADIX_HEAP_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "priority_queue.hpp"
+#include "algol/integer/integer_interval.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the monotone priority queue ADT using a radix heap
+   * \details The items are pairs of a key and a value, the top is an item with the least key.
+   * The keys are bounded by an integer_interval, a narrower interval means fewer buckets
+   * \tparam Key integer type of the keys
+   * \tparam T type of the values stored with the keys
+   * \tparam Allocator allocator of the items
+   * \invariant The keys of the items are not less than the last key popped and the items of bucket i have
+   * the highest bit different from the last key popped at the position i-1
+   */
+  template <concepts::Integral Key, concepts::CopyConstructible T,
+      typename Allocator = std::allocator<std::pair<Key, T>>>
+  class radix_heap {
+  public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Comparison of the items, an item with a greater key has a lower priority
+     */
+    struct value_compare {
+      bool operator() (value_type const& lhs, value_type const& rhs) const
+      {
+        return rhs.first < lhs.first;
+      }
+    };
+
+    /**
+     * \brief Construct an empty heap for every key of Key
+     * \precondition None
+     * \postcondition The heap is empty
+     * \complexity O(B)
+     */
+    radix_heap ()
+        : radix_heap(integer::integer_interval<Key>{std::numeric_limits<Key>::min(), std::numeric_limits<Key>::max()})
+    {}
+
+    /**
+     * \brief Construct an empty heap for the keys in [keys.lower(), keys.upper()]
+     * \precondition keys.lower() <= keys.upper()
+     * \postcondition The heap is empty, the first key pushed is not less than keys.lower()
+     * \complexity O(LOG2 C), C the width of the keys interval
+     * \throws priority_queue_key_error if keys.upper() < keys.lower()
+     * \param keys The interval of the keys
+     * \param allocator The allocator of the items
+     */
+    explicit radix_heap (integer::integer_interval<Key> const& keys, allocator_type const& allocator = allocator_type{})
+        : lower_ {keys.lower()}, span_ {offset_(keys.upper())}, last_ {0}, top_bucket_ {0}, items_ {0},
+          buckets_(bucket_count_(span_), bucket_type{allocator}, bucket_allocator_type{allocator}),
+          min_index_(buckets_.size(), size_type{0})
+    {
+      if (keys.upper() < keys.lower())
+        throw priority_queue_key_error{"Attempting construction with an empty keys interval"};
+    }
+
+    /**
+     * \brief The heap is empty?
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return True if the heap is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return items_ == 0;
+    }
+
+    /**
+     * \brief The number of items in the heap
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return The number of items
+     */
+    size_type size () const noexcept
+    {
+      return items_;
+    }
+
+    /**
+     * \brief The item with the least key
+     * \precondition The heap is not empty
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \throws priority_queue_empty_error if the heap is empty
+     * \return The item on top of the heap
+     */
+    const_reference top () const
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting top() on empty heap"};
+      auto const& bucket = buckets_[top_bucket_];
+      return top_bucket_ == 0 ? bucket.back() : bucket[min_index_[top_bucket_]];
+    }
+
+    /**
+     * \brief The least key that can be pushed
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return The last key popped or the lower bound of the keys if no key is popped
+     */
+    key_type last_key () const noexcept
+    {
+      return static_cast<key_type>(static_cast<unsigned_key>(lower_) + last_);
+    }
+
+    /**
+     * \brief Add an item to the heap
+     * \precondition The key is not less than last_key() and it is in the keys interval
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(1)
+     * \throws priority_queue_key_error if the key is not accepted
+     * \param value The item to add
+     */
+    void push (value_type const& value)
+    {
+      push_(value);
+    }
+
+    /**
+     * \brief Add an item to the heap with move operation
+     * \precondition The key is not less than last_key() and it is in the keys interval
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(1)
+     * \throws priority_queue_key_error if the key is not accepted
+     * \param value The item to add
+     */
+    void push (value_type&& value)
+    {
+      push_(std::move(value));
+    }
+
+    /**
+     * \brief Add an item with the key provided and the value constructed in place from args
+     * \precondition The key is not less than last_key() and it is in the keys interval
+     * \postcondition The size of the heap is increased by 1
+     * \complexity O(1)
+     * \throws priority_queue_key_error if the key is not accepted
+     * \param key The key of the item
+     * \param args The arguments forwarded to the constructor of the value
+     */
+    template <typename... Args>
+    void emplace (key_type key, Args&& ... args)
+    {
+      push_(value_type{std::piecewise_construct, std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...)});
+    }
+
+    /**
+     * \brief Remove the item with the least key
+     * \details If the bucket 0 is empty the items of the first bucket not empty are spread in the lower buckets
+     * \precondition The heap is not empty
+     * \postcondition The size of the heap is decreased by 1, last_key() is the key of the item removed
+     * \complexity O(LOG2 C) amortized
+     * \throws priority_queue_empty_error if the heap is empty
+     */
+    void pop ()
+    {
+      if (empty())
+        throw priority_queue_empty_error{"Attempting pop() on empty heap"};
+
+      auto& bucket = buckets_[top_bucket_];
+      if (top_bucket_ == 0) {
+        bucket.pop_back();
+      }
+      else {
+        auto min = min_index_[top_bucket_];
+        last_ = offset_(bucket[min].first);
+        if (min != bucket.size() - 1)
+          bucket[min] = std::move(bucket.back());
+        bucket.pop_back();
+        // loop invariant: the items before item are in the buckets of their key relative to the new last_
+        for (auto& item : bucket)
+          insert_(std::move(item));
+        bucket.clear();
+      }
+      items_--;
+
+      top_bucket_ = 0;
+      if (items_ > 0)
+        while (buckets_[top_bucket_].empty())
+          top_bucket_++;
+    }
+
+    /**
+     * \brief Remove all the items
+     * \precondition None
+     * \postcondition The heap is empty, last_key() is unchanged
+     * \complexity O(N + LOG2 C)
+     */
+    void clear () noexcept
+    {
+      for (auto& bucket : buckets_)
+        bucket.clear();
+      items_ = 0;
+      top_bucket_ = 0;
+    }
+
+    /**
+     * \brief The comparison of the items
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return The comparison by key
+     */
+    value_compare value_comp () const
+    {
+      return value_compare{};
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The heap is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return buckets_.front().get_allocator();
+    }
+
+  private:
+    using unsigned_key = std::make_unsigned_t<Key>;
+    using bucket_type = std::vector<value_type, allocator_type>;
+    using bucket_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<bucket_type>;
+
+    // the number of bits needed to represent value, 0 for 0
+    static size_type bit_width_ (unsigned_key value) noexcept
+    {
+      size_type width = 0;
+#if defined(__GNUC__)
+      if (value != 0)
+        width = std::numeric_limits<unsigned long long>::digits
+                - static_cast<size_type>(__builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+      // loop invariant: value has width bits less than the original value
+      for (; value != 0; value >>= 1)
+        width++;
+#endif
+      return width;
+    }
+
+    // the buckets 0 ... bit_width(span)
+    static size_type bucket_count_ (unsigned_key span) noexcept
+    {
+      return bit_width_(span) + 1;
+    }
+
+    // the distance of the key from the lower bound, the order of the keys is preserved
+    unsigned_key offset_ (key_type key) const noexcept
+    {
+      return static_cast<unsigned_key>(static_cast<unsigned_key>(key) - static_cast<unsigned_key>(lower_));
+    }
+
+    template <typename U>
+    void push_ (U&& value)
+    {
+      auto offset = offset_(value.first);
+      if (offset < last_ || offset > span_)
+        throw priority_queue_key_error{"Attempting push() with a key less than the last key popped or out of bounds"};
+      auto bucket = insert_(std::forward<U>(value));
+      if (items_ == 0 || bucket < top_bucket_)
+        top_bucket_ = bucket;
+      items_++;
+    }
+
+    // put the item in the bucket of its key and update the least key of the bucket
+    template <typename U>
+    size_type insert_ (U&& value)
+    {
+      auto offset = offset_(value.first);
+      auto index = bit_width_(static_cast<unsigned_key>(offset ^ last_));
+      auto& bucket = buckets_[index];
+      bucket.push_back(std::forward<U>(value));
+      if (bucket.size() == 1 || offset < offset_(bucket[min_index_[index]].first))
+        min_index_[index] = bucket.size() - 1;
+      return index;
+    }
+
+    key_type lower_;
+    unsigned_key span_;
+    unsigned_key last_;
+    size_type top_bucket_;
+    size_type items_;
+    std::vector<bucket_type, bucket_allocator_type> buckets_;
+    std::vector<size_type> min_index_;
+  };
+}
+
+#endif //ALGOL_DS_RADIX_HEAP_HPP
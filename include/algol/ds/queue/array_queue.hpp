@@ -0,0 +1,413 @@
+/**
+ * \file
+ * Array queue implementation.
+ */
+
+#ifndef ALGOL_DS_ARRAY_QUEUE_HPP
+#define ALGOL_DS_ARRAY_QUEUE_HPP
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+#include "queue.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the Queue ADT using a std::array as circular buffer
+   * \details A queue is a sequence that can be accessed in <b>'first-in, first-out' (FIFO) order</b>
+   * The only accessible item is the one that was least recently added (enqueued).
+   * The items live inside the queue object and every operation is constexpr, as for
+   * [array_stack](@ref array_stack): a breadth first search can run in a constant expression and its result
+   * becomes a table of the program.
+   * The preconditions of the operations are enforced, postconditions and invariant aren't enforced.
+   * \tparam T type of the items stored in the queue, default constructible since the array constructs N items
+   * \tparam N capacity of the queue
+   * \invariant The item that is accessible at the front of the queue is the item that has
+   * least recently been enqueued onto it and not yet dequeued (removed).
+   */
+  template <concepts::CopyConstructible T, std::size_t N>
+  class array_queue final {
+    static_assert(N > 0, "array_queue capacity must be greater than zero");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    constexpr bool empty () const
+    {
+      return items_ == size_type{0};
+    }
+
+    /**
+     * \brief The queue is full?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is full, false otherwise
+     */
+    constexpr bool full () const
+    {
+      return items_ == N;
+    }
+
+    /**
+     * \brief The size of the queue
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the queue
+     */
+    constexpr size_type size () const
+    {
+      return items_;
+    }
+
+    /**
+     * \brief A constant reference at the item on the front of the queue
+     * \precondition The queue is not empty
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item on the front of the queue
+     */
+    constexpr const_reference front () const&
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting front() on empty queue"};
+
+      return array_[front_item_];
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \precondition The queue is not full
+     * \postcondition The size of the Queue is increased by 1 and the item passed becomes the last item
+     * \complexity O(1)
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \param value The item to enqueue onto the queue
+     */
+    constexpr void enqueue (value_type const& value)
+    {
+      if (full())
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+
+      array_[rear_item_] = value;
+      rear_item_ = next_(rear_item_);
+      items_++;
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \precondition The queue is not full
+     * \postcondition The size of the Queue is increased by 1 and the item passed becomes the last item
+     * \complexity O(1)
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \param value The item to enqueue onto the queue with move operation
+     */
+    constexpr void enqueue (value_type&& value)
+    {
+      if (full())
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+
+      array_[rear_item_] = std::move(value);
+      rear_item_ = next_(rear_item_);
+      items_++;
+    }
+
+    /**
+     * \brief Dequeue the current front item from the queue
+     * \details The item stays in the array until its slot is reused
+     * \precondition The queue is not empty
+     * \postcondition The size of the Queue is decreased by 1 and the current front item is removed from the queue
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     */
+    constexpr void dequeue ()
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+
+      front_item_ = next_(front_item_);
+      items_--;
+    }
+
+    /**
+     * \brief Clear the queue removing all the items
+     * \details Invalidates any references or pointers referring to contained elements
+     * \precondition None
+     * \postcondition The queue is empty, the size becomes 0
+     * \complexity O(1)
+     */
+    constexpr void clear ()
+    {
+      items_ = size_type{0};
+      front_item_ = size_type{0};
+      rear_item_ = size_type{0};
+    }
+
+    /**
+     * \brief Creates a vector with the items enqueued onto the queue
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \return A vector with the items enqueued onto the queue, the front first
+     */
+    std::vector<value_type> to_vector () const
+    {
+      std::vector<value_type> vector {};
+      vector.reserve(size());
+
+      for (auto i = size_type{0}; i < items_; ++i) {
+        vector.emplace_back(array_[(front_item_ + i) % N]);
+      }
+      return vector;
+    }
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(1)
+     */
+    constexpr array_queue ()
+    noexcept(std::is_nothrow_default_constructible_v<value_type> && noexcept(size_type{0}))
+        : items_ {size_type{0}}, front_item_ {size_type{0}}, rear_item_ {size_type{0}}, array_ {}
+    {}
+
+    /**
+     * \brief Construct a queue with values provided
+     * \details The values are enqueued onto the queue starting at begin of initializer list and stopping at the end
+     * If the initializer_list contains {1, 2, 3, 4} the front of the queue will be 1
+     * \precondition The initializer_list has at most N values
+     * \postcondition The queue size is the same of the initializer_list and all the items contained in the
+     * initializer_list are enqueued onto the queue
+     * \complexity O(N)
+     * \throws queue_full_error if the initializer_list has more than N values
+     * \param values The items to be enqueued onto the queue
+     */
+    constexpr array_queue (std::initializer_list<value_type> values) : array_queue()
+    {
+      for (auto const& v : values)
+        enqueue(v);
+    }
+
+    /**
+     * \brief Copy constructor
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue
+     * \complexity O(N)
+     * \param rhs The queue to be copied
+     */
+    constexpr array_queue (array_queue const&) = default;
+
+    /**
+     * \brief Move constructor
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue
+     * \complexity O(N) moving std:array is O(N)
+     * \param rhs The queue to be moved, items contained are 'stolen' from this queue
+     */
+    constexpr array_queue (array_queue&&) = default;
+
+    /**
+     * \brief Assignment operator
+     * \details The actual items of the queue are replaced with the items of the provided queue
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue
+     * \complexity O(N)
+     * \param rhs The queue to be copied
+     * \return The queue containing the provided queue items
+     */
+    constexpr array_queue& operator= (array_queue const&) = default;
+
+    /**
+     * \brief Move assignment operator
+     * \details The actual items of the queue are replaced with the items of the provided queue
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue
+     * \complexity O(N) moving std:array is O(N)
+     * \param rhs The queue to be moved, items contained are 'stolen' from this queue
+     * \return The queue containing the provided queue items
+     */
+    constexpr array_queue& operator= (array_queue&&) = default;
+
+    /**
+     * \brief Destructor
+     * \precondition None
+     * \postcondition The queue items are destroyed
+     * \complexity O(N) Destructor calls (for std::array elements)
+     */
+    ~array_queue () = default;
+
+    /**
+     * \brief Equality operator
+     * \details It must be reflexive, symmetric and transitive, the items are compared from the front
+     * wherever they are in the array
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \param rhs The queue to be compared with this
+     * \return True if the items are the same and in the same order, false otherwise
+     */
+    constexpr bool operator== (array_queue const& rhs) const
+    requires concepts::EqualityComparable<T>
+    {
+      if (items_ != rhs.items_)
+        return false;
+
+      for (auto i = size_type{0}; i < items_; ++i) {
+        if (array_[(front_item_ + i) % N] != rhs.array_[(rhs.front_item_ + i) % N])
+          return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * \brief Inequality operator
+     * \details Implemented in terms of equality operator
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \param rhs The queue to be compared with this
+     * \return True if the items are not the same or not in the same order, false otherwise
+     */
+    constexpr bool operator!= (array_queue const& rhs) const
+    requires concepts::EqualityComparable<T>
+    {
+      return !(*this == rhs);
+    }
+
+    /**
+     * \brief Less than operator
+     * \details Lexicographical comparison from the front, see [array_stack](@ref array_stack)
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \param rhs The queue to be compared with this
+     * \return True if this queue is lexicographically less than the provided queue, false otherwise
+     */
+    constexpr bool operator< (array_queue const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      auto items = std::min(items_, rhs.items_);
+      for (auto i = size_type{0}; i < items; ++i) {
+        auto j = (front_item_ + i) % N;
+        auto k = (rhs.front_item_ + i) % N;
+        if (array_[j] < rhs.array_[k])
+          return true;
+
+        if (array_[j] > rhs.array_[k])
+          return false;
+      }
+
+      return items_ < rhs.items_;
+    }
+
+    /**
+     * \brief Less than or equal operator
+     * \details Lexicographical comparison from the front
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \param rhs The queue to be compared with this
+     * \return True if this queue is lexicographically less than or equal to the provided queue, false otherwise
+     */
+    constexpr bool operator<= (array_queue const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return !(*this > rhs);
+    }
+
+    /**
+     * \brief Greater than operator
+     * \details Lexicographical comparison from the front
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \param rhs The queue to be compared with this
+     * \return True if this queue is lexicographically greater than the provided queue, false otherwise
+     */
+    constexpr bool operator> (array_queue const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return rhs < *this;
+    }
+
+    /**
+     * \brief Greater than or equal operator
+     * \details Lexicographical comparison from the front
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \param rhs The queue to be compared with this
+     * \return True if this queue is lexicographically greater than or equal to the provided queue, false otherwise
+     */
+    constexpr bool operator>= (array_queue const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return !(*this < rhs);
+    }
+
+    /**
+     * \brief Swaps the items of this queue with the items of the provided queue
+     * \details noexcept operation, it cannot throw
+     * \precondition None
+     * \postcondition This queue becomes the rhs queue and viceversa
+     * \complexity O(N) std::array swap is O(N)
+     * \param rhs The queue to be swapped with this
+     */
+    void swap (array_queue& rhs) noexcept(std::is_nothrow_swappable_v<value_type>)
+    {
+      using std::swap;
+      swap(items_, rhs.items_);
+      swap(front_item_, rhs.front_item_);
+      swap(rear_item_, rhs.rear_item_);
+      swap(array_, rhs.array_);
+    }
+
+  private:
+    // the slot after i in the circular buffer
+    static constexpr size_type next_ (size_type i)
+    {
+      return i + 1 == N ? size_type{0} : i + 1;
+    }
+
+    size_type items_;
+    size_type front_item_;
+    size_type rear_item_;
+    std::array<value_type, N> array_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs queues
+   * \details Non member function, noexcept it cannot fail
+   * \tparam T type of the items stored in the queue
+   * \precondition None
+   * \postcondition The lhs queue becomes the rhs queue and viceversa
+   * \complexity O(N)
+   * \param lhs Queue to be exchanged with rhs
+   * \param rhs Queue to be exchanged with lhs
+   */
+  template <typename T, std::size_t N>
+  void swap (array_queue<T, N>& lhs, array_queue<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif //ALGOL_DS_ARRAY_QUEUE_HPP
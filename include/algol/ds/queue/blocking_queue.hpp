@@ -0,0 +1,556 @@
+/**
+ * \file
+ * Bounded blocking queue implementation.
+ */
+
+#ifndef ALGOL_DS_BLOCKING_QUEUE_HPP
+#define ALGOL_DS_BLOCKING_QUEUE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "queue.hpp"
+#include "fixed_queue.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Bounded queue for any number of producers and consumers that blocks them while it is full or empty
+   * \details The items are kept in a [fixed_queue](@ref fixed_queue) protected by a mutex, the producers
+   * wait on a condition variable while the queue is full and the consumers on another one while it has not
+   * the items they want. Every wait operation has a timed version, for_ with a duration and until_ with a
+   * time point, that gives up when the time is over.
+   * A consumer of a batch tells how many items it wants and the producers wake it only once that many
+   * items are enqueued, not at every item: a pipeline that moves items in batches pays a context switch per
+   * batch. The producers are woken once for every dequeue, a producer woken always finds room.
+   * close ends the stream: the enqueue operations throw queue_closed_error, the consumers dequeue the items
+   * still enqueued and then the wait operations return false or less items than wanted instead of blocking.
+   * \tparam T type of the items stored in the queue
+   * \tparam N capacity of the queue
+   * \tparam Allocator allocator of the array of the fixed_queue
+   * \invariant The items dequeued by a consumer that were enqueued by the same producer are dequeued
+   * in the same order they were enqueued
+   */
+  template <concepts::CopyConstructible T, std::size_t N, typename Allocator = std::allocator<T>>
+  class blocking_queue final {
+    static_assert(N > 0, "blocking_queue capacity must be greater than zero");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The queue is empty and open
+     * \complexity O(1)
+     */
+    blocking_queue () : blocking_queue(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty queue whose array is allocated with the provided allocator
+     * \precondition None
+     * \postcondition The queue is empty and open
+     * \complexity O(1)
+     * \param allocator The allocator of the array
+     */
+    explicit blocking_queue (allocator_type const& allocator) : queue_ {allocator}
+    {}
+
+    // the threads wait on the queue, it cannot be copied nor moved
+    blocking_queue (blocking_queue const&) = delete;
+    blocking_queue& operator= (blocking_queue const&) = delete;
+
+    /**
+     * \brief The capacity of the queue
+     * \precondition None
+     * \complexity O(1)
+     * \return N
+     */
+    static constexpr size_type capacity () noexcept
+    {
+      return N;
+    }
+
+    /**
+     * \brief The queue is empty?
+     * \details With concurrent operations the answer can be stale
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      return queue_.empty();
+    }
+
+    /**
+     * \brief The queue is full?
+     * \details With concurrent operations the answer can be stale
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is full, false otherwise
+     */
+    bool full () const
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      return queue_.full();
+    }
+
+    /**
+     * \brief The number of items in the queue
+     * \details With concurrent operations the size can be stale
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the queue
+     */
+    size_type size () const
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      return queue_.size();
+    }
+
+    /**
+     * \brief Close the queue, the items enqueued can still be dequeued
+     * \details Every waiting thread is woken
+     * \precondition None
+     * \postcondition The queue is closed
+     * \complexity O(1)
+     */
+    void close ()
+    {
+      {
+        std::lock_guard<std::mutex> lock {mutex_};
+        closed_ = true;
+      }
+      not_full_.notify_all();
+      not_empty_.notify_all();
+    }
+
+    /**
+     * \brief The queue is closed?
+     * \precondition None
+     * \complexity O(1)
+     * \return True if close has been called, false otherwise
+     */
+    bool closed () const
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      return closed_;
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue if the queue is not full
+     * \precondition The queue is not closed
+     * \postcondition If the queue was not full the item passed is enqueued, otherwise the queue is not changed
+     * \complexity O(1)
+     * \throws queue_closed_error if the queue is closed
+     * \param value The item to enqueue onto the queue
+     * \return True if the item is enqueued, false if the queue is full
+     */
+    bool try_enqueue (value_type const& value)
+    {
+      return try_enqueue_(value);
+    }
+
+    bool try_enqueue (value_type&& value)
+    {
+      return try_enqueue_(std::move(value));
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \precondition The queue is not full nor closed
+     * \postcondition The item passed is enqueued
+     * \complexity O(1)
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \throws queue_closed_error if the queue is closed
+     * \param value The item to enqueue onto the queue
+     */
+    void enqueue (value_type value)
+    {
+      if (!try_enqueue_(std::move(value)))
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue, waiting while the queue is full
+     * \precondition The queue is not closed
+     * \postcondition The item passed is enqueued
+     * \complexity O(1) if the queue is not full
+     * \throws queue_closed_error if the queue is closed before the item is enqueued
+     * \param value The item to enqueue onto the queue
+     */
+    void wait_enqueue (value_type const& value)
+    {
+      wait_enqueue_(value, no_deadline);
+    }
+
+    void wait_enqueue (value_type&& value)
+    {
+      wait_enqueue_(std::move(value), no_deadline);
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue, waiting while the queue is full at most until deadline
+     * \precondition The queue is not closed
+     * \postcondition The item passed is enqueued if room was made before deadline, otherwise the queue and
+     * value are not changed
+     * \complexity O(1) if the queue is not full
+     * \throws queue_closed_error if the queue is closed before the item is enqueued
+     * \param value The item to enqueue onto the queue
+     * \param deadline The time point after which the wait gives up
+     * \return True if the item is enqueued, false if the time is over
+     */
+    template <typename Clock, typename Duration>
+    bool wait_enqueue_until (value_type&& value, std::chrono::time_point<Clock, Duration> const& deadline)
+    {
+      return wait_enqueue_(std::move(value), &deadline);
+    }
+
+    template <typename Clock, typename Duration>
+    bool wait_enqueue_until (value_type const& value, std::chrono::time_point<Clock, Duration> const& deadline)
+    {
+      return wait_enqueue_(value, &deadline);
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue, waiting while the queue is full at most for timeout
+     * \details see wait_enqueue_until
+     * \param value The item to enqueue onto the queue
+     * \param timeout The duration after which the wait gives up
+     * \return True if the item is enqueued, false if the time is over
+     */
+    template <typename Rep, typename Period>
+    bool wait_enqueue_for (value_type&& value, std::chrono::duration<Rep, Period> const& timeout)
+    {
+      return wait_enqueue_until(std::move(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Rep, typename Period>
+    bool wait_enqueue_for (value_type const& value, std::chrono::duration<Rep, Period> const& timeout)
+    {
+      return wait_enqueue_until(value, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * \brief Enqueue the items of the range onto the queue, waiting for room while the queue is full
+     * \details The items are enqueued in chunks as large as the room in the queue and the consumers are woken
+     * once for every chunk. If the queue is closed or a copy throws, the items before can be left in the queue
+     * \precondition The queue is not closed
+     * \postcondition The items of the range are enqueued in order
+     * \complexity O(M) where M is the number of the items of the range
+     * \throws queue_closed_error if the queue is closed before all the items are enqueued
+     * \tparam ForwardIt iterator type of the range
+     * \param first iterator to the first item to enqueue
+     * \param last iterator past the last item to enqueue
+     */
+    template <concepts::ForwardIterator ForwardIt>
+    void wait_enqueue_range (ForwardIt first, ForwardIt last)
+    {
+      auto count = static_cast<size_type>(std::distance(first, last));
+      // loop invariant: the items before first are enqueued
+      while (count > 0) {
+        std::unique_lock<std::mutex> lock {mutex_};
+        wait_room_(lock, no_deadline);
+        auto chunk = std::min(count, N - queue_.size());
+        auto next = std::next(first, static_cast<typename std::iterator_traits<ForwardIt>::difference_type>(chunk));
+        queue_.enqueue_range(first, next);
+        first = next;
+        count -= chunk;
+        wake_consumers_(lock, chunk);
+      }
+    }
+
+    /**
+     * \brief Dequeue the front item moving it in value if the queue is not empty
+     * \precondition None
+     * \postcondition If the queue was not empty the item dequeued is moved in value, otherwise the queue
+     * and value are not changed
+     * \complexity O(1)
+     * \param value The item that receives the item dequeued
+     * \return True if an item is dequeued, false if the queue is empty
+     */
+    bool try_dequeue (value_type& value)
+    {
+      return try_dequeue_n(&value, 1) == 1;
+    }
+
+    /**
+     * \brief Dequeue the front item from the queue
+     * \precondition The queue is not empty
+     * \postcondition The item dequeued is returned and removed from the queue
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item dequeued
+     */
+    value_type dequeue ()
+    {
+      std::unique_lock<std::mutex> lock {mutex_};
+      if (queue_.empty())
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+      // the front item is destroyed right after, it is moved out as dequeue_n does
+      value_type value {std::move(const_cast<reference>(queue_.front()))};
+      queue_.dequeue();
+      wake_producers_(lock, 1);
+      return value;
+    }
+
+    /**
+     * \brief Dequeue the front item moving it in value, waiting while the queue is empty
+     * \precondition None
+     * \postcondition If an item is dequeued it is moved in value, otherwise the queue is closed and empty
+     * \complexity O(1) if the queue is not empty
+     * \param value The item that receives the item dequeued
+     * \return True if an item is dequeued, false if the queue is closed and empty
+     */
+    bool wait_dequeue (value_type& value)
+    {
+      return wait_dequeue_n_(&value, 1, 1, no_deadline) == 1;
+    }
+
+    /**
+     * \brief Dequeue the front item moving it in value, waiting while the queue is empty at most until deadline
+     * \precondition None
+     * \postcondition If an item is dequeued it is moved in value, otherwise the time is over or the queue is
+     * closed and empty
+     * \complexity O(1) if the queue is not empty
+     * \param value The item that receives the item dequeued
+     * \param deadline The time point after which the wait gives up
+     * \return True if an item is dequeued, false otherwise
+     */
+    template <typename Clock, typename Duration>
+    bool wait_dequeue_until (value_type& value, std::chrono::time_point<Clock, Duration> const& deadline)
+    {
+      return wait_dequeue_n_(&value, 1, 1, &deadline) == 1;
+    }
+
+    template <typename Rep, typename Period>
+    bool wait_dequeue_for (value_type& value, std::chrono::duration<Rep, Period> const& timeout)
+    {
+      return wait_dequeue_until(value, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * \brief Dequeue up to count items moving them in the range starting at out
+     * \precondition out can be incremented count times
+     * \postcondition min(count, size) items are moved in order in out and removed from the queue
+     * \complexity O(count)
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count maximum number of items to dequeue
+     * \return The number of items dequeued
+     */
+    template <typename OutputIt>
+    size_type try_dequeue_n (OutputIt out, size_type count)
+    {
+      std::unique_lock<std::mutex> lock {mutex_};
+      count = std::min(count, queue_.size());
+      if (count > 0) {
+        queue_.dequeue_n(out, count);
+        wake_producers_(lock, count);
+      }
+      return count;
+    }
+
+    /**
+     * \brief Dequeue count items moving them in the range starting at out, waiting until they are enqueued
+     * \details The producers wake the consumer when min(count, N) items are enqueued, the consumer takes
+     * up to count items: a batch costs one wake up. If count is greater than N the items are taken in batches
+     * of N
+     * \precondition out can be incremented count times
+     * \postcondition count items are moved in order in out, less only if the queue is closed and empty
+     * \complexity O(count)
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count number of the items to dequeue
+     * \return The number of items dequeued
+     */
+    template <typename OutputIt>
+    size_type wait_dequeue_n (OutputIt out, size_type count)
+    {
+      auto dequeued = size_type{0};
+      // loop invariant: dequeued items are moved in the output range
+      while (dequeued < count) {
+        auto batch = wait_dequeue_n_(out, count - dequeued, std::min(count - dequeued, N), no_deadline);
+        if (batch == 0)
+          break;
+        std::advance(out, static_cast<typename std::iterator_traits<OutputIt>::difference_type>(batch));
+        dequeued += batch;
+      }
+      return dequeued;
+    }
+
+    /**
+     * \brief Dequeue up to count items moving them in the range starting at out, waiting until min(count, N)
+     * items are enqueued at most until deadline
+     * \details When the time is over the items enqueued are taken, the wait for a batch is bounded by deadline
+     * \precondition out can be incremented count times
+     * \postcondition up to count items are moved in order in out
+     * \complexity O(count)
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count maximum number of items to dequeue
+     * \param deadline The time point after which the wait gives up
+     * \return The number of items dequeued, it can be zero
+     */
+    template <typename OutputIt, typename Clock, typename Duration>
+    size_type wait_dequeue_n_until (OutputIt out, size_type count,
+                                    std::chrono::time_point<Clock, Duration> const& deadline)
+    {
+      return wait_dequeue_n_(out, count, std::min(count, N), &deadline);
+    }
+
+    template <typename OutputIt, typename Rep, typename Period>
+    size_type wait_dequeue_n_for (OutputIt out, size_type count, std::chrono::duration<Rep, Period> const& timeout)
+    {
+      return wait_dequeue_n_until(out, count, std::chrono::steady_clock::now() + timeout);
+    }
+
+  private:
+    using deadline_type = std::chrono::steady_clock::time_point;
+
+    // the wait operations without a time limit pass a null deadline
+    static constexpr deadline_type const* no_deadline = nullptr;
+    static constexpr size_type no_wake = std::numeric_limits<size_type>::max();
+
+    // wait on cv until ready() holds, or until the deadline if it is not null; true if ready() holds
+    template <typename Ready, typename Deadline>
+    static bool wait_ (std::unique_lock<std::mutex>& lock, std::condition_variable& cv, Ready ready,
+                       Deadline const* deadline)
+    {
+      if (deadline == nullptr) {
+        cv.wait(lock, ready);
+        return true;
+      }
+      return cv.wait_until(lock, *deadline, ready);
+    }
+
+    // wait for a free slot, true if there is room, false if the time is over
+    template <typename Deadline>
+    bool wait_room_ (std::unique_lock<std::mutex>& lock, Deadline const* deadline)
+    {
+      if (closed_)
+        throw queue_closed_error{"Attempting enqueue() on closed queue"};
+      if (!queue_.full())
+        return true;
+      ++producers_waiting_;
+      auto room = wait_(lock, not_full_, [this] { return closed_ || !queue_.full(); }, deadline);
+      --producers_waiting_;
+      if (closed_)
+        throw queue_closed_error{"Attempting enqueue() on closed queue"};
+      return room;
+    }
+
+    template <typename U>
+    bool try_enqueue_ (U&& value)
+    {
+      std::unique_lock<std::mutex> lock {mutex_};
+      if (closed_)
+        throw queue_closed_error{"Attempting enqueue() on closed queue"};
+      if (queue_.full())
+        return false;
+      queue_.enqueue(std::forward<U>(value));
+      wake_consumers_(lock, 1);
+      return true;
+    }
+
+    template <typename U, typename Deadline>
+    bool wait_enqueue_ (U&& value, Deadline const* deadline)
+    {
+      std::unique_lock<std::mutex> lock {mutex_};
+      if (!wait_room_(lock, deadline))
+        return false;
+      queue_.enqueue(std::forward<U>(value));
+      wake_consumers_(lock, 1);
+      return true;
+    }
+
+    // wait until wanted items are enqueued, the queue is closed or the deadline, then take up to count items
+    template <typename OutputIt, typename Deadline>
+    size_type wait_dequeue_n_ (OutputIt out, size_type count, size_type wanted, Deadline const* deadline)
+    {
+      std::unique_lock<std::mutex> lock {mutex_};
+      if (queue_.size() < wanted && !closed_) {
+        ++consumers_waiting_;
+        if (wanted > 1)
+          ++batch_consumers_waiting_;
+        // loop invariant: the consumer is registered, the producers wake it when wake_size_ items are enqueued
+        auto ready = [this, wanted] {
+          if (queue_.size() >= wanted || closed_)
+            return true;
+          wake_size_ = std::min(wake_size_, wanted);
+          return false;
+        };
+        wait_(lock, not_empty_, ready, deadline);
+        if (wanted > 1)
+          --batch_consumers_waiting_;
+        if (--consumers_waiting_ == 0)
+          wake_size_ = no_wake;
+      }
+      count = std::min(count, queue_.size());
+      if (count > 0) {
+        queue_.dequeue_n(out, count);
+        wake_producers_(lock, count);
+      }
+      return count;
+    }
+
+    // called after enqueued items are enqueued, the lock is released before the notify
+    void wake_consumers_ (std::unique_lock<std::mutex>& lock, size_type enqueued)
+    {
+      if (consumers_waiting_ == 0 || queue_.size() < wake_size_)
+        return;
+      // the consumers of single items are woken one for every item, the consumers of batches all together
+      // when the smallest batch is complete and then they register again
+      auto all = enqueued > 1 || batch_consumers_waiting_ > 0;
+      if (all)
+        wake_size_ = no_wake;
+      lock.unlock();
+      if (all)
+        not_empty_.notify_all();
+      else
+        not_empty_.notify_one();
+    }
+
+    // called after dequeued items are dequeued, the lock is released before the notify
+    void wake_producers_ (std::unique_lock<std::mutex>& lock, size_type dequeued)
+    {
+      if (producers_waiting_ == 0)
+        return;
+      lock.unlock();
+      if (dequeued > 1)
+        not_full_.notify_all();
+      else
+        not_full_.notify_one();
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    fixed_queue<value_type, N, allocator_type> queue_;
+    size_type producers_waiting_ {0};
+    size_type consumers_waiting_ {0};
+    size_type batch_consumers_waiting_ {0};
+    // the number of items that completes the smallest batch a consumer is waiting for
+    size_type wake_size_ {no_wake};
+    bool closed_ {false};
+  };
+}
+
+#endif //ALGOL_DS_BLOCKING_QUEUE_HPP
@@ -4,7 +4,7 @@
 #include "stl2/concepts.hpp"
 
 namespace algol::concepts {
-  template <typename S>
+  template <typename Q>
   concept bool Queue ()
   {
     return requires(Q
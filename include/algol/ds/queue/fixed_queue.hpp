@@ -7,9 +7,12 @@
 #define ALGOL_DS_FIXED_QUEUE_HPP
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
+#include <type_traits>
 #include <cassert>
-#include "queue.hpp"
+#include "static_queue.hpp"
+#include "algol/ds/allocator.hpp"
 #include "stl2/concepts.hpp"
 
 namespace algol::ds {
@@ -17,18 +20,31 @@ namespace algol::ds {
 
   /**
    * \brief Implementation of the Queue ADT using a fixed array
-   * \details see class [queue](@ref queue)
+   * \details see class [queue](@ref queue), the operations are dispatched at compile time by
+   * [static_queue](@ref static_queue)
+   * The array is uninitialized storage: an item is constructed when it is enqueued and destroyed when it is
+   * dequeued, so T does not need to be default constructible.
+   * With the inline_storage tag in place of the allocator the array is kept inside the queue object and the queue
+   * never allocates, moving and swapping such a queue moves the items one by one.
    * \tparam T type of the items stored in the queue
+   * \tparam N capacity of the queue
+   * \tparam Allocator allocator of the array, for example a std::pmr::polymorphic_allocator, or inline_storage
    * \invariant The item that is accessible at the front of the queue is the item that has
    * least recently been enqueued onto it and not yet dequeued (removed)
    */
-  template <concepts::CopyConstructible T, typename queue<T>::size_type N>
-  class fixed_queue final : public queue<T> {
+  template <concepts::CopyConstructible T, typename queue<T>::size_type N,
+            typename Allocator = std::allocator<T>>
+  class fixed_queue final : public static_queue<fixed_queue<T, N, Allocator>, T> {
+    static constexpr bool is_inline_ = std::is_same_v<Allocator, inline_storage>;
+    // the items of an inline queue are moved on move and swap
+    static constexpr bool nothrow_relocate_ = !is_inline_ || std::is_nothrow_move_constructible_v<T>;
+
   public:
     using value_type = typename queue<T>::value_type;
     using reference = typename queue<T>::reference;
     using const_reference = typename queue<T>::const_reference;
     using size_type = typename queue<T>::size_type;
+    using allocator_type = std::conditional_t<is_inline_, std::allocator<T>, Allocator>;
 
     /**
      * \brief Default constructor
@@ -36,11 +52,25 @@ namespace algol::ds {
      * \postcondition The queue is empty
      * \complexity O(1)
      */
-    fixed_queue ()
-        : queue<T>(), items_ {size_type{0}}, front_item_ {size_type{0}}, rear_item_ {size_type{0}},
-          array_ {std::make_unique<value_type[]>(N)}
+    fixed_queue () : fixed_queue(allocator_type{})
     {}
 
+    /**
+     * \brief Construct an empty queue whose array is allocated with the provided allocator
+     * \details The array is allocated, not initialized
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(1)
+     * \param allocator The allocator of the array
+     */
+    explicit fixed_queue (allocator_type const& allocator)
+        : items_ {size_type{0}}, front_item_ {size_type{0}}, rear_item_ {size_type{0}},
+          allocator_ {allocator}, array_ {}
+    {
+      if constexpr (!is_inline_)
+        array_ = detail::allocate_storage(allocator_, N);
+    }
+
     /**
      * \brief Construct a queue with values provided
      * \details The values are enqueued onto the queue starting at begin of initializer list and stopping at the end
@@ -50,65 +80,109 @@ namespace algol::ds {
      * initializer_list are enqueued onto the queue
      * \complexity O(N)
      * \param values The items to be enqueued onto the queue
+     * \param allocator The allocator of the array
      */
-    fixed_queue (std::initializer_list<value_type> values) : fixed_queue()
+    fixed_queue (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : fixed_queue(allocator)
     {
-      for (auto const& v : values)
-        enqueue_(v);
+      this->enqueue_range(values.begin(), values.end());
     }
 
     /**
      * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue
+     * \complexity O(N)
+     * \param rhs The queue to be copied
+     */
+    fixed_queue (fixed_queue const& rhs)
+        : fixed_queue(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
+
+    /**
+     * \brief Copy constructor with the allocator provided
      * \precondition None
      * \postcondition This queue is equal to the provided queue
      * \complexity O(N)
      * \param rhs The queue to be copied
+     * \param allocator The allocator of the array
      */
-    fixed_queue (fixed_queue const& rhs) : fixed_queue()
+    fixed_queue (fixed_queue const& rhs, allocator_type const& allocator) : fixed_queue(allocator)
     {
       assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
       assert(rhs.front_item_ >= size_type{0} && rhs.front_item_ < N);
       assert(rhs.rear_item_ >= size_type{0} && rhs.rear_item_ < N);
 
-      fixed_queue queue;
-
-      if (!rhs.empty()) {
-        for (auto i = size_type{0}; i < rhs.items_; ++i) {
-          auto j = (rhs.front_item_ + i) % N;
-          alloc_traits::destroy(allocator_, std::addressof(queue.array_[j]));
-          alloc_traits::construct(allocator_, std::addressof(queue.array_[j]), value_type{rhs.array_[j]});
-        }
-
-        queue.items_ = rhs.items_;
-        queue.front_item_ = rhs.front_item_;
-        queue.rear_item_ = rhs.rear_item_;
-      }
-      swap(queue);
+      // the items keep their slots, the copy starts at the front of rhs
+      front_item_ = rhs.front_item_;
+      rear_item_ = rhs.front_item_;
+      // the delegating constructor has completed, if a copy throws the destructor destroys the items copied
+      for (auto i = size_type{0}; i < rhs.items_; ++i)
+        emplace_(rhs.array_[(rhs.front_item_ + i) % N]);
     }
 
     /**
      * \brief Move constructor
      * \precondition None
      * \postcondition This queue is equal to the provided queue that becomes empty
-     * \complexity O(1)
+     * \complexity O(1), O(N) with inline storage
      * \param rhs The queue to be moved, items contained are 'stolen' from this queue
      */
-    fixed_queue (fixed_queue&& rhs) noexcept
-    : items_ {rhs.items_}, front_item_ {rhs.front_item_}, rear_item_ {rhs.rear_item_}, array_ {std::move(rhs.array_)}
+    fixed_queue (fixed_queue&& rhs) noexcept(nothrow_relocate_)
+        : items_ {size_type{0}}, front_item_ {size_type{0}}, rear_item_ {size_type{0}},
+          allocator_ {rhs.allocator_}, array_ {}
+    {
+      assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
+      assert(rhs.front_item_ >= size_type{0} && rhs.front_item_ < N);
+      assert(rhs.rear_item_ >= size_type{0} && rhs.rear_item_ < N);
+
+      if constexpr (is_inline_)
+        move_items_(rhs);
+      else
+        swap_items_(rhs);
+    }
+
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The array is stolen if the allocators are equal, otherwise the items are moved one by one
+     * into an array allocated with the provided allocator
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \param rhs The queue to be moved
+     * \param allocator The allocator of the array
+     */
+    fixed_queue (fixed_queue&& rhs, allocator_type const& allocator)
+        : items_ {size_type{0}}, front_item_ {size_type{0}}, rear_item_ {size_type{0}},
+          allocator_ {allocator}, array_ {}
     {
       assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
       assert(rhs.front_item_ >= size_type{0} && rhs.front_item_ < N);
       assert(rhs.rear_item_ >= size_type{0} && rhs.rear_item_ < N);
 
-      rhs.items_ = size_type{0};
-      rhs.front_item_ = size_type{0};
-      rhs.rear_item_ = size_type{0};
-      rhs.array_ = nullptr;
+      if constexpr (!is_inline_) {
+        if (allocator_ == rhs.allocator_) {
+          swap_items_(rhs);
+          return;
+        }
+        array_ = detail::allocate_storage(allocator_, N);
+      }
+
+      // the constructor has not completed, if a move throws the destructor would not release the array
+      try {
+        move_items_(rhs);
+      }
+      catch (...) {
+        release_();
+        throw;
+      }
     }
 
     /**
      * \brief Assignment operator
-     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue
+     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue,
+     * the allocator is replaced only if it propagates on copy assignment
      * \precondition None
      * \postcondition This queue is equal to the provided queue
      * \complexity O(N)
@@ -121,28 +195,42 @@ namespace algol::ds {
       assert(rhs.front_item_ >= size_type{0} && rhs.front_item_ < N);
       assert(rhs.rear_item_ >= size_type{0} && rhs.rear_item_ < N);
 
-      fixed_queue temp {rhs};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      fixed_queue temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
       return *this;
     }
 
     /**
      * \brief Move assignment operator
-     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue
+     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue,
+     * the array is stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
      * \precondition None
      * \postcondition This queue is equal to the provided queue that becomes empty
-     * \complexity O(1)
+     * \complexity O(1) if the array is stolen, O(N) otherwise
      * \param rhs The queue to be moved, items contained are 'stolen' from this queue
      * \return The queue containing the provided queue items
      */
-    fixed_queue& operator= (fixed_queue&& rhs) noexcept
+    fixed_queue& operator= (fixed_queue&& rhs)
+    noexcept((alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+             && nothrow_relocate_)
     {
       assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
       assert(rhs.front_item_ >= size_type{0} && rhs.front_item_ < N);
       assert(rhs.rear_item_ >= size_type{0} && rhs.rear_item_ < N);
 
-      fixed_queue temp {std::move(rhs)};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      fixed_queue temp {std::move(rhs), propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
       return *this;
     }
 
@@ -152,7 +240,22 @@ namespace algol::ds {
      * \postcondition The queue items are destroyed
      * \complexity O(N) Destructor calls
      */
-    ~fixed_queue () = default;
+    ~fixed_queue ()
+    {
+      release_();
+    }
+
+    /**
+     * \brief The allocator of the array
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
 
     /**
      * \brief Emplace the item passed onto the queue
@@ -337,13 +440,31 @@ namespace algol::ds {
 
     /**
      * \brief Swaps the items of this queue with the items of the provided queue
-     * \details noexcept operation, it cannot throw
-     * \precondition None
+     * \details noexcept operation, unless the items of an inline queue can throw on move.
+     * The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
      * \postcondition This queue becomes the rhs queue and viceversa
-     * \complexity O(1)
+     * \complexity O(1), O(N) with inline storage
      * \param rhs The queue to be swapped with this
      */
-    void swap (fixed_queue& rhs) noexcept
+    void swap (fixed_queue& rhs) noexcept(nothrow_relocate_)
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+  private:
+    friend class static_queue<fixed_queue, T>;
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    // swap the array and the indexes, not the allocators
+    void swap_items_ (fixed_queue& rhs) noexcept(nothrow_relocate_)
     {
       assert(items_ >= size_type{0} && items_ <= N);
       assert(front_item_ >= size_type{0} && front_item_ < N);
@@ -352,14 +473,57 @@ namespace algol::ds {
       assert(rhs.front_item_ >= size_type{0} && rhs.front_item_ < N);
       assert(rhs.rear_item_ >= size_type{0} && rhs.rear_item_ < N);
 
-      using std::swap;
-      swap(items_, rhs.items_);
-      swap(front_item_, rhs.front_item_);
-      swap(rear_item_, rhs.rear_item_);
-      swap(array_, rhs.array_);
+      if constexpr (is_inline_) {
+        // the arrays cannot be exchanged, the items are moved through a third queue
+        fixed_queue temp {};
+        temp.move_items_(*this);
+        move_items_(rhs);
+        rhs.move_items_(temp);
+      }
+      else {
+        using std::swap;
+        swap(items_, rhs.items_);
+        swap(front_item_, rhs.front_item_);
+        swap(rear_item_, rhs.rear_item_);
+        swap(array_, rhs.array_);
+      }
+    }
+
+    // move the items of rhs into this empty queue, rhs becomes empty
+    void move_items_ (fixed_queue& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+      assert(items_ == size_type{0});
+      assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
+
+      // invariant: the first i items of rhs have been moved into this queue
+      for (auto i = size_type{0}; i < rhs.items_; ++i)
+        emplace_(std::move(rhs.array_[(rhs.front_item_ + i) % N]));
+      rhs.clear_();
+    }
+
+    // destroy the items and give back the array
+    void release_ () noexcept
+    {
+      clear_();
+      if constexpr (!is_inline_)
+        detail::deallocate_storage(allocator_, array_, N);
+    }
+
+    // the address of the slot i of the array, whether an item is constructed there or not
+    value_type* slot_ (size_type i) noexcept
+    {
+      if constexpr (is_inline_)
+        return array_.data() + i;
+      else
+        return array_ + i;
+    }
+
+    // the address of the item i, it is constructed
+    value_type* item_ (size_type i) noexcept
+    {
+      return std::addressof(array_[i]);
     }
 
-  private:
     bool empty_ () const final
     {
       assert(items_ >= size_type{0} && items_ <= N);
@@ -391,26 +555,12 @@ namespace algol::ds {
 
     void enqueue_ (value_type const& value) final
     {
-      assert(items_ >= size_type{0} && items_ < N);
-      assert(rear_item_ >= size_type{0} && rear_item_ < N);
-
-      alloc_traits::destroy(allocator_, std::addressof(array_[rear_item_]));
-      alloc_traits::construct(allocator_, std::addressof(array_[rear_item_]), value_type{value});
-      rear_item_++;
-      rear_item_ %= N;
-      items_++;
+      emplace_(value);
     }
 
     void enqueue_ (value_type&& value) final
     {
-      assert(items_ >= size_type{0} && items_ < N);
-      assert(rear_item_ >= size_type{0} && rear_item_ < N);
-
-      alloc_traits::destroy(allocator_, std::addressof(array_[rear_item_]));
-      alloc_traits::construct(allocator_, std::addressof(array_[rear_item_]), value_type{std::move(value)});
-      rear_item_++;
-      rear_item_ %= N;
-      items_++;
+      emplace_(std::move(value));
     }
 
     void dequeue_ () final
@@ -418,6 +568,7 @@ namespace algol::ds {
       assert(items_ > size_type{0} && items_ <= N);
       assert(front_item_ >= size_type{0} && front_item_ < N);
 
+      alloc_traits::destroy(allocator_, item_(front_item_));
       front_item_++;
       front_item_ %= N;
       items_--;
@@ -429,7 +580,11 @@ namespace algol::ds {
       assert(items_ >= size_type{0} && items_ <= N);
       assert(front_item_ >= size_type{0} && front_item_ < N);
 
-      items_ = size_type{0};
+      // invariant: the items before front_item_ are destroyed
+      for (; items_ > size_type{0}; --items_) {
+        alloc_traits::destroy(allocator_, item_(front_item_));
+        front_item_ = (front_item_ + 1) % N;
+      }
       front_item_ = size_type{0};
       rear_item_ = size_type{0};
     }
@@ -449,44 +604,98 @@ namespace algol::ds {
       return vector;
     }
 
+    size_type space_ () const
+    {
+      return N - items_;
+    }
+
+    // the items are copied in at most two segments, from the rear to the end of the array and from its start,
+    // with memcpy if they are trivially copyable; if a copy throws the queue is not changed
+    template <typename ForwardIt>
+    void enqueue_n_ (ForwardIt first, size_type count)
+    {
+      assert(items_ + count <= N);
+
+      auto rear_segment = std::min(count, N - rear_item_);
+      first = detail::uninitialized_copy_n(allocator_, first, rear_segment, slot_(rear_item_));
+      try {
+        detail::uninitialized_copy_n(allocator_, first, count - rear_segment, slot_(0));
+      }
+      catch (...) {
+        for (auto i = size_type{0}; i < rear_segment; ++i)
+          alloc_traits::destroy(allocator_, item_(rear_item_ + i));
+        throw;
+      }
+      rear_item_ = (rear_item_ + count) % N;
+      items_ += count;
+    }
+
+    // the items are moved out in at most two segments, from the front to the end of the array and from its start
+    template <typename OutputIt>
+    OutputIt dequeue_n_ (OutputIt out, size_type count)
+    {
+      assert(count <= items_);
+
+      // loop invariant: the items of the segments before the front are moved and destroyed
+      while (count > size_type{0}) {
+        auto segment = std::min(count, N - front_item_);
+        auto front = item_(front_item_);
+        out = std::move(front, front + segment, out);
+        for (auto i = size_type{0}; i < segment; ++i)
+          alloc_traits::destroy(allocator_, item_(front_item_ + i));
+        front_item_ = (front_item_ + segment) % N;
+        items_ -= segment;
+        count -= segment;
+      }
+      return out;
+    }
+
     template <typename... Args>
     void emplace_ (Args&& ... args) noexcept(std::is_nothrow_constructible<T, Args...>())
     {
       assert(items_ >= size_type{0} && items_ < N);
       assert(rear_item_ >= size_type{0} && rear_item_ < N);
 
-      alloc_traits::destroy(allocator_, std::addressof(array_[rear_item_]));
-      alloc_traits::construct(allocator_, std::addressof(array_[rear_item_]), value_type{std::forward<Args>(args)...});
+      alloc_traits::construct(allocator_, slot_(rear_item_), std::forward<Args>(args)...);
       rear_item_++;
       rear_item_ %= N;
       items_++;
     }
 
-    using alloc = std::allocator<value_type>;
-    using alloc_traits = std::allocator_traits<alloc>;
-
     size_type items_;
     size_type front_item_;
     size_type rear_item_;
-    std::unique_ptr<value_type[]> array_;
-    alloc allocator_;
+    allocator_type allocator_;
+    std::conditional_t<is_inline_, detail::inline_array<value_type, N>, value_type*> array_;
   };
 
   /**
    * \brief Exchanges the items of lhs and rhs queues
-   * \details Non member function, noexcept it cannot fail
+   * \details Non member function, noexcept unless the items of inline queues can throw on move
    * \tparam T type of the items stored in the queue
-   * \precondition None
+   * \precondition The allocators are equal or they propagate on swap
    * \postcondition The lhs queue becomes the rhs queue and viceversa
-   * \complexity O(1)
+   * \complexity O(1), O(N) with inline storage
    * \param lhs Queue to be exchanged with rhs
    * \param rhs Queue to be exchanged with lhs
    */
-  template <typename T, typename queue<T>::size_type N>
-  void swap (fixed_queue<T, N>& lhs, fixed_queue<T, N>& rhs) noexcept
+  template <typename T, typename queue<T>::size_type N, typename Allocator>
+  void swap (fixed_queue<T, N, Allocator>& lhs, fixed_queue<T, N, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
   {
     lhs.swap(rhs);
   }
 }
 
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief fixed_queue whose array is allocated from a std::pmr::memory_resource
+   */
+  template <typename T, typename queue<T>::size_type N>
+  using fixed_queue = ds::fixed_queue<T, N, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
 #endif //ALGOL_DS_FIXED_QUEUE_HPP
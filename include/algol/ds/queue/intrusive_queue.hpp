@@ -0,0 +1,276 @@
+/**
+ * \file
+ * Intrusive queue implementation
+ */
+
+#ifndef ALGOL_DS_INTRUSIVE_QUEUE_HPP
+#define ALGOL_DS_INTRUSIVE_QUEUE_HPP
+
+#include <type_traits>
+#include <vector>
+#include "queue.hpp"
+#include "algol/ds/intrusive_hook.hpp"
+
+namespace algol::ds {
+  /**
+   * \brief Implementation of the Queue ADT linking the items through a hook embedded in them
+   * \details The items derive from [intrusive_hook](@ref intrusive_hook)<Tag> and the queue links their hooks:
+   * enqueue and dequeue relink pointers, they never allocate nor copy the items, and two queues are concatenated
+   * in O(1).
+   * The queue does not own the items:
+   * - an item is enqueued by reference and must outlive its stay in the queue
+   * - an item can be linked in one stack or queue per tag at a time
+   * - dequeue, clear and the destructor unlink the items and never destroy them
+   * - the queue cannot be copied, moving it moves the links
+   * The ownership is checked in debug builds: enqueuing a linked item, or destroying an item still linked,
+   * is asserted.
+   * Since enqueue takes a non const reference the queue does not satisfy the Queue concept.
+   * \tparam T type of the items, derived from intrusive_hook<Tag>
+   * \tparam Tag tag of the hook used by the queue
+   * \invariant The item that is accessible at the front of the queue is the item that has
+   * least recently been enqueued onto it and not yet dequeued (removed)
+   */
+  template <typename T, typename Tag = void>
+  class intrusive_queue final {
+    static_assert(std::is_base_of_v<intrusive_hook<Tag>, T>, "intrusive_queue items must derive from intrusive_hook");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(1)
+     */
+    intrusive_queue () noexcept = default;
+
+    // an item is linked in one queue at a time, the queue cannot be copied
+    intrusive_queue (intrusive_queue const&) = delete;
+    intrusive_queue& operator= (intrusive_queue const&) = delete;
+
+    /**
+     * \brief Move constructor
+     * \precondition None
+     * \postcondition This queue links the items of the provided queue that becomes empty
+     * \complexity O(1), O(N) in debug builds
+     * \param rhs The queue to be moved
+     */
+    intrusive_queue (intrusive_queue&& rhs) noexcept = default;
+
+    /**
+     * \brief Move assignment operator
+     * \details The items of this queue are unlinked and replaced with the items of the provided queue
+     * \precondition None
+     * \postcondition This queue links the items of the provided queue that becomes empty
+     * \complexity O(N)
+     * \param rhs The queue to be moved
+     * \return This queue
+     */
+    intrusive_queue& operator= (intrusive_queue&& rhs) noexcept = default;
+
+    /**
+     * \brief Destructor
+     * \details The items are unlinked, not destroyed
+     * \precondition None
+     * \postcondition The items are no longer linked
+     * \complexity O(N)
+     */
+    ~intrusive_queue () = default;
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return items_.empty();
+    }
+
+    /**
+     * \brief The queue is full?
+     * \details The queue is never full, it does not allocate
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return false
+     */
+    bool full () const noexcept
+    {
+      return false;
+    }
+
+    /**
+     * \brief The size of the queue
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the items in the queue
+     */
+    size_type size () const noexcept
+    {
+      return items_.size();
+    }
+
+    /**
+     * \brief The item at the front of the queue
+     * \precondition The queue is not empty
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item at the front of the queue
+     */
+    reference front ()
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting front() on empty queue"};
+
+      return item_(items_.front());
+    }
+
+    /**
+     * \brief The item at the front of the queue
+     * \precondition The queue is not empty
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item at the front of the queue
+     */
+    const_reference front () const
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting front() on empty queue"};
+
+      return item_(items_.front());
+    }
+
+    /**
+     * \brief Link the item passed at the rear of the queue
+     * \precondition The item is not linked in a container with the same tag
+     * \postcondition The item is the rear of the queue
+     * \complexity O(1), no allocation
+     * \param item The item to enqueue
+     */
+    void enqueue (reference item) noexcept
+    {
+      items_.push_back(item);
+    }
+
+    /**
+     * \brief Unlink the item at the front of the queue
+     * \precondition The queue is not empty
+     * \postcondition The front item is removed from the queue, it is not destroyed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item removed
+     */
+    reference dequeue ()
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+
+      return item_(items_.pop_front());
+    }
+
+    /**
+     * \brief Unlink the item at the front of the queue if the queue is not empty
+     * \precondition None
+     * \postcondition If the queue was not empty the front item is removed from the queue
+     * \complexity O(1)
+     * \return The item removed or nullptr if the queue is empty
+     */
+    value_type* try_dequeue () noexcept
+    {
+      if (empty())
+        return nullptr;
+
+      return &item_(items_.pop_front());
+    }
+
+    /**
+     * \brief Move the items of the provided queue at the rear of this queue
+     * \details The items keep their order, the front of rhs follows the rear of this queue
+     * \precondition rhs is not this queue
+     * \postcondition rhs is empty
+     * \complexity O(1), O(N) in debug builds
+     * \param rhs The queue whose items are moved
+     */
+    void splice (intrusive_queue& rhs) noexcept
+    {
+      items_.splice_back(rhs.items_);
+    }
+
+    /**
+     * \brief Clear the queue unlinking all the items
+     * \precondition None
+     * \postcondition The queue is empty and the items are no longer linked
+     * \complexity O(N)
+     */
+    void clear () noexcept
+    {
+      items_.clear();
+    }
+
+    /**
+     * \brief The addresses of the items from the front to the rear
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(N)
+     * \return The items from the front to the rear
+     */
+    std::vector<value_type const*> to_vector () const
+    {
+      std::vector<value_type const*> vector {};
+      vector.reserve(size());
+      items_.for_each([&vector] (hook& h) { vector.push_back(&item_(h)); });
+      return vector;
+    }
+
+    /**
+     * \brief Swaps the items of this queue with the items of the provided queue
+     * \precondition None
+     * \postcondition This queue becomes the rhs queue and viceversa
+     * \complexity O(1), O(N) in debug builds
+     * \param rhs The queue to be swapped with this
+     */
+    void swap (intrusive_queue& rhs) noexcept
+    {
+      items_.swap(rhs.items_);
+    }
+
+  private:
+    using hook = intrusive_hook<Tag>;
+
+    static reference item_ (hook& h) noexcept
+    {
+      return static_cast<reference>(h);
+    }
+
+    detail::intrusive_list<Tag> items_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs queues
+   * \details Non member function, noexcept it cannot fail
+   * \tparam T type of the items stored in the queue
+   * \tparam Tag tag of the hook used by the queues
+   * \precondition None
+   * \postcondition The lhs queue becomes the rhs queue and viceversa
+   * \complexity O(1)
+   * \param lhs Queue to be exchanged with rhs
+   * \param rhs Queue to be exchanged with lhs
+   */
+  template <typename T, typename Tag>
+  void swap (intrusive_queue<T, Tag>& lhs, intrusive_queue<T, Tag>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif //ALGOL_DS_INTRUSIVE_QUEUE_HPP
@@ -9,25 +9,30 @@
 #include <algorithm>
 #include <memory>
 #include <cassert>
-#include "queue.hpp"
+#include "static_queue.hpp"
+#include "algol/ds/allocator.hpp"
 #include "stl2/concepts.hpp"
 
 namespace algol::ds {
   namespace concepts = std::experimental::ranges;
   /**
    * \brief Implementation of the Queue ADT using a linked structure
-   * \details see class [queue](@ref queue)
+   * \details see class [queue](@ref queue), the operations are dispatched at compile time by
+   * [static_queue](@ref static_queue)
    * \tparam T type of the items stored in the queue
+   * \tparam Allocator allocator of the items, for example a std::pmr::polymorphic_allocator, the nodes and
+   * the sentinel nodes are allocated with it rebound to the node type
    * \invariant The item that is accessible at the front of the queue is the item that has
    * least recently been enqueued onto it and not yet dequeued (removed)
    */
-  template <concepts::CopyConstructible T>
-  class linked_queue final : public queue<T> {
+  template <concepts::CopyConstructible T, typename Allocator = std::allocator<T>>
+  class linked_queue final : public static_queue<linked_queue<T, Allocator>, T> {
   public:
     using value_type = typename queue<T>::value_type;
     using reference = typename queue<T>::reference;
     using const_reference = typename queue<T>::const_reference;
     using size_type = typename queue<T>::size_type;
+    using allocator_type = Allocator;
 
     /**
      * \brief Default constructor
@@ -35,13 +40,30 @@ namespace algol::ds {
      * \postcondition The queue is empty
      * \complexity O(1)
      */
-    linked_queue () noexcept(std::is_nothrow_constructible_v<size_type, int>)
-        : queue<T>(), items_ {size_type{0}}
+    linked_queue () : linked_queue(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty queue whose nodes are allocated with the provided allocator
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(1)
+     * \param allocator The allocator of the nodes, it is rebound to the node type
+     */
+    explicit linked_queue (allocator_type const& allocator)
+        : allocator_ {allocator}, front_node_ {new_node_()}, rear_node_ {nullptr}, items_ {size_type{0}}
     {
-      front_node_->prev_ = front_node_.get();
-      front_node_->next_ = rear_node_.get();
-      rear_node_->prev_ = front_node_.get();
-      rear_node_->next_ = rear_node_.get();
+      try {
+        rear_node_ = new_node_();
+      }
+      catch (...) {
+        detail::deallocate_node(allocator_, front_node_);
+        throw;
+      }
+      front_node_->prev_ = front_node_;
+      front_node_->next_ = rear_node_;
+      rear_node_->prev_ = front_node_;
+      rear_node_->next_ = rear_node_;
     }
 
     /**
@@ -53,39 +75,39 @@ namespace algol::ds {
      * initializer_list are enqueued onto the queue
      * \complexity O(N)
      * \param values The items to be enqueued onto the queue
+     * \param allocator The allocator of the nodes
      */
-    linked_queue (std::initializer_list<value_type> values) : linked_queue()
+    linked_queue (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : linked_queue(allocator)
     {
-      for (auto const& v : values)
-        enqueue_(v);
+      this->enqueue_range(values.begin(), values.end());
     }
 
     /**
      * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction
      * \precondition None
      * \postcondition This queue is equal to the provided queue
      * \complexity O(N)
      * \param rhs The queue to be copied
      */
-    linked_queue (linked_queue const& rhs) : linked_queue()
-    {
-      linked_queue queue;
+    linked_queue (linked_queue const& rhs)
+        : linked_queue(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
 
-      if (!rhs.empty()) {
-        for (auto i = size_type{0}; i < rhs.items_; ++i) {
-          queue.enqueue_((node * ) ::operator new(sizeof(node)));
-        }
-
-        node* this_iter = queue.front_node_->next_;
-        node* rhs_iter = rhs.front_node_->next_;
-
-        while (rhs_iter != rhs.rear_node_.get()) {
-          new(std::addressof(this_iter->value_)) T(rhs_iter->value_);
-          this_iter = this_iter->next_;
-          rhs_iter = rhs_iter->next_;
-        }
-      }
-      swap(queue);
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue
+     * \complexity O(N)
+     * \param rhs The queue to be copied
+     * \param allocator The allocator of the nodes
+     */
+    linked_queue (linked_queue const& rhs, allocator_type const& allocator) : linked_queue(allocator)
+    {
+      // the delegating constructor has completed, if a copy throws the destructor releases the nodes
+      for (node* rhs_iter = rhs.front_node_->next_; rhs_iter != rhs.rear_node_; rhs_iter = rhs_iter->next_)
+        enqueue_(rhs_iter->value_[0]);
     }
 
     /**
@@ -95,17 +117,41 @@ namespace algol::ds {
      * \complexity O(1)
      * \param rhs The queue to be moved, items contained are 'stolen' from this queue
      */
-    linked_queue (linked_queue&& rhs) noexcept :
-        front_node_ {std::move(rhs.front_node_)}, rear_node_ {std::move(rhs.rear_node_)}, items_ {rhs.items_}
+    linked_queue (linked_queue&& rhs) noexcept
+        : allocator_ {rhs.allocator_}, front_node_ {rhs.front_node_}, rear_node_ {rhs.rear_node_},
+          items_ {rhs.items_}
     {
-      rhs.front_node_.reset();
-      rhs.rear_node_.reset();
+      rhs.front_node_ = nullptr;
+      rhs.rear_node_ = nullptr;
       rhs.items_ = size_type{0};
     }
 
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The nodes are stolen if the allocators are equal, otherwise the items are moved one by one
+     * into nodes allocated with the provided allocator
+     * \precondition None
+     * \postcondition This queue is equal to the provided queue that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \param rhs The queue to be moved
+     * \param allocator The allocator of the nodes
+     */
+    linked_queue (linked_queue&& rhs, allocator_type const& allocator) : linked_queue(allocator)
+    {
+      if (allocator_ == rhs.allocator_) {
+        swap_items_(rhs);
+        return;
+      }
+
+      for (node* rhs_iter = rhs.front_node_->next_; rhs_iter != rhs.rear_node_; rhs_iter = rhs_iter->next_)
+        enqueue_(std::move(rhs_iter->value_[0]));
+      rhs.clear_();
+    }
+
     /**
      * \brief Assignment operator
-     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue
+     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue,
+     * the allocator is replaced only if it propagates on copy assignment
      * \precondition None
      * \postcondition This queue is equal to the provided queue
      * \complexity O(N)
@@ -114,24 +160,43 @@ namespace algol::ds {
      */
     linked_queue& operator= (linked_queue const& rhs)
     {
-      linked_queue temp {rhs};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      linked_queue temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
       return *this;
     }
 
     /**
      * \brief Move assignment operator
-     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue
+     * \details The actual items of the queue are destroyed and are replaced with the items of the provided queue,
+     * the nodes are stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
      * \precondition None
      * \postcondition This queue is equal to the provided queue that becomes empty
-     * \complexity O(1)
+     * \complexity O(1) if the nodes are stolen, O(N) otherwise
      * \param rhs The queue to be moved, items contained are 'stolen' from this queue
      * \return The queue containing the provided queue items
      */
-    linked_queue& operator= (linked_queue&& rhs) noexcept
+    linked_queue& operator= (linked_queue&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
     {
-      linked_queue temp {std::move(rhs)};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      if (propagate || allocator_ == rhs.allocator_) {
+        linked_queue temp {std::move(rhs)};
+        swap_items_(temp);
+        if constexpr (propagate) {
+          using std::swap;
+          swap(allocator_, temp.allocator_);
+        }
+      }
+      else {
+        linked_queue temp {std::move(rhs), allocator_};
+        swap_items_(temp);
+      }
       return *this;
     }
 
@@ -143,9 +208,26 @@ namespace algol::ds {
      */
     ~linked_queue ()
     {
+      if (front_node_ == nullptr)
+        return;
+
       while (!empty_()) {
         dequeue_();
       }
+      detail::deallocate_node(allocator_, rear_node_);
+      detail::deallocate_node(allocator_, front_node_);
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
     }
 
     /**
@@ -167,15 +249,15 @@ namespace algol::ds {
       node* this_iter = front_node_->next_;
       node* rhs_iter = rhs.front_node_->next_;
 
-      while (this_iter != rear_node_.get() && rhs_iter != rhs.rear_node_.get()) {
-        if (this_iter->value_ != rhs_iter->value_)
+      while (this_iter != rear_node_ && rhs_iter != rhs.rear_node_) {
+        if (this_iter->value_[0] != rhs_iter->value_[0])
           return false;
 
         this_iter = this_iter->next_;
         rhs_iter = rhs_iter->next_;
       }
 
-      return this_iter == rear_node_.get()  && rhs_iter == rhs.rear_node_.get();
+      return this_iter == rear_node_  && rhs_iter == rhs.rear_node_;
     }
 
     /**
@@ -215,18 +297,18 @@ namespace algol::ds {
       node* this_iter = front_node_->next_;
       node* rhs_iter = rhs.front_node_->next_;
 
-      while (this_iter != rear_node_.get() && rhs_iter != rhs.rear_node_.get()) {
-        if (this_iter->value_ < rhs_iter->value_)
+      while (this_iter != rear_node_ && rhs_iter != rhs.rear_node_) {
+        if (this_iter->value_[0] < rhs_iter->value_[0])
           return true;
 
-        if (this_iter->value_ > rhs_iter->value_)
+        if (this_iter->value_[0] > rhs_iter->value_[0])
           return false;
 
         this_iter = this_iter->next_;
         rhs_iter = rhs_iter->next_;
       }
 
-      return this_iter == rear_node_.get()  && rhs_iter != rhs.rear_node_.get();
+      return this_iter == rear_node_  && rhs_iter != rhs.rear_node_;
     }
 
     /**
@@ -294,13 +376,38 @@ namespace algol::ds {
 
     /**
      * \brief Swaps the items of this queue with the items of the provided queue
-     * \details noexcept operation, it cannot throw
-     * \precondition None
+     * \details noexcept operation, it cannot throw.
+     * The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
      * \postcondition This queue becomes the rhs queue and viceversa
      * \complexity O(1)
      * \param rhs The queue to be swapped with this
      */
     void swap (linked_queue& rhs) noexcept
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+  private:
+    friend class static_queue<linked_queue, T>;
+
+    // the value is constructed by allocate_node with the allocator of the items
+    struct node {
+      detail::inline_array<value_type, 1> value_;
+      node* next_ {nullptr};
+      node* prev_ {nullptr};
+    };
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    // swap the nodes and the counter, not the allocators
+    void swap_items_ (linked_queue& rhs) noexcept
     {
       using std::swap;
       swap(front_node_, rhs.front_node_);
@@ -308,12 +415,12 @@ namespace algol::ds {
       swap(items_, rhs.items_);
     }
 
-  private:
-    struct node {
-      value_type value_;
-      node* next_;
-      node* prev_;
-    };
+    // a node whose value is constructed from args, it is not linked
+    template <typename... Args>
+    node* new_node_ (Args&& ... args)
+    {
+      return detail::allocate_node<node>(allocator_, std::forward<Args>(args)...);
+    }
 
     bool empty_ () const final
     {
@@ -332,32 +439,33 @@ namespace algol::ds {
 
     const_reference front_ () const& final
     {
-      return front_node_->next_->value_;
+      return front_node_->next_->value_[0];
     }
 
     void enqueue_ (value_type const& value) final
     {
-      enqueue_(new node {value, nullptr, nullptr});
+      enqueue_(new_node_(value));
     }
 
     void enqueue_ (value_type&& value) final
     {
-      enqueue_(new node {std::move(value), nullptr, nullptr});
+      enqueue_(new_node_(std::move(value)));
     }
 
     void dequeue_ () final
     {
       node* node_to_dequeue = front_node_->next_;
       front_node_->next_ = front_node_->next_->next_;
-      front_node_->next_->prev_ = front_node_.get();
+      front_node_->next_->prev_ = front_node_;
       items_--;
-      delete node_to_dequeue;
+      detail::deallocate_node(allocator_, node_to_dequeue);
     }
 
     void clear_ () final
     {
-      linked_queue temp {};
-      swap(temp);
+      while (!empty_()) {
+        dequeue_();
+      }
     }
 
     std::vector<value_type> to_vector_ () const final
@@ -367,8 +475,8 @@ namespace algol::ds {
 
       node* this_iter = front_node_->next_;
 
-      while (this_iter != rear_node_.get()) {
-        vector.emplace_back(this_iter->value_);
+      while (this_iter != rear_node_) {
+        vector.emplace_back(this_iter->value_[0]);
         this_iter = this_iter->next_;
       }
       return vector;
@@ -376,15 +484,16 @@ namespace algol::ds {
 
     void enqueue_ (node* node_to_enqueue)
     {
-      node_to_enqueue->next_ = rear_node_.get();
+      node_to_enqueue->next_ = rear_node_;
       node_to_enqueue->prev_ = rear_node_->prev_;
       rear_node_->prev_->next_ = node_to_enqueue;
       rear_node_->prev_ = node_to_enqueue;
       items_++;
     }
 
-    std::unique_ptr<node> front_node_ = std::make_unique<node>();
-    std::unique_ptr<node> rear_node_ = std::make_unique<node>();
+    allocator_type allocator_;
+    node* front_node_;
+    node* rear_node_;
     size_type items_;
   };
 
@@ -392,17 +501,29 @@ namespace algol::ds {
    * \brief Exchanges the items of lhs and rhs queues.
    * \details Non member function, noexcept it cannot fail.
    * \tparam T type of the items stored in the queue.
-   * \precondition None.
+   * \precondition The allocators are equal or they propagate on swap.
    * \postcondition The lhs queue becomes the rhs queue and viceversa.
    * \complexity O(1)
    * \param lhs Stack to be exchanged with rhs.
    * \param rhs Stack to be exchanged with lhs.
    */
-  template <typename T>
-  void swap (linked_queue<T>& lhs, linked_queue<T>& rhs) noexcept
+  template <typename T, typename Allocator>
+  void swap (linked_queue<T, Allocator>& lhs, linked_queue<T, Allocator>& rhs) noexcept
   {
     lhs.swap(rhs);
   }
 }
 
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief linked_queue whose nodes are allocated from a std::pmr::memory_resource
+   */
+  template <typename T>
+  using linked_queue = ds::linked_queue<T, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
 #endif //ALGOL_DS_LINKED_QUEUE_HPP
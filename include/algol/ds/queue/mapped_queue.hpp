@@ -0,0 +1,834 @@
+/**
+ * \file
+ * Persistent queues stored in a memory mapped file.
+ */
+
+#ifndef ALGOL_DS_MAPPED_QUEUE_HPP
+#define ALGOL_DS_MAPPED_QUEUE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "queue.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Throwed when the file of a mapped queue cannot be used.
+   * \details Throwed on open when the file is not a queue, has another layout or its head and tail are not valid.
+   */
+  struct mapped_queue_error : public queue_error {
+    explicit mapped_queue_error (std::string const& what_arg) : std::logic_error {what_arg},
+                                                                queue_error {what_arg}
+    {}
+  };
+
+  /**
+   * \brief When the changes of a mapped queue reach the disk
+   * \details
+   * - none: the header is updated after every operation and the kernel writes the pages back when it wants,
+   * a crash of the process loses nothing, a crash of the system can lose any change since the last sync
+   * - each: every operation flushes the pages of the records with msync, then updates the header and flushes it,
+   * an operation that returned is on the disk
+   * - batch: the header is updated every batch operations, after a fdatasync of the records, the operations since
+   * the last commit are lost by any crash: the records enqueued disappear, the records dequeued come back
+   */
+  enum class sync_policy {
+    none,
+    each,
+    batch
+  };
+}
+
+namespace algol::ds::detail {
+  /**
+   * \brief A ring of bytes in a memory mapped file whose head and tail are stored in a header page
+   * \details The head and the tail are positions that only grow, the offset in the ring is the position modulo
+   * the capacity. The header keeps the committed positions: the records between them are on the file and the
+   * header is written after them, as the sync policy says. After a crash the queue reopens at the last commit.
+   * The 40 bytes of the header are written with one copy at the start of the page, they are assumed to reach
+   * the disk together as they are in one sector.
+   */
+  class mapped_ring {
+  public:
+    using size_type = std::size_t;
+
+    mapped_ring (mapped_ring const&) = delete;
+    mapped_ring& operator= (mapped_ring const&) = delete;
+
+  protected:
+    static constexpr std::uint64_t magic = 0x3151504d4c4f474cu;  // "LGOLMPQ1"
+    static constexpr std::uint32_t version = 1;
+
+    struct header {
+      std::uint64_t magic_;
+      std::uint32_t version_;
+      std::uint32_t record_size_;
+      std::uint64_t capacity_;
+      std::uint64_t head_;
+      std::uint64_t tail_;
+    };
+
+    // record_size is 0 for the records prefixed by their length, capacity 0 takes the one of an existing file
+    mapped_ring (std::string const& path, std::uint32_t record_size, std::uint64_t capacity, sync_policy policy,
+                 size_type batch)
+        : record_size_ {record_size}, policy_ {policy}, batch_ {batch > 0 ? batch : 1}
+    {
+      page_ = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+      fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (fd_ < 0)
+        throw std::system_error{errno, std::generic_category(), "open " + path};
+      try {
+        open_(path, capacity);
+      }
+      catch (...) {
+        close_();
+        throw;
+      }
+    }
+
+    mapped_ring (mapped_ring&& rhs) noexcept
+        : fd_ {std::exchange(rhs.fd_, -1)}, map_ {std::exchange(rhs.map_, nullptr)},
+          map_size_ {rhs.map_size_}, page_ {rhs.page_}, data_ {rhs.data_}, capacity_ {rhs.capacity_},
+          record_size_ {rhs.record_size_}, head_ {rhs.head_}, tail_ {rhs.tail_},
+          committed_head_ {rhs.committed_head_}, committed_tail_ {rhs.committed_tail_}, policy_ {rhs.policy_},
+          batch_ {rhs.batch_}, pending_ {std::exchange(rhs.pending_, size_type{0})}
+    {}
+
+    // the operations not committed are committed, the errors are ignored
+    ~mapped_ring ()
+    {
+      if (map_ != nullptr && pending_ > 0) {
+        try {
+          commit_();
+        }
+        catch (...) {
+        }
+      }
+      close_();
+    }
+
+    // the record of the operation is written in [first, last) and the positions are updated
+    void operation_ (std::uint64_t first, std::uint64_t last)
+    {
+      switch (policy_) {
+        case sync_policy::none:
+          // the header is written after the records also when the compiler reorders the stores
+          std::atomic_signal_fence(std::memory_order_release);
+          publish_();
+          break;
+        case sync_policy::each:
+          flush_data_(first, last);
+          publish_();
+          flush_(map_, sizeof(header));
+          break;
+        case sync_policy::batch:
+          if (++pending_ >= batch_)
+            commit_();
+          break;
+      }
+    }
+
+    // the ring has room for bytes written at the tail without overwriting the records dequeued and not committed
+    void reserve_ (std::uint64_t bytes)
+    {
+      if (tail_ + bytes - committed_head_ > capacity_)
+        commit_();
+    }
+
+    void commit_ ()
+    {
+      switch (policy_) {
+        case sync_policy::none:
+          flush_(map_, map_size_);
+          break;
+        case sync_policy::each:
+          break;
+        case sync_policy::batch:
+          if (head_ == committed_head_ && tail_ == committed_tail_)
+            break;
+          if (tail_ != committed_tail_) {
+#if defined(__linux__)
+            auto result = ::fdatasync(fd_);
+#else
+            auto result = ::fsync(fd_);
+#endif
+            if (result != 0)
+              throw std::system_error{errno, std::generic_category(), "fdatasync"};
+          }
+          publish_();
+          flush_(map_, sizeof(header));
+          break;
+      }
+      pending_ = 0;
+    }
+
+    std::byte* at_ (std::uint64_t position) const noexcept
+    {
+      return data_ + position % capacity_;
+    }
+
+    int fd_ {-1};
+    std::byte* map_ {nullptr};
+    size_type map_size_ {0};
+    size_type page_ {0};
+    std::byte* data_ {nullptr};
+    std::uint64_t capacity_ {0};
+    std::uint32_t record_size_;
+    std::uint64_t head_ {0};
+    std::uint64_t tail_ {0};
+    std::uint64_t committed_head_ {0};
+    std::uint64_t committed_tail_ {0};
+    sync_policy policy_;
+    size_type batch_;
+    size_type pending_ {0};
+
+  private:
+    void open_ (std::string const& path, std::uint64_t capacity)
+    {
+      struct stat status {};
+      if (::fstat(fd_, &status) != 0)
+        throw std::system_error{errno, std::generic_category(), "fstat " + path};
+      auto fresh = status.st_size == 0;
+      if (fresh) {
+        if (capacity == 0)
+          throw mapped_queue_error{"Attempting to create " + path + " with zero capacity"};
+        if (::ftruncate(fd_, static_cast<off_t>(page_ + capacity)) != 0)
+          throw std::system_error{errno, std::generic_category(), "ftruncate " + path};
+        map_size_ = page_ + static_cast<size_type>(capacity);
+      }
+      else if (static_cast<size_type>(status.st_size) <= page_)
+        throw mapped_queue_error{path + " is not a mapped queue"};
+      else
+        map_size_ = static_cast<size_type>(status.st_size);
+
+      auto map = ::mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+      if (map == MAP_FAILED)
+        throw std::system_error{errno, std::generic_category(), "mmap " + path};
+      map_ = static_cast<std::byte*>(map);
+      data_ = map_ + page_;
+
+      if (fresh) {
+        capacity_ = capacity;
+        publish_();
+        flush_(map_, sizeof(header));
+        return;
+      }
+      header h {};
+      std::memcpy(&h, map_, sizeof(header));
+      if (h.magic_ != magic || h.version_ != version)
+        throw mapped_queue_error{path + " is not a mapped queue"};
+      if (h.record_size_ != record_size_ || (capacity != 0 && h.capacity_ != capacity)
+          || page_ + h.capacity_ != map_size_)
+        throw mapped_queue_error{path + " has another record size or capacity"};
+      if (h.head_ > h.tail_ || h.tail_ - h.head_ > h.capacity_
+          || (record_size_ != 0 && (h.head_ % record_size_ != 0 || h.tail_ % record_size_ != 0)))
+        throw mapped_queue_error{path + " has invalid head and tail"};
+      capacity_ = h.capacity_;
+      head_ = committed_head_ = h.head_;
+      tail_ = committed_tail_ = h.tail_;
+    }
+
+    void close_ () noexcept
+    {
+      if (map_ != nullptr)
+        ::munmap(map_, map_size_);
+      map_ = nullptr;
+      if (fd_ >= 0)
+        ::close(fd_);
+      fd_ = -1;
+    }
+
+    void publish_ () noexcept
+    {
+      committed_head_ = head_;
+      committed_tail_ = tail_;
+      header h {magic, version, record_size_, capacity_, head_, tail_};
+      std::memcpy(map_, &h, sizeof(header));
+    }
+
+    // the pages of [first, last) of the ring, in two parts if the range wraps
+    void flush_data_ (std::uint64_t first, std::uint64_t last)
+    {
+      if (first == last)
+        return;
+      if (last - first >= capacity_) {
+        flush_(data_, static_cast<size_type>(capacity_));
+        return;
+      }
+      auto begin = first % capacity_;
+      auto end = begin + (last - first);
+      if (end <= capacity_)
+        flush_(data_ + begin, static_cast<size_type>(end - begin));
+      else {
+        flush_(data_ + begin, static_cast<size_type>(capacity_ - begin));
+        flush_(data_, static_cast<size_type>(end - capacity_));
+      }
+    }
+
+    void flush_ (std::byte* address, size_type bytes)
+    {
+      // msync wants the address at the start of a page
+      auto offset = static_cast<size_type>(address - map_) % page_;
+      if (::msync(address - offset, bytes + offset, MS_SYNC) != 0)
+        throw std::system_error{errno, std::generic_category(), "msync"};
+    }
+  };
+}
+
+namespace algol::ds {
+  /**
+   * \brief Bounded queue of fixed size records stored in a memory mapped file, it survives the process
+   * \details The records are kept in a ring in the file after a header page with the head and the tail,
+   * the queue opened again on the same file has the records committed before it was closed or crashed.
+   * The operations are the ones of [fixed_queue](@ref fixed_queue), the writes reach the disk according to
+   * the [sync_policy](@ref sync_policy): with batch a commit happens every batch operations, on sync and on
+   * destruction.
+   * The records are copied in the file byte by byte, so T must be trivially copyable, and the file can be read
+   * only by a program with the same T.
+   * The file is not locked, a process must not open a queue opened by another one.
+   * \tparam T type of the records, trivially copyable
+   * \invariant The item that is accessible at the front of the queue is the item that has
+   * least recently been enqueued onto it and not yet dequeued (removed)
+   */
+  template <typename T>
+  class mapped_queue final : private detail::mapped_ring {
+    static_assert(std::is_trivially_copyable_v<T>, "mapped_queue records must be trivially copyable");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+
+    /**
+     * \brief Open the queue stored in the file at path, the file is created if it does not exist
+     * \precondition No other queue uses the file
+     * \postcondition The queue has the records committed in the file, it is empty if the file was created
+     * \complexity O(1)
+     * \throws std::system_error if the file cannot be created or mapped
+     * \throws mapped_queue_error if the file is not a queue of capacity records of type T, the file is unchanged
+     * \param path The path of the file
+     * \param capacity The number of records, 0 to open an existing file with its capacity
+     * \param policy When the changes are written to the disk
+     * \param batch The number of operations of a commit with the batch policy
+     */
+    mapped_queue (std::string const& path, size_type capacity, sync_policy policy = sync_policy::none,
+                  size_type batch = 64)
+        : mapped_ring(path, sizeof(value_type), std::uint64_t{capacity} * sizeof(value_type), policy, batch)
+    {}
+
+    mapped_queue (mapped_queue&&) noexcept = default;
+
+    /**
+     * \brief Destructor
+     * \details The operations not yet committed are committed and the file is unmapped
+     * \complexity O(1), plus the writes of the commit
+     */
+    ~mapped_queue () = default;
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return head_ == tail_;
+    }
+
+    /**
+     * \brief The queue is full?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is full, false otherwise
+     */
+    bool full () const noexcept
+    {
+      return tail_ - head_ == capacity_;
+    }
+
+    /**
+     * \brief The size of the queue
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the queue
+     */
+    size_type size () const noexcept
+    {
+      return static_cast<size_type>((tail_ - head_) / sizeof(value_type));
+    }
+
+    /**
+     * \brief The number of records the file can hold
+     * \precondition None
+     * \complexity O(1)
+     * \return The capacity of the queue
+     */
+    size_type capacity () const noexcept
+    {
+      return static_cast<size_type>(capacity_ / sizeof(value_type));
+    }
+
+    /**
+     * \brief The sync policy of the queue
+     * \precondition None
+     * \complexity O(1)
+     * \return The policy
+     */
+    sync_policy policy () const noexcept
+    {
+      return policy_;
+    }
+
+    /**
+     * \brief A copy of the item on the front of the queue
+     * \details The item is copied out of the file, a reference would be changed by the next enqueue after dequeue
+     * \precondition The queue is not empty
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item on the front of the queue
+     */
+    value_type front () const
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting front() on empty queue"};
+
+      value_type value;
+      std::memcpy(&value, at_(head_), sizeof(value_type));
+      return value;
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \precondition The queue is not full
+     * \postcondition The size of the Queue is increased by 1 and the item passed becomes the last item
+     * \complexity O(1), plus the writes of the sync policy
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \throws std::system_error if the record cannot be written to the disk
+     * \param value The item to enqueue onto the queue
+     */
+    void enqueue (value_type const& value)
+    {
+      if (full())
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+
+      reserve_(sizeof(value_type));
+      auto first = tail_;
+      std::memcpy(at_(tail_), &value, sizeof(value_type));
+      tail_ += sizeof(value_type);
+      operation_(first, tail_);
+    }
+
+    /**
+     * \brief Enqueue the items of the range, one operation of the sync policy for all of them
+     * \precondition The queue has room for the items of the range
+     * \postcondition The items are enqueued in order
+     * \complexity O(M) where M is the number of the items of the range, plus the writes of the sync policy
+     * \throws queue_full_error if the queue has not room for all the items and the queue is not changed
+     * \throws std::system_error if the records cannot be written to the disk
+     * \tparam ForwardIt iterator type of the range
+     * \param first iterator to the first item to enqueue
+     * \param last iterator past the last item to enqueue
+     */
+    template <concepts::ForwardIterator ForwardIt>
+    void enqueue_range (ForwardIt first, ForwardIt last)
+    {
+      auto count = static_cast<std::uint64_t>(std::distance(first, last));
+      if (count * sizeof(value_type) > capacity_ - (tail_ - head_))
+        throw queue_full_error{"Attempting enqueue_range() on full queue"};
+      if (count == 0)
+        return;
+
+      reserve_(count * sizeof(value_type));
+      auto start = tail_;
+      for (; first != last; ++first) {
+        value_type const& value = *first;
+        std::memcpy(at_(tail_), &value, sizeof(value_type));
+        tail_ += sizeof(value_type);
+      }
+      operation_(start, tail_);
+    }
+
+    /**
+     * \brief Dequeue the current front item from the queue
+     * \precondition The queue is not empty
+     * \postcondition The size of the Queue is decreased by 1 and the current front item is removed from the queue
+     * \complexity O(1), plus the writes of the sync policy
+     * \throws queue_empty_error if the queue is empty
+     * \throws std::system_error if the header cannot be written to the disk
+     */
+    void dequeue ()
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+
+      head_ += sizeof(value_type);
+      operation_(tail_, tail_);
+    }
+
+    /**
+     * \brief Dequeue count items copying them in the range starting at out, one operation of the sync policy
+     * \precondition The queue has at least count items, out can be incremented count times
+     * \postcondition The count items at the front are copied in order in out and removed from the queue
+     * \complexity O(count), plus the writes of the sync policy
+     * \throws queue_empty_error if the queue has less than count items and the queue is not changed
+     * \throws std::system_error if the header cannot be written to the disk
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count number of the items to dequeue
+     * \return The iterator past the last item copied
+     */
+    template <typename OutputIt>
+    OutputIt dequeue_n (OutputIt out, size_type count)
+    {
+      if (count > size())
+        throw queue_empty_error{"Attempting dequeue_n() on a queue with less items"};
+      if (count == 0)
+        return out;
+
+      // loop invariant: the items before head_ are copied in out
+      for (size_type i = 0; i < count; ++i, ++out) {
+        value_type value;
+        std::memcpy(&value, at_(head_), sizeof(value_type));
+        *out = value;
+        head_ += sizeof(value_type);
+      }
+      operation_(tail_, tail_);
+      return out;
+    }
+
+    /**
+     * \brief Clear the queue removing all the items
+     * \precondition None
+     * \postcondition The queue is empty, the size becomes 0
+     * \complexity O(1), plus the writes of the sync policy
+     * \throws std::system_error if the header cannot be written to the disk
+     */
+    void clear ()
+    {
+      if (empty())
+        return;
+      head_ = tail_;
+      operation_(tail_, tail_);
+    }
+
+    /**
+     * \brief Write to the disk the operations not yet written
+     * \details With the none policy the whole file is flushed, with batch the pending operations are committed
+     * \precondition None
+     * \postcondition The records and the header of the file are on the disk
+     * \complexity O(1), plus the writes
+     * \throws std::system_error if the file cannot be written to the disk
+     */
+    void sync ()
+    {
+      commit_();
+    }
+
+    /**
+     * \brief Creates a vector with the items enqueued onto the queue
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \return A vector with the items enqueued onto the queue, the front first
+     */
+    std::vector<value_type> to_vector () const
+    {
+      std::vector<value_type> vector(size());
+      auto position = head_;
+      for (auto& value : vector) {
+        std::memcpy(&value, at_(position), sizeof(value_type));
+        position += sizeof(value_type);
+      }
+      return vector;
+    }
+  };
+
+  /**
+   * \brief Bounded queue of records of any length stored in a memory mapped file, it survives the process
+   * \details A record is stored as its length in 4 bytes followed by its bytes, padded to 8 bytes. A record
+   * never wraps around the end of the ring: if it does not fit before the end a marker fills the rest of the
+   * ring and the record starts at the beginning, so front returns a view of the bytes in the file.
+   * Since the room taken by a record depends on its length, try_enqueue tells if a record fits.
+   * On open the records between the head and the tail are walked to count them and check their lengths.
+   * See [mapped_queue](@ref mapped_queue) for the file and the sync policies.
+   * \invariant The item that is accessible at the front of the queue is the item that has
+   * least recently been enqueued onto it and not yet dequeued (removed)
+   */
+  class mapped_record_queue final : private detail::mapped_ring {
+  public:
+    using value_type = std::string_view;
+    using size_type = std::size_t;
+
+    /**
+     * \brief Open the queue stored in the file at path, the file is created if it does not exist
+     * \precondition No other queue uses the file
+     * \postcondition The queue has the records committed in the file, it is empty if the file was created
+     * \complexity O(N) to walk the records of an existing file
+     * \throws std::system_error if the file cannot be created or mapped
+     * \throws mapped_queue_error if the file is not a record queue of capacity bytes or its records are not
+     * valid, the file is unchanged
+     * \param path The path of the file
+     * \param capacity The bytes of the ring, rounded up to a multiple of 8, 0 to open an existing file
+     * \param policy When the changes are written to the disk
+     * \param batch The number of operations of a commit with the batch policy
+     */
+    mapped_record_queue (std::string const& path, size_type capacity, sync_policy policy = sync_policy::none,
+                         size_type batch = 64)
+        : mapped_ring(path, 0, (std::uint64_t{capacity} + alignment - 1) / alignment * alignment, policy, batch)
+    {
+      // loop invariant: the records between head_ and position are valid and counted
+      for (auto position = head_; position != tail_; ++items_) {
+        position = skip_marker_(position);
+        auto length = length_at_(position);
+        auto end = position + record_bytes_(length);
+        if (position > tail_ || end > tail_ || position % capacity_ + record_bytes_(length) > capacity_)
+          throw mapped_queue_error{path + " has invalid records"};
+        position = end;
+      }
+    }
+
+    mapped_record_queue (mapped_record_queue&&) noexcept = default;
+
+    /**
+     * \brief Destructor
+     * \details The operations not yet committed are committed and the file is unmapped
+     * \complexity O(1), plus the writes of the commit
+     */
+    ~mapped_record_queue () = default;
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return head_ == tail_;
+    }
+
+    /**
+     * \brief The number of records in the queue
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the records on the queue
+     */
+    size_type size () const noexcept
+    {
+      return items_;
+    }
+
+    /**
+     * \brief The bytes of the ring, the records take 4 bytes more than their length rounded up to 8
+     * \precondition None
+     * \complexity O(1)
+     * \return The capacity in bytes
+     */
+    size_type capacity () const noexcept
+    {
+      return static_cast<size_type>(capacity_);
+    }
+
+    /**
+     * \brief The sync policy of the queue
+     * \precondition None
+     * \complexity O(1)
+     * \return The policy
+     */
+    sync_policy policy () const noexcept
+    {
+      return policy_;
+    }
+
+    /**
+     * \brief A view of the bytes of the record on the front of the queue
+     * \details The view is valid until the record is dequeued
+     * \precondition The queue is not empty
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The record on the front of the queue
+     */
+    value_type front () const
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting front() on empty queue"};
+
+      auto position = skip_marker_(head_);
+      return {reinterpret_cast<char const*>(at_(position) + length_bytes), length_at_(position)};
+    }
+
+    /**
+     * \brief Enqueue the record passed onto the queue if there is room for it
+     * \precondition None
+     * \postcondition If there was room the record is the last item, otherwise the queue is not changed
+     * \complexity O(L) where L is the length of the record, plus the writes of the sync policy
+     * \throws std::system_error if the record cannot be written to the disk
+     * \param record The bytes of the record
+     * \return True if the record is enqueued, false if it does not fit
+     */
+    bool try_enqueue (value_type record)
+    {
+      if (record.size() > std::numeric_limits<std::uint32_t>::max() - alignment)
+        return false;
+      auto length = static_cast<std::uint32_t>(record.size());
+      auto bytes = record_bytes_(length);
+      auto to_end = capacity_ - tail_ % capacity_;
+      // the marker and the rest of the ring are skipped if the record does not fit before the end
+      auto skip = bytes > to_end ? to_end : 0;
+      if (tail_ - head_ + skip + bytes > capacity_)
+        return false;
+
+      reserve_(skip + bytes);
+      auto first = tail_;
+      if (skip > 0) {
+        std::memcpy(at_(tail_), &marker, length_bytes);
+        tail_ += skip;
+      }
+      std::memcpy(at_(tail_), &length, length_bytes);
+      if (length > 0)
+        std::memcpy(at_(tail_) + length_bytes, record.data(), length);
+      tail_ += bytes;
+      ++items_;
+      operation_(first, tail_);
+      return true;
+    }
+
+    /**
+     * \brief Enqueue the record passed onto the queue
+     * \precondition There is room for the record
+     * \postcondition The size of the Queue is increased by 1 and the record passed becomes the last item
+     * \complexity O(L) where L is the length of the record, plus the writes of the sync policy
+     * \throws queue_full_error if there is no room for the record and the queue is not changed
+     * \throws std::system_error if the record cannot be written to the disk
+     * \param record The bytes of the record
+     */
+    void enqueue (value_type record)
+    {
+      if (!try_enqueue(record))
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+    }
+
+    /**
+     * \brief Dequeue the current front record from the queue
+     * \precondition The queue is not empty
+     * \postcondition The size of the Queue is decreased by 1 and the current front record is removed
+     * \complexity O(1), plus the writes of the sync policy
+     * \throws queue_empty_error if the queue is empty
+     * \throws std::system_error if the header cannot be written to the disk
+     */
+    void dequeue ()
+    {
+      if (empty())
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+
+      auto position = skip_marker_(head_);
+      head_ = position + record_bytes_(length_at_(position));
+      --items_;
+      operation_(tail_, tail_);
+    }
+
+    /**
+     * \brief Clear the queue removing all the records
+     * \precondition None
+     * \postcondition The queue is empty, the size becomes 0
+     * \complexity O(1), plus the writes of the sync policy
+     * \throws std::system_error if the header cannot be written to the disk
+     */
+    void clear ()
+    {
+      if (empty())
+        return;
+      head_ = tail_;
+      items_ = 0;
+      operation_(tail_, tail_);
+    }
+
+    /**
+     * \brief Write to the disk the operations not yet written
+     * \details With the none policy the whole file is flushed, with batch the pending operations are committed
+     * \precondition None
+     * \postcondition The records and the header of the file are on the disk
+     * \complexity O(1), plus the writes
+     * \throws std::system_error if the file cannot be written to the disk
+     */
+    void sync ()
+    {
+      commit_();
+    }
+
+    /**
+     * \brief Creates a vector with the records enqueued onto the queue
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \return A vector with copies of the records, the front first
+     */
+    std::vector<std::string> to_vector () const
+    {
+      std::vector<std::string> vector;
+      vector.reserve(items_);
+      for (auto position = head_; position != tail_;) {
+        position = skip_marker_(position);
+        auto length = length_at_(position);
+        vector.emplace_back(reinterpret_cast<char const*>(at_(position) + length_bytes), length);
+        position += record_bytes_(length);
+      }
+      return vector;
+    }
+
+  private:
+    static constexpr std::uint64_t alignment = 8;
+    static constexpr std::uint64_t length_bytes = sizeof(std::uint32_t);
+    static constexpr std::uint32_t marker = std::numeric_limits<std::uint32_t>::max();
+
+    static std::uint64_t record_bytes_ (std::uint32_t length) noexcept
+    {
+      return (length_bytes + length + alignment - 1) / alignment * alignment;
+    }
+
+    std::uint32_t length_at_ (std::uint64_t position) const noexcept
+    {
+      std::uint32_t length;
+      std::memcpy(&length, at_(position), length_bytes);
+      return length;
+    }
+
+    // the position of the record at position, after the marker that fills the end of the ring
+    std::uint64_t skip_marker_ (std::uint64_t position) const noexcept
+    {
+      if (length_at_(position) == marker)
+        position += capacity_ - position % capacity_;
+      return position;
+    }
+
+    size_type items_ {0};
+  };
+}
+
+#endif //ALGOL_DS_MAPPED_QUEUE_HPP
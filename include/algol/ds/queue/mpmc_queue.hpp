@@ -0,0 +1,433 @@
+/**
+ * \file
+ * Bounded multiple producers multiple consumers lock-free queue implementation.
+ */
+
+#ifndef ALGOL_DS_MPMC_QUEUE_HPP
+#define ALGOL_DS_MPMC_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "queue.hpp"
+#include "algol/ds/allocator.hpp"
+#include "algol/ds/cache_line.hpp"
+#include "algol/ds/event_count.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Bounded queue for any number of producers and consumers using sequence numbered slots
+   * \details Every slot of the ring buffer carries a sequence number that tells the state of the slot:
+   * the slot for the position pos is free when its sequence is pos and holds the item when it is pos + 1.
+   * A producer reads the sequence of the slot of the enqueue position and claims the position with a
+   * compare and swap, then constructs the item and publishes it storing pos + 1; a consumer does the same on
+   * the dequeue position and frees the slot storing pos + N, the position of the next round.
+   * The only contended writes are the compare and swap of the positions, that live on different cache lines,
+   * so the producers do not interfere with the consumers and the try operations are lock-free.
+   * The wait operations retry yielding the processor for a while and then block the thread on an
+   * [event_count](@ref event_count) until the queue is not full or not empty,
+   * the notify of the other side costs a fence and a load when nobody is waiting.
+   * Since an item can be dequeued by any consumer there is no front, the queue does not satisfy the Queue concept;
+   * empty, full and size are snapshots that can be stale with concurrent operations.
+   * The move constructor and the destructor of T must not throw, otherwise a claimed slot could never be released.
+   * \tparam T type of the items stored in the queue
+   * \tparam N capacity of the queue, a power of two avoids the division
+   * \tparam Allocator allocator of the ring buffer, it is rebound to the slot type and used only by the
+   * constructor and the destructor, the items are constructed in place by the producers
+   * \invariant The items dequeued by a consumer that were enqueued by the same producer are dequeued
+   * in the same order they were enqueued
+   * \note see Vyukov "Bounded MPMC queue" 1024cores.net
+   */
+  template <concepts::MoveConstructible T, std::size_t N, typename Allocator = std::allocator<T>>
+  class mpmc_queue final {
+    // with one slot the sequence of a full slot would be the one of a free slot of the next round
+    static_assert(N > 1, "mpmc_queue capacity must be greater than one");
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>,
+                  "mpmc_queue items must be nothrow move constructible and nothrow destructible");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Default constructor
+     * \details The slots are not constructed, T is not required to be default constructible
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(N)
+     */
+    mpmc_queue () : mpmc_queue(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty queue whose ring buffer is allocated with the provided allocator
+     * \details The slots are not constructed, T is not required to be default constructible
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(N)
+     * \param allocator The allocator of the ring buffer
+     */
+    explicit mpmc_queue (allocator_type const& allocator)
+        : allocator_ {allocator}, cells_ {detail::allocate_array(allocator_, N)}
+    {
+      for (auto i = size_type{0}; i < N; ++i)
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // the positions are shared by many threads, the queue cannot be copied nor moved
+    mpmc_queue (mpmc_queue const&) = delete;
+    mpmc_queue& operator= (mpmc_queue const&) = delete;
+
+    /**
+     * \brief Destructor
+     * \details The items still enqueued are destroyed
+     * \precondition No thread is using the queue
+     * \complexity O(N)
+     */
+    ~mpmc_queue ()
+    {
+      auto last = enqueue_pos_.load(std::memory_order_relaxed);
+      for (auto pos = dequeue_pos_.load(std::memory_order_relaxed); pos != last; ++pos)
+        std::destroy_at(cells_[index_(pos)].item());
+      detail::deallocate_array(allocator_, cells_, N);
+    }
+
+    /**
+     * \brief The allocator of the ring buffer
+     * \precondition None
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_type{allocator_};
+    }
+
+    /**
+     * \brief The capacity of the queue
+     * \precondition None
+     * \complexity O(1)
+     * \return N
+     */
+    static constexpr size_type capacity () noexcept
+    {
+      return N;
+    }
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return size() == size_type{0};
+    }
+
+    /**
+     * \brief The queue is full?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is full, false otherwise
+     */
+    bool full () const noexcept
+    {
+      return size() == N;
+    }
+
+    /**
+     * \brief The size of the queue
+     * \details The claimed positions are counted, the items being constructed or destroyed included
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the queue
+     */
+    size_type size () const noexcept
+    {
+      auto dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+      auto enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+      return enqueue_pos > dequeue_pos ? std::min(enqueue_pos - dequeue_pos, N) : size_type{0};
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue if the queue is not full
+     * \details The item is copied before claiming a slot
+     * \precondition None
+     * \postcondition If the queue was not full the item passed is enqueued, otherwise the queue is not changed
+     * \complexity O(1), lock-free
+     * \param value The item to enqueue onto the queue
+     * \return True if the item is enqueued, false if the queue is full
+     */
+    bool try_enqueue (value_type const& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+      return try_enqueue(value_type(value));
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue if the queue is not full
+     * \precondition None
+     * \postcondition If the queue was not full the item passed is enqueued, otherwise the queue and value
+     * are not changed
+     * \complexity O(1), lock-free
+     * \param value The item to enqueue onto the queue with move operation
+     * \return True if the item is enqueued, false if the queue is full
+     */
+    bool try_enqueue (value_type&& value) noexcept
+    {
+      if (!try_enqueue_(value))
+        return false;
+
+      not_empty_.notify_one();
+      return true;
+    }
+
+    /**
+     * \brief Dequeue the front item moving it in value if the queue is not empty
+     * \precondition None
+     * \postcondition If the queue was not empty the item dequeued is moved in value, otherwise the queue
+     * and value are not changed
+     * \complexity O(1), lock-free
+     * \param value The item that receives the item dequeued
+     * \return True if an item is dequeued, false if the queue is empty
+     */
+    bool try_dequeue (value_type& value) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+      if (!try_dequeue_(value))
+        return false;
+
+      not_full_.notify_one();
+      return true;
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue, waiting while the queue is full
+     * \precondition None
+     * \postcondition The item passed is enqueued
+     * \complexity O(1) if the queue is not full
+     * \param value The item to enqueue onto the queue
+     */
+    void wait_enqueue (value_type const& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+      wait_enqueue(value_type(value));
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue, waiting while the queue is full
+     * \precondition None
+     * \postcondition The item passed is enqueued
+     * \complexity O(1) if the queue is not full
+     * \param value The item to enqueue onto the queue with move operation
+     */
+    void wait_enqueue (value_type&& value) noexcept
+    {
+      wait_until_(not_full_, [this, &value] { return try_enqueue_(value); });
+      not_empty_.notify_one();
+    }
+
+    /**
+     * \brief Dequeue the front item moving it in value, waiting while the queue is empty
+     * \precondition None
+     * \postcondition The item dequeued is moved in value
+     * \complexity O(1) if the queue is not empty
+     * \param value The item that receives the item dequeued
+     */
+    void wait_dequeue (value_type& value) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+      wait_until_(not_empty_, [this, &value] { return try_dequeue_(value); });
+      not_full_.notify_one();
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \precondition The queue is not full
+     * \postcondition The item passed is enqueued
+     * \complexity O(1), lock-free
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \param value The item to enqueue onto the queue
+     */
+    void enqueue (value_type value)
+    {
+      if (!try_enqueue(std::move(value)))
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+    }
+
+    /**
+     * \brief Dequeue the front item from the queue
+     * \precondition The queue is not empty
+     * \postcondition The item dequeued is returned and removed from the queue
+     * \complexity O(1), lock-free
+     * \throws queue_empty_error if the queue is empty
+     * \return The item dequeued
+     */
+    value_type dequeue ()
+    {
+      auto pos = size_type{0};
+      auto cell = claim_dequeue_(pos);
+      if (cell == nullptr)
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+
+      value_type value {std::move(*cell->item())};
+      release_(cell, pos);
+      not_full_.notify_one();
+      return value;
+    }
+
+  private:
+    // a slot and its sequence number, the items are constructed in place
+    struct cell {
+      std::atomic<size_type> sequence;
+      alignas(value_type) unsigned char bytes[sizeof(value_type)];
+
+      value_type* item () noexcept
+      {
+        return std::launder(reinterpret_cast<value_type*>(bytes));
+      }
+    };
+
+    static constexpr size_type index_ (size_type pos) noexcept
+    {
+      if constexpr ((N & (N - 1)) == 0)
+        return pos & (N - 1);
+      else
+        return pos % N;
+    }
+
+    bool try_enqueue_ (value_type& value) noexcept
+    {
+      auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+      for (;;) {
+        // loop invariant (holds also at the end of this loop)
+        // pos is a position not older than the enqueue position when the loop started
+        auto& cell = cells_[index_(pos)];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+          if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            ::new (static_cast<void*>(cell.bytes)) value_type(std::move(value));
+            cell.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (diff < 0)
+          // the slot still holds the item of the previous round
+          return false;
+        else
+          // another producer claimed pos
+          pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    // the cell holding the item at the dequeue position, claimed, or nullptr if the queue is empty
+    cell* claim_dequeue_ (size_type& pos) noexcept
+    {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+      for (;;) {
+        auto& cell = cells_[index_(pos)];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {
+          if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            return &cell;
+        }
+        else if (diff < 0)
+          // the item of this round has not been published yet
+          return nullptr;
+        else
+          // another consumer claimed pos
+          pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    // retry a few times yielding the processor before sleeping, a sleep costs two system calls
+    template <typename Try>
+    static void wait_until_ (event_count& event, Try try_operation)
+    {
+      for (auto spin = 0; spin < wait_spins_; ++spin) {
+        if (try_operation())
+          return;
+        std::this_thread::yield();
+      }
+      while (!try_operation()) {
+        // loop invariant (holds also at the end of this loop)
+        // the operation failed and it did not change the queue nor its argument
+        auto key = event.prepare_wait();
+        if (try_operation()) {
+          event.cancel_wait();
+          return;
+        }
+        event.wait(key);
+      }
+    }
+
+    // destroy the item of a claimed cell and free the slot for the next round
+    void release_ (cell* cell, size_type pos) noexcept
+    {
+      std::destroy_at(cell->item());
+      cell->sequence.store(pos + N, std::memory_order_release);
+    }
+
+    bool try_dequeue_ (value_type& value) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+      auto pos = size_type{0};
+      auto cell = claim_dequeue_(pos);
+      if (cell == nullptr)
+        return false;
+
+      // the slot is released even if the assignment throws
+      struct releaser {
+        mpmc_queue* queue;
+        typename mpmc_queue::cell* cell;
+        size_type pos;
+
+        ~releaser ()
+        {
+          queue->release_(cell, pos);
+        }
+      } guard {this, cell, pos};
+      value = std::move(*cell->item());
+      return true;
+    }
+
+    static constexpr int wait_spins_ = 64;
+
+    using cell_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<cell>;
+
+    // read only after the construction
+    cell_allocator allocator_;
+    cell* cells_;
+
+    alignas(cache_line_size) std::atomic<size_type> enqueue_pos_ {0};
+    alignas(cache_line_size) std::atomic<size_type> dequeue_pos_ {0};
+    alignas(cache_line_size) event_count not_empty_;
+    event_count not_full_;
+  };
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief mpmc_queue whose ring buffer is allocated from a std::pmr::memory_resource
+   */
+  template <typename T, std::size_t N>
+  using mpmc_queue = ds::mpmc_queue<T, N, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif //ALGOL_DS_MPMC_QUEUE_HPP
@@ -45,6 +45,16 @@ namespace algol::ds {
     {}
   };
 
+  /**
+   * \brief Throwed when the queue is closed.
+   * \details Throwed from the enqueue operations of a blocking queue after close.
+   */
+  struct queue_closed_error : public queue_error {
+    explicit queue_closed_error (std::string const& what_arg) : std::logic_error {what_arg},
+                                                                queue_error {what_arg}
+    {}
+  };
+
   /**
    * \brief Queue ADT interface
    * \details A queue is a sequence that can be accessed in <b>'first-in, first-out' (FIFO) order</b>
@@ -0,0 +1,880 @@
+/**
+ * \file
+ * Segmented double ended queue implementation
+ */
+
+#ifndef ALGOL_DS_SEGMENTED_DEQUE_HPP
+#define ALGOL_DS_SEGMENTED_DEQUE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include "static_queue.hpp"
+#include "algol/ds/allocator.hpp"
+#include "algol/ds/chunk.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the Queue ADT as a double ended queue using a list of fixed size chunks
+   * \details see class [queue](@ref queue), the operations are dispatched at compile time by
+   * [static_queue](@ref static_queue)
+   * The items are pushed and popped at both ends, enqueue pushes at the back and dequeue pops at the front.
+   * The deque grows one chunk at a time at either end and is never full: the items already pushed are never copied
+   * nor moved, the references to them stay valid until they are popped.
+   * A chunk emptied by pop is put on a free list and reused by the next push that needs a chunk, at either end,
+   * the chunks are deallocated by shrink_to_fit and by the destructor.
+   * \tparam T type of the items stored in the deque
+   * \tparam ChunkSize number of the items of a chunk, by default a chunk is about 4 KiB
+   * \tparam Allocator allocator of the items, for example a std::pmr::polymorphic_allocator, the chunks are
+   * allocated with it rebound to the chunk type
+   * \invariant The item that is accessible at the front of the queue is the item that has
+   * least recently been enqueued onto it and not yet dequeued (removed)
+   */
+  template <concepts::CopyConstructible T, typename queue<T>::size_type ChunkSize = detail::default_chunk_size<T>,
+            typename Allocator = std::allocator<T>>
+  class segmented_deque final : public static_queue<segmented_deque<T, ChunkSize, Allocator>, T> {
+    static_assert(ChunkSize > 0, "a chunk holds at least one item");
+
+  public:
+    using value_type = typename queue<T>::value_type;
+    using reference = typename queue<T>::reference;
+    using const_reference = typename queue<T>::const_reference;
+    using size_type = typename queue<T>::size_type;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The deque is empty
+     * \complexity O(1), no allocation
+     */
+    segmented_deque () : segmented_deque(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty deque whose chunks are allocated with the provided allocator
+     * \precondition None
+     * \postcondition The deque is empty
+     * \complexity O(1), no allocation
+     * \param allocator The allocator of the items, it is rebound to the chunk type
+     */
+    explicit segmented_deque (allocator_type const& allocator)
+        : allocator_ {allocator}, pool_ {}, front_chunk_ {nullptr}, back_chunk_ {nullptr},
+          front_index_ {size_type{0}}, back_index_ {size_type{0}}, items_ {size_type{0}}, chunks_ {size_type{0}}
+    {}
+
+    /**
+     * \brief Construct a deque with values provided
+     * \details The values are pushed at the back of the deque starting at begin of initializer list and stopping
+     * at the end. If the initializer_list contains {1, 2, 3, 4} the front of the deque will be 1
+     * \precondition None
+     * \postcondition The deque size is the same of the initializer_list and all the items contained in the
+     * initializer_list are pushed at the back of the deque
+     * \complexity O(N)
+     * \param values The items to be pushed at the back of the deque
+     * \param allocator The allocator of the items
+     */
+    segmented_deque (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : segmented_deque(allocator)
+    {
+      this->enqueue_range(values.begin(), values.end());
+    }
+
+    /**
+     * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction
+     * \precondition None
+     * \postcondition This deque is equal to the provided deque
+     * \complexity O(N)
+     * \param rhs The deque to be copied
+     */
+    segmented_deque (segmented_deque const& rhs)
+        : segmented_deque(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
+
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \precondition None
+     * \postcondition This deque is equal to the provided deque
+     * \complexity O(N)
+     * \param rhs The deque to be copied
+     * \param allocator The allocator of the items
+     */
+    segmented_deque (segmented_deque const& rhs, allocator_type const& allocator) : segmented_deque(allocator)
+    {
+      // the delegating constructor has completed, if a copy throws the destructor releases the chunks
+      rhs.for_each_([this] (value_type const& value) { emplace_back_(value); });
+    }
+
+    /**
+     * \brief Move constructor
+     * \details The chunks, also the free ones, are stolen
+     * \precondition None
+     * \postcondition This deque is equal to the provided deque that becomes empty
+     * \complexity O(1)
+     * \param rhs The deque to be moved, items contained are 'stolen' from this deque
+     */
+    segmented_deque (segmented_deque&& rhs) noexcept : segmented_deque(rhs.allocator_)
+    {
+      swap_items_(rhs);
+    }
+
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The chunks are stolen if the allocators are equal, otherwise the items are moved one by one
+     * into chunks allocated with the provided allocator
+     * \precondition None
+     * \postcondition This deque is equal to the provided deque that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \param rhs The deque to be moved
+     * \param allocator The allocator of the items
+     */
+    segmented_deque (segmented_deque&& rhs, allocator_type const& allocator) : segmented_deque(allocator)
+    {
+      if (allocator_ == rhs.allocator_) {
+        swap_items_(rhs);
+        return;
+      }
+
+      // invariant: the items popped from the front of rhs are moved at the back of this deque in the same order
+      while (!rhs.empty_()) {
+        emplace_back_(std::move(rhs.front_chunk_->items_[rhs.front_index_]));
+        rhs.pop_front_();
+      }
+    }
+
+    /**
+     * \brief Assignment operator
+     * \details The actual items of the deque are destroyed and are replaced with the items of the provided deque,
+     * the allocator is replaced only if it propagates on copy assignment
+     * \precondition None
+     * \postcondition This deque is equal to the provided deque
+     * \complexity O(N)
+     * \param rhs The deque to be copied
+     * \return The deque containing the provided deque items
+     */
+    segmented_deque& operator= (segmented_deque const& rhs)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      segmented_deque temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Move assignment operator
+     * \details The actual items of the deque are destroyed and are replaced with the items of the provided deque,
+     * the chunks are stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
+     * \precondition None
+     * \postcondition This deque is equal to the provided deque that becomes empty
+     * \complexity O(1) if the chunks are stolen, O(N) otherwise
+     * \param rhs The deque to be moved, items contained are 'stolen' from this deque
+     * \return The deque containing the provided deque items
+     */
+    segmented_deque& operator= (segmented_deque&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      segmented_deque temp {std::move(rhs), propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Destructor
+     * \precondition None
+     * \postcondition The deque items are destroyed and the chunks deallocated
+     * \complexity O(N) Destructor calls
+     */
+    ~segmented_deque ()
+    {
+      clear_();
+      pool_.release(allocator_);
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
+
+    /**
+     * \brief The number of the item slots of the allocated chunks
+     * \details The chunks in use and the free chunks are counted, the free slots of the chunks in use at the
+     * front and at the back are reused only by a push at the same end
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(1)
+     * \return The capacity of the deque
+     */
+    size_type capacity () const noexcept
+    {
+      return (chunks_ + pool_.size()) * ChunkSize;
+    }
+
+    /**
+     * \brief Allocate free chunks until the capacity is at least n items
+     * \precondition None
+     * \postcondition The capacity is at least n, the items are unchanged
+     * \complexity O(n / ChunkSize)
+     * \throws std::bad_alloc if a chunk cannot be allocated, the chunks already allocated are kept
+     * \param n The number of the items
+     */
+    void reserve (size_type n)
+    {
+      if (n > chunks_ * ChunkSize)
+        pool_.reserve(allocator_, (n - chunks_ * ChunkSize + ChunkSize - 1) / ChunkSize);
+    }
+
+    /**
+     * \brief Deallocate the free chunks
+     * \precondition None
+     * \postcondition The capacity is the one of the chunks in use, the items are unchanged
+     * \complexity O(C) where C is the number of free chunks
+     */
+    void shrink_to_fit () noexcept
+    {
+      pool_.release(allocator_);
+    }
+
+    /**
+     * \brief A constant reference at the item at the back of the deque
+     * \precondition The deque is not empty
+     * \postcondition Deque is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the deque is empty
+     * \return The item at the back of the deque
+     */
+    const_reference back () const&
+    {
+      if (empty_())
+        throw queue_empty_error{"Attempting back() on empty queue"};
+
+      return back_();
+    }
+
+    /**
+     * \brief Push the item passed at the front of the deque
+     * \precondition None
+     * \postcondition The size of the deque is increased by 1 and the item passed becomes the current front
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the deque is not changed
+     * \param value The item to push at the front of the deque
+     */
+    void push_front (value_type const& value)
+    {
+      emplace_front_(value);
+    }
+
+    /**
+     * \brief Push the item passed at the front of the deque
+     * \precondition None
+     * \postcondition The size of the deque is increased by 1 and the item passed becomes the current front
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the deque is not changed
+     * \param value The item to push at the front of the deque with move operation
+     */
+    void push_front (value_type&& value)
+    {
+      emplace_front_(std::move(value));
+    }
+
+    /**
+     * \brief Push the item passed at the back of the deque, the same of enqueue
+     * \precondition None
+     * \postcondition The size of the deque is increased by 1 and the item passed becomes the current back
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the deque is not changed
+     * \param value The item to push at the back of the deque
+     */
+    void push_back (value_type const& value)
+    {
+      emplace_back_(value);
+    }
+
+    /**
+     * \brief Push the item passed at the back of the deque, the same of enqueue
+     * \precondition None
+     * \postcondition The size of the deque is increased by 1 and the item passed becomes the current back
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the deque is not changed
+     * \param value The item to push at the back of the deque with move operation
+     */
+    void push_back (value_type&& value)
+    {
+      emplace_back_(std::move(value));
+    }
+
+    /**
+     * \brief Emplace the item passed at the front of the deque
+     * \precondition None
+     * \postcondition The size of the deque is increased by 1 and the item passed becomes the current front
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the deque is not changed
+     * \tparam Args parameters types for constructor of T
+     * \param args parameters for constructor of T
+     */
+    template <typename... Args>
+    std::enable_if_t<std::is_constructible_v<T, Args&& ...>, void>
+    emplace_front (Args&& ... args)
+    {
+      emplace_front_(std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Emplace the item passed at the back of the deque
+     * \precondition None
+     * \postcondition The size of the deque is increased by 1 and the item passed becomes the current back
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the deque is not changed
+     * \tparam Args parameters types for constructor of T
+     * \param args parameters for constructor of T
+     */
+    template <typename... Args>
+    std::enable_if_t<std::is_constructible_v<T, Args&& ...>, void>
+    emplace_back (Args&& ... args)
+    {
+      emplace_back_(std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Emplace the item passed at the back of the deque, the same of emplace_back
+     * \precondition None
+     * \postcondition The size of the deque is increased by 1 and the item passed becomes the current back
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the deque is not changed
+     * \tparam Args parameters types for constructor of T
+     * \param args parameters for constructor of T
+     */
+    template <typename... Args>
+    std::enable_if_t<std::is_constructible_v<T, Args&& ...>, void>
+    emplace (Args&& ... args)
+    {
+      emplace_back_(std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Pop the current front item from the deque, the same of dequeue
+     * \precondition The deque is not empty
+     * \postcondition The size of the deque is decreased by 1 and the current front item is removed
+     * \complexity O(1)
+     * \throws queue_empty_error if the deque is empty
+     */
+    void pop_front ()
+    {
+      if (empty_())
+        throw queue_empty_error{"Attempting pop_front() on empty queue"};
+
+      pop_front_();
+    }
+
+    /**
+     * \brief Pop the current back item from the deque
+     * \precondition The deque is not empty
+     * \postcondition The size of the deque is decreased by 1 and the current back item is removed
+     * \complexity O(1)
+     * \throws queue_empty_error if the deque is empty
+     */
+    void pop_back ()
+    {
+      if (empty_())
+        throw queue_empty_error{"Attempting pop_back() on empty queue"};
+
+      pop_back_();
+    }
+
+    /**
+     * \brief Equality operator
+     * \details It must be reflexive, symmetric and transitive
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(N)
+     * \param rhs The deque to be compared with this
+     * \return True if the items are the same and in the same order, false otherwise
+     */
+    bool operator== (segmented_deque const& rhs) const
+    requires concepts::EqualityComparable<T>
+    {
+      if (items_ != rhs.items_)
+        return false;
+
+      auto this_cursor = begin_();
+      auto rhs_cursor = rhs.begin_();
+      for (auto i = size_type{0}; i < items_; ++i, this_cursor.next(), rhs_cursor.next()) {
+        // loop invariant: the first i items are equal
+        if (!(this_cursor.value() == rhs_cursor.value()))
+          return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * \brief Inequality operator
+     * \details Implemented in terms of equality operator
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(N)
+     * \param rhs The deque to be compared with this
+     * \return True if the items are not the same or not in the same order, false otherwise
+     */
+    bool operator!= (segmented_deque const& rhs) const
+    requires concepts::EqualityComparable<T>
+    {
+      return !(*this == rhs);
+    }
+
+    /**
+     * \brief Less than operator
+     * \details Lexicographical comparison of the items from the front to the back:
+     * - The first mismatching item defines which deque is lexicographically less or greater than the other
+     * - If one deque is a prefix of another, the shorter deque is lexicographically less than the other
+     * - An empty deque is lexicographically less than any non-empty deque
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(N)
+     * \param rhs The deque to be compared with this
+     * \return True if this deque is lexicographically less than the provided deque, false otherwise
+     */
+    bool operator< (segmented_deque const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      auto this_cursor = begin_();
+      auto rhs_cursor = rhs.begin_();
+      auto items = std::min(items_, rhs.items_);
+      for (auto i = size_type{0}; i < items; ++i, this_cursor.next(), rhs_cursor.next()) {
+        // loop invariant: the first i items are equal
+        if (this_cursor.value() < rhs_cursor.value())
+          return true;
+        if (rhs_cursor.value() < this_cursor.value())
+          return false;
+      }
+
+      return items_ < rhs.items_;
+    }
+
+    /**
+     * \brief Less than or equal operator
+     * \details see operator<
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(N)
+     * \param rhs The deque to be compared with this
+     * \return True if this deque is lexicographically less than or equal to the provided deque, false otherwise
+     */
+    bool operator<= (segmented_deque const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return !(*this > rhs);
+    }
+
+    /**
+     * \brief Greater than operator
+     * \details see operator<
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(N)
+     * \param rhs The deque to be compared with this
+     * \return True if this deque is lexicographically greater than the provided deque, false otherwise
+     */
+    bool operator> (segmented_deque const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return rhs < *this;
+    }
+
+    /**
+     * \brief Greater than or equal operator
+     * \details see operator<
+     * \precondition None
+     * \postcondition The deque is unchanged
+     * \complexity O(N)
+     * \param rhs The deque to be compared with this
+     * \return True if this deque is lexicographically greater than or equal to the provided deque, false otherwise
+     */
+    bool operator>= (segmented_deque const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return !(*this < rhs);
+    }
+
+    /**
+     * \brief Swaps the items of this deque with the items of the provided deque
+     * \details noexcept operation, it cannot throw.
+     * The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
+     * \postcondition This deque becomes the rhs deque and viceversa
+     * \complexity O(1)
+     * \param rhs The deque to be swapped with this
+     */
+    void swap (segmented_deque& rhs) noexcept
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+  private:
+    friend class static_queue<segmented_deque, T>;
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using chunk_type = detail::chunk<value_type, ChunkSize>;
+
+    // a position in the chunks, it steps from the front to the back
+    struct cursor_ {
+      chunk_type const* chunk_;
+      size_type index_;
+
+      const_reference value () const
+      {
+        return chunk_->items_[index_];
+      }
+
+      void next () noexcept
+      {
+        if (++index_ == ChunkSize) {
+          chunk_ = chunk_->next_;
+          index_ = size_type{0};
+        }
+      }
+    };
+
+    cursor_ begin_ () const noexcept
+    {
+      return cursor_{front_chunk_, front_index_};
+    }
+
+    // swap the chunks and the counters, not the allocators
+    void swap_items_ (segmented_deque& rhs) noexcept
+    {
+      using std::swap;
+      swap(front_chunk_, rhs.front_chunk_);
+      swap(back_chunk_, rhs.back_chunk_);
+      swap(front_index_, rhs.front_index_);
+      swap(back_index_, rhs.back_index_);
+      swap(items_, rhs.items_);
+      swap(chunks_, rhs.chunks_);
+      pool_.swap(rhs.pool_);
+    }
+
+    // call f on the items from the front to the back
+    template <typename F>
+    void for_each_ (F f) const
+    {
+      auto cursor = begin_();
+      for (auto i = size_type{0}; i < items_; ++i, cursor.next())
+        f(cursor.value());
+    }
+
+    // the deque is empty, the only chunk in use goes back to the free list
+    void release_last_chunk_ () noexcept
+    {
+      assert(items_ == size_type{0} && front_chunk_ == back_chunk_);
+
+      pool_.recycle(front_chunk_);
+      front_chunk_ = back_chunk_ = nullptr;
+      front_index_ = back_index_ = size_type{0};
+      --chunks_;
+    }
+
+    bool empty_ () const final
+    {
+      return items_ == size_type{0};
+    }
+
+    bool full_ () const final
+    {
+      return false;
+    }
+
+    size_type size_ () const final
+    {
+      return items_;
+    }
+
+    const_reference front_ () const& final
+    {
+      assert(front_chunk_ != nullptr && front_index_ < ChunkSize);
+
+      return front_chunk_->items_[front_index_];
+    }
+
+    const_reference back_ () const&
+    {
+      assert(back_chunk_ != nullptr && back_index_ > size_type{0});
+
+      return back_chunk_->items_[back_index_ - 1];
+    }
+
+    void enqueue_ (value_type const& value) final
+    {
+      emplace_back_(value);
+    }
+
+    void enqueue_ (value_type&& value) final
+    {
+      emplace_back_(std::move(value));
+    }
+
+    void dequeue_ () final
+    {
+      pop_front_();
+    }
+
+    void pop_front_ ()
+    {
+      assert(front_chunk_ != nullptr && front_index_ < ChunkSize);
+
+      alloc_traits::destroy(allocator_, std::addressof(front_chunk_->items_[front_index_++]));
+      if (--items_ == size_type{0})
+        release_last_chunk_();
+      else if (front_index_ == ChunkSize)
+        drop_front_chunk_();
+    }
+
+    // the front chunk is empty, it goes back to the free list and the next chunk becomes the front
+    void drop_front_chunk_ () noexcept
+    {
+      assert(front_chunk_ != back_chunk_ && front_index_ == ChunkSize);
+
+      auto empty_chunk = front_chunk_;
+      front_chunk_ = front_chunk_->next_;
+      front_chunk_->prev_ = nullptr;
+      front_index_ = size_type{0};
+      --chunks_;
+      pool_.recycle(empty_chunk);
+    }
+
+    void pop_back_ ()
+    {
+      assert(back_chunk_ != nullptr && back_index_ > size_type{0});
+
+      alloc_traits::destroy(allocator_, std::addressof(back_chunk_->items_[--back_index_]));
+      if (--items_ == size_type{0})
+        release_last_chunk_();
+      else if (back_index_ == size_type{0})
+        drop_back_chunk_();
+    }
+
+    // the back chunk is empty, it goes back to the free list and the previous chunk becomes the back
+    void drop_back_chunk_ () noexcept
+    {
+      assert(front_chunk_ != back_chunk_ && back_index_ == size_type{0});
+
+      auto empty_chunk = back_chunk_;
+      back_chunk_ = back_chunk_->prev_;
+      back_chunk_->next_ = nullptr;
+      back_index_ = ChunkSize;
+      --chunks_;
+      pool_.recycle(empty_chunk);
+    }
+
+    void clear_ () final
+    {
+      // invariant: the items before the front are destroyed and their chunks are free
+      while (items_ > size_type{0})
+        pop_front_();
+    }
+
+    std::vector<value_type> to_vector_ () const final
+    {
+      std::vector<value_type> vector {};
+      vector.reserve(items_);
+      for_each_([&vector] (value_type const& value) { vector.push_back(value); });
+      return vector;
+    }
+
+    // construct the item in a chunk from the pool, the chunk is recycled if the construction throws
+    template <typename... Args>
+    chunk_type* construct_in_new_chunk_ (size_type index, Args&& ... args)
+    {
+      auto new_chunk = pool_.acquire(allocator_);
+      try {
+        alloc_traits::construct(allocator_, new_chunk->items_.data() + index, std::forward<Args>(args)...);
+      }
+      catch (...) {
+        pool_.recycle(new_chunk);
+        throw;
+      }
+      ++chunks_;
+      return new_chunk;
+    }
+
+    template <typename... Args>
+    void emplace_back_ (Args&& ... args)
+    {
+      if (back_chunk_ != nullptr && back_index_ < ChunkSize) {
+        alloc_traits::construct(allocator_, back_chunk_->items_.data() + back_index_, std::forward<Args>(args)...);
+        ++back_index_;
+        ++items_;
+        return;
+      }
+
+      // the back chunk is full or there are no chunks, the item goes at the start of a new back chunk
+      auto new_chunk = construct_in_new_chunk_(size_type{0}, std::forward<Args>(args)...);
+      link_back_chunk_(new_chunk);
+      back_index_ = size_type{1};
+      ++items_;
+    }
+
+    // link a chunk after the back chunk, its items are constructed from the start
+    void link_back_chunk_ (chunk_type* new_chunk) noexcept
+    {
+      new_chunk->prev_ = back_chunk_;
+      if (back_chunk_ != nullptr)
+        back_chunk_->next_ = new_chunk;
+      else {
+        front_chunk_ = new_chunk;
+        front_index_ = size_type{0};
+      }
+      back_chunk_ = new_chunk;
+      back_index_ = size_type{0};
+    }
+
+    // the items are copied a chunk at a time at the back, with memcpy if they are trivially copyable;
+    // if a copy throws the items already enqueued are popped at the back
+    template <typename ForwardIt>
+    void enqueue_n_ (ForwardIt first, size_type count)
+    {
+      auto enqueued = size_type{0};
+      try {
+        // loop invariant: the items before first are enqueued
+        while (enqueued < count) {
+          if (back_chunk_ == nullptr || back_index_ == ChunkSize) {
+            link_back_chunk_(pool_.acquire(allocator_));
+            ++chunks_;
+          }
+          auto segment = std::min(count - enqueued, ChunkSize - back_index_);
+          first = detail::uninitialized_copy_n(allocator_, first, segment, back_chunk_->items_.data() + back_index_);
+          back_index_ += segment;
+          items_ += segment;
+          enqueued += segment;
+        }
+      }
+      catch (...) {
+        // the chunk linked for the copy that has thrown is empty
+        if (back_chunk_ != nullptr && back_index_ == size_type{0}) {
+          if (items_ == size_type{0})
+            release_last_chunk_();
+          else
+            drop_back_chunk_();
+        }
+        while (enqueued-- > size_type{0})
+          pop_back_();
+        throw;
+      }
+    }
+
+    // the items are moved out a chunk at a time from the front and then destroyed
+    template <typename OutputIt>
+    OutputIt dequeue_n_ (OutputIt out, size_type count)
+    {
+      assert(count <= items_);
+
+      // loop invariant: the items dequeued are written before out
+      while (count > size_type{0}) {
+        auto end = front_chunk_ == back_chunk_ ? back_index_ : ChunkSize;
+        auto segment = std::min(count, end - front_index_);
+        auto front = std::addressof(front_chunk_->items_[front_index_]);
+        out = std::move(front, front + segment, out);
+        for (auto i = size_type{0}; i < segment; ++i)
+          alloc_traits::destroy(allocator_, front + i);
+        front_index_ += segment;
+        items_ -= segment;
+        count -= segment;
+        if (items_ == size_type{0})
+          release_last_chunk_();
+        else if (front_index_ == ChunkSize)
+          drop_front_chunk_();
+      }
+      return out;
+    }
+
+    template <typename... Args>
+    void emplace_front_ (Args&& ... args)
+    {
+      if (front_chunk_ != nullptr && front_index_ > size_type{0}) {
+        alloc_traits::construct(allocator_, front_chunk_->items_.data() + front_index_ - 1,
+                                std::forward<Args>(args)...);
+        --front_index_;
+        ++items_;
+        return;
+      }
+
+      // the front chunk is full or there are no chunks, the item goes at the end of a new front chunk
+      auto new_chunk = construct_in_new_chunk_(ChunkSize - 1, std::forward<Args>(args)...);
+      new_chunk->next_ = front_chunk_;
+      if (front_chunk_ != nullptr)
+        front_chunk_->prev_ = new_chunk;
+      else {
+        back_chunk_ = new_chunk;
+        back_index_ = ChunkSize;
+      }
+      front_chunk_ = new_chunk;
+      front_index_ = ChunkSize - 1;
+      ++items_;
+    }
+
+    allocator_type allocator_;
+    detail::chunk_pool<value_type, ChunkSize> pool_;
+    chunk_type* front_chunk_;
+    chunk_type* back_chunk_;
+    size_type front_index_;   // the position of the front item in the front chunk
+    size_type back_index_;    // one past the position of the back item in the back chunk
+    size_type items_;
+    size_type chunks_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs deques
+   * \details Non member function, noexcept it cannot fail
+   * \tparam T type of the items stored in the deque
+   * \precondition The allocators are equal or they propagate on swap
+   * \postcondition The lhs deque becomes the rhs deque and viceversa
+   * \complexity O(1)
+   * \param lhs Deque to be exchanged with rhs
+   * \param rhs Deque to be exchanged with lhs
+   */
+  template <typename T, typename queue<T>::size_type ChunkSize, typename Allocator>
+  void swap (segmented_deque<T, ChunkSize, Allocator>& lhs, segmented_deque<T, ChunkSize, Allocator>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief segmented_deque whose chunks are allocated from a std::pmr::memory_resource
+   */
+  template <typename T, typename queue<T>::size_type ChunkSize = detail::default_chunk_size<T>>
+  using segmented_deque = ds::segmented_deque<T, ChunkSize, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif //ALGOL_DS_SEGMENTED_DEQUE_HPP
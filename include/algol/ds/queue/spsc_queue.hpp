@@ -0,0 +1,512 @@
+/**
+ * \file
+ * Single producer single consumer lock-free queue implementation.
+ */
+
+#ifndef ALGOL_DS_SPSC_QUEUE_HPP
+#define ALGOL_DS_SPSC_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "queue.hpp"
+#include "algol/ds/allocator.hpp"
+#include "algol/ds/cache_line.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the Queue ADT using a lock-free ring buffer for one producer and one consumer
+   * \details The queue can be used concurrently by exactly two threads: the producer calls the enqueue
+   * operations and the consumer calls front and the dequeue operations.
+   * The ring buffer is indexed by two counters that only grow: head is written only by the consumer and
+   * tail only by the producer, the slot of a counter is counter % N, computed with a mask when N is a power of two.
+   * Head and tail live on different cache lines, each one next to a cached copy of the other counter owned by
+   * the same thread: the producer reloads head, and the consumer reloads tail, only when the cached copy
+   * says that the queue is full or empty, so in the steady state the two threads do not share any cache line
+   * but the slots.
+   * The batch operations transfer many items publishing the counter once.
+   * The queue is not derived from [queue](@ref queue), it satisfies the Queue concept without the virtual calls.
+   * empty, full and size can be called by both threads, with concurrent operations the result can be stale.
+   * \tparam T type of the items stored in the queue
+   * \tparam N capacity of the queue, a power of two avoids the division
+   * \tparam Allocator allocator of the ring buffer, it is rebound to the slot type and used only by the
+   * constructor and the destructor, the items are constructed in place by the producers
+   * \invariant The item that is accessible at the front of the queue is the item that has
+   * least recently been enqueued onto it and not yet dequeued (removed)
+   */
+  template <concepts::MoveConstructible T, std::size_t N, typename Allocator = std::allocator<T>>
+  class spsc_queue final {
+    static_assert(N > 0, "spsc_queue capacity must be greater than zero");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Default constructor
+     * \details The slots are not constructed, T is not required to be default constructible
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(1)
+     */
+    spsc_queue () : spsc_queue(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty queue whose ring buffer is allocated with the provided allocator
+     * \details The slots are not constructed, T is not required to be default constructible
+     * \precondition None
+     * \postcondition The queue is empty
+     * \complexity O(1)
+     * \param allocator The allocator of the ring buffer
+     */
+    explicit spsc_queue (allocator_type const& allocator)
+        : allocator_ {allocator}, slots_ {detail::allocate_array(allocator_, N)}
+    {}
+
+    /**
+     * \brief Construct a queue with values provided
+     * \details The values are enqueued onto the queue starting at begin of initializer list and stopping at the end
+     * \precondition values.size() <= N
+     * \postcondition The queue size is the same of the initializer_list and all the items contained in the
+     * initializer_list are enqueued onto the queue
+     * \complexity O(N)
+     * \throws queue_full_error if the values are more than N
+     * \param values The items to be enqueued onto the queue
+     * \param allocator The allocator of the ring buffer
+     */
+    spsc_queue (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : spsc_queue(allocator)
+    {
+      enqueue_range(values.begin(), values.end());
+    }
+
+    // the counters are shared by two threads, the queue cannot be copied nor moved
+    spsc_queue (spsc_queue const&) = delete;
+    spsc_queue& operator= (spsc_queue const&) = delete;
+
+    /**
+     * \brief Destructor
+     * \details The items still enqueued are destroyed
+     * \precondition No thread is using the queue
+     * \complexity O(N)
+     */
+    ~spsc_queue ()
+    {
+      auto tail = tail_.load(std::memory_order_relaxed);
+      for (auto head = head_.load(std::memory_order_relaxed); head != tail; ++head)
+        std::destroy_at(item_(head));
+      detail::deallocate_array(allocator_, slots_, N);
+    }
+
+    /**
+     * \brief The allocator of the ring buffer
+     * \precondition None
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_type{allocator_};
+    }
+
+    /**
+     * \brief The capacity of the queue
+     * \precondition None
+     * \complexity O(1)
+     * \return N
+     */
+    static constexpr size_type capacity () noexcept
+    {
+      return N;
+    }
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return size() == size_type{0};
+    }
+
+    /**
+     * \brief The queue is full?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is full, false otherwise
+     */
+    bool full () const noexcept
+    {
+      return size() == N;
+    }
+
+    /**
+     * \brief The size of the queue
+     * \details With concurrent operations the size is a snapshot taken between the two loads
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the queue
+     */
+    size_type size () const noexcept
+    {
+      // head is loaded first, tail can only grow after so tail - head is never negative
+      auto head = head_.load(std::memory_order_acquire);
+      auto tail = tail_.load(std::memory_order_acquire);
+      return std::min(tail - head, N);
+    }
+
+    /**
+     * \brief A constant reference at the item on the front of the queue
+     * \details To be called only by the consumer
+     * \precondition The queue is not empty
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item on the front of the queue
+     */
+    const_reference front () const&
+    {
+      auto head = head_.load(std::memory_order_relaxed);
+      if (!readable_(head, 1))
+        throw queue_empty_error{"Attempting front() on empty queue"};
+
+      return *item_(head);
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \details To be called only by the producer
+     * \precondition The queue is not full
+     * \postcondition The size of the Queue is increased by 1 and the item passed becomes the current rear
+     * \complexity O(1)
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \param value The item to enqueue onto the queue
+     */
+    void enqueue (value_type const& value)
+    {
+      if (!try_emplace(value))
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \details To be called only by the producer
+     * \precondition The queue is not full
+     * \postcondition The size of the Queue is increased by 1 and the item passed becomes the current rear
+     * \complexity O(1)
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \param value The item to enqueue onto the queue with move operation
+     */
+    void enqueue (value_type&& value)
+    {
+      if (!try_emplace(std::move(value)))
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue if the queue is not full
+     * \details To be called only by the producer
+     * \precondition None
+     * \postcondition If the queue was not full the size of the Queue is increased by 1 and the item passed
+     * becomes the current rear, otherwise the queue is not changed
+     * \complexity O(1)
+     * \param value The item to enqueue onto the queue
+     * \return True if the item is enqueued, false if the queue is full
+     */
+    bool try_enqueue (value_type const& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+      return try_emplace(value);
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue if the queue is not full
+     * \details To be called only by the producer
+     * \precondition None
+     * \postcondition If the queue was not full the size of the Queue is increased by 1 and the item passed
+     * becomes the current rear, otherwise the queue and value are not changed
+     * \complexity O(1)
+     * \param value The item to enqueue onto the queue with move operation
+     * \return True if the item is enqueued, false if the queue is full
+     */
+    bool try_enqueue (value_type&& value) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+      return try_emplace(std::move(value));
+    }
+
+    /**
+     * \brief Construct an item in place at the rear of the queue if the queue is not full
+     * \details To be called only by the producer
+     * \precondition None
+     * \postcondition If the queue was not full the size of the Queue is increased by 1 and the item constructed
+     * becomes the current rear, otherwise the queue is not changed
+     * \complexity O(1)
+     * \param args The arguments forwarded to the constructor of the item
+     * \return True if the item is enqueued, false if the queue is full
+     */
+    template <typename... Args>
+    bool try_emplace (Args&& ... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    {
+      auto tail = tail_.load(std::memory_order_relaxed);
+      if (!writable_(tail, 1))
+        return false;
+
+      ::new (static_cast<void*>(item_(tail))) value_type(std::forward<Args>(args)...);
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * \brief Enqueue up to count items copied from the range starting at first
+     * \details To be called only by the producer. The items are published all together with one store,
+     * if the construction of an item throws the items already constructed are published.
+     * Pass a move_iterator to move the items
+     * \precondition [first, first + count) is a valid range
+     * \postcondition min(count, free slots) items are enqueued in order
+     * \complexity O(count)
+     * \tparam InputIt iterator type of the range
+     * \param first iterator to the first item to enqueue
+     * \param count number of items to enqueue
+     * \return The number of items enqueued
+     */
+    template <concepts::InputIterator InputIt>
+    size_type try_enqueue_n (InputIt first, size_type count)
+    {
+      auto tail = tail_.load(std::memory_order_relaxed);
+      count = std::min(count, writable_(tail, count));
+
+      auto i = size_type{0};
+      try {
+        for (; i < count; ++i, ++first)
+          ::new (static_cast<void*>(item_(tail + i))) value_type(*first);
+      }
+      catch (...) {
+        tail_.store(tail + i, std::memory_order_release);
+        throw;
+      }
+      tail_.store(tail + count, std::memory_order_release);
+      return count;
+    }
+
+    /**
+     * \brief Enqueue the items of the range onto the queue, the last item becomes the rear
+     * \details To be called only by the producer. The room for the items is checked once and the items are
+     * published all together with one store, see try_enqueue_n
+     * \precondition The queue has room for std::distance(first, last) items
+     * \postcondition The items of the range are enqueued in order
+     * \complexity O(M) where M is the number of the items of the range
+     * \throws queue_full_error if the queue has not room for all the items and the queue is not changed
+     * \tparam ForwardIt iterator type of the range
+     * \param first iterator to the first item to enqueue
+     * \param last iterator past the last item to enqueue
+     */
+    template <concepts::ForwardIterator ForwardIt>
+    void enqueue_range (ForwardIt first, ForwardIt last)
+    {
+      auto count = static_cast<size_type>(std::distance(first, last));
+      if (writable_(tail_.load(std::memory_order_relaxed), count) < count)
+        throw queue_full_error{"Attempting enqueue_range() on full queue"};
+
+      try_enqueue_n(first, count);
+    }
+
+    /**
+     * \brief Dequeue the current front item from the queue
+     * \details To be called only by the consumer
+     * \precondition The queue is not empty
+     * \postcondition The size of the Queue is decreased by 1 and the current front item is removed from the queue
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     */
+    void dequeue ()
+    {
+      auto head = head_.load(std::memory_order_relaxed);
+      if (!readable_(head, 1))
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+
+      std::destroy_at(item_(head));
+      head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * \brief Move the front item in value and dequeue it if the queue is not empty
+     * \details To be called only by the consumer
+     * \precondition None
+     * \postcondition If the queue was not empty the front item is moved in value and removed from the queue,
+     * otherwise the queue and value are not changed
+     * \complexity O(1)
+     * \param value The item that receives the front item
+     * \return True if an item is dequeued, false if the queue is empty
+     */
+    bool try_dequeue (value_type& value) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+      auto head = head_.load(std::memory_order_relaxed);
+      if (!readable_(head, 1))
+        return false;
+
+      auto item = item_(head);
+      value = std::move(*item);
+      std::destroy_at(item);
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * \brief Dequeue up to count items moving them in the range starting at out
+     * \details To be called only by the consumer. The slots are released all together with one store
+     * \precondition out can be incremented count times
+     * \postcondition min(count, size) items are moved in order in out and removed from the queue
+     * \complexity O(count)
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count maximum number of items to dequeue
+     * \return The number of items dequeued
+     */
+    template <typename OutputIt>
+    size_type try_dequeue_n (OutputIt out, size_type count)
+    {
+      auto head = head_.load(std::memory_order_relaxed);
+      count = std::min(count, readable_(head, count));
+
+      dequeue_n_(head, out, count);
+      return count;
+    }
+
+    /**
+     * \brief Dequeue count items moving them in the range starting at out
+     * \details To be called only by the consumer. The size is checked once and the slots are released all
+     * together with one store
+     * \precondition The queue holds at least count items and out can be incremented count times
+     * \postcondition count items are moved in order in out and removed from the queue
+     * \complexity O(count)
+     * \throws queue_empty_error if the queue holds less than count items and the queue is not changed
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count number of the items to dequeue
+     * \return The iterator past the last item written
+     */
+    template <typename OutputIt>
+    OutputIt dequeue_n (OutputIt out, size_type count)
+    {
+      auto head = head_.load(std::memory_order_relaxed);
+      if (readable_(head, count) < count)
+        throw queue_empty_error{"Attempting dequeue_n() on empty queue"};
+
+      return dequeue_n_(head, out, count);
+    }
+
+    /**
+     * \brief Clear the queue removing all the items
+     * \details To be called only by the consumer, the items enqueued concurrently can be not removed.
+     * Invalidates any references or pointers referring to contained elements
+     * \precondition None
+     * \postcondition The items enqueued before the call are removed
+     * \complexity O(N)
+     */
+    void clear () noexcept
+    {
+      auto head = head_.load(std::memory_order_relaxed);
+      auto tail = tail_.load(std::memory_order_acquire);
+      for (auto i = head; i != tail; ++i)
+        std::destroy_at(item_(i));
+      tail_cache_ = tail;
+      head_.store(tail, std::memory_order_release);
+    }
+
+  private:
+    // raw storage for one item
+    struct slot {
+      alignas(value_type) unsigned char bytes[sizeof(value_type)];
+    };
+
+    static constexpr size_type index_ (size_type counter) noexcept
+    {
+      if constexpr ((N & (N - 1)) == 0)
+        return counter & (N - 1);
+      else
+        return counter % N;
+    }
+
+    value_type* item_ (size_type counter) const noexcept
+    {
+      return std::launder(reinterpret_cast<value_type*>(slots_[index_(counter)].bytes));
+    }
+
+    // producer: the number of free slots, at most wanted, head is reloaded only if the cached copy is not enough
+    size_type writable_ (size_type tail, size_type wanted) noexcept
+    {
+      assert(tail - head_cache_ <= N);
+
+      if (N - (tail - head_cache_) < wanted)
+        head_cache_ = head_.load(std::memory_order_acquire);
+      return N - (tail - head_cache_);
+    }
+
+    // consumer: move count readable items starting at head in out and release their slots
+    template <typename OutputIt>
+    OutputIt dequeue_n_ (size_type head, OutputIt out, size_type count)
+    {
+      for (auto i = size_type{0}; i < count; ++i, ++out) {
+        auto item = item_(head + i);
+        *out = std::move(*item);
+        std::destroy_at(item);
+      }
+      head_.store(head + count, std::memory_order_release);
+      return out;
+    }
+
+    // consumer: the number of items available, at most wanted, tail is reloaded only if the cached copy is not enough
+    size_type readable_ (size_type head, size_type wanted) const noexcept
+    {
+      assert(tail_cache_ - head <= N);
+
+      if (tail_cache_ - head < wanted)
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+      return tail_cache_ - head;
+    }
+
+    using slot_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<slot>;
+
+    // read only after the construction
+    slot_allocator allocator_;
+    slot* slots_;
+
+    // consumer cache line
+    alignas(cache_line_size) std::atomic<size_type> head_ {0};
+    mutable size_type tail_cache_ {0};
+
+    // producer cache line, the alignment of the class pads it to a whole line
+    alignas(cache_line_size) std::atomic<size_type> tail_ {0};
+    size_type head_cache_ {0};
+  };
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief spsc_queue whose ring buffer is allocated from a std::pmr::memory_resource
+   */
+  template <typename T, std::size_t N>
+  using spsc_queue = ds::spsc_queue<T, N, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif //ALGOL_DS_SPSC_QUEUE_HPP
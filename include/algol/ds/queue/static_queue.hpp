@@ -0,0 +1,258 @@
+/**
+ * \file
+ * Queue ADT with static dispatch
+ */
+
+#ifndef ALGOL_DS_STATIC_QUEUE_HPP
+#define ALGOL_DS_STATIC_QUEUE_HPP
+
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "queue.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Queue ADT interface dispatched at compile time (CRTP)
+   * \details The operations have the same signatures, preconditions and exceptions of the ones of
+   * [queue](@ref queue), but they call the hooks of Derived directly: Derived is a final class so the hooks
+   * are not looked up in the virtual table and they can be inlined in the caller.
+   * The operations of [queue](@ref queue) are hidden, not replaced: through a reference to queue<T> the
+   * same container is still used with dynamic dispatch.
+   * Derived implements the hooks of [queue](@ref queue) as final and befriends static_queue.
+   * The batch operations enqueue_range and dequeue_n check the queue once per batch and call the hooks
+   * enqueue_n_, dequeue_n_ and space_ of static_queue, which enqueue and dequeue one item at a time: Derived
+   * hides them to copy a whole segment of its storage at once.
+   * \tparam Derived the final class implementing the queue
+   * \tparam T type of the items stored in the queue.
+   * \invariant The item that is accessible at the front of the queue is the item that has
+   * least recently been enqueued onto it and not yet dequeued (removed).
+   */
+  template <typename Derived, typename T>
+  class static_queue : public queue<T> {
+  public:
+    using value_type = typename queue<T>::value_type;
+    using reference = typename queue<T>::reference;
+    using const_reference = typename queue<T>::const_reference;
+    using size_type = typename queue<T>::size_type;
+
+    /**
+     * \brief The queue is empty?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is empty, false otherwise
+     */
+    bool empty () const
+    {
+      return derived_().empty_();
+    }
+
+    /**
+     * \brief The queue is full?
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return True if the queue is full, false otherwise
+     */
+    bool full () const
+    {
+      return derived_().full_();
+    }
+
+    /**
+     * \brief The size of the queue
+     * \precondition None
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the queue
+     */
+    size_type size () const
+    {
+      return derived_().size_();
+    }
+
+    /**
+     * \brief A constant reference at the item on the front of the queue
+     * \precondition The queue is not empty
+     * \postcondition Queue is not changed
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     * \return The item on the front of the queue
+     */
+    const_reference front () const&
+    {
+      if (derived_().empty_())
+        throw queue_empty_error{"Attempting front() on empty queue"};
+
+      return derived_().front_();
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \precondition The queue is not full
+     * \postcondition The size of the Queue is increased by 1 and the item passed becomes the current rear
+     * \complexity O(1)
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \param value The item to enqueue onto the queue
+     */
+    void enqueue (value_type const& value)
+    {
+      if (derived_().full_())
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+
+      derived_().enqueue_(value);
+    }
+
+    /**
+     * \brief Enqueue the item passed onto the queue
+     * \precondition The queue is not full
+     * \postcondition The size of the Queue is increased by 1 and the item passed becomes the current rear
+     * \complexity O(1)
+     * \throws queue_full_error if the queue is full and the queue is not changed
+     * \param value The item to enqueue onto the queue with move operation
+     */
+    void enqueue (value_type&& value)
+    {
+      if (derived_().full_())
+        throw queue_full_error{"Attempting enqueue() on full queue"};
+
+      derived_().enqueue_(std::move(value));
+    }
+
+    /**
+     * \brief Enqueue the items of the range onto the queue, the last item becomes the rear
+     * \details The room for the items is checked once before the first enqueue.
+     * If the copy of an item throws, the items of the range before it can be left in the queue
+     * \precondition The queue has room for std::distance(first, last) items
+     * \postcondition The size of the Queue is increased by the number of the items of the range, enqueued in order
+     * \complexity O(M) where M is the number of the items of the range
+     * \throws queue_full_error if the queue has not room for all the items and the queue is not changed
+     * \tparam ForwardIt iterator type of the range
+     * \param first iterator to the first item to enqueue
+     * \param last iterator past the last item to enqueue
+     */
+    template <concepts::ForwardIterator ForwardIt>
+    void enqueue_range (ForwardIt first, ForwardIt last)
+    {
+      auto count = static_cast<size_type>(std::distance(first, last));
+      if (count > derived_().space_())
+        throw queue_full_error{"Attempting enqueue_range() on full queue"};
+
+      derived_().enqueue_n_(first, count);
+    }
+
+    /**
+     * \brief Dequeue count items from the queue moving them in the range starting at out, the front item first
+     * \details The size is checked once before the first dequeue
+     * \precondition The queue holds at least count items and out can be incremented count times
+     * \postcondition The size of the Queue is decreased by count, the items are written in the order of the queue
+     * \complexity O(count)
+     * \throws queue_empty_error if the queue holds less than count items and the queue is not changed
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count number of the items to dequeue
+     * \return The iterator past the last item written
+     */
+    template <typename OutputIt>
+    OutputIt dequeue_n (OutputIt out, size_type count)
+    {
+      if (count > derived_().size_())
+        throw queue_empty_error{"Attempting dequeue_n() on empty queue"};
+
+      return derived_().dequeue_n_(out, count);
+    }
+
+    /**
+     * \brief Dequeue the current front item from the queue
+     * \precondition The queue is not empty
+     * \postcondition The size of the Queue is decreased by 1 and the current front item is removed from the queue
+     * \complexity O(1)
+     * \throws queue_empty_error if the queue is empty
+     */
+    void dequeue ()
+    {
+      if (derived_().empty_())
+        throw queue_empty_error{"Attempting dequeue() on empty queue"};
+
+      derived_().dequeue_();
+    }
+
+    /**
+     * \brief Clear the queue removing all the items
+     * \details Invalidates any references or pointers referring to contained elements
+     * \precondition None
+     * \postcondition The queue is empty, the size becomes 0
+     * \complexity O(1) or O(N) depends on the implementation
+     */
+    void clear ()
+    {
+      derived_().clear_();
+    }
+
+    /**
+     * \brief Creates a vector with the items enqueued onto the queue
+     * \precondition None
+     * \postcondition The queue is unchanged
+     * \complexity O(N)
+     * \return A vector with the items enqueued onto the queue
+     */
+    std::vector<T> to_vector () const
+    {
+      return derived_().to_vector_();
+    }
+
+  protected:
+    static_queue () = default;
+    static_queue (static_queue const&) = default;
+    static_queue (static_queue&&) = default;
+    static_queue& operator= (static_queue const&) = default;
+    static_queue& operator= (static_queue&&) = default;
+    ~static_queue () override = default;
+
+    // the number of the items the queue has room for, unbounded by default
+    size_type space_ () const
+    {
+      return std::numeric_limits<size_type>::max() - derived_().size_();
+    }
+
+    // enqueue count items one at a time
+    template <typename ForwardIt>
+    void enqueue_n_ (ForwardIt first, size_type count)
+    {
+      // the rear cannot be removed from a queue, a throwing copy leaves the items enqueued before it
+      // loop invariant: the items before first are enqueued
+      for (; count > size_type{0}; --count, ++first)
+        derived_().enqueue_(*first);
+    }
+
+    // dequeue count items one at a time moving the front before the dequeue
+    // front_ gives a constant reference to an item that is not constant and that is dequeued right after
+    template <typename OutputIt>
+    OutputIt dequeue_n_ (OutputIt out, size_type count)
+    {
+      // loop invariant: the items dequeued are written before out
+      for (; count > size_type{0}; --count, ++out) {
+        *out = std::move(const_cast<reference>(derived_().front_()));
+        derived_().dequeue_();
+      }
+      return out;
+    }
+
+  private:
+    Derived& derived_ () noexcept
+    {
+      return static_cast<Derived&>(*this);
+    }
+
+    Derived const& derived_ () const noexcept
+    {
+      return static_cast<Derived const&>(*this);
+    }
+  };
+}
+#endif //ALGOL_DS_STATIC_QUEUE_HPP
@@ -0,0 +1,266 @@
+/**
+ * \file
+ * Chase-Lev work-stealing deque implementation.
+ */
+
+#ifndef ALGOL_DS_WORK_STEALING_DEQUE_HPP
+#define ALGOL_DS_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include "algol/ds/allocator.hpp"
+#include "algol/ds/cache_line.hpp"
+
+namespace algol::ds {
+  /**
+   * \brief Deque whose owner thread pushes and pops at the bottom while any other thread steals from the top
+   * \details The items live in a circular array indexed by two counters: the owner writes bottom and the
+   * thieves advance top with a compare and swap, so push and the pops that leave more than one item never
+   * execute a read-modify-write. The owner and a thief race only for the last item, both try the compare and
+   * swap of top and one of them gets the item.
+   * When the array is full push copies the items in an array of double capacity; a thief can still be reading
+   * the old array, so the old arrays are kept until the deque is destroyed, they take less memory than the
+   * last array.
+   * The items are stored in atomics and copied out by the thieves before the compare and swap, so T must be
+   * trivially copyable: the deques of a scheduler hold pointers to the tasks.
+   * \tparam T type of the items stored in the deque, trivially copyable
+   * \tparam Allocator allocator of the arrays, it is rebound to the array and to the item types
+   * \invariant top <= bottom + 1 and the items are the ones at the positions [top, bottom)
+   * \note see Chase, Lev "Dynamic Circular Work-Stealing Deque" SPAA 2005 and
+   * Le, Pop, Cohen, Zappa Nardelli "Correct and Efficient Work-Stealing for Weak Memory Models" PPoPP 2013
+   */
+  template <typename T, typename Allocator = std::allocator<T>>
+  class work_stealing_deque final {
+    static_assert(std::is_trivially_copyable_v<T>, "work_stealing_deque items must be trivially copyable");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Construct an empty deque
+     * \precondition None
+     * \postcondition The deque is empty
+     * \complexity O(capacity)
+     * \param capacity The initial capacity, rounded up to a power of two
+     * \param allocator The allocator of the arrays
+     */
+    explicit work_stealing_deque (size_type capacity = 64, allocator_type const& allocator = allocator_type{})
+        : allocator_ {allocator}
+    {
+      auto size = size_type{1};
+      while (size < capacity)
+        size <<= 1;
+      ring_.store(new_ring_(size, nullptr), std::memory_order_relaxed);
+    }
+
+    // the counters are shared by many threads, the deque cannot be copied nor moved
+    work_stealing_deque (work_stealing_deque const&) = delete;
+    work_stealing_deque& operator= (work_stealing_deque const&) = delete;
+
+    /**
+     * \brief Destructor
+     * \details The current array and the ones replaced by the growth are deallocated
+     * \precondition No thread is using the deque
+     * \complexity O(capacity)
+     */
+    ~work_stealing_deque ()
+    {
+      auto r = ring_.load(std::memory_order_relaxed);
+      // loop invariant: the arrays newer than r are deallocated
+      while (r != nullptr) {
+        auto older = r->older;
+        delete_ring_(r);
+        r = older;
+      }
+    }
+
+    /**
+     * \brief The allocator of the arrays
+     * \precondition None
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
+
+    /**
+     * \brief The deque is empty?
+     * \details With concurrent operations the answer can be stale
+     * \precondition None
+     * \complexity O(1)
+     * \return True if the deque is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return size() == 0;
+    }
+
+    /**
+     * \brief The number of items in the deque
+     * \details With concurrent operations the size is the one of the deque at some point during the call
+     * \precondition None
+     * \complexity O(1)
+     * \return The number of items
+     */
+    size_type size () const noexcept
+    {
+      auto top = top_.load(std::memory_order_acquire);
+      auto bottom = bottom_.load(std::memory_order_acquire);
+      return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+    }
+
+    /**
+     * \brief The number of items the current array can hold
+     * \precondition Called by the owner
+     * \complexity O(1)
+     * \return The capacity of the array
+     */
+    size_type capacity () const noexcept
+    {
+      return ring_.load(std::memory_order_relaxed)->capacity;
+    }
+
+    /**
+     * \brief Push an item at the bottom
+     * \details When the array is full the items are copied in an array of double capacity
+     * \precondition Called by the owner
+     * \postcondition The item is at the bottom of the deque
+     * \complexity O(1) amortized
+     * \throws std::bad_alloc if the array cannot grow, the deque is unchanged
+     * \param value The item
+     */
+    void push (value_type value)
+    {
+      auto bottom = bottom_.load(std::memory_order_relaxed);
+      auto top = top_.load(std::memory_order_acquire);
+      auto r = ring_.load(std::memory_order_relaxed);
+      if (bottom - top >= static_cast<std::int64_t>(r->capacity))
+        r = grow_(r, top, bottom);
+      r->put(bottom, value);
+      // the thief that reads the new bottom reads the item
+      bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * \brief Pop the item at the bottom, the last pushed
+     * \precondition Called by the owner
+     * \postcondition The item is removed if the deque was not empty
+     * \complexity O(1)
+     * \return The item or nothing if the deque was empty or a thief took the last item
+     */
+    std::optional<value_type> try_pop () noexcept
+    {
+      auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+      auto r = ring_.load(std::memory_order_relaxed);
+      // the store of bottom and the load of top are sequentially consistent as the loads of try_steal:
+      // a thief that reads top after this point sees the new bottom and does not take the item
+      bottom_.store(bottom, std::memory_order_seq_cst);
+      auto top = top_.load(std::memory_order_seq_cst);
+      std::optional<value_type> value;
+      if (top <= bottom) {
+        value = r->get(bottom);
+        // the last item is taken by the owner or a thief, whoever advances top
+        if (top == bottom) {
+          if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            value.reset();
+          bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+      }
+      else
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return value;
+    }
+
+    /**
+     * \brief Steal the item at the top, the first pushed
+     * \details The item is copied before advancing top, if another thief or the owner take it first
+     * the copy is discarded
+     * \precondition None, it can be called by any thread other than the owner
+     * \postcondition The item is removed if the deque was not empty and no other thread took it
+     * \complexity O(1)
+     * \return The item or nothing if the deque was empty or the item was taken by another thread
+     */
+    std::optional<value_type> try_steal () noexcept
+    {
+      // sequentially consistent instead of the fence of the paper, thread sanitizer does not understand fences
+      auto top = top_.load(std::memory_order_seq_cst);
+      auto bottom = bottom_.load(std::memory_order_seq_cst);
+      if (top >= bottom)
+        return std::nullopt;
+      auto value = ring_.load(std::memory_order_acquire)->get(top);
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return std::nullopt;
+      return value;
+    }
+
+  private:
+    struct ring {
+      size_type capacity;
+      std::atomic<value_type>* items;
+      // the array replaced by this one, kept for the thieves that are still reading it
+      ring* older;
+
+      value_type get (std::int64_t pos) const noexcept
+      {
+        return items[static_cast<size_type>(pos) & (capacity - 1)].load(std::memory_order_relaxed);
+      }
+
+      void put (std::int64_t pos, value_type value) noexcept
+      {
+        items[static_cast<size_type>(pos) & (capacity - 1)].store(value, std::memory_order_relaxed);
+      }
+    };
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using ring_allocator = typename alloc_traits::template rebind_alloc<ring>;
+    using item_allocator = typename alloc_traits::template rebind_alloc<std::atomic<value_type>>;
+
+    ring* new_ring_ (size_type capacity, ring* older)
+    {
+      ring_allocator rings {allocator_};
+      item_allocator items {allocator_};
+      auto r = detail::allocate_storage(rings, 1);
+      try {
+        ::new(static_cast<void*>(r)) ring{capacity, detail::allocate_array(items, capacity), older};
+      }
+      catch (...) {
+        detail::deallocate_storage(rings, r, 1);
+        throw;
+      }
+      return r;
+    }
+
+    void delete_ring_ (ring* r) noexcept
+    {
+      ring_allocator rings {allocator_};
+      item_allocator items {allocator_};
+      detail::deallocate_array(items, r->items, r->capacity);
+      detail::deallocate_storage(rings, r, 1);
+    }
+
+    ring* grow_ (ring* r, std::int64_t top, std::int64_t bottom)
+    {
+      auto bigger = new_ring_(r->capacity * 2, r);
+      for (auto pos = top; pos < bottom; ++pos)
+        bigger->put(pos, r->get(pos));
+      // the thief that reads the new array reads the items copied
+      ring_.store(bigger, std::memory_order_release);
+      return bigger;
+    }
+
+    alignas(cache_line_size) std::atomic<std::int64_t> top_ {0};
+    alignas(cache_line_size) std::atomic<std::int64_t> bottom_ {0};
+    alignas(cache_line_size) std::atomic<ring*> ring_ {nullptr};
+    allocator_type allocator_;
+  };
+}
+
+#endif //ALGOL_DS_WORK_STEALING_DEQUE_HPP
@@ -7,9 +7,12 @@
 #define ALGOL_DS_FIXED_STACK_HPP
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
+#include <type_traits>
 #include <cassert>
-#include "stack.hpp"
+#include "static_stack.hpp"
+#include "algol/ds/allocator.hpp"
 #include "stl2/concepts.hpp"
 
 namespace algol::ds {
@@ -17,30 +20,56 @@ namespace algol::ds {
 
   /**
    * \brief Implementation of the Stsck ADT using a fixed array
-   * \details see class [stack](@ref stack)
+   * \details see class [stack](@ref stack), the operations are dispatched at compile time by
+   * [static_stack](@ref static_stack)
+   * The array is uninitialized storage: an item is constructed when it is pushed and destroyed when it is popped,
+   * so T does not need to be default constructible.
+   * With the inline_storage tag in place of the allocator the array is kept inside the stack object and the stack
+   * never allocates, moving and swapping such a stack moves the items one by one.
    * \tparam T type of the items stored in the stack
+   * \tparam N capacity of the stack
+   * \tparam Allocator allocator of the array, for example a std::pmr::polymorphic_allocator, or inline_storage
    * \invariant The item that is accessible at the top of the stack is the item that has
    * most recently been pushed onto it and not yet popped (removed)
    */
-  template <concepts::CopyConstructible T, typename stack<T>::size_type N>
-  class fixed_stack final : public stack<T> {
+  template <concepts::CopyConstructible T, typename stack<T>::size_type N,
+            typename Allocator = std::allocator<T>>
+  class fixed_stack final : public static_stack<fixed_stack<T, N, Allocator>, T> {
+    static constexpr bool is_inline_ = std::is_same_v<Allocator, inline_storage>;
+    // the items of an inline stack are moved on move and swap
+    static constexpr bool nothrow_relocate_ = !is_inline_ || std::is_nothrow_move_constructible_v<T>;
+
   public:
     using value_type = typename stack<T>::value_type;
     using reference = typename stack<T>::reference;
     using const_reference = typename stack<T>::const_reference;
     using size_type = typename stack<T>::size_type;
+    using allocator_type = std::conditional_t<is_inline_, std::allocator<T>, Allocator>;
 
     /**
      * \brief Default constructor
      * \precondition None
      * \postcondition The stack is empty
-     * \complexity O(N) array initializing
+     * \complexity O(1)
      */
-    fixed_stack ()
-        : stack<T>(), items_ {size_type{0}}, top_item_ {size_type{0}},
-          array_ {std::make_unique<value_type[]>(N)}
+    fixed_stack () : fixed_stack(allocator_type{})
     {}
 
+    /**
+     * \brief Construct an empty stack whose array is allocated with the provided allocator
+     * \details The array is allocated, not initialized
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1)
+     * \param allocator The allocator of the array
+     */
+    explicit fixed_stack (allocator_type const& allocator)
+        : items_ {size_type{0}}, top_item_ {size_type{0}}, allocator_ {allocator}, array_ {}
+    {
+      if constexpr (!is_inline_)
+        array_ = detail::allocate_storage(allocator_, N);
+    }
+
     /**
      * \brief Construct a stack with values provided
      * \details The values are pushed onto the stack starting at begin of initializer list and stopping at the end
@@ -50,57 +79,98 @@ namespace algol::ds {
      * initializer_list are pushed onto the stack
      * \complexity O(N)
      * \param values The items to be pushed onto the stack
+     * \param allocator The allocator of the array
      */
-    fixed_stack (std::initializer_list<value_type> values) : fixed_stack()
+    fixed_stack (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : fixed_stack(allocator)
     {
-      for (auto const& v : values)
-        push_(v);
+      this->push_range(values.begin(), values.end());
     }
 
     /**
      * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction
      * \precondition None
      * \postcondition This stack is equal to the provided stack
      * \complexity O(N)
      * \param rhs The stack to be copied
      */
-    fixed_stack (fixed_stack const& rhs) : fixed_stack()
+    fixed_stack (fixed_stack const& rhs)
+        : fixed_stack(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
+
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack
+     * \complexity O(N)
+     * \param rhs The stack to be copied
+     * \param allocator The allocator of the array
+     */
+    fixed_stack (fixed_stack const& rhs, allocator_type const& allocator) : fixed_stack(allocator)
     {
       assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
       assert(rhs.top_item_ >= size_type{0} && rhs.top_item_ <= N);
 
-      fixed_stack stack;
-
-      if (!rhs.empty()) {
-        for (auto i = size_type{0}; i < rhs.items_; ++i) {
-          alloc_traits::destroy(allocator_, std::addressof(stack.array_[i]));
-          alloc_traits::construct(allocator_, std::addressof(stack.array_[i]), value_type{rhs.array_[i]});
-        }
-
-        stack.items_ = rhs.items_;
-        stack.top_item_ = rhs.top_item_;
-      }
-      swap(stack);
+      // the delegating constructor has completed, if a copy throws the destructor destroys the items copied
+      for (auto i = size_type{0}; i < rhs.items_; ++i)
+        emplace_(rhs.array_[i]);
     }
 
     /**
      * \brief Move constructor
      * \precondition None
      * \postcondition This stack is equal to the provided stack that becomes empty
-     * \complexity O(1)
+     * \complexity O(1), O(N) with inline storage
      * \param rhs The stack to be moved, items contained are 'stolen' from this stack
      */
-    fixed_stack (fixed_stack&& rhs) noexcept
-        : items_ {rhs.items_}, top_item_ {rhs.top_item_}, array_ {std::move(rhs.array_)}
+    fixed_stack (fixed_stack&& rhs) noexcept(nothrow_relocate_)
+        : items_ {size_type{0}}, top_item_ {size_type{0}}, allocator_ {rhs.allocator_}, array_ {}
+    {
+      if constexpr (is_inline_)
+        move_items_(rhs);
+      else
+        swap_items_(rhs);
+    }
+
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The array is stolen if the allocators are equal, otherwise the items are moved one by one
+     * into an array allocated with the provided allocator
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \param rhs The stack to be moved
+     * \param allocator The allocator of the array
+     */
+    fixed_stack (fixed_stack&& rhs, allocator_type const& allocator)
+        : items_ {size_type{0}}, top_item_ {size_type{0}}, allocator_ {allocator}, array_ {}
     {
-      rhs.items_ = size_type{0};
-      rhs.top_item_ = size_type{0};
-      rhs.array_ = nullptr;
+      assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
+      assert(rhs.top_item_ >= size_type{0} && rhs.top_item_ <= N);
+
+      if constexpr (!is_inline_) {
+        if (allocator_ == rhs.allocator_) {
+          swap_items_(rhs);
+          return;
+        }
+        array_ = detail::allocate_storage(allocator_, N);
+      }
+
+      // the constructor has not completed, if a move throws the destructor would not release the array
+      try {
+        move_items_(rhs);
+      }
+      catch (...) {
+        release_();
+        throw;
+      }
     }
 
     /**
      * \brief Assignment operator
-     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack
+     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack,
+     * the allocator is replaced only if it propagates on copy assignment
      * \precondition None
      * \postcondition This stack is equal to the provided stack
      * \complexity O(N)
@@ -112,27 +182,41 @@ namespace algol::ds {
       assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
       assert(rhs.top_item_ >= size_type{0} && rhs.top_item_ <= N);
 
-      fixed_stack temp {rhs};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      fixed_stack temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
       return *this;
     }
 
     /**
      * \brief Move assignment operator
-     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack
+     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack,
+     * the array is stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
      * \precondition None
      * \postcondition This stack is equal to the provided stack that becomes empty
-     * \complexity O(1)
+     * \complexity O(1) if the array is stolen, O(N) otherwise
      * \param rhs The stack to be moved, items contained are 'stolen' from this stack
      * \return The stack containing the provided stack items
      */
-    fixed_stack& operator= (fixed_stack&& rhs) noexcept
+    fixed_stack& operator= (fixed_stack&& rhs)
+    noexcept((alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+             && nothrow_relocate_)
     {
       assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
       assert(rhs.top_item_ >= size_type{0} && rhs.top_item_ <= N);
 
-      fixed_stack temp {std::move(rhs)};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      fixed_stack temp {std::move(rhs), propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
       return *this;
     }
 
@@ -142,7 +226,22 @@ namespace algol::ds {
      * \postcondition The stack items are destroyed
      * \complexity O(N) Destructor calls
      */
-    ~fixed_stack () = default;
+    ~fixed_stack ()
+    {
+      release_();
+    }
+
+    /**
+     * \brief The allocator of the array
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
 
     /**
      * \brief Emplace the item passed onto the stack
@@ -323,26 +422,87 @@ namespace algol::ds {
 
     /**
      * \brief Swaps the items of this stack with the items of the provided stack
-     * \details noexcept operation, it cannot throw
-     * \precondition None
+     * \details noexcept operation, unless the items of an inline stack can throw on move.
+     * The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
      * \postcondition This stack becomes the rhs stack and viceversa
-     * \complexity O(1)
+     * \complexity O(1), O(N) with inline storage
      * \param rhs The stack to be swapped with this
      */
-    void swap (fixed_stack& rhs) noexcept
+    void swap (fixed_stack& rhs) noexcept(nothrow_relocate_)
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+  private:
+    friend class static_stack<fixed_stack, T>;
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    // swap the array and the counters, not the allocators
+    void swap_items_ (fixed_stack& rhs) noexcept(nothrow_relocate_)
     {
       assert(items_ >= size_type{0} && items_ <= N);
       assert(top_item_ >= size_type{0} && top_item_ <= N);
       assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
       assert(rhs.top_item_ >= size_type{0} && rhs.top_item_ <= N);
 
-      using std::swap;
-      swap(items_, rhs.items_);
-      swap(top_item_, rhs.top_item_);
-      swap(array_, rhs.array_);
+      if constexpr (is_inline_) {
+        // the arrays cannot be exchanged, the items are moved through a third stack
+        fixed_stack temp {};
+        temp.move_items_(*this);
+        move_items_(rhs);
+        rhs.move_items_(temp);
+      }
+      else {
+        using std::swap;
+        swap(items_, rhs.items_);
+        swap(top_item_, rhs.top_item_);
+        swap(array_, rhs.array_);
+      }
+    }
+
+    // move the items of rhs into this empty stack, rhs becomes empty
+    void move_items_ (fixed_stack& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+      assert(items_ == size_type{0});
+      assert(rhs.items_ >= size_type{0} && rhs.items_ <= N);
+
+      // invariant: the items below i have been moved into this stack
+      for (auto i = size_type{0}; i < rhs.items_; ++i)
+        emplace_(std::move(rhs.array_[i]));
+      rhs.clear_();
+    }
+
+    // destroy the items and give back the array
+    void release_ () noexcept
+    {
+      clear_();
+      if constexpr (!is_inline_)
+        detail::deallocate_storage(allocator_, array_, N);
+    }
+
+    // the address of the slot i of the array, whether an item is constructed there or not
+    value_type* slot_ (size_type i) noexcept
+    {
+      if constexpr (is_inline_)
+        return array_.data() + i;
+      else
+        return array_ + i;
+    }
+
+    // the address of the item i, it is constructed
+    value_type* item_ (size_type i) noexcept
+    {
+      return std::addressof(array_[i]);
     }
 
-  private:
     bool empty_ () const final
     {
       assert(items_ >= size_type{0} && items_ <= N);
@@ -374,24 +534,12 @@ namespace algol::ds {
 
     void push_ (value_type const& value) final
     {
-      assert(items_ >= size_type{0} && items_ < N);
-      assert(top_item_ >= size_type{0} && top_item_ < N);
-
-      alloc_traits::destroy(allocator_, std::addressof(array_[top_item_]));
-      alloc_traits::construct(allocator_, std::addressof(array_[top_item_]), value_type{value});
-      top_item_++;
-      items_++;
+      emplace_(value);
     }
 
     void push_ (value_type&& value) final
     {
-      assert(items_ >= size_type{0} && items_ < N);
-      assert(top_item_ >= size_type{0} && top_item_ < N);
-
-      alloc_traits::destroy(allocator_, std::addressof(array_[top_item_]));
-      alloc_traits::construct(allocator_, std::addressof(array_[top_item_]), value_type{std::move(value)});
-      top_item_++;
-      items_++;
+      emplace_(std::move(value));
     }
 
     void pop_ () final
@@ -401,6 +549,7 @@ namespace algol::ds {
 
       top_item_--;
       items_--;
+      alloc_traits::destroy(allocator_, item_(top_item_));
     }
 
     void clear_ () final
@@ -408,8 +557,10 @@ namespace algol::ds {
       assert(items_ >= size_type{0} && items_ <= N);
       assert(top_item_ >= size_type{0} && top_item_ <= N);
 
+      // invariant: the items above top_item_ are destroyed
+      while (top_item_ > size_type{0})
+        alloc_traits::destroy(allocator_, item_(--top_item_));
       items_ = size_type{0};
-      top_item_ = size_type{0};
     }
 
     std::vector<value_type> to_vector_ () const final
@@ -426,42 +577,84 @@ namespace algol::ds {
       return vector;
     }
 
+    size_type space_ () const
+    {
+      return N - items_;
+    }
+
+    // the items are copied at once above the top, with memcpy if they are trivially copyable
+    template <typename ForwardIt>
+    void push_n_ (ForwardIt first, size_type count)
+    {
+      assert(top_item_ + count <= N);
+
+      detail::uninitialized_copy_n(allocator_, first, count, slot_(top_item_));
+      top_item_ += count;
+      items_ += count;
+    }
+
+    // the items are moved from the top down and then destroyed
+    template <typename OutputIt>
+    OutputIt pop_n_ (OutputIt out, size_type count)
+    {
+      assert(count <= items_);
+
+      if (count == size_type{0})
+        return out;
+      auto top = std::make_reverse_iterator(item_(top_item_ - 1) + 1);
+      out = std::move(top, top + static_cast<std::ptrdiff_t>(count), out);
+      // loop invariant: the items above top_item_ are destroyed
+      for (; count > size_type{0}; --count) {
+        alloc_traits::destroy(allocator_, item_(--top_item_));
+        items_--;
+      }
+      return out;
+    }
+
     template <typename... Args>
     void emplace_ (Args&& ... args) noexcept(std::is_nothrow_constructible<T, Args...>())
     {
       assert(items_ >= size_type{0} && items_ < N);
       assert(top_item_ >= size_type{0} && top_item_ < N);
 
-      alloc_traits::destroy(allocator_, std::addressof(array_[top_item_]));
-      alloc_traits::construct(allocator_, std::addressof(array_[top_item_]), value_type{std::forward<Args>(args)...});
+      alloc_traits::construct(allocator_, slot_(top_item_), std::forward<Args>(args)...);
       top_item_++;
       items_++;
     }
 
-    using alloc = std::allocator<value_type>;
-    using alloc_traits = std::allocator_traits<alloc>;
-
     size_type items_;
     size_type top_item_;
-    std::unique_ptr<value_type[]> array_;
-    alloc allocator_;
+    allocator_type allocator_;
+    std::conditional_t<is_inline_, detail::inline_array<value_type, N>, value_type*> array_;
   };
 
   /**
    * \brief Exchanges the items of lhs and rhs stacks
-   * \details Non member function, noexcept it cannot fail
+   * \details Non member function, noexcept unless the items of inline stacks can throw on move
    * \tparam T type of the items stored in the stack
-   * \precondition None
+   * \precondition The allocators are equal or they propagate on swap
    * \postcondition The lhs stack becomes the rhs stack and viceversa
-   * \complexity O(1)
+   * \complexity O(1), O(N) with inline storage
    * \param lhs Stack to be exchanged with rhs
    * \param rhs Stack to be exchanged with lhs
    */
-  template <typename T, typename stack<T>::size_type N>
-  void swap (fixed_stack<T, N>& lhs, fixed_stack<T, N>& rhs) noexcept
+  template <typename T, typename stack<T>::size_type N, typename Allocator>
+  void swap (fixed_stack<T, N, Allocator>& lhs, fixed_stack<T, N, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
   {
     lhs.swap(rhs);
   }
 }
 
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief fixed_stack whose array is allocated from a std::pmr::memory_resource
+   */
+  template <typename T, typename stack<T>::size_type N>
+  using fixed_stack = ds::fixed_stack<T, N, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
 #endif //ALGOL_DS_FIXED_STACK_HPP
@@ -0,0 +1,275 @@
+/**
+ * \file
+ * Intrusive stack implementation
+ */
+
+#ifndef ALGOL_DS_INTRUSIVE_STACK_HPP
+#define ALGOL_DS_INTRUSIVE_STACK_HPP
+
+#include <type_traits>
+#include <vector>
+#include "stack.hpp"
+#include "algol/ds/intrusive_hook.hpp"
+
+namespace algol::ds {
+  /**
+   * \brief Implementation of the Stack ADT linking the items through a hook embedded in them
+   * \details The items derive from [intrusive_hook](@ref intrusive_hook)<Tag> and the stack links their hooks:
+   * push and pop relink pointers, they never allocate nor copy the items, and two stacks are spliced in O(1).
+   * The stack does not own the items:
+   * - an item is pushed by reference and must outlive its stay in the stack
+   * - an item can be linked in one stack or queue per tag at a time
+   * - pop, clear and the destructor unlink the items and never destroy them
+   * - the stack cannot be copied, moving it moves the links
+   * The ownership is checked in debug builds: pushing a linked item, or destroying an item still linked,
+   * is asserted.
+   * Since push takes a non const reference the stack does not satisfy the Stack concept.
+   * \tparam T type of the items, derived from intrusive_hook<Tag>
+   * \tparam Tag tag of the hook used by the stack
+   * \invariant The item that is accessible at the top of the stack is the item that has
+   * most recently been pushed onto it and not yet popped (removed)
+   */
+  template <typename T, typename Tag = void>
+  class intrusive_stack final {
+    static_assert(std::is_base_of_v<intrusive_hook<Tag>, T>, "intrusive_stack items must derive from intrusive_hook");
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1)
+     */
+    intrusive_stack () noexcept = default;
+
+    // an item is linked in one stack at a time, the stack cannot be copied
+    intrusive_stack (intrusive_stack const&) = delete;
+    intrusive_stack& operator= (intrusive_stack const&) = delete;
+
+    /**
+     * \brief Move constructor
+     * \precondition None
+     * \postcondition This stack links the items of the provided stack that becomes empty
+     * \complexity O(1), O(N) in debug builds
+     * \param rhs The stack to be moved
+     */
+    intrusive_stack (intrusive_stack&& rhs) noexcept = default;
+
+    /**
+     * \brief Move assignment operator
+     * \details The items of this stack are unlinked and replaced with the items of the provided stack
+     * \precondition None
+     * \postcondition This stack links the items of the provided stack that becomes empty
+     * \complexity O(N)
+     * \param rhs The stack to be moved
+     * \return This stack
+     */
+    intrusive_stack& operator= (intrusive_stack&& rhs) noexcept = default;
+
+    /**
+     * \brief Destructor
+     * \details The items are unlinked, not destroyed
+     * \precondition None
+     * \postcondition The items are no longer linked
+     * \complexity O(N)
+     */
+    ~intrusive_stack () = default;
+
+    /**
+     * \brief The stack is empty?
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return True if the stack is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return items_.empty();
+    }
+
+    /**
+     * \brief The stack is full?
+     * \details The stack is never full, it does not allocate
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return false
+     */
+    bool full () const noexcept
+    {
+      return false;
+    }
+
+    /**
+     * \brief The size of the stack
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the stack
+     */
+    size_type size () const noexcept
+    {
+      return items_.size();
+    }
+
+    /**
+     * \brief The item on the top of the stack
+     * \precondition The stack is not empty
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     * \return The item on the top of the stack
+     */
+    reference top ()
+    {
+      if (empty())
+        throw stack_empty_error{"Attempting top() on empty stack"};
+
+      return item_(items_.front());
+    }
+
+    /**
+     * \brief The item on the top of the stack
+     * \precondition The stack is not empty
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     * \return The item on the top of the stack
+     */
+    const_reference top () const
+    {
+      if (empty())
+        throw stack_empty_error{"Attempting top() on empty stack"};
+
+      return item_(items_.front());
+    }
+
+    /**
+     * \brief Link the item passed on the top of the stack
+     * \precondition The item is not linked in a container with the same tag
+     * \postcondition The item is the top of the stack
+     * \complexity O(1), no allocation
+     * \param item The item to push onto the stack
+     */
+    void push (reference item) noexcept
+    {
+      items_.push_front(item);
+    }
+
+    /**
+     * \brief Unlink the item on the top of the stack
+     * \precondition The stack is not empty
+     * \postcondition The top item is removed from the stack, it is not destroyed
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     * \return The item removed
+     */
+    reference pop ()
+    {
+      if (empty())
+        throw stack_empty_error{"Attempting pop() on empty stack"};
+
+      return item_(items_.pop_front());
+    }
+
+    /**
+     * \brief Unlink the item on the top of the stack if the stack is not empty
+     * \precondition None
+     * \postcondition If the stack was not empty the top item is removed from the stack
+     * \complexity O(1)
+     * \return The item removed or nullptr if the stack is empty
+     */
+    value_type* try_pop () noexcept
+    {
+      if (empty())
+        return nullptr;
+
+      return &item_(items_.pop_front());
+    }
+
+    /**
+     * \brief Move the items of the provided stack on the top of this stack
+     * \details The items keep their order, the top of rhs becomes the top of this stack
+     * \precondition rhs is not this stack
+     * \postcondition rhs is empty
+     * \complexity O(1), O(N) in debug builds
+     * \param rhs The stack whose items are moved
+     */
+    void splice (intrusive_stack& rhs) noexcept
+    {
+      items_.splice_front(rhs.items_);
+    }
+
+    /**
+     * \brief Clear the stack unlinking all the items
+     * \precondition None
+     * \postcondition The stack is empty and the items are no longer linked
+     * \complexity O(N)
+     */
+    void clear () noexcept
+    {
+      items_.clear();
+    }
+
+    /**
+     * \brief The addresses of the items from the top to the bottom
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(N)
+     * \return The items from the top to the bottom
+     */
+    std::vector<value_type const*> to_vector () const
+    {
+      std::vector<value_type const*> vector {};
+      vector.reserve(size());
+      items_.for_each([&vector] (hook& h) { vector.push_back(&item_(h)); });
+      return vector;
+    }
+
+    /**
+     * \brief Swaps the items of this stack with the items of the provided stack
+     * \precondition None
+     * \postcondition This stack becomes the rhs stack and viceversa
+     * \complexity O(1), O(N) in debug builds
+     * \param rhs The stack to be swapped with this
+     */
+    void swap (intrusive_stack& rhs) noexcept
+    {
+      items_.swap(rhs.items_);
+    }
+
+  private:
+    using hook = intrusive_hook<Tag>;
+
+    static reference item_ (hook& h) noexcept
+    {
+      return static_cast<reference>(h);
+    }
+
+    detail::intrusive_list<Tag> items_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs stacks
+   * \details Non member function, noexcept it cannot fail
+   * \tparam T type of the items stored in the stack
+   * \tparam Tag tag of the hook used by the stacks
+   * \precondition None
+   * \postcondition The lhs stack becomes the rhs stack and viceversa
+   * \complexity O(1)
+   * \param lhs Stack to be exchanged with rhs
+   * \param rhs Stack to be exchanged with lhs
+   */
+  template <typename T, typename Tag>
+  void swap (intrusive_stack<T, Tag>& lhs, intrusive_stack<T, Tag>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif //ALGOL_DS_INTRUSIVE_STACK_HPP
@@ -6,7 +6,10 @@
 #ifndef ALGOL_DS_LINKED_STACK_HPP
 #define ALGOL_DS_LINKED_STACK_HPP
 
-#include "stack.hpp"
+#include <cassert>
+#include <memory>
+#include "static_stack.hpp"
+#include "algol/ds/allocator.hpp"
 #include "stl2/concepts.hpp"
 
 namespace algol::ds {
@@ -14,18 +17,22 @@ namespace algol::ds {
 
   /**
    * \brief Implementation of the Stsck ADT using a linked structure
-   * \details see class [stack](@ref stack)
+   * \details see class [stack](@ref stack), the operations are dispatched at compile time by
+   * [static_stack](@ref static_stack)
    * \tparam T type of the items stored in the stack
+   * \tparam Allocator allocator of the items, for example a std::pmr::polymorphic_allocator, the nodes and
+   * the sentinel node are allocated with it rebound to the node type
    * \invariant The item that is accessible at the top of the stack is the item that has
    * most recently been pushed onto it and not yet popped (removed)
    */
-  template <concepts::CopyConstructible T>
-  class linked_stack final : public stack<T> {
+  template <concepts::CopyConstructible T, typename Allocator = std::allocator<T>>
+  class linked_stack final : public static_stack<linked_stack<T, Allocator>, T> {
   public:
     using value_type = typename stack<T>::value_type;
     using reference = typename stack<T>::reference;
     using const_reference = typename stack<T>::const_reference;
     using size_type = typename stack<T>::size_type;
+    using allocator_type = Allocator;
 
     /**
      * \brief Default constructor
@@ -33,8 +40,18 @@ namespace algol::ds {
      * \postcondition The stack is empty
      * \complexity O(1)
      */
-    linked_stack () noexcept(std::is_nothrow_constructible_v<size_type, int>)
-        : stack<T>(), items_ {size_type{0}}
+    linked_stack () : linked_stack(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty stack whose nodes are allocated with the provided allocator
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1)
+     * \param allocator The allocator of the nodes, it is rebound to the node type
+     */
+    explicit linked_stack (allocator_type const& allocator)
+        : allocator_ {allocator}, top_node_ {new_node_()}, items_ {size_type{0}}
     {}
 
     /**
@@ -46,39 +63,45 @@ namespace algol::ds {
      * initializer_list are pushed onto the stack
      * \complexity O(N)
      * \param values The items to be pushed onto the stack
+     * \param allocator The allocator of the nodes
      */
-    linked_stack (std::initializer_list<value_type> values) : linked_stack()
+    linked_stack (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : linked_stack(allocator)
     {
-      for (auto const& v : values)
-        push_(v);
+      this->push_range(values.begin(), values.end());
     }
 
     /**
      * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction
      * \precondition None
      * \postcondition This stack is equal to the provided stack
      * \complexity O(N)
      * \param rhs The stack to be copied
      */
-    linked_stack (linked_stack const& rhs) : linked_stack()
-    {
-      linked_stack stack;
-
-      if (!rhs.empty()) {
-        for (auto i = size_type{0}; i < rhs.items_; ++i) {
-          stack.push_((node * ) ::operator new(sizeof(node)));
-        }
-
-        node* this_iter = stack.top_node_->next_;
-        node* rhs_iter = rhs.top_node_->next_;
+    linked_stack (linked_stack const& rhs)
+        : linked_stack(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
 
-        while (rhs_iter) {
-          new(std::addressof(this_iter->value_)) T(rhs_iter->value_);
-          this_iter = this_iter->next_;
-          rhs_iter = rhs_iter->next_;
-        }
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack
+     * \complexity O(N)
+     * \param rhs The stack to be copied
+     * \param allocator The allocator of the nodes
+     */
+    linked_stack (linked_stack const& rhs, allocator_type const& allocator) : linked_stack(allocator)
+    {
+      // the delegating constructor has completed, if a copy throws the destructor releases the nodes
+      node* last = top_node_;
+      for (node* rhs_iter = rhs.top_node_->next_; rhs_iter; rhs_iter = rhs_iter->next_) {
+        // loop invariant
+        // the items of rhs before rhs_iter are copied in the same order and last is the bottom node
+        last->next_ = new_node_(rhs_iter->value_[0]);
+        last = last->next_;
+        items_++;
       }
-      swap(stack);
     }
 
     /**
@@ -88,15 +111,45 @@ namespace algol::ds {
      * \complexity O(1)
      * \param rhs The stack to be moved, items contained are 'stolen' from this stack
      */
-    linked_stack (linked_stack&& rhs) noexcept : top_node_ {std::move(rhs.top_node_)}, items_ {rhs.items_}
+    linked_stack (linked_stack&& rhs) noexcept
+        : allocator_ {rhs.allocator_}, top_node_ {rhs.top_node_}, items_ {rhs.items_}
     {
-      rhs.top_node_.reset();
+      rhs.top_node_ = nullptr;
       rhs.items_ = size_type{0};
     }
 
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The nodes are stolen if the allocators are equal, otherwise the items are moved one by one
+     * into nodes allocated with the provided allocator
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \param rhs The stack to be moved
+     * \param allocator The allocator of the nodes
+     */
+    linked_stack (linked_stack&& rhs, allocator_type const& allocator) : linked_stack(allocator)
+    {
+      if (allocator_ == rhs.allocator_) {
+        swap_items_(rhs);
+        return;
+      }
+
+      node* last = top_node_;
+      for (node* rhs_iter = rhs.top_node_->next_; rhs_iter; rhs_iter = rhs_iter->next_) {
+        // loop invariant
+        // the items of rhs before rhs_iter are moved in the same order and last is the bottom node
+        last->next_ = new_node_(std::move(rhs_iter->value_[0]));
+        last = last->next_;
+        items_++;
+      }
+      rhs.clear_();
+    }
+
     /**
      * \brief Assignment operator
-     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack
+     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack,
+     * the allocator is replaced only if it propagates on copy assignment
      * \precondition None
      * \postcondition This stack is equal to the provided stack
      * \complexity O(N)
@@ -105,24 +158,43 @@ namespace algol::ds {
      */
     linked_stack& operator= (linked_stack const& rhs)
     {
-      linked_stack temp {rhs};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      linked_stack temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
       return *this;
     }
 
     /**
      * \brief Move assignment operator
-     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack
+     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack,
+     * the nodes are stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
      * \precondition None
      * \postcondition This stack is equal to the provided stack that becomes empty
-     * \complexity O(1)
+     * \complexity O(1) if the nodes are stolen, O(N) otherwise
      * \param rhs The stack to be moved, items contained are 'stolen' from this stack
      * \return The stack containing the provided stack items
      */
-    linked_stack& operator= (linked_stack&& rhs) noexcept
+    linked_stack& operator= (linked_stack&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
     {
-      linked_stack temp {std::move(rhs)};
-      swap(temp);
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      if (propagate || allocator_ == rhs.allocator_) {
+        linked_stack temp {std::move(rhs)};
+        swap_items_(temp);
+        if constexpr (propagate) {
+          using std::swap;
+          swap(allocator_, temp.allocator_);
+        }
+      }
+      else {
+        linked_stack temp {std::move(rhs), allocator_};
+        swap_items_(temp);
+      }
       return *this;
     }
 
@@ -134,9 +206,25 @@ namespace algol::ds {
      */
     ~linked_stack ()
     {
+      if (top_node_ == nullptr)
+        return;
+
       while (!empty_()) {
         pop_();
       }
+      detail::deallocate_node(allocator_, top_node_);
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
     }
 
     /**
@@ -159,7 +247,7 @@ namespace algol::ds {
       node* rhs_iter = rhs.top_node_->next_;
 
       while (this_iter && rhs_iter) {
-        if (this_iter->value_ != rhs_iter->value_)
+        if (this_iter->value_[0] != rhs_iter->value_[0])
           return false;
 
         this_iter = this_iter->next_;
@@ -207,10 +295,10 @@ namespace algol::ds {
       node* rhs_iter = rhs.top_node_->next_;
 
       while (this_iter && rhs_iter) {
-        if (this_iter->value_ < rhs_iter->value_)
+        if (this_iter->value_[0] < rhs_iter->value_[0])
           return true;
 
-        if (this_iter->value_ > rhs_iter->value_)
+        if (this_iter->value_[0] > rhs_iter->value_[0])
           return false;
 
         this_iter = this_iter->next_;
@@ -285,25 +373,50 @@ namespace algol::ds {
 
     /**
      * \brief Swaps the items of this stack with the items of the provided stack
-     * \details noexcept operation, it cannot throw
-     * \precondition None
+     * \details noexcept operation, it cannot throw.
+     * The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
      * \postcondition This stack becomes the rhs stack and viceversa
      * \complexity O(1)
      * \param rhs The stack to be swapped with this
      */
     void swap (linked_stack& rhs) noexcept
     {
-      using std::swap;
-      swap(top_node_, rhs.top_node_);
-      swap(items_, rhs.items_);
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
     }
 
   private:
+    friend class static_stack<linked_stack, T>;
+
+    // the value is constructed by allocate_node with the allocator of the items
     struct node {
-      value_type value_;
-      node* next_;
+      detail::inline_array<value_type, 1> value_;
+      node* next_ {nullptr};
     };
 
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    // swap the nodes and the counter, not the allocators
+    void swap_items_ (linked_stack& rhs) noexcept
+    {
+      using std::swap;
+      swap(top_node_, rhs.top_node_);
+      swap(items_, rhs.items_);
+    }
+
+    // a node whose value is constructed from args, it is not linked
+    template <typename... Args>
+    node* new_node_ (Args&& ... args)
+    {
+      return detail::allocate_node<node>(allocator_, std::forward<Args>(args)...);
+    }
+
     bool empty_ () const final
     {
       return items_ == 0;
@@ -321,17 +434,17 @@ namespace algol::ds {
 
     const_reference top_ () const& final
     {
-      return top_node_->next_->value_;
+      return top_node_->next_->value_[0];
     }
 
     void push_ (value_type const& value) final
     {
-      push_(new node {value, nullptr});
+      push_(new_node_(value));
     }
 
     void push_ (value_type&& value) final
     {
-      push_(new node {std::move(value), nullptr});
+      push_(new_node_(std::move(value)));
     }
 
     void pop_ () final
@@ -339,13 +452,14 @@ namespace algol::ds {
       node* node_to_pop = top_node_->next_;
       top_node_->next_ = top_node_->next_->next_;
       items_--;
-      delete node_to_pop;
+      detail::deallocate_node(allocator_, node_to_pop);
     }
 
     void clear_ () final
     {
-      linked_stack temp {};
-      swap(temp);
+      while (!empty_()) {
+        pop_();
+      }
     }
 
     std::vector<value_type> to_vector_ () const final
@@ -356,7 +470,7 @@ namespace algol::ds {
       node* this_iter = top_node_->next_;
 
       while (this_iter) {
-        vector.emplace_back(this_iter->value_);
+        vector.emplace_back(this_iter->value_[0]);
         this_iter = this_iter->next_;
       }
       return vector;
@@ -369,7 +483,8 @@ namespace algol::ds {
       items_++;
     }
 
-    std::unique_ptr<node> top_node_ = std::make_unique<node>();
+    allocator_type allocator_;
+    node* top_node_;
     size_type items_;
   };
 
@@ -377,17 +492,29 @@ namespace algol::ds {
    * \brief Exchanges the items of lhs and rhs stacks.
    * \details Non member function, noexcept it cannot fail.
    * \tparam T type of the items stored in the stack.
-   * \precondition None.
+   * \precondition The allocators are equal or they propagate on swap.
    * \postcondition The lhs stack becomes the rhs stack and viceversa.
    * \complexity O(1)
    * \param lhs Stack to be exchanged with rhs.
    * \param rhs Stack to be exchanged with lhs.
    */
-  template <typename T>
-  void swap (linked_stack<T>& lhs, linked_stack<T>& rhs) noexcept
+  template <typename T, typename Allocator>
+  void swap (linked_stack<T, Allocator>& lhs, linked_stack<T, Allocator>& rhs) noexcept
   {
     lhs.swap(rhs);
   }
 }
 
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief linked_stack whose nodes are allocated from a std::pmr::memory_resource
+   */
+  template <typename T>
+  using linked_stack = ds::linked_stack<T, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
 #endif //ALGOL_DS_LINKED_STACK_HPP
@@ -0,0 +1,357 @@
+/**
+ * \file
+ * Lock-free stack implementation
+ */
+
+#ifndef ALGOL_DS_LOCK_FREE_STACK_HPP
+#define ALGOL_DS_LOCK_FREE_STACK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <utility>
+#include "stack.hpp"
+#include "algol/ds/cache_line.hpp"
+#include "algol/ds/hazard_pointer.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the Stack ADT for concurrent use, Treiber stack with elimination backoff
+   * \details The stack is a linked list whose top is changed with a compare and swap, every operation is
+   * lock-free and can be called by any number of threads.
+   * The popped nodes are [retired](@ref retire) and deleted when no [hazard pointer](@ref hazard_pointer)
+   * protects them: a node cannot be reused while a thread is reading it so the compare and swap of the top
+   * is not exposed to the ABA problem.
+   * When the compare and swap fails because of contention the thread tries the elimination array:
+   * a push offers its node in a random slot for a short time and a pop that finds it takes the node,
+   * the two operations cancel out without touching the top.
+   * Every node stores the size of the stack below it, so size does not need a shared counter.
+   * The items can be read by many threads at the same time, top and try_pop return copies.
+   * \tparam T type of the items stored in the stack
+   * \tparam EliminationSlots number of slots of the elimination array, 0 disables the elimination
+   * \invariant The item that is accessible at the top of the stack is the item that has
+   * most recently been pushed onto it and not yet popped (removed)
+   * \note see Hendler, Shavit, Yerushalmi "A Scalable Lock-free Stack Algorithm" SPAA 2004
+   */
+  template <concepts::CopyConstructible T, std::size_t EliminationSlots = 16>
+  class lock_free_stack final {
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1)
+     */
+    lock_free_stack () = default;
+
+    /**
+     * \brief Construct a stack with values provided
+     * \details The values are pushed onto the stack starting at begin of initializer list and stopping at the end
+     * If the initializer_list contains {1, 2, 3, 4} the stack will contains [4, 3, 2, 1]
+     * \precondition None
+     * \postcondition The stack size is the same of the initializer_list and all the items contained in the
+     * initializer_list are pushed onto the stack
+     * \complexity O(N)
+     * \param values The items to be pushed onto the stack
+     */
+    lock_free_stack (std::initializer_list<value_type> values) : lock_free_stack()
+    {
+      for (auto const& v : values)
+        push(v);
+    }
+
+    // the top is shared by many threads, the stack cannot be copied nor moved
+    lock_free_stack (lock_free_stack const&) = delete;
+    lock_free_stack& operator= (lock_free_stack const&) = delete;
+
+    /**
+     * \brief Destructor
+     * \precondition No thread is using the stack
+     * \postcondition The stack items are destroyed
+     * \complexity O(N)
+     */
+    ~lock_free_stack ()
+    {
+      for (auto n = top_.load(std::memory_order_relaxed); n != nullptr;) {
+        auto next = n->next_;
+        delete n;
+        n = next;
+      }
+    }
+
+    /**
+     * \brief The stack is empty?
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return True if the stack is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return top_.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /**
+     * \brief The stack is full?
+     * \details The stack is never full, push throws std::bad_alloc if memory is exhausted
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return false
+     */
+    bool full () const noexcept
+    {
+      return false;
+    }
+
+    /**
+     * \brief The size of the stack
+     * \details With concurrent operations the size is the one of the stack at some point during the call
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the stack
+     */
+    size_type size () const
+    {
+      hazard_pointer hazard;
+      auto top = hazard.protect(top_);
+      return top != nullptr ? top->size_ : size_type{0};
+    }
+
+    /**
+     * \brief A copy of the item on the top of the stack
+     * \details The item is copied because another thread can pop it at any time
+     * \precondition The stack is not empty
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     * \return The item on the top of the stack
+     */
+    value_type top () const
+    {
+      hazard_pointer hazard;
+      auto top = hazard.protect(top_);
+      if (top == nullptr)
+        throw stack_empty_error{"Attempting top() on empty stack"};
+
+      return top->value_;
+    }
+
+    /**
+     * \brief Push the item passed onto the stack
+     * \precondition None
+     * \postcondition The item passed is pushed onto the stack
+     * \complexity O(1), lock-free
+     * \param value The item to push onto the stack
+     */
+    void push (value_type const& value)
+    {
+      push_(new node {value});
+    }
+
+    /**
+     * \brief Push the item passed onto the stack
+     * \precondition None
+     * \postcondition The item passed is pushed onto the stack
+     * \complexity O(1), lock-free
+     * \param value The item to push onto the stack with move operation
+     */
+    void push (value_type&& value)
+    {
+      push_(new node {std::move(value)});
+    }
+
+    /**
+     * \brief Construct an item in place on the top of the stack
+     * \precondition None
+     * \postcondition The item constructed is pushed onto the stack
+     * \complexity O(1), lock-free
+     * \param args The arguments forwarded to the constructor of the item
+     */
+    template <typename... Args>
+    void emplace (Args&& ... args)
+    {
+      push_(new node {std::forward<Args>(args)...});
+    }
+
+    /**
+     * \brief Pop the item on the top of the stack if the stack is not empty
+     * \precondition None
+     * \postcondition If the stack was not empty the top item is removed from the stack
+     * \complexity O(1), lock-free
+     * \return The item popped or an empty optional if the stack is empty
+     */
+    std::optional<value_type> try_pop ()
+    {
+      return pop_();
+    }
+
+    /**
+     * \brief Pop the item on the top of the stack
+     * \precondition The stack is not empty
+     * \postcondition The top item is removed from the stack
+     * \complexity O(1), lock-free
+     * \throws stack_empty_error if the stack is empty
+     */
+    void pop ()
+    {
+      if (!pop_())
+        throw stack_empty_error{"Attempting pop() on empty stack"};
+    }
+
+    /**
+     * \brief Clear the stack removing all the items
+     * \details The items pushed concurrently can be not removed
+     * \precondition None
+     * \postcondition The items pushed before the call are removed
+     * \complexity O(N)
+     */
+    void clear ()
+    {
+      hazard_pointer hazard;
+      for (auto top = hazard.protect(top_); top != nullptr; top = hazard.protect(top_))
+        if (top_.compare_exchange_weak(top, nullptr, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+          hazard.reset();
+          // the detached list is owned by this thread but the nodes can still be protected by the others
+          for (auto n = top; n != nullptr;) {
+            auto next = n->next_;
+            retire(n);
+            n = next;
+          }
+          return;
+        }
+    }
+
+  private:
+    struct node {
+      template <typename... Args>
+      explicit node (Args&& ... args) : value_ {std::forward<Args>(args)...}
+      {}
+
+      value_type value_;
+      node* next_ {nullptr};
+      size_type size_ {1};
+    };
+
+    // a slot of the elimination array, it holds the node offered by a push
+    struct alignas(cache_line_size) exchanger {
+      std::atomic<node*> offer {nullptr};
+    };
+
+    // how many times a push checks if its offer has been taken
+    static constexpr int elimination_wait_ = 32;
+
+    void push_ (node* n)
+    {
+      hazard_pointer hazard;
+      for (;;) {
+        // loop invariant (holds also at the end of this loop)
+        // n is owned by this thread and not reachable from the stack nor from the elimination array
+        auto top = hazard.protect(top_);
+        n->next_ = top;
+        n->size_ = top != nullptr ? top->size_ + 1 : 1;
+        if (top_.compare_exchange_weak(top, n, std::memory_order_release, std::memory_order_relaxed))
+          return;
+        if (eliminate_push_(n))
+          return;
+      }
+    }
+
+    std::optional<value_type> pop_ ()
+    {
+      hazard_pointer hazard;
+      for (;;) {
+        auto top = hazard.protect(top_);
+        if (top == nullptr)
+          return std::nullopt;
+        // top cannot be deleted so its next did not change if the compare and swap succeeds
+        if (top_.compare_exchange_weak(top, top->next_, std::memory_order_acquire, std::memory_order_relaxed)) {
+          hazard.reset();
+          try {
+            std::optional<value_type> value {top->value_};
+            retire(top);
+            return value;
+          }
+          catch (...) {
+            // the item is lost but the node is not leaked
+            retire(top);
+            throw;
+          }
+        }
+        if (auto n = eliminate_pop_()) {
+          hazard.reset();
+          std::optional<value_type> value {std::move(n->value_)};
+          delete n;
+          return value;
+        }
+      }
+    }
+
+    // offer n to a pop, true if a pop took it
+    bool eliminate_push_ (node* n)
+    {
+      if constexpr (EliminationSlots == 0) {
+        static_cast<void>(n);
+        return false;
+      }
+      else {
+        auto& slot = elimination_[random_slot_()];
+        node* empty = nullptr;
+        if (!slot.offer.compare_exchange_strong(empty, n, std::memory_order_release, std::memory_order_relaxed))
+          return false;
+
+        for (auto i = 0; i < elimination_wait_; ++i) {
+          if (slot.offer.load(std::memory_order_relaxed) != n)
+            return true;
+          std::this_thread::yield();
+        }
+        // withdraw the offer, if it fails a pop took the node
+        auto offered = n;
+        return !slot.offer.compare_exchange_strong(offered, nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    // the node offered by a push, it is owned by the calling thread, or nullptr
+    node* eliminate_pop_ ()
+    {
+      if constexpr (EliminationSlots == 0)
+        return nullptr;
+      else {
+        auto& slot = elimination_[random_slot_()];
+        // the node is not dereferenced until it is taken, so it does not need a hazard pointer
+        auto n = slot.offer.load(std::memory_order_relaxed);
+        if (n != nullptr && slot.offer.compare_exchange_strong(n, nullptr, std::memory_order_acquire,
+                                                               std::memory_order_relaxed))
+          return n;
+        return nullptr;
+      }
+    }
+
+    static std::size_t random_slot_ () noexcept
+    {
+      // xorshift, the state is per thread so the threads spread over the slots
+      thread_local std::uint32_t state = static_cast<std::uint32_t>(
+          std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      return state % EliminationSlots;
+    }
+
+    alignas(cache_line_size) std::atomic<node*> top_ {nullptr};
+    alignas(cache_line_size) std::array<exchanger, EliminationSlots> elimination_ {};
+  };
+}
+
+#endif //ALGOL_DS_LOCK_FREE_STACK_HPP
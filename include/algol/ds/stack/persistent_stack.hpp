@@ -0,0 +1,594 @@
+/**
+ * \file
+ * Persistent stack implementation
+ */
+
+#ifndef ALGOL_DS_PERSISTENT_STACK_HPP
+#define ALGOL_DS_PERSISTENT_STACK_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "stack.hpp"
+#include "algol/ds/allocator.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Immutable stack whose versions share their nodes
+   * \details A version is never changed: push and pop return a new version and leave this one as it was.
+   * The version returned by push is a node linked to the nodes of this version, the one returned by pop
+   * is the version below the top, so both take O(1) and the versions share the common part of their items.
+   * Copying a version takes O(1) too, a backtracking search keeps the stack of every branch for free.
+   * The nodes are reference counted and given back to the allocator when the last version that reaches
+   * them is destroyed.
+   * With ThreadSafe the counts are atomic and the versions can be copied and destroyed by different threads,
+   * like a std::shared_ptr. Without it the counts are plain integers, all the versions sharing nodes must be
+   * used by one thread: with an arena allocator, for example a std::pmr::monotonic_buffer_resource,
+   * push and the destruction neither execute atomic operations nor call the global allocator.
+   * Only the read side of the Stack ADT is provided, the stack does not satisfy the Stack concept.
+   * \tparam T type of the items stored in the stack
+   * \tparam Allocator allocator of the items, the nodes are allocated with it rebound to the node type
+   * \tparam ThreadSafe the reference counts are atomic
+   * \invariant The item that is accessible at the top of the stack is the item that has
+   * most recently been pushed onto it and not yet popped (removed)
+   */
+  template <concepts::CopyConstructible T, typename Allocator = std::allocator<T>, bool ThreadSafe = true>
+  class persistent_stack final {
+  private:
+    struct node;
+
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Forward iterator from the top to the bottom of a version
+     * \details The items cannot be changed, they are shared with other versions
+     */
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = T const*;
+      using reference = T const&;
+
+      const_iterator () noexcept = default;
+
+      reference operator* () const noexcept
+      {
+        return current_->value_[0];
+      }
+
+      pointer operator-> () const noexcept
+      {
+        return std::addressof(current_->value_[0]);
+      }
+
+      const_iterator& operator++ () noexcept
+      {
+        current_ = current_->next_;
+        return *this;
+      }
+
+      const_iterator operator++ (int) noexcept
+      {
+        auto previous = *this;
+        ++*this;
+        return previous;
+      }
+
+      friend bool operator== (const_iterator const& lhs, const_iterator const& rhs) noexcept
+      {
+        return lhs.current_ == rhs.current_;
+      }
+
+      friend bool operator!= (const_iterator const& lhs, const_iterator const& rhs) noexcept
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+      friend class persistent_stack;
+
+      explicit const_iterator (node const* current) noexcept : current_ {current}
+      {}
+
+      node const* current_ {nullptr};
+    };
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1)
+     */
+    persistent_stack () noexcept(noexcept(allocator_type{})) : persistent_stack(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty stack whose nodes are allocated with the provided allocator
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1)
+     * \param allocator The allocator of the nodes, it is rebound to the node type
+     */
+    explicit persistent_stack (allocator_type const& allocator) noexcept
+        : allocator_ {allocator}, top_node_ {nullptr}, items_ {size_type{0}}
+    {}
+
+    /**
+     * \brief Initializer list constructor, the last value is the top
+     * \precondition None
+     * \postcondition The stack contains the values pushed in order
+     * \complexity O(N)
+     * \param values The values to push
+     * \param allocator The allocator of the nodes
+     */
+    persistent_stack (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : persistent_stack(allocator)
+    {
+      // loop invariant: the values before value are pushed
+      for (auto const& value : values)
+        *this = push(value);
+    }
+
+    /**
+     * \brief Copy constructor
+     * \details The copy shares the nodes of rhs, so it keeps its allocator: the nodes are given back to the
+     * allocator that allocated them
+     * \precondition None
+     * \postcondition This stack is equal to rhs
+     * \complexity O(1)
+     * \param rhs The stack to be copied
+     */
+    persistent_stack (persistent_stack const& rhs) noexcept
+        : allocator_ {rhs.allocator_}, top_node_ {acquire_(rhs.top_node_)}, items_ {rhs.items_}
+    {}
+
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \details The copy shares the nodes of rhs if the allocators are equal, otherwise the items are copied
+     * into nodes allocated with the provided allocator
+     * \precondition None
+     * \postcondition This stack is equal to rhs
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \throws std::bad_alloc if a node cannot be allocated, or the exception of the copy of an item
+     * \param rhs The stack to be copied
+     * \param allocator The allocator of the nodes
+     */
+    persistent_stack (persistent_stack const& rhs, allocator_type const& allocator)
+        : allocator_ {allocator}, top_node_ {nullptr}, items_ {rhs.items_}
+    {
+      top_node_ = allocator_ == rhs.allocator_ ? acquire_(rhs.top_node_) : copy_nodes_(rhs.top_node_);
+    }
+
+    /**
+     * \brief Move constructor
+     * \precondition None
+     * \postcondition This stack has the nodes of rhs that becomes empty
+     * \complexity O(1)
+     * \param rhs The stack to be moved
+     */
+    persistent_stack (persistent_stack&& rhs) noexcept
+        : allocator_ {rhs.allocator_}, top_node_ {std::exchange(rhs.top_node_, nullptr)},
+          items_ {std::exchange(rhs.items_, size_type{0})}
+    {}
+
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The nodes are stolen if the allocators are equal, otherwise the items are copied into nodes
+     * allocated with the provided allocator: the nodes of rhs can be shared with other versions, the items
+     * cannot be moved
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \throws std::bad_alloc if a node cannot be allocated, or the exception of the copy of an item
+     * \param rhs The stack to be moved
+     * \param allocator The allocator of the nodes
+     */
+    persistent_stack (persistent_stack&& rhs, allocator_type const& allocator)
+        : persistent_stack(rhs, allocator)
+    {
+      rhs.release_(std::exchange(rhs.top_node_, nullptr));
+      rhs.items_ = 0;
+    }
+
+    /**
+     * \brief Copy assignment operator
+     * \details This stack shares the nodes of rhs if the allocator propagates on copy assignment or the
+     * allocators are equal, otherwise the items are copied into nodes allocated with the allocator of this stack
+     * \precondition None
+     * \postcondition This stack is equal to rhs
+     * \complexity O(1) plus the nodes released, the ones reached only by this stack, O(N) if the items are copied
+     * \throws std::bad_alloc if a node cannot be allocated, or the exception of the copy of an item
+     * \param rhs The stack to be copied
+     * \return This stack
+     */
+    persistent_stack& operator= (persistent_stack const& rhs)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      persistent_stack temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_nodes_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Move assignment operator
+     * \details This stack takes the nodes of rhs if the allocator propagates on move assignment or the
+     * allocators are equal, otherwise the items are copied into nodes allocated with the allocator of this stack
+     * \precondition None
+     * \postcondition This stack has the items of rhs that becomes empty
+     * \complexity O(1) plus the nodes released, the ones reached only by this stack, O(N) if the items are copied
+     * \param rhs The stack to be moved
+     * \return This stack
+     */
+    persistent_stack& operator= (persistent_stack&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      persistent_stack temp {std::move(rhs), propagate ? rhs.allocator_ : allocator_};
+      swap_nodes_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Destructor
+     * \details The nodes reached only by this stack are deallocated, the loop stops at the first node shared
+     * with another version
+     * \complexity O(1) plus the nodes released
+     */
+    ~persistent_stack ()
+    {
+      release_(top_node_);
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
+
+    /**
+     * \brief The stack is empty?
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return True if the stack is empty, false otherwise
+     */
+    bool empty () const noexcept
+    {
+      return top_node_ == nullptr;
+    }
+
+    /**
+     * \brief The stack is full?
+     * \details The stack is full only when the allocator fails, this is not detected
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return false
+     */
+    bool full () const noexcept
+    {
+      return false;
+    }
+
+    /**
+     * \brief The size of the stack
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the stack
+     */
+    size_type size () const noexcept
+    {
+      return items_;
+    }
+
+    /**
+     * \brief A constant reference at the item on the top of the stack
+     * \precondition The stack is not empty
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     * \return The item on the top of the stack
+     */
+    const_reference top () const
+    {
+      if (empty())
+        throw stack_empty_error{"Attempting top() on empty stack"};
+
+      return top_node_->value_[0];
+    }
+
+    /**
+     * \brief A new version with the item passed on the top of this version
+     * \precondition None
+     * \postcondition This stack is not changed, the version returned shares its nodes
+     * \complexity O(1)
+     * \throws std::bad_alloc if the node cannot be allocated
+     * \param value The item to push onto the new version
+     * \return The new version
+     */
+    [[nodiscard]] persistent_stack push (value_type const& value) const
+    {
+      return emplace(value);
+    }
+
+    [[nodiscard]] persistent_stack push (value_type&& value) const
+    {
+      return emplace(std::move(value));
+    }
+
+    /**
+     * \brief A new version with an item constructed in place on the top of this version
+     * \precondition None
+     * \postcondition This stack is not changed, the version returned shares its nodes
+     * \complexity O(1)
+     * \throws std::bad_alloc if the node cannot be allocated, or the exception of the constructor of the item
+     * \param args The arguments forwarded to the constructor of the item
+     * \return The new version
+     */
+    template <typename... Args>
+    [[nodiscard]] persistent_stack emplace (Args&& ... args) const
+    {
+      auto n = make_node_(std::forward<Args>(args)...);
+      n->next_ = acquire_(top_node_);
+      return persistent_stack{allocator_, n, items_ + 1};
+    }
+
+    /**
+     * \brief The version below the top of this version
+     * \precondition The stack is not empty
+     * \postcondition This stack is not changed, the version returned shares its nodes
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     * \return The version without the top item
+     */
+    [[nodiscard]] persistent_stack pop () const
+    {
+      if (empty())
+        throw stack_empty_error{"Attempting pop() on empty stack"};
+
+      return persistent_stack{allocator_, acquire_(top_node_->next_), items_ - 1};
+    }
+
+    /**
+     * \brief Iterator to the top item
+     * \precondition None
+     * \complexity O(1)
+     * \return The iterator, equal to end() if the stack is empty
+     */
+    const_iterator begin () const noexcept
+    {
+      return const_iterator{top_node_};
+    }
+
+    /**
+     * \brief Iterator past the bottom item
+     * \precondition None
+     * \complexity O(1)
+     * \return The iterator
+     */
+    const_iterator end () const noexcept
+    {
+      return const_iterator{};
+    }
+
+    /**
+     * \brief Creates a vector with the items pushed onto the stack, the top first
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \return A vector with the items pushed onto the stack
+     */
+    std::vector<value_type> to_vector () const
+    {
+      return std::vector<value_type>(begin(), end());
+    }
+
+    /**
+     * \brief The two versions share all their nodes?
+     * \details Two versions obtained one from the other by copies share their nodes, two versions built by
+     * different pushes do not, even with equal items
+     * \precondition None
+     * \complexity O(1)
+     * \param rhs The other version
+     * \return True if the stacks have the same nodes, false otherwise
+     */
+    bool shares (persistent_stack const& rhs) const noexcept
+    {
+      return top_node_ == rhs.top_node_;
+    }
+
+    /**
+     * \brief Exchanges the contents of the stack with those of rhs
+     * \details The allocators are exchanged only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
+     * \postcondition The stack has the nodes of rhs and viceversa
+     * \complexity O(1)
+     * \param rhs The stack to exchange
+     */
+    void swap (persistent_stack& rhs) noexcept
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_nodes_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+    /**
+     * \brief Equality operator
+     * \details The items are compared from the top and the comparison stops at the first node shared
+     * \precondition None
+     * \postcondition The stacks are not changed
+     * \complexity O(N), O(1) if the stacks share their nodes
+     * \param lhs First stack to compare
+     * \param rhs Second stack to compare
+     * \return True if the stacks have the same items in the same order, false otherwise
+     */
+    friend bool operator== (persistent_stack const& lhs, persistent_stack const& rhs)
+    {
+      if (lhs.items_ != rhs.items_)
+        return false;
+      auto l = lhs.top_node_;
+      auto r = rhs.top_node_;
+      // loop invariant: the items above l and r are equal
+      for (; l != r; l = l->next_, r = r->next_)
+        if (!(l->value_[0] == r->value_[0]))
+          return false;
+      return true;
+    }
+
+    friend bool operator!= (persistent_stack const& lhs, persistent_stack const& rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using count_type = std::conditional_t<ThreadSafe, std::atomic<size_type>, size_type>;
+
+    // the value is constructed by allocate_node with the allocator of the items
+    struct node {
+      count_type count_ {1};
+      node* next_ {nullptr};
+      detail::inline_array<value_type, 1> value_;
+    };
+
+    persistent_stack (allocator_type const& allocator, node* top_node, size_type items) noexcept
+        : allocator_ {allocator}, top_node_ {top_node}, items_ {items}
+    {}
+
+    // a node with count 1 and without the next node, the item is constructed from args
+    template <typename... Args>
+    node* make_node_ (Args&& ... args) const
+    {
+      auto allocator = allocator_;
+      return detail::allocate_node<node>(allocator, std::forward<Args>(args)...);
+    }
+
+    // the items from n to the bottom copied into nodes allocated with the allocator of this stack
+    node* copy_nodes_ (node const* n)
+    {
+      node* top = nullptr;
+      auto link = &top;
+      try {
+        // loop invariant: the items above n are copied and link is the next node of the last copy
+        for (; n != nullptr; n = n->next_) {
+          *link = make_node_(n->value_[0]);
+          link = &(*link)->next_;
+        }
+      }
+      catch (...) {
+        release_(top);
+        throw;
+      }
+      return top;
+    }
+
+    void swap_nodes_ (persistent_stack& rhs) noexcept
+    {
+      using std::swap;
+      swap(top_node_, rhs.top_node_);
+      swap(items_, rhs.items_);
+    }
+
+    static node* acquire_ (node* n) noexcept
+    {
+      if (n != nullptr) {
+        if constexpr (ThreadSafe)
+          n->count_.fetch_add(1, std::memory_order_relaxed);
+        else
+          ++n->count_;
+      }
+      return n;
+    }
+
+    // the last reference to n is dropped?
+    static bool drop_ (node* n) noexcept
+    {
+      if constexpr (ThreadSafe)
+        // acquire and release: the thread that deallocates sees the writes of the other owners
+        return n->count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+      else
+        return --n->count_ == 0;
+    }
+
+    void release_ (node* n) noexcept
+    {
+      // iterative, a long stack does not recurse
+      // loop invariant: the nodes above n that were reached only by this stack are deallocated
+      while (n != nullptr && drop_(n)) {
+        auto next = n->next_;
+        detail::deallocate_node(allocator_, n);
+        n = next;
+      }
+    }
+
+    allocator_type allocator_;
+    node* top_node_;
+    size_type items_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs stacks.
+   * \details Non member function, noexcept it cannot fail.
+   * \tparam T type of the items stored in the stack.
+   * \precondition The allocators are equal or they propagate on swap.
+   * \postcondition The lhs stack becomes the rhs stack and viceversa.
+   * \complexity O(1)
+   * \param lhs Stack to be exchanged with rhs.
+   * \param rhs Stack to be exchanged with lhs.
+   */
+  template <typename T, typename Allocator, bool ThreadSafe>
+  void swap (persistent_stack<T, Allocator, ThreadSafe>& lhs, persistent_stack<T, Allocator, ThreadSafe>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief persistent_stack whose nodes are allocated from a std::pmr::memory_resource, with ThreadSafe false
+   * and an unsynchronized pool or a monotonic buffer it is the arena version
+   */
+  template <typename T, bool ThreadSafe = true>
+  using persistent_stack = ds::persistent_stack<T, std::pmr::polymorphic_allocator<T>, ThreadSafe>;
+}
+#endif
+
+#endif //ALGOL_DS_PERSISTENT_STACK_HPP
@@ -0,0 +1,644 @@
+/**
+ * \file
+ * Segmented stack implementation
+ */
+
+#ifndef ALGOL_DS_SEGMENTED_STACK_HPP
+#define ALGOL_DS_SEGMENTED_STACK_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include "static_stack.hpp"
+#include "algol/ds/allocator.hpp"
+#include "algol/ds/chunk.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Implementation of the Stack ADT using a list of fixed size chunks
+   * \details see class [stack](@ref stack), the operations are dispatched at compile time by
+   * [static_stack](@ref static_stack)
+   * The stack grows one chunk at a time and is never full: a new chunk is linked on top of the others,
+   * the items already pushed are never copied nor moved, the references to them stay valid until they are popped.
+   * A chunk emptied by pop is put on a free list and reused by the next push that needs a chunk, the chunks are
+   * deallocated by shrink_to_fit and by the destructor.
+   * \tparam T type of the items stored in the stack
+   * \tparam ChunkSize number of the items of a chunk, by default a chunk is about 4 KiB
+   * \tparam Allocator allocator of the items, for example a std::pmr::polymorphic_allocator, the chunks are
+   * allocated with it rebound to the chunk type
+   * \invariant The item that is accessible at the top of the stack is the item that has
+   * most recently been pushed onto it and not yet popped (removed)
+   */
+  template <concepts::CopyConstructible T, typename stack<T>::size_type ChunkSize = detail::default_chunk_size<T>,
+            typename Allocator = std::allocator<T>>
+  class segmented_stack final : public static_stack<segmented_stack<T, ChunkSize, Allocator>, T> {
+    static_assert(ChunkSize > 0, "a chunk holds at least one item");
+
+  public:
+    using value_type = typename stack<T>::value_type;
+    using reference = typename stack<T>::reference;
+    using const_reference = typename stack<T>::const_reference;
+    using size_type = typename stack<T>::size_type;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Default constructor
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1), no allocation
+     */
+    segmented_stack () : segmented_stack(allocator_type{})
+    {}
+
+    /**
+     * \brief Construct an empty stack whose chunks are allocated with the provided allocator
+     * \precondition None
+     * \postcondition The stack is empty
+     * \complexity O(1), no allocation
+     * \param allocator The allocator of the items, it is rebound to the chunk type
+     */
+    explicit segmented_stack (allocator_type const& allocator)
+        : allocator_ {allocator}, pool_ {}, bottom_chunk_ {nullptr}, top_chunk_ {nullptr}, top_items_ {size_type{0}},
+          items_ {size_type{0}}, chunks_ {size_type{0}}
+    {}
+
+    /**
+     * \brief Construct a stack with values provided
+     * \details The values are pushed onto the stack starting at begin of initializer list and stopping at the end
+     * If the initializer_list contains {1, 2, 3, 4} the stack will contains [4, 3, 2, 1]
+     * \precondition None
+     * \postcondition The stack size is the same of the initializer_list and all the items contained in the
+     * initializer_list are pushed onto the stack
+     * \complexity O(N)
+     * \param values The items to be pushed onto the stack
+     * \param allocator The allocator of the items
+     */
+    segmented_stack (std::initializer_list<value_type> values, allocator_type const& allocator = allocator_type{})
+        : segmented_stack(allocator)
+    {
+      this->push_range(values.begin(), values.end());
+    }
+
+    /**
+     * \brief Copy constructor
+     * \details The allocator is the one returned by select_on_container_copy_construction
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack
+     * \complexity O(N)
+     * \param rhs The stack to be copied
+     */
+    segmented_stack (segmented_stack const& rhs)
+        : segmented_stack(rhs, alloc_traits::select_on_container_copy_construction(rhs.allocator_))
+    {}
+
+    /**
+     * \brief Copy constructor with the allocator provided
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack
+     * \complexity O(N)
+     * \param rhs The stack to be copied
+     * \param allocator The allocator of the items
+     */
+    segmented_stack (segmented_stack const& rhs, allocator_type const& allocator) : segmented_stack(allocator)
+    {
+      // the delegating constructor has completed, if a copy throws the destructor releases the chunks
+      rhs.for_each_([this] (value_type const& value) { emplace_(value); });
+    }
+
+    /**
+     * \brief Move constructor
+     * \details The chunks, also the free ones, are stolen
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack that becomes empty
+     * \complexity O(1)
+     * \param rhs The stack to be moved, items contained are 'stolen' from this stack
+     */
+    segmented_stack (segmented_stack&& rhs) noexcept : segmented_stack(rhs.allocator_)
+    {
+      swap_items_(rhs);
+    }
+
+    /**
+     * \brief Move constructor with the allocator provided
+     * \details The chunks are stolen if the allocators are equal, otherwise the items are moved one by one
+     * into chunks allocated with the provided allocator
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack that becomes empty
+     * \complexity O(1) if the allocators are equal, O(N) otherwise
+     * \param rhs The stack to be moved
+     * \param allocator The allocator of the items
+     */
+    segmented_stack (segmented_stack&& rhs, allocator_type const& allocator) : segmented_stack(allocator)
+    {
+      if (allocator_ == rhs.allocator_) {
+        swap_items_(rhs);
+        return;
+      }
+
+      for (auto c = rhs.bottom_chunk_; c != nullptr; c = c->next_) {
+        // loop invariant: the items of the chunks of rhs below c are moved in the same order
+        auto n = c == rhs.top_chunk_ ? rhs.top_items_ : ChunkSize;
+        for (auto i = size_type{0}; i < n; ++i)
+          emplace_(std::move(c->items_[i]));
+      }
+      rhs.clear_();
+    }
+
+    /**
+     * \brief Assignment operator
+     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack,
+     * the allocator is replaced only if it propagates on copy assignment
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack
+     * \complexity O(N)
+     * \param rhs The stack to be copied
+     * \return The stack containing the provided stack items
+     */
+    segmented_stack& operator= (segmented_stack const& rhs)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+      segmented_stack temp {rhs, propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Move assignment operator
+     * \details The actual items of the stack are destroyed and are replaced with the items of the provided stack,
+     * the chunks are stolen if the allocator propagates on move assignment or the allocators are equal,
+     * otherwise the items are moved one by one
+     * \precondition None
+     * \postcondition This stack is equal to the provided stack that becomes empty
+     * \complexity O(1) if the chunks are stolen, O(N) otherwise
+     * \param rhs The stack to be moved, items contained are 'stolen' from this stack
+     * \return The stack containing the provided stack items
+     */
+    segmented_stack& operator= (segmented_stack&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+      constexpr auto propagate = alloc_traits::propagate_on_container_move_assignment::value;
+      segmented_stack temp {std::move(rhs), propagate ? rhs.allocator_ : allocator_};
+      swap_items_(temp);
+      if constexpr (propagate) {
+        using std::swap;
+        swap(allocator_, temp.allocator_);
+      }
+      return *this;
+    }
+
+    /**
+     * \brief Destructor
+     * \precondition None
+     * \postcondition The stack items are destroyed and the chunks deallocated
+     * \complexity O(N) Destructor calls
+     */
+    ~segmented_stack ()
+    {
+      clear_();
+      pool_.release(allocator_);
+    }
+
+    /**
+     * \brief The allocator of the items
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(1)
+     * \return A copy of the allocator
+     */
+    allocator_type get_allocator () const noexcept
+    {
+      return allocator_;
+    }
+
+    /**
+     * \brief The number of the items the stack holds before it allocates a chunk
+     * \details The chunks in use and the free chunks are counted
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(1)
+     * \return The capacity of the stack
+     */
+    size_type capacity () const noexcept
+    {
+      return (chunks_ + pool_.size()) * ChunkSize;
+    }
+
+    /**
+     * \brief Allocate free chunks until the stack holds at least n items without allocating
+     * \precondition None
+     * \postcondition The capacity is at least n, the items are unchanged
+     * \complexity O(n / ChunkSize)
+     * \throws std::bad_alloc if a chunk cannot be allocated, the chunks already allocated are kept
+     * \param n The number of the items
+     */
+    void reserve (size_type n)
+    {
+      if (n > chunks_ * ChunkSize)
+        pool_.reserve(allocator_, (n - chunks_ * ChunkSize + ChunkSize - 1) / ChunkSize);
+    }
+
+    /**
+     * \brief Deallocate the free chunks
+     * \precondition None
+     * \postcondition The capacity is the one of the chunks in use, the items are unchanged
+     * \complexity O(C) where C is the number of free chunks
+     */
+    void shrink_to_fit () noexcept
+    {
+      pool_.release(allocator_);
+    }
+
+    /**
+     * \brief Emplace the item passed onto the stack
+     * \precondition None
+     * \postcondition The size of the Stack is increased by 1 and the item passed becomes the current top
+     * \complexity O(1)
+     * \throws std::bad_alloc if a chunk is needed and it cannot be allocated, the stack is not changed
+     * \tparam Args parameters types for constructor of T
+     * \param args parameters for constructor of T
+     */
+    template <typename... Args>
+    std::enable_if_t<std::is_constructible_v<T, Args&& ...>, void>
+    emplace (Args&& ... args)
+    {
+      emplace_(std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Equality operator
+     * \details It must be reflexive, symmetric and transitive
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \param rhs The stack to be compared with this
+     * \return True if the items are the same and in the same order, false otherwise
+     */
+    bool operator== (segmented_stack const& rhs) const
+    requires concepts::EqualityComparable<T>
+    {
+      if (items_ != rhs.items_)
+        return false;
+
+      // the chunks but the top ones are full, the chunks of both stacks hold the same positions
+      auto this_chunk = bottom_chunk_;
+      auto rhs_chunk = rhs.bottom_chunk_;
+      for (auto items = items_; items > size_type{0}; items -= std::min(items, ChunkSize)) {
+        // loop invariant: the items of the chunks before this_chunk and rhs_chunk are equal
+        auto n = std::min(items, ChunkSize);
+        auto this_first = std::addressof(this_chunk->items_[0]);
+        if (!std::equal(this_first, this_first + n, std::addressof(rhs_chunk->items_[0])))
+          return false;
+        this_chunk = this_chunk->next_;
+        rhs_chunk = rhs_chunk->next_;
+      }
+
+      return true;
+    }
+
+    /**
+     * \brief Inequality operator
+     * \details Implemented in terms of equality operator
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \param rhs The stack to be compared with this
+     * \return True if the items are not the same or not in the same order, false otherwise
+     */
+    bool operator!= (segmented_stack const& rhs) const
+    requires concepts::EqualityComparable<T>
+    {
+      return !(*this == rhs);
+    }
+
+    /**
+     * \brief Less than operator
+     * \details Lexicographical comparison of the items from the bottom to the top:
+     * - The first mismatching item defines which stack is lexicographically less or greater than the other
+     * - If one stack is a prefix of another, the shorter stack is lexicographically less than the other
+     * - An empty stack is lexicographically less than any non-empty stack
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \param rhs The stack to be compared with this
+     * \return True if this stack is lexicographically less than the provided stack, false otherwise
+     */
+    bool operator< (segmented_stack const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      auto this_chunk = bottom_chunk_;
+      auto rhs_chunk = rhs.bottom_chunk_;
+      for (auto items = std::min(items_, rhs.items_); items > size_type{0}; items -= std::min(items, ChunkSize)) {
+        // loop invariant: the items of the chunks before this_chunk and rhs_chunk are equal
+        auto n = std::min(items, ChunkSize);
+        auto this_first = std::addressof(this_chunk->items_[0]);
+        auto [this_item, rhs_item] = std::mismatch(this_first, this_first + n, std::addressof(rhs_chunk->items_[0]));
+        if (this_item != this_first + n)
+          return *this_item < *rhs_item;
+        this_chunk = this_chunk->next_;
+        rhs_chunk = rhs_chunk->next_;
+      }
+
+      return items_ < rhs.items_;
+    }
+
+    /**
+     * \brief Less than or equal operator
+     * \details see operator<
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \param rhs The stack to be compared with this
+     * \return True if this stack is lexicographically less than or equal to the provided stack, false otherwise
+     */
+    bool operator<= (segmented_stack const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return !(*this > rhs);
+    }
+
+    /**
+     * \brief Greater than operator
+     * \details see operator<
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \param rhs The stack to be compared with this
+     * \return True if this stack is lexicographically greater than the provided stack, false otherwise
+     */
+    bool operator> (segmented_stack const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return rhs < *this;
+    }
+
+    /**
+     * \brief Greater than or equal operator
+     * \details see operator<
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \param rhs The stack to be compared with this
+     * \return True if this stack is lexicographically greater than or equal to the provided stack, false otherwise
+     */
+    bool operator>= (segmented_stack const& rhs) const
+    requires concepts::StrictTotallyOrdered<T>
+    {
+      return !(*this < rhs);
+    }
+
+    /**
+     * \brief Swaps the items of this stack with the items of the provided stack
+     * \details noexcept operation, it cannot throw.
+     * The allocators are swapped only if they propagate on swap
+     * \precondition The allocators are equal or they propagate on swap
+     * \postcondition This stack becomes the rhs stack and viceversa
+     * \complexity O(1)
+     * \param rhs The stack to be swapped with this
+     */
+    void swap (segmented_stack& rhs) noexcept
+    {
+      assert(alloc_traits::propagate_on_container_swap::value || allocator_ == rhs.allocator_);
+
+      swap_items_(rhs);
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhs.allocator_);
+      }
+    }
+
+  private:
+    friend class static_stack<segmented_stack, T>;
+
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using chunk_type = detail::chunk<value_type, ChunkSize>;
+
+    // swap the chunks and the counters, not the allocators
+    void swap_items_ (segmented_stack& rhs) noexcept
+    {
+      using std::swap;
+      swap(bottom_chunk_, rhs.bottom_chunk_);
+      swap(top_chunk_, rhs.top_chunk_);
+      swap(top_items_, rhs.top_items_);
+      swap(items_, rhs.items_);
+      swap(chunks_, rhs.chunks_);
+      pool_.swap(rhs.pool_);
+    }
+
+    // call f on the items from the bottom to the top
+    template <typename F>
+    void for_each_ (F f) const
+    {
+      for (auto c = bottom_chunk_; c != nullptr; c = c->next_) {
+        // loop invariant: f has been called on the items of the chunks below c
+        auto n = c == top_chunk_ ? top_items_ : ChunkSize;
+        for (auto i = size_type{0}; i < n; ++i)
+          f(c->items_[i]);
+      }
+    }
+
+    bool empty_ () const final
+    {
+      return items_ == size_type{0};
+    }
+
+    bool full_ () const final
+    {
+      return false;
+    }
+
+    size_type size_ () const final
+    {
+      return items_;
+    }
+
+    const_reference top_ () const& final
+    {
+      assert(top_chunk_ != nullptr && top_items_ > size_type{0});
+
+      return top_chunk_->items_[top_items_ - 1];
+    }
+
+    void push_ (value_type const& value) final
+    {
+      emplace_(value);
+    }
+
+    void push_ (value_type&& value) final
+    {
+      emplace_(std::move(value));
+    }
+
+    void pop_ () final
+    {
+      assert(top_chunk_ != nullptr && top_items_ > size_type{0});
+
+      alloc_traits::destroy(allocator_, std::addressof(top_chunk_->items_[--top_items_]));
+      --items_;
+      if (top_items_ == size_type{0})
+        drop_top_chunk_();
+    }
+
+    // link an empty chunk on top of the others, the caller constructs its first item
+    void link_top_chunk_ (chunk_type* new_chunk) noexcept
+    {
+      new_chunk->prev_ = top_chunk_;
+      if (top_chunk_ != nullptr)
+        top_chunk_->next_ = new_chunk;
+      else
+        bottom_chunk_ = new_chunk;
+      top_chunk_ = new_chunk;
+      top_items_ = size_type{0};
+      ++chunks_;
+    }
+
+    // the top chunk is empty, it goes back to the free list and the chunk below, if any, is full
+    void drop_top_chunk_ () noexcept
+    {
+      assert(top_chunk_ != nullptr && top_items_ == size_type{0});
+
+      auto empty_chunk = top_chunk_;
+      top_chunk_ = top_chunk_->prev_;
+      if (top_chunk_ != nullptr)
+        top_chunk_->next_ = nullptr;
+      else
+        bottom_chunk_ = nullptr;
+      top_items_ = top_chunk_ != nullptr ? ChunkSize : size_type{0};
+      --chunks_;
+      pool_.recycle(empty_chunk);
+    }
+
+    void clear_ () final
+    {
+      // invariant: the items above the top are destroyed and their chunks are free
+      while (items_ > size_type{0})
+        pop_();
+    }
+
+    std::vector<value_type> to_vector_ () const final
+    {
+      std::vector<value_type> vector {};
+      vector.reserve(items_);
+      for_each_([&vector] (value_type const& value) { vector.push_back(value); });
+      std::reverse(vector.begin(), vector.end());
+      return vector;
+    }
+
+    template <typename... Args>
+    void emplace_ (Args&& ... args)
+    {
+      if (top_chunk_ != nullptr && top_items_ < ChunkSize) {
+        alloc_traits::construct(allocator_, top_chunk_->items_.data() + top_items_, std::forward<Args>(args)...);
+        ++top_items_;
+        ++items_;
+        return;
+      }
+
+      // the top chunk is full, the item goes in a new chunk linked on top of it
+      auto new_chunk = pool_.acquire(allocator_);
+      try {
+        alloc_traits::construct(allocator_, new_chunk->items_.data(), std::forward<Args>(args)...);
+      }
+      catch (...) {
+        pool_.recycle(new_chunk);
+        throw;
+      }
+      link_top_chunk_(new_chunk);
+      top_items_ = size_type{1};
+      ++items_;
+    }
+
+    // the items are copied a chunk at a time, with memcpy if they are trivially copyable;
+    // if a copy throws the items already pushed are popped
+    template <typename ForwardIt>
+    void push_n_ (ForwardIt first, size_type count)
+    {
+      auto pushed = size_type{0};
+      try {
+        // loop invariant: the items before first are pushed
+        while (pushed < count) {
+          if (top_chunk_ == nullptr || top_items_ == ChunkSize)
+            link_top_chunk_(pool_.acquire(allocator_));
+          auto segment = std::min(count - pushed, ChunkSize - top_items_);
+          first = detail::uninitialized_copy_n(allocator_, first, segment, top_chunk_->items_.data() + top_items_);
+          top_items_ += segment;
+          items_ += segment;
+          pushed += segment;
+        }
+      }
+      catch (...) {
+        if (top_chunk_ != nullptr && top_items_ == size_type{0})
+          drop_top_chunk_();
+        while (pushed-- > size_type{0})
+          pop_();
+        throw;
+      }
+    }
+
+    // the items are moved a chunk at a time from the top down and then destroyed
+    template <typename OutputIt>
+    OutputIt pop_n_ (OutputIt out, size_type count)
+    {
+      assert(count <= items_);
+
+      // loop invariant: the items popped are written before out
+      while (count > size_type{0}) {
+        auto segment = std::min(count, top_items_);
+        auto top = std::make_reverse_iterator(std::addressof(top_chunk_->items_[top_items_ - 1]) + 1);
+        out = std::move(top, top + static_cast<std::ptrdiff_t>(segment), out);
+        for (auto i = size_type{0}; i < segment; ++i)
+          alloc_traits::destroy(allocator_, std::addressof(top_chunk_->items_[--top_items_]));
+        items_ -= segment;
+        count -= segment;
+        if (top_items_ == size_type{0})
+          drop_top_chunk_();
+      }
+      return out;
+    }
+
+    allocator_type allocator_;
+    detail::chunk_pool<value_type, ChunkSize> pool_;
+    chunk_type* bottom_chunk_;
+    chunk_type* top_chunk_;
+    size_type top_items_;
+    size_type items_;
+    size_type chunks_;
+  };
+
+  /**
+   * \brief Exchanges the items of lhs and rhs stacks
+   * \details Non member function, noexcept it cannot fail
+   * \tparam T type of the items stored in the stack
+   * \precondition The allocators are equal or they propagate on swap
+   * \postcondition The lhs stack becomes the rhs stack and viceversa
+   * \complexity O(1)
+   * \param lhs Stack to be exchanged with rhs
+   * \param rhs Stack to be exchanged with lhs
+   */
+  template <typename T, typename stack<T>::size_type ChunkSize, typename Allocator>
+  void swap (segmented_stack<T, ChunkSize, Allocator>& lhs, segmented_stack<T, ChunkSize, Allocator>& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace algol::ds::pmr {
+  /**
+   * \brief segmented_stack whose chunks are allocated from a std::pmr::memory_resource
+   */
+  template <typename T, typename stack<T>::size_type ChunkSize = detail::default_chunk_size<T>>
+  using segmented_stack = ds::segmented_stack<T, ChunkSize, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif //ALGOL_DS_SEGMENTED_STACK_HPP
@@ -0,0 +1,264 @@
+/**
+ * \file
+ * Stack ADT with static dispatch
+ */
+
+#ifndef ALGOL_DS_STATIC_STACK_HPP
+#define ALGOL_DS_STATIC_STACK_HPP
+
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "stack.hpp"
+#include "stl2/concepts.hpp"
+
+namespace algol::ds {
+  namespace concepts = std::experimental::ranges;
+
+  /**
+   * \brief Stack ADT interface dispatched at compile time (CRTP)
+   * \details The operations have the same signatures, preconditions and exceptions of the ones of
+   * [stack](@ref stack), but they call the hooks of Derived directly: Derived is a final class so the hooks
+   * are not looked up in the virtual table and they can be inlined in the caller.
+   * The operations of [stack](@ref stack) are hidden, not replaced: through a reference to stack<T> the
+   * same container is still used with dynamic dispatch.
+   * Derived implements the hooks of [stack](@ref stack) as final and befriends static_stack.
+   * The batch operations push_range and pop_n check the stack once per batch and call the hooks push_n_, pop_n_
+   * and space_ of static_stack, which push and pop one item at a time: Derived hides them to copy a whole
+   * segment of its storage at once.
+   * \tparam Derived the final class implementing the stack
+   * \tparam T type of the items stored in the stack.
+   * \invariant The item that is accessible at the top of the stack is the item that has
+   * most recently been pushed onto it and not yet popped (removed).
+   */
+  template <typename Derived, typename T>
+  class static_stack : public stack<T> {
+  public:
+    using value_type = typename stack<T>::value_type;
+    using reference = typename stack<T>::reference;
+    using const_reference = typename stack<T>::const_reference;
+    using size_type = typename stack<T>::size_type;
+
+    /**
+     * \brief The stack is empty?
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return True if the stack is empty, false otherwise
+     */
+    bool empty () const
+    {
+      return derived_().empty_();
+    }
+
+    /**
+     * \brief The stack is full?
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return True if the stack is full, false otherwise
+     */
+    bool full () const
+    {
+      return derived_().full_();
+    }
+
+    /**
+     * \brief The size of the stack
+     * \precondition None
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \return The current number of the items on the stack
+     */
+    size_type size () const
+    {
+      return derived_().size_();
+    }
+
+    /**
+     * \brief A constant reference at the item on the top of the stack
+     * \precondition The stack is not empty
+     * \postcondition Stack is not changed
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     * \return The item on the top of the stack
+     */
+    const_reference top () const&
+    {
+      if (derived_().empty_())
+        throw stack_empty_error{"Attempting top() on empty stack"};
+
+      return derived_().top_();
+    }
+
+    /**
+     * \brief Push the item passed onto the stack
+     * \precondition The stack is not full
+     * \postcondition The size of the Stack is increased by 1 and the item passed becomes the current top
+     * \complexity O(1)
+     * \throws stack_full_error if the stack is full and the stack is not changed
+     * \param value The item to push onto the stack
+     */
+    void push (value_type const& value)
+    {
+      if (derived_().full_())
+        throw stack_full_error{"Attempting push() on full stack"};
+
+      derived_().push_(value);
+    }
+
+    /**
+     * \brief Push the item passed onto the stack
+     * \precondition The stack is not full
+     * \postcondition The size of the Stack is increased by 1 and the item passed becomes the current top
+     * \complexity O(1)
+     * \throws stack_full_error if the stack is full and the stack is not changed
+     * \param value The item to push onto the stack with move operation
+     */
+    void push (value_type&& value)
+    {
+      if (derived_().full_())
+        throw stack_full_error{"Attempting push() on full stack"};
+
+      derived_().push_(std::move(value));
+    }
+
+    /**
+     * \brief Push the items of the range onto the stack, the last item becomes the top
+     * \details The room for the items is checked once before the first push
+     * \precondition The stack has room for std::distance(first, last) items
+     * \postcondition The size of the Stack is increased by the number of the items of the range, pushed in order
+     * \complexity O(M) where M is the number of the items of the range
+     * \throws stack_full_error if the stack has not room for all the items and the stack is not changed
+     * \tparam ForwardIt iterator type of the range
+     * \param first iterator to the first item to push
+     * \param last iterator past the last item to push
+     */
+    template <concepts::ForwardIterator ForwardIt>
+    void push_range (ForwardIt first, ForwardIt last)
+    {
+      auto count = static_cast<size_type>(std::distance(first, last));
+      if (count > derived_().space_())
+        throw stack_full_error{"Attempting push_range() on full stack"};
+
+      derived_().push_n_(first, count);
+    }
+
+    /**
+     * \brief Pop count items from the stack moving them in the range starting at out, the top item first
+     * \details The size is checked once before the first pop
+     * \precondition The stack holds at least count items and out can be incremented count times
+     * \postcondition The size of the Stack is decreased by count, the items are written in the order of the pops
+     * \complexity O(count)
+     * \throws stack_empty_error if the stack holds less than count items and the stack is not changed
+     * \tparam OutputIt iterator type of the output range
+     * \param out iterator to the first position of the output range
+     * \param count number of the items to pop
+     * \return The iterator past the last item written
+     */
+    template <typename OutputIt>
+    OutputIt pop_n (OutputIt out, size_type count)
+    {
+      if (count > derived_().size_())
+        throw stack_empty_error{"Attempting pop_n() on empty stack"};
+
+      return derived_().pop_n_(out, count);
+    }
+
+    /**
+     * \brief Pop the current top item from the stack
+     * \precondition The stack is not empty
+     * \postcondition The size of the Stack is decreased by 1 and the current top item is removed from the stack
+     * \complexity O(1)
+     * \throws stack_empty_error if the stack is empty
+     */
+    void pop ()
+    {
+      if (derived_().empty_())
+        throw stack_empty_error{"Attempting pop() on empty stack"};
+
+      derived_().pop_();
+    }
+
+    /**
+     * \brief Clear the stack removing all the items
+     * \details Invalidates any references or pointers referring to contained elements
+     * \precondition None
+     * \postcondition The stack is empty, the size becomes 0
+     * \complexity O(1) or O(N) depends on the implementation
+     */
+    void clear ()
+    {
+      derived_().clear_();
+    }
+
+    /**
+     * \brief Creates a vector with the items pushed onto the stack
+     * \precondition None
+     * \postcondition The stack is unchanged
+     * \complexity O(N)
+     * \return A vector with the items pushed onto the stack
+     */
+    std::vector<T> to_vector () const
+    {
+      return derived_().to_vector_();
+    }
+
+  protected:
+    static_stack () = default;
+    static_stack (static_stack const&) = default;
+    static_stack (static_stack&&) = default;
+    static_stack& operator= (static_stack const&) = default;
+    static_stack& operator= (static_stack&&) = default;
+    ~static_stack () override = default;
+
+    // the number of the items the stack has room for, unbounded by default
+    size_type space_ () const
+    {
+      return std::numeric_limits<size_type>::max() - derived_().size_();
+    }
+
+    // push count items one at a time, the items already pushed are popped if a copy throws
+    template <typename ForwardIt>
+    void push_n_ (ForwardIt first, size_type count)
+    {
+      auto pushed = size_type{0};
+      try {
+        // loop invariant: the items before first are pushed
+        for (; pushed < count; ++pushed, ++first)
+          derived_().push_(*first);
+      }
+      catch (...) {
+        while (pushed-- > size_type{0})
+          derived_().pop_();
+        throw;
+      }
+    }
+
+    // pop count items one at a time moving the top before the pop
+    // top_ gives a constant reference to an item that is not constant and that is popped right after
+    template <typename OutputIt>
+    OutputIt pop_n_ (OutputIt out, size_type count)
+    {
+      // loop invariant: the items popped are written before out
+      for (; count > size_type{0}; --count, ++out) {
+        *out = std::move(const_cast<reference>(derived_().top_()));
+        derived_().pop_();
+      }
+      return out;
+    }
+
+  private:
+    Derived& derived_ () noexcept
+    {
+      return static_cast<Derived&>(*this);
+    }
+
+    Derived const& derived_ () const noexcept
+    {
+      return static_cast<Derived const&>(*this);
+    }
+  };
+}
+#endif //ALGOL_DS_STATIC_STACK_HPP
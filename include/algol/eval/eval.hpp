@@ -112,7 +112,7 @@ namespace algol::eval {
   template <typename T, std::size_t N = 100>
   auto evaluate_postfix (std::string const& expression)
   {
-    algol::ds::fixed_stack<T, N> stack;
+    algol::ds::fixed_stack<T, N, algol::ds::inline_storage> stack;
     eval_tokenizer postfix {expression};
 
     for (const auto& token : postfix) {
@@ -164,7 +164,7 @@ namespace algol::eval {
   template <std::size_t N = 100>
   auto postfix_to_prefix (std::string const& expression)
   {
-    algol::ds::fixed_stack<std::string, N> stack;
+    algol::ds::fixed_stack<std::string, N, algol::ds::inline_storage> stack;
     eval_tokenizer postfix {expression};
 
     for (auto token : postfix) {
@@ -200,7 +200,7 @@ namespace algol::eval {
   {
     std::string postfix;
     eval_tokenizer prefix {expression};
-    algol::ds::fixed_stack<std::string, N> stack;
+    algol::ds::fixed_stack<std::string, N, algol::ds::inline_storage> stack;
 
     for (const auto& token : prefix) {
       if (detail::is_operator(token)) {
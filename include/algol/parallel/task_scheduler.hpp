@@ -0,0 +1,402 @@
+/**
+ * \file
+ * Fork-join task scheduler with work stealing.
+ */
+
+#ifndef ALGOL_PARALLEL_TASK_SCHEDULER_HPP
+#define ALGOL_PARALLEL_TASK_SCHEDULER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "algol/ds/cache_line.hpp"
+#include "algol/ds/event_count.hpp"
+#include "algol/ds/queue/work_stealing_deque.hpp"
+
+namespace algol::parallel {
+  class task_group;
+
+  /**
+   * \brief Pool of worker threads that run the tasks spawned by the task groups
+   * \details Every worker owns a [work-stealing deque](@ref algol::ds::work_stealing_deque): the tasks spawned
+   * by a worker are pushed at the bottom of its deque and the worker pops them in LIFO order, so it keeps
+   * working on the most recent, cache hot, part of the computation. A worker whose deque is empty steals
+   * the oldest task, usually the largest one, from the top of the deque of a random worker.
+   * The tasks spawned by a thread that is not a worker go to a shared queue protected by a mutex.
+   * A worker that finds no task for a few rounds sleeps on an [event_count](@ref algol::ds::event_count):
+   * an idle pool does not use the processor and a spawn pays a fence and a load when no worker sleeps.
+   * A thread that syncs a task group sleeps on the same event count, it is woken by a spawn, since it runs
+   * the tasks it finds, and by the completion of the last task of a group.
+   * \invariant Every task spawned is run exactly once
+   */
+  class task_scheduler {
+  public:
+    using size_type = std::size_t;
+
+    /**
+     * \brief Start the workers
+     * \precondition None
+     * \postcondition The workers wait for tasks
+     * \complexity O(W)
+     * \throws std::system_error if a thread cannot be started, the workers started are stopped
+     * \param workers The number of worker threads, at least one
+     */
+    explicit task_scheduler (size_type workers = std::max(std::thread::hardware_concurrency(), 1u))
+    {
+      workers = std::max(workers, size_type{1});
+      workers_.reserve(workers);
+      for (size_type i = 0; i < workers; ++i)
+        workers_.push_back(std::make_unique<worker>());
+      threads_.reserve(workers);
+      try {
+        for (size_type i = 0; i < workers; ++i)
+          threads_.emplace_back([this, i] { run_worker_(i); });
+      }
+      catch (...) {
+        stop_();
+        throw;
+      }
+    }
+
+    // the workers refer to the scheduler, it cannot be copied nor moved
+    task_scheduler (task_scheduler const&) = delete;
+    task_scheduler& operator= (task_scheduler const&) = delete;
+
+    /**
+     * \brief Stop and join the workers
+     * \precondition Every task group of the scheduler has been synced
+     * \complexity O(W)
+     */
+    ~task_scheduler ()
+    {
+      stop_();
+    }
+
+    /**
+     * \brief The number of worker threads
+     * \precondition None
+     * \complexity O(1)
+     * \return The number of workers
+     */
+    size_type workers () const noexcept
+    {
+      return workers_.size();
+    }
+
+  private:
+    friend class task_group;
+
+    // rounds of stealing before sleeping, a task spawned soon after is taken without a wake up
+    static constexpr auto spin_rounds = 64;
+
+    struct task {
+      explicit task (task_group* group) noexcept : group_ {group}
+      {}
+
+      virtual ~task () = default;
+
+      virtual void run () = 0;
+
+      task_group* group_;
+    };
+
+    template <typename F>
+    struct function_task final : task {
+      function_task (task_group* group, F&& f) : task {group}, f_ {std::move(f)}
+      {}
+
+      function_task (task_group* group, F const& f) : task {group}, f_ {f}
+      {}
+
+      void run () override
+      {
+        f_();
+      }
+
+      F f_;
+    };
+
+    struct alignas(ds::cache_line_size) worker {
+      ds::work_stealing_deque<task*> deque_;
+    };
+
+    // the worker the thread runs, nullptr for the threads that are not workers
+    struct thread_context {
+      task_scheduler* scheduler_;
+      worker* worker_;
+      std::uint64_t seed_;
+    };
+
+    static thread_context& context_ () noexcept
+    {
+      static std::atomic<std::uint64_t> seeds {0x9e3779b97f4a7c15u};
+      thread_local thread_context context {nullptr, nullptr,
+                                           seeds.fetch_add(0x9e3779b97f4a7c15u, std::memory_order_relaxed)};
+      return context;
+    }
+
+    // the worker of the calling thread if it is a worker of this scheduler
+    worker* current_worker_ () const noexcept
+    {
+      auto& context = context_();
+      return context.scheduler_ == this ? context.worker_ : nullptr;
+    }
+
+    void submit_ (task* t)
+    {
+      if (auto w = current_worker_())
+        w->deque_.push(t);
+      else {
+        std::lock_guard<std::mutex> lock {injected_mutex_};
+        injected_.push_back(t);
+        injected_count_.fetch_add(1, std::memory_order_release);
+      }
+      idle_.notify_one();
+    }
+
+    // a task from the deque of the calling worker, the shared queue or the deque of another worker
+    task* find_task_ ()
+    {
+      auto self = current_worker_();
+      if (self != nullptr)
+        if (auto t = self->deque_.try_pop())
+          return *t;
+      if (injected_count_.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock {injected_mutex_};
+        if (!injected_.empty()) {
+          auto t = injected_.front();
+          injected_.pop_front();
+          injected_count_.fetch_sub(1, std::memory_order_relaxed);
+          return t;
+        }
+      }
+      return steal_(self);
+    }
+
+    // every other worker is tried once starting from a random one
+    task* steal_ (worker* self) noexcept
+    {
+      auto& seed = context_().seed_;
+      // xorshift64
+      seed ^= seed << 13;
+      seed ^= seed >> 7;
+      seed ^= seed << 17;
+      auto n = workers_.size();
+      auto start = static_cast<size_type>(seed % n);
+      for (size_type i = 0; i < n; ++i) {
+        auto& victim = *workers_[(start + i) % n];
+        if (&victim == self)
+          continue;
+        if (auto t = victim.deque_.try_steal())
+          return *t;
+      }
+      return nullptr;
+    }
+
+    bool has_work_ () const noexcept
+    {
+      if (injected_count_.load(std::memory_order_acquire) > 0)
+        return true;
+      return std::any_of(std::begin(workers_), std::end(workers_), [] (auto const& w) {
+        return !w->deque_.empty();
+      });
+    }
+
+    inline void execute_ (task* t) noexcept;
+
+    void run_worker_ (size_type index)
+    {
+      auto& context = context_();
+      context.scheduler_ = this;
+      context.worker_ = workers_[index].get();
+      // loop invariant: the tasks taken by this worker have been run
+      while (true) {
+        auto t = find_task_();
+        for (auto round = 0; t == nullptr && round < spin_rounds; ++round) {
+          std::this_thread::yield();
+          t = find_task_();
+        }
+        if (t != nullptr) {
+          execute_(t);
+          continue;
+        }
+        auto key = idle_.prepare_wait();
+        if (stopping_.load(std::memory_order_acquire)) {
+          idle_.cancel_wait();
+          break;
+        }
+        if (has_work_()) {
+          idle_.cancel_wait();
+          continue;
+        }
+        idle_.wait(key);
+      }
+      context.scheduler_ = nullptr;
+      context.worker_ = nullptr;
+    }
+
+    void stop_ () noexcept
+    {
+      stopping_.store(true, std::memory_order_release);
+      idle_.notify_all();
+      for (auto& thread : threads_)
+        thread.join();
+      threads_.clear();
+    }
+
+    std::vector<std::unique_ptr<worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex injected_mutex_;
+    std::deque<task*> injected_;
+    alignas(ds::cache_line_size) std::atomic<size_type> injected_count_ {0};
+    std::atomic<bool> stopping_ {false};
+    ds::event_count idle_;
+  };
+
+  /**
+   * \brief Set of tasks spawned on a scheduler and waited together, the fork and join of a computation
+   * \details A thread that syncs a group runs the tasks it finds while the tasks of the group are running,
+   * so a worker that waits for the tasks it spawned keeps working and the nested groups do not deadlock.
+   * The first exception thrown by a task is rethrown by sync, the other tasks of the group still run.
+   * \invariant The tasks spawned and not yet completed are counted by the group
+   */
+  class task_group {
+  public:
+    /**
+     * \brief Construct a group with no task
+     * \precondition None
+     * \postcondition The group has no task
+     * \complexity O(1)
+     * \param scheduler The scheduler that runs the tasks
+     */
+    explicit task_group (task_scheduler& scheduler) noexcept : scheduler_ {scheduler}
+    {}
+
+    // the tasks refer to the group, it cannot be copied nor moved
+    task_group (task_group const&) = delete;
+    task_group& operator= (task_group const&) = delete;
+
+    /**
+     * \brief Destructor
+     * \details The tasks still running are waited, their exceptions are discarded
+     * \complexity O(1) if the group has been synced
+     */
+    ~task_group ()
+    {
+      wait_();
+    }
+
+    /**
+     * \brief Spawn a task that runs f()
+     * \precondition None
+     * \postcondition A worker will run f
+     * \complexity O(1) amortized
+     * \throws std::bad_alloc if the task cannot be allocated
+     * \param f The invokable of the task
+     */
+    template <typename F>
+    void spawn (F&& f)
+    {
+      using task_type = task_scheduler::function_task<std::decay_t<F>>;
+      auto t = std::make_unique<task_type>(this, std::forward<F>(f));
+      pending_.fetch_add(1, std::memory_order_relaxed);
+      try {
+        scheduler_.submit_(t.get());
+      }
+      catch (...) {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+      }
+      t.release();
+    }
+
+    /**
+     * \brief Wait for the tasks of the group running other tasks meanwhile
+     * \precondition None
+     * \postcondition Every task spawned has completed
+     * \complexity O(1) if the tasks have completed
+     * \throws The first exception thrown by a task
+     */
+    void sync ()
+    {
+      wait_();
+      if (exception_ != nullptr)
+        std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+
+  private:
+    friend class task_scheduler;
+
+    // the tasks found are run, after a few rounds without tasks the thread sleeps until a spawn or a completion
+    void wait_ () noexcept
+    {
+      auto rounds = 0;
+      auto slept = false;
+      // loop invariant: the tasks taken by this thread have been run
+      while (pending_.load(std::memory_order_acquire) != 0) {
+        if (auto t = scheduler_.find_task_()) {
+          scheduler_.execute_(t);
+          rounds = 0;
+          continue;
+        }
+        if (++rounds < task_scheduler::spin_rounds) {
+          std::this_thread::yield();
+          continue;
+        }
+        auto key = scheduler_.idle_.prepare_wait();
+        if (pending_.load(std::memory_order_acquire) == 0 || scheduler_.has_work_()) {
+          scheduler_.idle_.cancel_wait();
+          continue;
+        }
+        scheduler_.idle_.wait(key);
+        slept = true;
+      }
+      // the wake up of a spawn may have been taken by this thread, it is passed to a worker
+      if (slept && scheduler_.has_work_())
+        scheduler_.idle_.notify_one();
+    }
+
+    void complete_ (std::exception_ptr exception) noexcept
+    {
+      if (exception != nullptr) {
+        std::lock_guard<std::mutex> lock {exception_mutex_};
+        if (exception_ == nullptr)
+          exception_ = std::move(exception);
+      }
+      // after the decrement the group can be destroyed by the syncing thread, the scheduler outlives it
+      auto& scheduler = scheduler_;
+      if (pending_.fetch_sub(1, std::memory_order_release) == 1)
+        scheduler.idle_.notify_all();
+    }
+
+    task_scheduler& scheduler_;
+    std::atomic<std::size_t> pending_ {0};
+    std::mutex exception_mutex_;
+    std::exception_ptr exception_;
+  };
+
+  void task_scheduler::execute_ (task* t) noexcept
+  {
+    auto group = t->group_;
+    std::exception_ptr exception;
+    try {
+      t->run();
+    }
+    catch (...) {
+      exception = std::current_exception();
+    }
+    delete t;
+    group->complete_(std::move(exception));
+  }
+}
+
+#endif //ALGOL_PARALLEL_TASK_SCHEDULER_HPP
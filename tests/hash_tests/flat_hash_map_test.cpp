@@ -0,0 +1,251 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <memory_resource>
+
+#include "algol/ds/hash/flat_hash_map.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<int, std::uint64_t>;
+
+namespace {
+  struct counter_hash {
+    std::size_t operator() (operation_counter const& key) const noexcept
+    {
+      return ds::murmur3_hash<int>{}(key.value());
+    }
+  };
+
+  // every key has the same hash, the lookups compare all the keys
+  struct constant_hash {
+    std::size_t operator() (int) const noexcept
+    {
+      return 42;
+    }
+  };
+}
+
+TEST(flat_hash_map_test, operations)
+{
+  ds::flat_hash_map<std::string, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.capacity(), 0u);
+  EXPECT_EQ(map.find("one"), map.end());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_THROW(map.at("one"), ds::key_not_found_error);
+
+  EXPECT_TRUE(map.insert({"one", 1}).second);
+  EXPECT_FALSE(map.insert({"one", 10}).second);
+  EXPECT_EQ(map.at("one"), 1);
+  map["two"] = 2;
+  EXPECT_TRUE(map.emplace("three", 3).second);
+  EXPECT_FALSE(map.try_emplace("three", 30).second);
+  EXPECT_FALSE(map.insert_or_assign("three", 33).second);
+  EXPECT_TRUE(map.insert_or_assign("four", 4).second);
+  EXPECT_EQ(map.size(), 4u);
+  EXPECT_EQ(map["three"], 33);
+  EXPECT_TRUE(map.contains("four"));
+  EXPECT_EQ(map.count("five"), 0u);
+  EXPECT_EQ(map.find("two")->second, 2);
+
+  EXPECT_EQ(map.erase("two"), 1u);
+  EXPECT_EQ(map.erase("two"), 0u);
+  EXPECT_FALSE(map.contains("two"));
+  EXPECT_EQ(map.size(), 3u);
+
+  auto const& const_map = map;
+  EXPECT_EQ(const_map.at("one"), 1);
+  EXPECT_THROW(const_map.at("two"), ds::key_not_found_error);
+  auto sum = 0;
+  for (auto const& item : const_map)
+    sum += item.second;
+  EXPECT_EQ(sum, 38);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_GT(map.capacity(), 0u);
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(flat_hash_map_test, erase_while_iterating)
+{
+  ds::flat_hash_map<int, int> map;
+  for (auto i = 0; i < 1000; ++i)
+    map[i] = i * i;
+  // loop invariant: the odd keys before it are removed
+  for (auto it = map.begin(); it != map.end();)
+    it = it->first % 2 == 1 ? map.erase(it) : std::next(it);
+  EXPECT_EQ(map.size(), 500u);
+  for (auto i = 0; i < 1000; ++i)
+    EXPECT_EQ(map.contains(i), i % 2 == 0);
+}
+
+TEST(flat_hash_map_test, same_as_unordered_map)
+{
+  // random inserts and erases on small and growing tables
+  std::mt19937 generator {1234};
+  for (auto range : {4, 30, 1000, 100000}) {
+    std::uniform_int_distribution<int> keys {0, range};
+    ds::flat_hash_map<int, int> map;
+    std::unordered_map<int, int> expected;
+    for (auto i = 0; i < 200000; ++i) {
+      auto key = keys(generator);
+      switch (generator() % 3) {
+        case 0:
+          EXPECT_EQ(map.insert({key, i}).second, expected.insert({key, i}).second);
+          break;
+        case 1:
+          EXPECT_EQ(map.erase(key), expected.erase(key));
+          break;
+        default:
+          EXPECT_EQ(map.contains(key), expected.count(key) == 1);
+      }
+    }
+    ASSERT_EQ(map.size(), expected.size());
+    for (auto const& item : map)
+      EXPECT_EQ(expected.at(item.first), item.second);
+    EXPECT_LE(map.load_factor(), map.max_load_factor());
+  }
+}
+
+TEST(flat_hash_map_test, deletion_without_tombstones)
+{
+  // an erase in a sparse table leaves the slot empty, the table does not grow or rehash
+  ds::flat_hash_map<int, int> map;
+  map.reserve(100);
+  auto capacity = map.capacity();
+  for (auto i = 0; i < 10; ++i)
+    map[i] = i;
+  for (auto i = 10; i < 100000; ++i) {
+    map[i] = i;
+    map.erase(i - 10);
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(map.size(), 10u);
+
+  // with one probe sequence the erased slots become tombstones, the rehash at the same capacity drops them
+  ds::flat_hash_map<int, int, constant_hash> collisions;
+  for (auto i = 0; i < 100; ++i)
+    collisions[i] = i;
+  capacity = collisions.capacity();
+  for (auto i = 100; i < 10000; ++i) {
+    collisions[i] = i;
+    collisions.erase(i - 100);
+  }
+  EXPECT_EQ(collisions.capacity(), capacity);
+  EXPECT_EQ(collisions.size(), 100u);
+  for (auto i = 9900; i < 10000; ++i)
+    EXPECT_EQ(collisions.at(i), i);
+}
+
+TEST(flat_hash_map_test, key_comparisons)
+{
+  // with a good hash a lookup compares about one key, the control bytes filter the others
+  ds::flat_hash_map<operation_counter, int, counter_hash> map;
+  for (auto i = 0; i < 10000; ++i)
+    map.emplace(i, i);
+  operation_counter::reset();
+  for (auto i = 0; i < 10000; ++i)
+    EXPECT_TRUE(map.contains(i));
+  EXPECT_LT(operation_counter::equal_comparisons(), 10100u);
+  // a missing key is compared only with the keys whose 7 bits match, about 1 in 128 of a group
+  operation_counter::reset();
+  for (auto i = 10000; i < 20000; ++i)
+    EXPECT_FALSE(map.contains(i));
+  EXPECT_LT(operation_counter::equal_comparisons(), 1500u);
+}
+
+TEST(flat_hash_map_test, move_only_and_rehash)
+{
+  ds::flat_hash_map<std::string, std::unique_ptr<int>> map;
+  for (auto i = 0; i < 1000; ++i)
+    map.try_emplace(std::to_string(i), std::make_unique<int>(i));
+  map.rehash(5000);
+  EXPECT_GE(map.capacity(), 5000u);
+  for (auto i = 0; i < 1000; ++i)
+    EXPECT_EQ(*map.at(std::to_string(i)), i);
+  auto key = std::string{"moved"};
+  map.try_emplace(std::move(key), std::make_unique<int>(-1));
+  EXPECT_EQ(*map["moved"], -1);
+
+  map.clear();
+  map.rehash(0);
+  EXPECT_EQ(map.capacity(), 0u);
+}
+
+TEST(flat_hash_map_test, copy_move_swap)
+{
+  ds::flat_hash_map<int, std::string> map {{1, "one"}, {2, "two"}, {3, "three"}, {1, "uno"}};
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ(map.at(1), "one");
+  auto copy = map;
+  EXPECT_EQ(copy, map);
+  copy[4] = "four";
+  EXPECT_NE(copy, map);
+  copy.erase(4);
+  copy[3] = "tre";
+  EXPECT_NE(copy, map);
+
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.at(3), "tre");
+  swap(moved, map);
+  EXPECT_EQ(map.at(3), "tre");
+  EXPECT_EQ(moved.at(3), "three");
+  map = moved;
+  EXPECT_EQ(map, moved);
+  map = ds::flat_hash_map<int, std::string>{};
+  EXPECT_TRUE(map.empty());
+
+  std::vector<std::pair<int, std::string>> items {{5, "five"}, {6, "six"}};
+  ds::flat_hash_map<int, std::string> from_range {items.begin(), items.end()};
+  EXPECT_EQ(from_range.size(), 2u);
+  EXPECT_EQ(from_range.to_vector().size(), 2u);
+}
+
+TEST(flat_hash_map_test, pmr)
+{
+  std::pmr::monotonic_buffer_resource arena;
+  ds::pmr::flat_hash_map<int, int> map {&arena};
+  for (auto i = 0; i < 1000; ++i)
+    map[i] = -i;
+  EXPECT_EQ(map.size(), 1000u);
+  EXPECT_EQ(map.get_allocator().resource(), &arena);
+  ds::pmr::flat_hash_map<int, int> other {&arena};
+  other.swap(map);
+  EXPECT_EQ(other.at(999), -999);
+}
+
+TEST(flat_hash_map_test, pmr_assignment)
+{
+  // the polymorphic allocator does not propagate, the items are copied or moved into the slots of this map
+  std::pmr::monotonic_buffer_resource arena;
+  ds::pmr::flat_hash_map<int, std::pmr::string> map {&arena};
+  ds::pmr::flat_hash_map<int, std::pmr::string> other;
+  for (auto i = 0; i < 100; ++i)
+    other[i] = std::pmr::string(static_cast<std::size_t>(i), 'x');
+
+  map = other;
+  EXPECT_EQ(map, other);
+  EXPECT_EQ(map.get_allocator().resource(), &arena);
+  EXPECT_EQ(map.at(99).get_allocator().resource(), &arena);
+
+  map.try_emplace(100, 1, 'y');
+  other = std::move(map);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.get_allocator().resource(), &arena);
+  EXPECT_EQ(other.size(), 101u);
+  EXPECT_EQ(other.at(100), std::pmr::string(1, 'y'));
+  EXPECT_EQ(other.get_allocator().resource(), std::pmr::get_default_resource());
+  EXPECT_EQ(other.at(99).get_allocator().resource(), std::pmr::get_default_resource());
+
+  map = std::move(other);
+  EXPECT_EQ(map.size(), 101u);
+  EXPECT_EQ(map.at(50), std::pmr::string(50, 'x'));
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "algol/ds/hash/flat_hash_set.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+TEST(flat_hash_set_test, operations)
+{
+  ds::flat_hash_set<std::string> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.contains("a"));
+  EXPECT_TRUE(set.insert("a").second);
+  EXPECT_FALSE(set.insert("a").second);
+  EXPECT_TRUE(set.emplace(3, 'b').second);
+  EXPECT_TRUE(set.contains("bbb"));
+  EXPECT_EQ(*set.find("a"), "a");
+  EXPECT_EQ(set.size(), 2u);
+  EXPECT_EQ(set.erase("a"), 1u);
+  EXPECT_EQ(set.erase("a"), 0u);
+  EXPECT_EQ(set.size(), 1u);
+  EXPECT_EQ(set.count("bbb"), 1u);
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(flat_hash_set_test, iteration)
+{
+  ds::flat_hash_set<int> set;
+  for (auto i = 0; i < 5000; ++i)
+    set.insert(i * 7);
+  auto items = set.to_vector();
+  std::sort(items.begin(), items.end());
+  ASSERT_EQ(items.size(), 5000u);
+  for (auto i = 0; i < 5000; ++i)
+    EXPECT_EQ(items[static_cast<std::size_t>(i)], i * 7);
+
+  // loop invariant: the keys before it that are multiples of 3 are removed
+  for (auto it = set.cbegin(); it != set.cend();)
+    it = *it % 3 == 0 ? set.erase(it) : std::next(it);
+  for (auto i = 0; i < 5000; ++i)
+    EXPECT_EQ(set.contains(i * 7), (i * 7) % 3 != 0);
+}
+
+TEST(flat_hash_set_test, copy_move_swap)
+{
+  ds::flat_hash_set<int> set {1, 2, 3, 2, 1};
+  EXPECT_EQ(set.size(), 3u);
+  auto copy = set;
+  EXPECT_EQ(copy, set);
+  copy.erase(2);
+  copy.insert(4);
+  EXPECT_NE(copy, set);
+  ds::flat_hash_set<int> other {std::move(copy)};
+  EXPECT_TRUE(copy.empty());
+  swap(other, set);
+  EXPECT_TRUE(set.contains(4));
+  EXPECT_FALSE(other.contains(4));
+  set = other;
+  EXPECT_EQ(set, other);
+
+  std::vector<int> items {1, 2, 3, 4, 5, 5};
+  ds::flat_hash_set<int> from_range {items.begin(), items.end(), 100};
+  EXPECT_EQ(from_range.size(), 5u);
+  EXPECT_GE(from_range.capacity(), 100u);
+}
+
+TEST(flat_hash_set_test, pmr)
+{
+  std::pmr::monotonic_buffer_resource arena;
+  ds::pmr::flat_hash_set<std::pmr::string> set {&arena};
+  for (auto i = 0; i < 100; ++i)
+    set.insert(std::pmr::string(static_cast<std::size_t>(i), 'x'));
+  EXPECT_EQ(set.size(), 100u);
+  EXPECT_TRUE(set.contains(std::pmr::string(50, 'x')));
+}
@@ -0,0 +1,58 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "cx_murmur3.h"
+#include "algol/ds/hash/murmur3.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+TEST(murmur3_test, reference_vectors)
+{
+  EXPECT_EQ(ds::murmur3_32("", 0, 0), 0u);
+  EXPECT_EQ(ds::murmur3_32("", 0, 1), 0x514e28b7u);
+  EXPECT_EQ(ds::murmur3_32("", 0, 0xffffffff), 0x81f16f39u);
+  EXPECT_EQ(ds::murmur3_32("\0\0\0\0", 4, 0), 0x2362f9deu);
+  EXPECT_EQ(ds::murmur3_32("aaaa", 4, 0x9747b28c), 0x5a97808au);
+  EXPECT_EQ(ds::murmur3_32("abc", 3, 0), 0xb3dd93fau);
+  EXPECT_EQ(ds::murmur3_32("Hello, world!", 13, 0x9747b28c), 0x24884cbau);
+  EXPECT_EQ(ds::murmur3_32("The quick brown fox jumps over the lazy dog", 43, 0x9747b28c), 0x2fa826cdu);
+}
+
+TEST(murmur3_test, same_as_constexpr)
+{
+  // the hashes of lib/constexpr computed at compile time
+  constexpr auto empty = cx::murmur3_32("", 0);
+  constexpr auto tail = cx::murmur3_32("algol", 42);
+  constexpr auto blocks = cx::murmur3_32("flat hash map", 0x9747b28c);
+  EXPECT_EQ(ds::murmur3_32("", 0, 0), empty);
+  EXPECT_EQ(ds::murmur3_32("algol", 5, 42), tail);
+  EXPECT_EQ(ds::murmur3_32("flat hash map", 13, 0x9747b28c), blocks);
+}
+
+TEST(murmur3_test, hash)
+{
+  ds::murmur3_hash<std::string> string_hash;
+  ds::murmur3_hash<std::string_view> view_hash;
+  EXPECT_EQ(string_hash("algol"), view_hash("algol"));
+  EXPECT_NE(string_hash("algol"), string_hash("algom"));
+
+  // consecutive integers differ in the low 7 bits and in the high bits
+  ds::murmur3_hash<int> int_hash;
+  auto low = 0, high = 0;
+  for (auto i = 0; i < 64; ++i) {
+    low += (int_hash(i) & 0x7f) == (int_hash(i + 1) & 0x7f) ? 1 : 0;
+    high += (int_hash(i) >> 57) == (int_hash(i + 1) >> 57) ? 1 : 0;
+  }
+  EXPECT_LT(low, 4);
+  EXPECT_LT(high, 4);
+
+  ds::murmur3_hash<double> double_hash;
+  EXPECT_EQ(double_hash(0.0), double_hash(-0.0));
+  EXPECT_NE(double_hash(1.0), double_hash(2.0));
+
+  enum class color { red, green };
+  ds::murmur3_hash<color> color_hash;
+  EXPECT_NE(color_hash(color::red), color_hash(color::green));
+}
@@ -0,0 +1,302 @@
+#include <list>
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <numeric>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include "algol/ds/list/list.hpp"
+#include "algol/algorithms/sort/bubble_sort.hpp"
+#include "algol/algorithms/sort/selection_sort.hpp"
+#include "algol/algorithms/sort/insertion_sort.hpp"
+#include "algol/algorithms/sort/shell_sort.hpp"
+#include "algol/algorithms/shuffle/fisher_yates.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+namespace sort = algol::algorithms::sort;
+
+// small chunks to exercise the growth and the free list
+using small_list = ds::list<int, 4>;
+
+template <typename List>
+std::vector<typename List::value_type> items (List const& list)
+{
+  return {std::begin(list), std::end(list)};
+}
+
+static_assert(std::is_same_v<std::iterator_traits<small_list::iterator>::iterator_category,
+                             std::bidirectional_iterator_tag>);
+static_assert(std::is_convertible_v<small_list::iterator, small_list::const_iterator>);
+static_assert(!std::is_convertible_v<small_list::const_iterator, small_list::iterator>);
+
+TEST(list, axioms)
+{
+  small_list list;
+  // new list is empty
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.size(), 0u);
+  EXPECT_EQ(list.capacity(), 0u);
+  EXPECT_EQ(list.begin(), list.end());
+  // new list throws list_empty_error on front, back, pop_front and pop_back
+  EXPECT_THROW(list.front(), ds::list_empty_error);
+  EXPECT_THROW(list.back(), ds::list_empty_error);
+  EXPECT_THROW(list.pop_front(), ds::list_empty_error);
+  EXPECT_THROW(list.pop_back(), ds::list_error);
+  list.push_back(2);
+  list.push_front(1);
+  list.emplace_back(3);
+  EXPECT_EQ(list.size(), 3u);
+  EXPECT_EQ(list.front(), 1);
+  EXPECT_EQ(list.back(), 3);
+  EXPECT_EQ(items(list), (std::vector<int>{1, 2, 3}));
+  list.pop_front();
+  list.pop_back();
+  EXPECT_EQ(items(list), (std::vector<int>{2}));
+  list.clear();
+  EXPECT_TRUE(list.empty());
+  // the chunks are kept
+  EXPECT_EQ(list.capacity(), 4u);
+}
+
+TEST(list, iterators)
+{
+  small_list list {1, 2, 3, 4, 5, 6};
+  auto it = std::next(list.begin(), 2);
+  EXPECT_EQ(*it, 3);
+  // the end iterator is decrementable
+  EXPECT_EQ(*std::prev(list.end()), 6);
+  EXPECT_EQ(std::distance(list.begin(), list.end()), 6);
+  EXPECT_EQ((std::vector<int>{list.rbegin(), list.rend()}), (std::vector<int>{6, 5, 4, 3, 2, 1}));
+  small_list::const_iterator cit = it;
+  EXPECT_EQ(cit, it);
+  *it = 30;
+  EXPECT_EQ(*cit, 30);
+  small_list const& clist = list;
+  EXPECT_EQ(*clist.begin(), 1);
+  EXPECT_EQ(std::count_if(clist.begin(), clist.end(), [] (int i) { return i > 4; }), 3);
+}
+
+TEST(list, insert_erase)
+{
+  small_list list {1, 5};
+  auto it = list.insert(std::next(list.begin()), 3);
+  EXPECT_EQ(*it, 3);
+  list.insert(it, 2);
+  list.emplace(std::next(it), 4);
+  EXPECT_EQ(items(list), (std::vector<int>{1, 2, 3, 4, 5}));
+  std::vector<int> values {6, 7, 8};
+  auto first = list.insert(list.end(), std::begin(values), std::end(values));
+  EXPECT_EQ(*first, 6);
+  EXPECT_EQ(list.insert(list.end(), std::begin(values), std::begin(values)), list.end());
+  // erase returns the iterator to the next item, the other iterators stay valid
+  auto next = list.erase(it);
+  EXPECT_EQ(*next, 4);
+  EXPECT_EQ(*first, 6);
+  EXPECT_EQ(list.erase(first, list.end()), list.end());
+  EXPECT_EQ(items(list), (std::vector<int>{1, 2, 4, 5}));
+  EXPECT_EQ(list.size(), 4u);
+}
+
+TEST(list, free_slots_are_reused)
+{
+  small_list list;
+  for (int i = 0; i < 8; ++i)
+    list.push_back(i);
+  EXPECT_EQ(list.capacity(), 8u);
+  // erase the even items and insert as many items, no chunk is allocated
+  for (auto it = list.begin(); it != list.end(); ++it)
+    it = list.erase(it);
+  EXPECT_EQ(items(list), (std::vector<int>{1, 3, 5, 7}));
+  for (int i = 0; i < 4; ++i)
+    list.push_front(-i);
+  EXPECT_EQ(list.capacity(), 8u);
+  EXPECT_EQ(items(list), (std::vector<int>{-3, -2, -1, 0, 1, 3, 5, 7}));
+  list.push_back(9);
+  EXPECT_EQ(list.capacity(), 12u);
+  list.reserve(20);
+  EXPECT_EQ(list.capacity(), 20u);
+  EXPECT_THROW(list.reserve(small_list::max_size() + 1), std::length_error);
+}
+
+TEST(list, splice)
+{
+  small_list list {1, 2, 3, 4, 5, 6};
+  auto three = std::next(list.begin(), 2);
+  auto five = std::next(list.begin(), 4);
+  // move [3, 5) to the front
+  list.splice(list.begin(), three, five);
+  EXPECT_EQ(items(list), (std::vector<int>{3, 4, 1, 2, 5, 6}));
+  // the iterators follow the items
+  EXPECT_EQ(*three, 3);
+  EXPECT_EQ(three, list.begin());
+  // move [3, end) to the end
+  list.splice(list.end(), three, list.end());
+  EXPECT_EQ(items(list), (std::vector<int>{3, 4, 1, 2, 5, 6}));
+  // move [1, end) before 3
+  list.splice(three, std::next(list.begin(), 2), list.end());
+  EXPECT_EQ(items(list), (std::vector<int>{1, 2, 5, 6, 3, 4}));
+  list.splice(list.end(), list.begin());
+  list.splice(five, five);
+  EXPECT_EQ(items(list), (std::vector<int>{2, 5, 6, 3, 4, 1}));
+  EXPECT_EQ(list.front(), 2);
+  EXPECT_EQ(list.back(), 1);
+  EXPECT_EQ(list.size(), 6u);
+
+  small_list other {7, 8};
+  list.splice(five, other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(items(list), (std::vector<int>{2, 7, 8, 5, 6, 3, 4, 1}));
+}
+
+TEST(list, reverse_sort_compact)
+{
+  std::vector<int> values(100);
+  std::iota(std::begin(values), std::end(values), 0);
+  std::shuffle(std::begin(values), std::end(values), std::mt19937{11});
+  small_list list {std::begin(values), std::end(values)};
+  auto front = list.begin();
+  auto value = *front;
+  list.sort();
+  EXPECT_TRUE(std::is_sorted(list.begin(), list.end()));
+  // the iterators follow the items
+  EXPECT_EQ(*front, value);
+  list.reverse();
+  EXPECT_TRUE(std::is_sorted(list.begin(), list.end(), std::greater<>{}));
+  list.sort(std::less<>{});
+  for (auto it = list.begin(); it != list.end(); ++it)
+    it = list.erase(it);
+  EXPECT_EQ(list.capacity(), 100u);
+  list.compact();
+  EXPECT_EQ(list.capacity(), 52u);
+  EXPECT_EQ(list.size(), 50u);
+  EXPECT_EQ(list.front(), 1);
+  EXPECT_EQ(list.back(), 99);
+  EXPECT_TRUE(std::is_sorted(list.begin(), list.end()));
+  EXPECT_EQ(*std::prev(list.end()), 99);
+  list.push_back(100);
+  EXPECT_EQ(list.size(), 51u);
+  list.clear();
+  list.compact();
+  EXPECT_EQ(list.capacity(), 0u);
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(list, sort_algorithms)
+{
+  std::vector<int> values(64);
+  std::iota(std::begin(values), std::end(values), -32);
+  std::mt19937 gen(5);
+  small_list list {std::begin(values), std::end(values)};
+
+  algol::algorithms::shuffle::fisher_yates_shuffle(list.begin(), list.end(), gen);
+  EXPECT_TRUE(std::is_permutation(list.begin(), list.end(), std::begin(values)));
+  sort::insertion_sort(list.begin(), list.end());
+  EXPECT_EQ(items(list), values);
+
+  algol::algorithms::shuffle::fisher_yates_shuffle(list.begin(), list.end(), gen);
+  sort::selection_sort(list.begin(), list.end());
+  EXPECT_EQ(items(list), values);
+
+  algol::algorithms::shuffle::fisher_yates_shuffle(list.begin(), list.end(), gen);
+  sort::bubble_sort(list.begin(), list.end());
+  EXPECT_EQ(items(list), values);
+
+  algol::algorithms::shuffle::fisher_yates_shuffle(list.begin(), list.end(), gen);
+  sort::comb_sort(list.begin(), list.end());
+  EXPECT_EQ(items(list), values);
+
+  algol::algorithms::shuffle::fisher_yates_shuffle(list.begin(), list.end(), gen);
+  sort::shell_sort(list.begin(), list.end(), std::greater<>{});
+  EXPECT_TRUE(std::is_sorted(list.begin(), list.end(), std::greater<>{}));
+}
+
+TEST(list, copy_move_swap)
+{
+  ds::list<std::string, 2> list {"a", "b", "c"};
+  auto copy = list;
+  EXPECT_EQ(copy, list);
+  copy.push_back("d");
+  EXPECT_NE(copy, list);
+  EXPECT_LT(list, copy);
+  EXPECT_GT(copy, list);
+  EXPECT_LE(list, list);
+  EXPECT_GE(copy, list);
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 4u);
+  copy = moved;
+  EXPECT_EQ(copy, moved);
+  list = std::move(moved);
+  EXPECT_EQ(list, copy);
+  EXPECT_TRUE(moved.empty());
+  moved.push_back("e");
+  swap(list, moved);
+  EXPECT_EQ(items(list), (std::vector<std::string>{"e"}));
+  EXPECT_EQ(moved, copy);
+  list = list;
+  EXPECT_EQ(list.front(), "e");
+}
+
+struct throwing_item {
+  static int countdown;
+
+  explicit throwing_item (int v) : value {v}
+  {}
+
+  throwing_item (throwing_item const& rhs) : value {rhs.value}
+  {
+    if (--countdown == 0)
+      throw std::runtime_error{"copy"};
+  }
+
+  int value;
+};
+
+int throwing_item::countdown = 0;
+
+TEST(list, exception_safety)
+{
+  ds::list<throwing_item, 2> list;
+  for (int i = 0; i < 5; ++i)
+    list.emplace_back(i);
+  std::vector<throwing_item> values {throwing_item{5}, throwing_item{6}, throwing_item{7}};
+  // the third copy throws, the items inserted are erased
+  throwing_item::countdown = 3;
+  EXPECT_THROW(list.insert(list.end(), std::begin(values), std::end(values)), std::runtime_error);
+  EXPECT_EQ(list.size(), 5u);
+  // compact copies the items because the move constructor may throw, the list is unchanged
+  list.erase(list.begin());
+  throwing_item::countdown = 2;
+  EXPECT_THROW(list.compact(), std::runtime_error);
+  EXPECT_EQ(list.size(), 4u);
+  EXPECT_EQ(list.front().value, 1);
+  EXPECT_EQ(list.back().value, 4);
+  throwing_item::countdown = 0;
+  list.compact();
+  EXPECT_EQ(list.capacity(), 4u);
+  EXPECT_EQ(list.front().value, 1);
+}
+
+#if __has_include(<memory_resource>)
+TEST(list, pmr)
+{
+  std::pmr::monotonic_buffer_resource resource;
+  ds::pmr::list<int, 8> list {std::pmr::polymorphic_allocator<int>{&resource}};
+  for (int i = 0; i < 20; ++i)
+    list.push_back(i);
+  EXPECT_EQ(list.get_allocator().resource(), &resource);
+  ds::pmr::list<int, 8> copy {list, std::pmr::polymorphic_allocator<int>{&resource}};
+  EXPECT_EQ(copy, list);
+  std::pmr::monotonic_buffer_resource other_resource;
+  ds::pmr::list<int, 8> other {std::pmr::polymorphic_allocator<int>{&other_resource}};
+  // the allocators are different, the items are moved one by one
+  other = std::move(list);
+  EXPECT_EQ(other, copy);
+  EXPECT_EQ(other.get_allocator().resource(), &other_resource);
+}
+#endif
@@ -0,0 +1,171 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "algol/parallel/task_scheduler.hpp"
+#include "gtest/gtest.h"
+
+namespace parallel = algol::parallel;
+
+namespace {
+  std::uint64_t fibonacci (parallel::task_scheduler& scheduler, unsigned n)
+  {
+    if (n < 2)
+      return n;
+    std::uint64_t a = 0;
+    parallel::task_group group {scheduler};
+    group.spawn([&] { a = fibonacci(scheduler, n - 1); });
+    auto b = fibonacci(scheduler, n - 2);
+    group.sync();
+    return a + b;
+  }
+
+  // sum of [first, last) splitting the range in halves down to grain items
+  std::uint64_t sum (parallel::task_scheduler& scheduler, std::vector<std::uint64_t> const& values,
+                     std::size_t first, std::size_t last, std::size_t grain)
+  {
+    if (last - first <= grain)
+      return std::accumulate(std::begin(values) + first, std::begin(values) + last, std::uint64_t{0});
+    auto middle = first + (last - first) / 2;
+    std::uint64_t left = 0;
+    parallel::task_group group {scheduler};
+    group.spawn([&] { left = sum(scheduler, values, first, middle, grain); });
+    auto right = sum(scheduler, values, middle, last, grain);
+    group.sync();
+    return left + right;
+  }
+}
+
+TEST(task_scheduler_test, workers)
+{
+  parallel::task_scheduler one {1};
+  EXPECT_EQ(one.workers(), 1u);
+  parallel::task_scheduler none {0};
+  EXPECT_EQ(none.workers(), 1u);
+  parallel::task_scheduler four {4};
+  EXPECT_EQ(four.workers(), 4u);
+}
+
+TEST(task_scheduler_test, spawn_sync)
+{
+  parallel::task_scheduler scheduler {4};
+  std::atomic<int> count {0};
+  parallel::task_group group {scheduler};
+  for (auto i = 0; i < 1000; ++i)
+    group.spawn([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+  group.sync();
+  EXPECT_EQ(count.load(), 1000);
+  // a group can be reused after sync
+  group.spawn([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+  group.sync();
+  EXPECT_EQ(count.load(), 1001);
+}
+
+TEST(task_scheduler_test, nested_fork_join)
+{
+  parallel::task_scheduler scheduler {4};
+  EXPECT_EQ(fibonacci(scheduler, 20), 6765u);
+  std::vector<std::uint64_t> values(100000);
+  std::iota(std::begin(values), std::end(values), std::uint64_t{1});
+  EXPECT_EQ(sum(scheduler, values, 0, values.size(), 1000), std::uint64_t{100000} * 100001 / 2);
+  // the whole computation runs on a worker
+  std::uint64_t result = 0;
+  parallel::task_group group {scheduler};
+  group.spawn([&] { result = fibonacci(scheduler, 18); });
+  group.sync();
+  EXPECT_EQ(result, 2584u);
+}
+
+TEST(task_scheduler_test, single_worker)
+{
+  // a worker that syncs runs the tasks of its own deque
+  parallel::task_scheduler scheduler {1};
+  std::uint64_t result = 0;
+  parallel::task_group group {scheduler};
+  group.spawn([&] { result = fibonacci(scheduler, 15); });
+  group.sync();
+  EXPECT_EQ(result, 610u);
+}
+
+TEST(task_scheduler_test, exception)
+{
+  parallel::task_scheduler scheduler {2};
+  std::atomic<int> count {0};
+  parallel::task_group group {scheduler};
+  for (auto i = 0; i < 10; ++i)
+    group.spawn([&count, i] {
+      count.fetch_add(1, std::memory_order_relaxed);
+      if (i % 5 == 0)
+        throw std::runtime_error{"task"};
+    });
+  EXPECT_THROW(group.sync(), std::runtime_error);
+  // the other tasks have run and the exception is rethrown once
+  EXPECT_EQ(count.load(), 10);
+  EXPECT_NO_THROW(group.sync());
+}
+
+TEST(task_scheduler_test, many_spawning_threads)
+{
+  parallel::task_scheduler scheduler {2};
+  std::atomic<int> count {0};
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < 4; ++t)
+    threads.emplace_back([&] {
+      parallel::task_group group {scheduler};
+      for (auto i = 0; i < 500; ++i)
+        group.spawn([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+      group.sync();
+    });
+  for (auto& thread : threads)
+    thread.join();
+  EXPECT_EQ(count.load(), 2000);
+}
+
+TEST(task_scheduler_test, idle_workers_sleep)
+{
+  parallel::task_scheduler scheduler {4};
+  {
+    parallel::task_group group {scheduler};
+    group.spawn([] {});
+    group.sync();
+  }
+  // the workers stop spinning and sleep, the process uses a small fraction of the processor time
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  auto start = std::clock();
+  std::this_thread::sleep_for(std::chrono::milliseconds{200});
+  auto used = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+  EXPECT_LT(used, 0.05);
+  // the sleeping workers wake up for new tasks
+  std::atomic<int> count {0};
+  parallel::task_group group {scheduler};
+  for (auto i = 0; i < 100; ++i)
+    group.spawn([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+  group.sync();
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST(task_scheduler_test, sync_sleeps)
+{
+  parallel::task_scheduler scheduler {2};
+  std::atomic<bool> started {false};
+  std::atomic<bool> done {false};
+  parallel::task_group group {scheduler};
+  group.spawn([&started, &done] {
+    started.store(true, std::memory_order_relaxed);
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+    done.store(true, std::memory_order_relaxed);
+  });
+  while (!started.load(std::memory_order_relaxed))
+    std::this_thread::yield();
+  // the task runs on a worker, the thread that syncs finds no task to run and sleeps until it completes
+  auto start = std::clock();
+  group.sync();
+  auto used = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+  EXPECT_TRUE(done.load(std::memory_order_relaxed));
+  EXPECT_LT(used, 0.05);
+}
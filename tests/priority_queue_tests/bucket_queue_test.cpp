@@ -0,0 +1,125 @@
+#include <vector>
+#include <queue>
+#include <random>
+#include <limits>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "algol/ds/priority_queue/bucket_queue.hpp"
+#include "algol/ds/priority_queue/concepts.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+namespace integer = algol::integer;
+
+static_assert(algol::concepts::PriorityQueue<ds::bucket_queue<int, int>>());
+static_assert(algol::concepts::PriorityQueue<ds::bucket_queue<long, std::string>>());
+
+TEST(bucket_queue, axioms)
+{
+  ds::bucket_queue<int, char> queue {integer::integer_interval<int>{0, 10}};
+  // new queue is empty
+  EXPECT_TRUE(queue.empty());
+  // new queue throws priority_queue_empty_error on top and pop
+  EXPECT_THROW(queue.top(), ds::priority_queue_empty_error);
+  EXPECT_THROW(queue.pop(), ds::priority_queue_empty_error);
+  queue.push({5, 'a'});
+  queue.emplace(3, 'b');
+  queue.push({7, 'c'});
+  // the top is the item with the least key
+  EXPECT_EQ(queue.top(), std::make_pair(3, 'b'));
+  EXPECT_EQ(queue.size(), 3u);
+  queue.pop();
+  // a pop removes the top and slides the window
+  EXPECT_EQ(queue.last_key(), 3);
+  EXPECT_EQ(queue.max_key(), 13);
+  EXPECT_EQ(queue.top(), std::make_pair(5, 'a'));
+  EXPECT_THROW(queue.push({2, 'd'}), ds::priority_queue_key_error);
+  EXPECT_THROW(queue.push({14, 'd'}), ds::priority_queue_key_error);
+  // a key between the last key popped and the top is accepted
+  queue.push({4, 'e'});
+  queue.push({13, 'f'});
+  EXPECT_EQ(queue.top(), std::make_pair(4, 'e'));
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.last_key(), 3);
+  EXPECT_THROW((ds::bucket_queue<int, int>{integer::integer_interval<int>{1, 0}}), ds::priority_queue_key_error);
+}
+
+TEST(bucket_queue, window_wraps)
+{
+  // four buckets used circularly for keys up to 1000
+  ds::bucket_queue<int, int> queue {integer::integer_interval<int>{-2, 1}};
+  queue.push({-2, 0});
+  queue.push({1, 0});
+  std::vector<int> keys;
+  // loop invariant: the keys popped are not decreasing and the queue holds keys in [key, key + 3]
+  while (!queue.empty()) {
+    auto key = queue.top().first;
+    queue.pop();
+    keys.push_back(key);
+    if (key < 1000)
+      queue.push({key % 2 == 0 ? key + 1 : key + 3, 0});
+  }
+  EXPECT_TRUE(std::is_sorted(std::begin(keys), std::end(keys)));
+  EXPECT_EQ(keys.back(), 1002);
+}
+
+TEST(bucket_queue, matches_binary_heap)
+{
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> distribution(0, 64);
+  ds::bucket_queue<int, int> queue {integer::integer_interval<int>{std::numeric_limits<int>::min(),
+                                                                    std::numeric_limits<int>::min() + 64}};
+  std::priority_queue<int, std::vector<int>, std::greater<>> reference;
+  for (auto i = 0; i < 5000; ++i) {
+    // pushes and pops interleaved, the keys are in the window of the last key popped
+    auto key = queue.last_key() + distribution(gen);
+    queue.push({key, i});
+    reference.push(key);
+    if (i % 2 == 1) {
+      ASSERT_EQ(queue.top().first, reference.top());
+      queue.pop();
+      reference.pop();
+    }
+  }
+  EXPECT_EQ(queue.size(), reference.size());
+  while (!reference.empty()) {
+    ASSERT_EQ(queue.top().first, reference.top());
+    queue.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(bucket_queue, dijkstra)
+{
+  // the weighted graph of the adjacency lists, the weights are at most 8
+  std::vector<std::vector<std::pair<std::size_t, int>>> graph {
+      {{1, 7}, {2, 1}},
+      {{3, 1}, {4, 8}},
+      {{1, 3}, {3, 6}},
+      {{4, 3}},
+      {}};
+  ds::bucket_queue<int, std::size_t> queue {integer::integer_interval<int>{0, 8}};
+  std::vector<int> distance(graph.size(), std::numeric_limits<int>::max());
+
+  distance[0] = 0;
+  queue.push({0, 0});
+  // loop invariant: the distances of the vertices popped with their distance are the shortest ones
+  while (!queue.empty()) {
+    auto [d, u] = queue.top();
+    queue.pop();
+    if (d > distance[u])
+      continue;
+    for (auto [v, w] : graph[u]) {
+      if (d + w < distance[v]) {
+        distance[v] = d + w;
+        queue.push({d + w, v});
+      }
+    }
+  }
+  EXPECT_EQ(distance, (std::vector<int>{0, 4, 1, 5, 8}));
+}
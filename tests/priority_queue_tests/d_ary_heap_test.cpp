@@ -0,0 +1,165 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "algol/ds/priority_queue/d_ary_heap.hpp"
+#include "algol/ds/priority_queue/concepts.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+static_assert(algol::concepts::PriorityQueue<ds::binary_heap<int>>());
+static_assert(algol::concepts::PriorityQueue<ds::d_ary_heap<std::string, 4>>());
+
+class d_ary_heap_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-500, 500);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted_random = random;
+    std::sort(std::begin(sorted_random), std::end(sorted_random), std::greater<>{});
+  }
+
+  // pop every item of the heap, they come out in the order of the comparison
+  template <typename Heap>
+  static std::vector<typename Heap::value_type> drain (Heap& heap)
+  {
+    std::vector<typename Heap::value_type> items;
+    while (!heap.empty()) {
+      items.push_back(heap.top());
+      heap.pop();
+    }
+    return items;
+  }
+
+  std::vector<int> random = std::vector<int>(1000);
+  std::vector<int> sorted_random;
+};
+
+TEST_F(d_ary_heap_fixture, axioms)
+{
+  ds::binary_heap<int> heap;
+  // new heap is empty
+  EXPECT_TRUE(heap.empty());
+  EXPECT_EQ(heap.size(), 0u);
+  // new heap throws priority_queue_empty_error on top and pop
+  EXPECT_THROW(heap.top(), ds::priority_queue_empty_error);
+  EXPECT_THROW(heap.pop(), ds::priority_queue_empty_error);
+  heap.push(1);
+  // a heap with one item is not empty and the item is on top
+  EXPECT_FALSE(heap.empty());
+  EXPECT_EQ(heap.top(), 1);
+  heap.push(3);
+  heap.push(2);
+  // the top is the greatest item
+  EXPECT_EQ(heap.top(), 3);
+  EXPECT_EQ(heap.size(), 3u);
+  heap.pop();
+  // a pop removes the top
+  EXPECT_EQ(heap.top(), 2);
+  EXPECT_EQ(heap.size(), 2u);
+  heap.clear();
+  EXPECT_TRUE(heap.empty());
+  EXPECT_THROW(heap.pop(), ds::priority_queue_error);
+}
+
+TEST_F(d_ary_heap_fixture, push_pop)
+{
+  ds::binary_heap<int, std::greater<>> binary;
+  ds::d_ary_heap<int, 4, std::greater<>> quaternary;
+  ds::d_ary_heap<int, 8, std::greater<>> octonary;
+  for (auto v : random) {
+    binary.push(v);
+    quaternary.push(v);
+    octonary.emplace(v);
+  }
+  // with std::greater the items come out from the least
+  auto ascending = sorted_random;
+  std::reverse(std::begin(ascending), std::end(ascending));
+  EXPECT_EQ(drain(binary), ascending);
+  EXPECT_EQ(drain(quaternary), ascending);
+  EXPECT_EQ(drain(octonary), ascending);
+}
+
+TEST_F(d_ary_heap_fixture, heapify)
+{
+  ds::binary_heap<int> binary {std::begin(random), std::end(random)};
+  ds::d_ary_heap<int, 4> quaternary {std::vector<int>(random)};
+  ds::d_ary_heap<int, 8> octonary {std::begin(random), std::end(random)};
+  EXPECT_EQ(binary.size(), random.size());
+  EXPECT_EQ(drain(binary), sorted_random);
+  EXPECT_EQ(drain(quaternary), sorted_random);
+  EXPECT_EQ(drain(octonary), sorted_random);
+
+  ds::d_ary_heap<std::string, 3> strings {"pear", "apple", "fig", "plum"};
+  EXPECT_EQ(drain(strings), (std::vector<std::string>{"plum", "pear", "fig", "apple"}));
+}
+
+TEST_F(d_ary_heap_fixture, heapify_is_linear)
+{
+  std::vector<operation_counter> items(std::begin(random), std::end(random));
+  auto const n = items.size();
+
+  // Floyd's method takes less than D/(D-1)*N comparisons on average and 2*N for a binary heap
+  operation_counter::reset();
+  ds::binary_heap<operation_counter> binary {std::begin(items), std::end(items)};
+  EXPECT_LT(operation_counter::less_comparisons(), 2 * n);
+  auto binary_comparisons = operation_counter::less_comparisons();
+
+  operation_counter::reset();
+  ds::d_ary_heap<operation_counter, 4> quaternary {std::begin(items), std::end(items)};
+  EXPECT_LT(operation_counter::less_comparisons(), 2 * n);
+  EXPECT_LT(operation_counter::less_comparisons(), binary_comparisons);
+
+  // pushing one item at a time takes more comparisons in the worst case, ascending items go up to the root
+  std::sort(std::begin(items), std::end(items));
+  operation_counter::reset();
+  ds::binary_heap<operation_counter> pushed;
+  for (auto const& item : items)
+    pushed.push(item);
+  EXPECT_GT(operation_counter::less_comparisons(), 4 * n);
+}
+
+TEST_F(d_ary_heap_fixture, push_range)
+{
+  ds::d_ary_heap<int, 4> heap {1, 2, 3};
+  // a range larger than the heap rebuilds the heap
+  heap.push_range(std::begin(random), std::end(random));
+  EXPECT_EQ(heap.size(), random.size() + 3);
+  EXPECT_EQ(heap.top(), sorted_random.front());
+
+  // a range smaller than the heap sifts up every item
+  std::vector<int> small {1000, -1000};
+  heap.push_range(std::begin(small), std::end(small));
+  auto expected = sorted_random;
+  expected.insert(std::end(expected), {3, 2, 1, 1000, -1000});
+  std::sort(std::begin(expected), std::end(expected), std::greater<>{});
+  EXPECT_EQ(drain(heap), expected);
+}
+
+TEST_F(d_ary_heap_fixture, copy_move_swap)
+{
+  ds::d_ary_heap<std::string, 4> heap {"one", "two", "three"};
+  auto copy = heap;
+  EXPECT_EQ(copy.size(), 3u);
+  EXPECT_EQ(copy.top(), "two");
+
+  auto moved = std::move(copy);
+  EXPECT_EQ(moved.top(), "two");
+
+  ds::d_ary_heap<std::string, 4> other {"four"};
+  swap(other, moved);
+  EXPECT_EQ(other.size(), 3u);
+  EXPECT_EQ(moved.top(), "four");
+  EXPECT_EQ(drain(other), (std::vector<std::string>{"two", "three", "one"}));
+  EXPECT_EQ(drain(heap), (std::vector<std::string>{"two", "three", "one"}));
+}
@@ -0,0 +1,212 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <limits>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "algol/ds/priority_queue/pairing_heap.hpp"
+#include "algol/ds/priority_queue/concepts.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+static_assert(algol::concepts::PriorityQueue<ds::pairing_heap<int>>());
+static_assert(algol::concepts::PriorityQueue<ds::pairing_heap<std::string, std::greater<>>>());
+
+class pairing_heap_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-500, 500);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted_random = random;
+    std::sort(std::begin(sorted_random), std::end(sorted_random), std::greater<>{});
+  }
+
+  // pop every item of the heap, they come out in the order of the comparison
+  template <typename Heap>
+  static std::vector<typename Heap::value_type> drain (Heap& heap)
+  {
+    std::vector<typename Heap::value_type> items;
+    while (!heap.empty()) {
+      items.push_back(heap.top());
+      heap.pop();
+    }
+    return items;
+  }
+
+  std::vector<int> random = std::vector<int>(1000);
+  std::vector<int> sorted_random;
+};
+
+TEST_F(pairing_heap_fixture, axioms)
+{
+  ds::pairing_heap<int> heap;
+  // new heap is empty
+  EXPECT_TRUE(heap.empty());
+  // new heap throws priority_queue_empty_error on top and pop
+  EXPECT_THROW(heap.top(), ds::priority_queue_empty_error);
+  EXPECT_THROW(heap.pop(), ds::priority_queue_empty_error);
+  auto one = heap.push(1);
+  // a heap with one item is not empty and the item is on top
+  EXPECT_FALSE(heap.empty());
+  EXPECT_EQ(heap.top(), 1);
+  EXPECT_EQ(*one, 1);
+  heap.push(3);
+  heap.emplace(2);
+  // the top is the greatest item
+  EXPECT_EQ(heap.top(), 3);
+  EXPECT_EQ(heap.size(), 3u);
+  heap.pop();
+  // a pop removes the top, the handles of the other items are valid
+  EXPECT_EQ(heap.top(), 2);
+  EXPECT_EQ(heap.size(), 2u);
+  EXPECT_EQ(*one, 1);
+  heap.clear();
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST_F(pairing_heap_fixture, push_pop)
+{
+  ds::pairing_heap<int> heap {std::begin(random), std::end(random)};
+  EXPECT_EQ(heap.size(), random.size());
+  EXPECT_EQ(drain(heap), sorted_random);
+
+  // pushes interleaved with pops
+  std::vector<int> popped;
+  for (auto v : random) {
+    heap.push(v);
+    if (heap.size() > 10) {
+      popped.push_back(heap.top());
+      heap.pop();
+    }
+  }
+  EXPECT_EQ(heap.size(), 10u);
+  auto rest = drain(heap);
+  EXPECT_TRUE(std::is_sorted(std::begin(rest), std::end(rest), std::greater<>{}));
+  // the items popped are the greatest ones at the time of the pop, every item is popped once
+  EXPECT_GE(popped.back(), rest.front());
+  popped.insert(std::end(popped), std::begin(rest), std::end(rest));
+  std::sort(std::begin(popped), std::end(popped), std::greater<>{});
+  EXPECT_EQ(popped, sorted_random);
+}
+
+TEST_F(pairing_heap_fixture, linear_build)
+{
+  std::vector<operation_counter> items(std::begin(random), std::end(random));
+  // every push links the new item to the root with one comparison
+  operation_counter::reset();
+  ds::pairing_heap<operation_counter> heap {std::begin(items), std::end(items)};
+  EXPECT_EQ(operation_counter::less_comparisons(), items.size() - 1);
+  EXPECT_EQ(heap.size(), items.size());
+}
+
+TEST_F(pairing_heap_fixture, decrease_key)
+{
+  // a min-heap, the key of an item decreases towards the top
+  ds::pairing_heap<int, std::greater<>> heap;
+  std::vector<ds::pairing_heap<int, std::greater<>>::handle> handles;
+  for (auto v : random)
+    handles.push_back(heap.push(v + 1000));
+
+  // the last item becomes the top, the other items keep their place
+  heap.decrease_key(handles.back(), -1);
+  EXPECT_EQ(heap.top(), -1);
+  EXPECT_EQ(*handles.back(), -1);
+  // the key of the top can be decreased as well
+  heap.decrease_key(handles.back(), -2);
+  EXPECT_EQ(heap.top(), -2);
+  // a key cannot be increased
+  EXPECT_THROW(heap.decrease_key(handles.back(), 0), ds::priority_queue_key_error);
+  EXPECT_EQ(heap.top(), -2);
+
+  // halve the keys of the items at odd positions
+  for (std::size_t i = 1; i < handles.size() - 1; i += 2)
+    heap.decrease_key(handles[i], *handles[i] / 2);
+  auto items = drain(heap);
+  EXPECT_EQ(items.size(), random.size());
+  EXPECT_TRUE(std::is_sorted(std::begin(items), std::end(items)));
+}
+
+TEST_F(pairing_heap_fixture, dijkstra)
+{
+  // the weighted graph of the adjacency lists, the shortest paths from vertex 0 are 0, 4, 1, 5, 8
+  std::vector<std::vector<std::pair<std::size_t, int>>> graph {
+      {{1, 7}, {2, 1}},
+      {{3, 1}, {4, 8}},
+      {{1, 3}, {3, 6}},
+      {{4, 3}},
+      {}};
+  using entry = std::pair<int, std::size_t>;
+  ds::pairing_heap<entry, std::greater<>> heap;
+  std::vector<ds::pairing_heap<entry, std::greater<>>::handle> handles(graph.size());
+  std::vector<int> distance(graph.size(), std::numeric_limits<int>::max());
+  std::vector<bool> done(graph.size(), false);
+
+  distance[0] = 0;
+  handles[0] = heap.push({0, 0});
+  // loop invariant: the distances of the vertices done are the shortest ones
+  while (!heap.empty()) {
+    auto [d, u] = heap.top();
+    heap.pop();
+    done[u] = true;
+    for (auto [v, w] : graph[u]) {
+      if (done[v] || d + w >= distance[v])
+        continue;
+      if (distance[v] == std::numeric_limits<int>::max())
+        handles[v] = heap.push({d + w, v});
+      else
+        heap.decrease_key(handles[v], {d + w, v});
+      distance[v] = d + w;
+    }
+  }
+  EXPECT_EQ(distance, (std::vector<int>{0, 4, 1, 5, 8}));
+}
+
+TEST_F(pairing_heap_fixture, merge)
+{
+  ds::pairing_heap<int> heap {1, 5, 3};
+  ds::pairing_heap<int> other {4, 2};
+  auto six = other.push(6);
+  heap.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(heap.size(), 6u);
+  // the handles of the merged heap refer to the items of this heap
+  EXPECT_EQ(*six, 6);
+  EXPECT_EQ(heap.top(), 6);
+  heap.merge(heap);
+  EXPECT_EQ(drain(heap), (std::vector<int>{6, 5, 4, 3, 2, 1}));
+}
+
+TEST_F(pairing_heap_fixture, copy_move_swap)
+{
+  ds::pairing_heap<std::string> heap {"one", "two", "three", "four", "five"};
+  auto copy = heap;
+  EXPECT_EQ(copy.size(), 5u);
+  EXPECT_EQ(copy.top(), "two");
+
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.top(), "two");
+
+  ds::pairing_heap<std::string> other {"six"};
+  swap(other, moved);
+  EXPECT_EQ(other.size(), 5u);
+  EXPECT_EQ(moved.top(), "six");
+
+  moved = other;
+  EXPECT_EQ(moved.size(), 5u);
+  other = ds::pairing_heap<std::string> {"seven"};
+  EXPECT_EQ(other.top(), "seven");
+  EXPECT_EQ(other.size(), 1u);
+  EXPECT_EQ(drain(moved), (std::vector<std::string>{"two", "three", "one", "four", "five"}));
+  EXPECT_EQ(drain(heap), (std::vector<std::string>{"two", "three", "one", "four", "five"}));
+}
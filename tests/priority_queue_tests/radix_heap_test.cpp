@@ -0,0 +1,121 @@
+#include <vector>
+#include <queue>
+#include <random>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#include "algol/ds/priority_queue/radix_heap.hpp"
+#include "algol/ds/priority_queue/concepts.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+namespace integer = algol::integer;
+
+static_assert(algol::concepts::PriorityQueue<ds::radix_heap<int, int>>());
+static_assert(algol::concepts::PriorityQueue<ds::radix_heap<std::uint8_t, char>>());
+
+TEST(radix_heap, axioms)
+{
+  ds::radix_heap<int, char> heap;
+  // new heap is empty
+  EXPECT_TRUE(heap.empty());
+  // new heap throws priority_queue_empty_error on top and pop
+  EXPECT_THROW(heap.top(), ds::priority_queue_empty_error);
+  EXPECT_THROW(heap.pop(), ds::priority_queue_empty_error);
+  heap.push({5, 'a'});
+  heap.emplace(3, 'b');
+  heap.push({7, 'c'});
+  // the top is the item with the least key
+  EXPECT_EQ(heap.top(), std::make_pair(3, 'b'));
+  EXPECT_EQ(heap.size(), 3u);
+  heap.pop();
+  // a pop removes the top and the key popped is the least key accepted
+  EXPECT_EQ(heap.last_key(), 3);
+  EXPECT_EQ(heap.top(), std::make_pair(5, 'a'));
+  EXPECT_THROW(heap.push({2, 'd'}), ds::priority_queue_key_error);
+  // a key between the last key popped and the top is accepted
+  heap.push({4, 'e'});
+  EXPECT_EQ(heap.top(), std::make_pair(4, 'e'));
+  heap.clear();
+  EXPECT_TRUE(heap.empty());
+  EXPECT_EQ(heap.last_key(), 3);
+}
+
+TEST(radix_heap, negative_keys)
+{
+  ds::radix_heap<int, int> heap;
+  for (auto key : {0, -1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), -100, 100})
+    heap.push({key, key});
+  std::vector<int> keys;
+  while (!heap.empty()) {
+    keys.push_back(heap.top().first);
+    heap.pop();
+  }
+  EXPECT_EQ(keys, (std::vector<int>{std::numeric_limits<int>::min(), -100, -1, 0, 100,
+                                    std::numeric_limits<int>::max()}));
+}
+
+TEST(radix_heap, bounded_keys)
+{
+  ds::radix_heap<int, int> heap {integer::integer_interval<int>{-10, 10}};
+  EXPECT_EQ(heap.last_key(), -10);
+  EXPECT_THROW(heap.push({-11, 0}), ds::priority_queue_key_error);
+  EXPECT_THROW(heap.push({11, 0}), ds::priority_queue_key_error);
+  heap.push({10, 0});
+  heap.push({-10, 0});
+  EXPECT_EQ(heap.top().first, -10);
+  EXPECT_THROW((ds::radix_heap<int, int>{integer::integer_interval<int>{1, 0}}), ds::priority_queue_key_error);
+}
+
+TEST(radix_heap, monotone_workload)
+{
+  // hold model: every pop is followed by pushes of keys not less than the key popped
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::uint32_t> distribution(0, 1000);
+  ds::radix_heap<std::uint32_t, std::uint32_t> heap;
+  for (std::uint32_t i = 0; i < 100; ++i)
+    heap.push({distribution(gen), i});
+  std::vector<std::uint32_t> keys;
+  std::uint32_t i = 0;
+  // loop invariant: the keys popped are not decreasing
+  while (!heap.empty() && i < 10000) {
+    auto [key, value] = heap.top();
+    heap.pop();
+    keys.push_back(key);
+    if (i++ % 3 != 2) {
+      heap.push({key + distribution(gen), value});
+      heap.push({key + distribution(gen) / 10, value});
+    }
+  }
+  EXPECT_TRUE(std::is_sorted(std::begin(keys), std::end(keys)));
+  EXPECT_EQ(keys.size(), 10000u);
+}
+
+TEST(radix_heap, matches_binary_heap)
+{
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> distribution(0, 64);
+  ds::radix_heap<int, int> heap {integer::integer_interval<int>{0, 1 << 20}};
+  std::priority_queue<int, std::vector<int>, std::greater<>> reference;
+  for (auto i = 0; i < 5000; ++i) {
+    // pushes and pops interleaved, the keys are at least the last key popped
+    auto key = heap.last_key() + distribution(gen);
+    heap.push({key, i});
+    reference.push(key);
+    if (i % 2 == 1) {
+      ASSERT_EQ(heap.top().first, reference.top());
+      heap.pop();
+      reference.pop();
+    }
+  }
+  EXPECT_EQ(heap.size(), reference.size());
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top().first, reference.top());
+    heap.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
@@ -0,0 +1,150 @@
+#include <vector>
+#include <utility>
+
+#include "algol/ds/queue/array_queue.hpp"
+#include "algol/ds/queue/concepts.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+static_assert(algol::concepts::Queue<ds::array_queue<int, 4>>());
+
+class array_queue_fixture : public ::testing::Test {
+protected:
+  ds::array_queue<operation_counter, 100> op_count_queue;
+};
+
+TEST_F(array_queue_fixture, axioms)
+{
+  // Note: Axioms for the ADT queue
+  // new queue is empty and not full
+  EXPECT_TRUE(op_count_queue.empty());
+  EXPECT_FALSE(op_count_queue.full());
+  // new queue is throws queue_empty_error on dequeue
+  EXPECT_THROW(op_count_queue.dequeue(), ds::queue_empty_error);
+  // new queue is throws queue_empty_error on front
+  EXPECT_THROW(op_count_queue.front(), ds::queue_empty_error);
+  op_count_queue.enqueue(1);
+  // a queue with one item is not empty
+  EXPECT_FALSE(op_count_queue.empty());
+  // a queue with one item on front return that item
+  EXPECT_EQ(op_count_queue.front(), 1);
+  // a queue with one item does not throw on dequeue
+  EXPECT_NO_THROW(op_count_queue.dequeue());
+  op_count_queue.enqueue(1);
+  auto size = op_count_queue.size();
+  op_count_queue.enqueue(2);
+  // an enqueue increase the size of the queue by 1
+  EXPECT_EQ(op_count_queue.size(), size + 1u);
+  size = op_count_queue.size();
+  op_count_queue.dequeue();
+  // a dequeue decrease the size of the queue by 1
+  EXPECT_EQ(op_count_queue.size(), size - 1u);
+}
+
+TEST_F(array_queue_fixture, initilizer_list)
+{
+  std::vector<operation_counter> val = {1, 2, 3, 4, 5, 6};
+  ds::array_queue<operation_counter, 6> init_list_queue {1, 2, 3, 4, 5, 6};
+  EXPECT_TRUE(init_list_queue.full());
+  EXPECT_EQ(init_list_queue.size(), 6u);
+  EXPECT_EQ(init_list_queue.front(), 1);
+  ASSERT_EQ(init_list_queue.to_vector(), val);
+  EXPECT_THROW((ds::array_queue<int, 2>{1, 2, 3}), ds::queue_full_error);
+}
+
+TEST_F(array_queue_fixture, full_queue)
+{
+  ds::array_queue<int, 3> queue {1, 2, 3};
+  EXPECT_TRUE(queue.full());
+  EXPECT_THROW(queue.enqueue(4), ds::queue_full_error);
+  EXPECT_EQ(queue.to_vector(), (std::vector<int>{1, 2, 3}));
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_THROW(queue.front(), ds::queue_empty_error);
+}
+
+TEST_F(array_queue_fixture, wraparound)
+{
+  ds::array_queue<int, 5> queue;
+  auto next_in = 0, next_out = 0;
+  for (auto round = 0; round < 20; ++round) {
+    for (auto i = 0; i < 3; ++i)
+      queue.enqueue(next_in++);
+    for (auto i = 0; i < 3; ++i, ++next_out) {
+      EXPECT_EQ(queue.front(), next_out);
+      queue.dequeue();
+    }
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(array_queue_fixture, copy_move_swap)
+{
+  ds::array_queue<int, 4> queue {1, 2, 3};
+  queue.dequeue();
+  queue.enqueue(4);
+  queue.enqueue(5);
+  auto copy = queue;
+  EXPECT_EQ(copy, queue);
+  EXPECT_EQ(copy.to_vector(), (std::vector<int>{2, 3, 4, 5}));
+  ds::array_queue<int, 4> other {9};
+  swap(copy, other);
+  EXPECT_EQ(copy.front(), 9);
+  EXPECT_EQ(other, queue);
+  auto moved = std::move(other);
+  EXPECT_EQ(moved, queue);
+}
+
+TEST_F(array_queue_fixture, comparison)
+{
+  // the same items at different positions of the array are equal
+  ds::array_queue<int, 3> shifted {0, 1, 2};
+  shifted.dequeue();
+  shifted.enqueue(3);
+  ds::array_queue<int, 3> queue {1, 2, 3};
+  EXPECT_EQ(shifted, queue);
+  EXPECT_FALSE(shifted != queue);
+  EXPECT_LE(shifted, queue);
+  EXPECT_GE(shifted, queue);
+  ds::array_queue<int, 3> prefix {1, 2};
+  EXPECT_LT(prefix, queue);
+  EXPECT_GT(queue, prefix);
+  EXPECT_NE(prefix, queue);
+  ds::array_queue<int, 3> greater {1, 3};
+  EXPECT_LT(queue, greater);
+}
+
+namespace {
+  // the queue in a constant expression
+  constexpr int drain_sum ()
+  {
+    ds::array_queue<int, 4> queue {1, 2, 3};
+    auto sum = 0;
+    for (auto i = 4; i < 10; ++i) {
+      sum += queue.front();
+      queue.dequeue();
+      queue.enqueue(i);
+    }
+    while (!queue.empty()) {
+      sum += queue.front();
+      queue.dequeue();
+    }
+    return sum;
+  }
+}
+
+TEST_F(array_queue_fixture, constexpr_queue)
+{
+  constexpr ds::array_queue<int, 4> queue {1, 2, 3};
+  static_assert(queue.size() == 3);
+  static_assert(queue.front() == 1);
+  static_assert(!queue.full());
+  static_assert(queue == ds::array_queue<int, 4>{1, 2, 3});
+  static_assert(queue < ds::array_queue<int, 4>{1, 2, 4});
+  static_assert(drain_sum() == 45);
+  EXPECT_EQ(drain_sum(), 45);
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "algol/ds/queue/blocking_queue.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+TEST(blocking_queue_test, empty_full)
+{
+  ds::blocking_queue<int, 3> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.capacity(), 3u);
+  int value = 42;
+  EXPECT_FALSE(queue.try_dequeue(value));
+  EXPECT_EQ(value, 42);
+  EXPECT_THROW(queue.dequeue(), ds::queue_empty_error);
+  for (auto i = 0; i < 3; ++i)
+    EXPECT_TRUE(queue.try_enqueue(i));
+  EXPECT_TRUE(queue.full());
+  EXPECT_EQ(queue.size(), 3u);
+  EXPECT_FALSE(queue.try_enqueue(3));
+  EXPECT_THROW(queue.enqueue(3), ds::queue_full_error);
+  EXPECT_EQ(queue.dequeue(), 0);
+  EXPECT_TRUE(queue.try_dequeue(value));
+  EXPECT_EQ(value, 1);
+  queue.enqueue(3);
+  EXPECT_EQ(queue.dequeue(), 2);
+  EXPECT_EQ(queue.dequeue(), 3);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(blocking_queue_test, move_only)
+{
+  ds::blocking_queue<std::shared_ptr<int>, 2> queue;
+  auto item = std::make_shared<int>(7);
+  queue.wait_enqueue(std::move(item));
+  EXPECT_EQ(item, nullptr);
+  std::shared_ptr<int> out;
+  EXPECT_TRUE(queue.wait_dequeue(out));
+  EXPECT_EQ(*out, 7);
+  EXPECT_EQ(out.use_count(), 1);
+
+  // dequeue moves the front item out as well
+  ds::blocking_queue<operation_counter, 2> counters;
+  counters.enqueue(operation_counter{7});
+  operation_counter::reset();
+  EXPECT_EQ(counters.dequeue(), 7);
+  EXPECT_EQ(operation_counter::constructions(), 0u);
+  EXPECT_GE(operation_counter::moves(), 1u);
+}
+
+TEST(blocking_queue_test, timed_waits)
+{
+  using namespace std::chrono_literals;
+  ds::blocking_queue<int, 1> queue;
+  int value = -1;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(queue.wait_dequeue_for(value, 20ms));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+  EXPECT_EQ(value, -1);
+  EXPECT_TRUE(queue.wait_enqueue_for(1, 20ms));
+  EXPECT_FALSE(queue.wait_enqueue_until(2, std::chrono::steady_clock::now() + 10ms));
+  EXPECT_TRUE(queue.wait_dequeue_until(value, std::chrono::system_clock::now() + 10ms));
+  EXPECT_EQ(value, 1);
+  // the batch wait takes what is there when the time is over
+  queue.enqueue(5);
+  std::vector<int> out(4, -1);
+  EXPECT_EQ(queue.wait_dequeue_n_for(std::begin(out), out.size(), 10ms), 1u);
+  EXPECT_EQ(out[0], 5);
+  EXPECT_EQ(queue.wait_dequeue_n_for(std::begin(out), out.size(), 10ms), 0u);
+}
+
+TEST(blocking_queue_test, close_drain)
+{
+  ds::blocking_queue<int, 4> queue;
+  queue.enqueue(1);
+  queue.enqueue(2);
+  queue.close();
+  EXPECT_TRUE(queue.closed());
+  EXPECT_THROW(queue.enqueue(3), ds::queue_closed_error);
+  EXPECT_THROW(queue.try_enqueue(3), ds::queue_closed_error);
+  EXPECT_THROW(queue.wait_enqueue(3), ds::queue_closed_error);
+  // the items enqueued before close are dequeued, then the waits return
+  int value = -1;
+  EXPECT_TRUE(queue.wait_dequeue(value));
+  EXPECT_EQ(value, 1);
+  std::vector<int> out(4, -1);
+  EXPECT_EQ(queue.wait_dequeue_n(std::begin(out), out.size()), 1u);
+  EXPECT_EQ(out[0], 2);
+  EXPECT_FALSE(queue.wait_dequeue(value));
+  EXPECT_EQ(queue.wait_dequeue_n(std::begin(out), out.size()), 0u);
+}
+
+TEST(blocking_queue_test, close_wakes_waiters)
+{
+  ds::blocking_queue<int, 1> full;
+  full.enqueue(0);
+  ds::blocking_queue<int, 1> empty;
+  std::thread producer {[&full] { EXPECT_THROW(full.wait_enqueue(1), ds::queue_closed_error); }};
+  std::thread consumer {[&empty] {
+    int value;
+    EXPECT_FALSE(empty.wait_dequeue(value));
+  }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  full.close();
+  empty.close();
+  producer.join();
+  consumer.join();
+  EXPECT_EQ(full.dequeue(), 0);
+}
+
+TEST(blocking_queue_test, batch)
+{
+  ds::blocking_queue<int, 8> queue;
+  std::vector<int> in(100);
+  std::iota(std::begin(in), std::end(in), 0);
+  std::vector<int> out;
+  // the consumer takes batches of 5, the producer enqueues a range and single items
+  std::thread consumer {[&queue, &out] {
+    std::vector<int> batch(20);
+    std::size_t n;
+    while ((n = queue.wait_dequeue_n(std::begin(batch), 5)) > 0)
+      out.insert(std::end(out), std::begin(batch), std::begin(batch) + static_cast<std::ptrdiff_t>(n));
+  }};
+  queue.wait_enqueue_range(std::begin(in), std::begin(in) + 50);
+  for (auto i = 50; i < 100; ++i)
+    queue.wait_enqueue(in[static_cast<std::size_t>(i)]);
+  queue.close();
+  consumer.join();
+  EXPECT_EQ(out, in);
+
+  // a batch larger than the capacity is taken 8 items at a time
+  ds::blocking_queue<int, 8> large;
+  std::vector<int> result(30);
+  std::thread taker {[&large, &result] { EXPECT_EQ(large.wait_dequeue_n(std::begin(result), 30), 30u); }};
+  large.wait_enqueue_range(std::begin(in), std::begin(in) + 30);
+  taker.join();
+  EXPECT_TRUE(std::equal(std::begin(result), std::end(result), std::begin(in)));
+}
+
+TEST(blocking_queue_test, many_producers_consumers)
+{
+  constexpr auto producers = 3;
+  constexpr auto consumers = 3;
+  constexpr auto items = 20000;
+  ds::blocking_queue<int, 16> queue;
+  std::vector<std::vector<int>> taken(consumers);
+  std::vector<std::thread> threads;
+  for (auto c = 0; c < consumers; ++c)
+    threads.emplace_back([&queue, &taken, c] {
+      std::vector<int> batch(4);
+      // the consumers mix single and batch dequeues
+      while (true) {
+        if (c == 0) {
+          int value;
+          if (!queue.wait_dequeue(value))
+            break;
+          taken[0].push_back(value);
+        }
+        else {
+          auto n = queue.wait_dequeue_n(std::begin(batch), static_cast<std::size_t>(c) * 2);
+          if (n == 0)
+            break;
+          taken[static_cast<std::size_t>(c)].insert(std::end(taken[static_cast<std::size_t>(c)]), std::begin(batch),
+                                                    std::begin(batch) + static_cast<std::ptrdiff_t>(n));
+        }
+      }
+    });
+  std::vector<std::thread> writers;
+  for (auto p = 0; p < producers; ++p)
+    writers.emplace_back([&queue, p] {
+      for (auto i = 0; i < items; ++i)
+        queue.wait_enqueue(p * items + i);
+    });
+  for (auto& writer : writers)
+    writer.join();
+  queue.close();
+  for (auto& thread : threads)
+    thread.join();
+
+  std::vector<int> all;
+  for (auto const& values : taken) {
+    // the items of a producer are taken by a consumer in the order they were enqueued
+    for (auto p = 0; p < producers; ++p) {
+      std::vector<int> mine;
+      std::copy_if(std::begin(values), std::end(values), std::back_inserter(mine),
+                   [p] (int v) { return v / items == p; });
+      EXPECT_TRUE(std::is_sorted(std::begin(mine), std::end(mine)));
+    }
+    all.insert(std::end(all), std::begin(values), std::end(values));
+  }
+  std::sort(std::begin(all), std::end(all));
+  std::vector<int> expected(producers * items);
+  std::iota(std::begin(expected), std::end(expected), 0);
+  EXPECT_EQ(all, expected);
+}
@@ -1,4 +1,8 @@
 #include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 #include <memory>
 
 #include "algol/ds/queue/queue.hpp"
@@ -573,4 +577,184 @@ TEST_F(fixed_queue_fixture, to_vector)
   EXPECT_EQ(op_count_queue.front(), 0);
 
   ASSERT_EQ(op_count_queue.to_vector(), val);
-}
\ No newline at end of file
+}
+
+namespace {
+  // counts the live objects and has no default constructor
+  struct live_item {
+    explicit live_item (int value) : value {value}
+    {
+      ++live;
+    }
+
+    live_item (live_item const& rhs) : value {rhs.value}
+    {
+      ++live;
+    }
+
+    ~live_item ()
+    {
+      --live;
+    }
+
+    bool operator== (live_item const& rhs) const
+    {
+      return value == rhs.value;
+    }
+
+    bool operator!= (live_item const& rhs) const
+    {
+      return value != rhs.value;
+    }
+
+    int value;
+    static inline int live = 0;
+  };
+}
+
+TEST(fixed_queue, uninitialized_storage)
+{
+  {
+    ds::fixed_queue<live_item, 3> queue;
+    // the items are constructed on enqueue, not when the queue is
+    EXPECT_EQ(live_item::live, 0);
+    queue.emplace(1);
+    queue.enqueue(live_item{2});
+    queue.emplace(3);
+    EXPECT_EQ(live_item::live, 3);
+    // the items are destroyed on dequeue, the rear wraps around into the slot released
+    queue.dequeue();
+    EXPECT_EQ(live_item::live, 2);
+    queue.emplace(4);
+    auto copy = queue;
+    EXPECT_EQ(live_item::live, 6);
+    EXPECT_TRUE(copy == queue);
+    copy.clear();
+    EXPECT_EQ(live_item::live, 3);
+    EXPECT_EQ(queue.front().value, 2);
+  }
+  // the items left are destroyed with the queue
+  EXPECT_EQ(live_item::live, 0);
+}
+
+TEST(fixed_queue, inline_storage)
+{
+  using inline_queue = ds::fixed_queue<std::string, 4, ds::inline_storage>;
+  static_assert(sizeof(inline_queue) >= 4 * sizeof(std::string));
+
+  inline_queue queue {"zero", "one", "two", "three"};
+  queue.dequeue();
+  queue.enqueue("four");
+  inline_queue copy {queue};
+  EXPECT_TRUE(copy == queue);
+
+  // an inline queue is moved item by item, the moved queue becomes empty
+  inline_queue moved {std::move(copy)};
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.to_vector(), (std::vector<std::string>{"one", "two", "three", "four"}));
+
+  inline_queue other {"five"};
+  swap(other, moved);
+  EXPECT_EQ(other.size(), 4u);
+  EXPECT_EQ(other.front(), "one");
+  EXPECT_EQ(moved.to_vector(), (std::vector<std::string>{"five"}));
+
+  moved = other;
+  EXPECT_TRUE(moved == other);
+  other = inline_queue{"six", "seven"};
+  EXPECT_EQ(other.front(), "six");
+  EXPECT_THROW((inline_queue{"a", "b", "c", "d"}.enqueue("e")), ds::queue_full_error);
+}
+
+TEST(fixed_queue, inline_storage_lifetime)
+{
+  {
+    ds::fixed_queue<live_item, 2, ds::inline_storage> queue;
+    EXPECT_EQ(live_item::live, 0);
+    queue.emplace(1);
+    queue.emplace(2);
+    queue.dequeue();
+    queue.emplace(3);
+    ds::fixed_queue<live_item, 2, ds::inline_storage> other;
+    other.emplace(4);
+    swap(queue, other);
+    EXPECT_EQ(live_item::live, 3);
+    EXPECT_EQ(queue.front().value, 4);
+    EXPECT_EQ(other.front().value, 2);
+  }
+  EXPECT_EQ(live_item::live, 0);
+}
+
+namespace {
+  struct const_item {
+    explicit const_item (int v) : value {v}
+    {}
+
+    int const value;
+  };
+}
+
+TEST(fixed_queue, inline_storage_const_member)
+{
+  // a slot reused by an item with a const member is reached through std::launder
+  ds::fixed_queue<const_item, 2, ds::inline_storage> queue;
+  queue.emplace(1);
+  queue.emplace(2);
+  queue.dequeue();
+  queue.emplace(3);
+  EXPECT_EQ(queue.front().value, 2);
+  queue.dequeue();
+  EXPECT_EQ(queue.front().value, 3);
+}
+
+namespace {
+  // the copy constructor throws when countdown reaches 0
+  struct throwing_item {
+    explicit throwing_item (int value) : value {value}
+    {}
+
+    throwing_item (throwing_item const& rhs) : value {rhs.value}
+    {
+      if (countdown-- == 0)
+        throw std::runtime_error{"copy"};
+    }
+
+    int value;
+    static inline int countdown = -1;
+  };
+}
+
+TEST(fixed_queue, bulk)
+{
+  ds::fixed_queue<int, 8> queue {0, 1, 2, 3, 4, 5};
+  std::vector<int> dequeued;
+  queue.dequeue_n(std::back_inserter(dequeued), 5);
+  EXPECT_EQ(dequeued, (std::vector<int>{0, 1, 2, 3, 4}));
+
+  // the range is copied in two segments, at the end of the array and from its start
+  std::vector<int> items {6, 7, 8, 9, 10, 11, 12};
+  queue.enqueue_range(items.begin(), items.end());
+  EXPECT_TRUE(queue.full());
+  EXPECT_THROW(queue.enqueue_range(items.begin(), items.begin() + 1), ds::queue_full_error);
+  EXPECT_EQ(queue.to_vector(), (std::vector<int>{5, 6, 7, 8, 9, 10, 11, 12}));
+
+  int out[8];
+  EXPECT_THROW(queue.dequeue_n(out, 9), ds::queue_empty_error);
+  EXPECT_EQ(queue.dequeue_n(out, 8), out + 8);
+  EXPECT_TRUE(std::equal(out, out + 8, std::vector<int>{5, 6, 7, 8, 9, 10, 11, 12}.begin()));
+  EXPECT_TRUE(queue.empty());
+  EXPECT_THROW((ds::fixed_queue<operation_counter, 2> {1, 2, 3}), ds::queue_full_error);
+
+  // a copy that throws in the second segment leaves the queue unchanged
+  ds::fixed_queue<throwing_item, 4> throwing_queue {throwing_item{0}, throwing_item{1}, throwing_item{2}};
+  throwing_queue.dequeue();
+  throwing_queue.dequeue();
+  std::vector<throwing_item> throwing_items {throwing_item{3}, throwing_item{4}, throwing_item{5}};
+  throwing_item::countdown = 2;
+  EXPECT_THROW(throwing_queue.enqueue_range(throwing_items.begin(), throwing_items.end()), std::runtime_error);
+  throwing_item::countdown = -1;
+  EXPECT_EQ(throwing_queue.size(), 1u);
+  throwing_queue.enqueue_range(throwing_items.begin(), throwing_items.end());
+  EXPECT_EQ(throwing_queue.size(), 4u);
+  EXPECT_EQ(throwing_queue.front().value, 2);
+}
@@ -0,0 +1,144 @@
+#include <vector>
+
+#include "algol/ds/queue/intrusive_queue.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+namespace {
+  struct message : ds::intrusive_hook<> {
+    explicit message (int id) : id {id}
+    {}
+
+    int id;
+  };
+
+  using message_queue = ds::intrusive_queue<message>;
+
+  std::vector<int> ids (message_queue const& queue)
+  {
+    std::vector<int> ids;
+    for (auto m : queue.to_vector())
+      ids.push_back(m->id);
+    return ids;
+  }
+}
+
+class intrusive_queue_fixture : public ::testing::Test {
+protected:
+  std::vector<message> messages {message{0}, message{1}, message{2}, message{3}, message{4}};
+  message_queue queue;
+};
+
+TEST_F(intrusive_queue_fixture, axioms)
+{
+  // Note: Axioms for the ADT queue
+  // new queue is empty and not full
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.full());
+  // new queue throws queue_empty_error on dequeue
+  EXPECT_THROW(queue.dequeue(), ds::queue_empty_error);
+  // new queue throws queue_empty_error on front
+  EXPECT_THROW(queue.front(), ds::queue_empty_error);
+  queue.enqueue(messages[0]);
+  // a queue with one item is not empty
+  EXPECT_FALSE(queue.empty());
+  // a queue with one item has that item at the front
+  EXPECT_EQ(&queue.front(), &messages[0]);
+  // a queue with one item does not throw on dequeue
+  EXPECT_NO_THROW(queue.dequeue());
+  queue.enqueue(messages[0]);
+  auto size = queue.size();
+  queue.enqueue(messages[1]);
+  // an enqueue increase the size of the queue by 1
+  EXPECT_EQ(queue.size(), size + 1u);
+  // the front does not change on enqueue
+  EXPECT_EQ(&queue.front(), &messages[0]);
+  size = queue.size();
+  queue.dequeue();
+  // a dequeue decrease the size of the queue by 1
+  EXPECT_EQ(queue.size(), size - 1u);
+  queue.clear();
+}
+
+TEST_F(intrusive_queue_fixture, fifo_without_copies)
+{
+  for (auto& m : messages)
+    queue.enqueue(m);
+  EXPECT_EQ(ids(queue), (std::vector<int>{0, 1, 2, 3, 4}));
+
+  for (auto i = 0; i < 5; ++i) {
+    auto m = queue.try_dequeue();
+    EXPECT_EQ(m, &messages[static_cast<std::size_t>(i)]);
+    EXPECT_FALSE(m->is_linked());
+  }
+  EXPECT_EQ(queue.try_dequeue(), nullptr);
+
+  // the last item dequeued leaves the rear empty, enqueue starts again from the front
+  queue.enqueue(messages[2]);
+  EXPECT_EQ(queue.front().id, 2);
+  queue.clear();
+}
+
+TEST_F(intrusive_queue_fixture, splice)
+{
+  message_queue other;
+  queue.enqueue(messages[0]);
+  queue.enqueue(messages[1]);
+  other.enqueue(messages[2]);
+  other.enqueue(messages[3]);
+
+  queue.splice(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(queue.size(), 4u);
+  EXPECT_EQ(ids(queue), (std::vector<int>{0, 1, 2, 3}));
+
+  // the rear of the concatenation is the rear of other
+  queue.enqueue(messages[4]);
+  EXPECT_EQ(ids(queue), (std::vector<int>{0, 1, 2, 3, 4}));
+
+  // splicing into an empty queue and splicing an empty queue
+  other.splice(queue);
+  other.splice(queue);
+  EXPECT_EQ(ids(other), (std::vector<int>{0, 1, 2, 3, 4}));
+  other.clear();
+}
+
+TEST_F(intrusive_queue_fixture, move_and_swap)
+{
+  queue.enqueue(messages[0]);
+  queue.enqueue(messages[1]);
+
+  message_queue moved {std::move(queue)};
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(moved.dequeue().id, 0);
+
+  queue.enqueue(messages[2]);
+  swap(queue, moved);
+  EXPECT_EQ(queue.front().id, 1);
+  EXPECT_EQ(moved.front().id, 2);
+
+  queue = std::move(moved);
+  EXPECT_FALSE(messages[1].is_linked());
+  EXPECT_EQ(ids(queue), (std::vector<int>{2}));
+  queue.clear();
+}
+
+#ifndef NDEBUG
+TEST_F(intrusive_queue_fixture, ownership_checks)
+{
+  queue.enqueue(messages[0]);
+  message_queue other;
+  // an item is linked in one queue at a time
+  EXPECT_DEATH(other.enqueue(messages[0]), "already linked");
+  // an item cannot be destroyed while it is linked
+  EXPECT_DEATH({
+    message_queue q;
+    {
+      message m {5};
+      q.enqueue(m);
+    }
+  }, "destroyed while it is linked");
+  queue.clear();
+}
+#endif
@@ -1,4 +1,5 @@
 #include <vector>
+#include <iterator>
 #include <memory>
 
 #include "algol/ds/queue/queue.hpp"
@@ -579,3 +580,22 @@ TEST_F(linked_queue_fixture, to_vector)
 
   ASSERT_EQ(op_count_queue.to_vector(), val);
 }
+
+TEST_F(linked_queue_fixture, bulk)
+{
+  std::vector<operation_counter> items {1, 2, 3, 4, 5};
+  op_count_queue.enqueue_range(items.begin(), items.end());
+  EXPECT_EQ(op_count_queue.size(), 5u);
+  EXPECT_EQ(op_count_queue.front(), 1);
+
+  std::vector<operation_counter> dequeued;
+  dequeued.reserve(3);
+  operation_counter::reset();
+  op_count_queue.dequeue_n(std::back_inserter(dequeued), 3);
+  // the default hook moves the items out
+  EXPECT_EQ(operation_counter::moves(), 3u);
+  EXPECT_EQ(operation_counter::constructions(), 0u);
+  EXPECT_EQ(dequeued, (std::vector<operation_counter>{1, 2, 3}));
+  EXPECT_THROW(op_count_queue.dequeue_n(std::back_inserter(dequeued), 3), ds::queue_empty_error);
+  EXPECT_EQ(op_count_queue.to_vector(), (std::vector<operation_counter>{4, 5}));
+}
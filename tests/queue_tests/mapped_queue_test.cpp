@@ -0,0 +1,254 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "algol/ds/queue/mapped_queue.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+namespace fs = std::filesystem;
+
+class mapped_queue_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    auto name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    directory = fs::temp_directory_path() / ("mapped_queue_test_" + std::to_string(::getpid()) + "_" + name);
+    fs::create_directories(directory);
+  }
+
+  void TearDown () override
+  {
+    fs::remove_all(directory);
+  }
+
+  std::string path (std::string const& name) const
+  {
+    return (directory / name).string();
+  }
+
+  fs::path directory;
+};
+
+TEST_F(mapped_queue_fixture, axioms)
+{
+  ds::mapped_queue<std::int64_t> queue {path("axioms"), 100};
+  // Note: Axioms for the ADT queue
+  // new queue is empty and not full
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.full());
+  EXPECT_EQ(queue.capacity(), 100u);
+  // new queue is throws queue_empty_error on dequeue
+  EXPECT_THROW(queue.dequeue(), ds::queue_empty_error);
+  // new queue is throws queue_empty_error on front
+  EXPECT_THROW(queue.front(), ds::queue_empty_error);
+  queue.enqueue(1);
+  // a queue with one item is not empty
+  EXPECT_FALSE(queue.empty());
+  // a queue with one item on front return that item
+  EXPECT_EQ(queue.front(), 1);
+  // a queue with one item does not throw on dequeue
+  EXPECT_NO_THROW(queue.dequeue());
+  queue.enqueue(1);
+  auto size = queue.size();
+  queue.enqueue(2);
+  // an enqueue increase the size of the queue by 1
+  EXPECT_EQ(queue.size(), size + 1u);
+  size = queue.size();
+  queue.dequeue();
+  // a dequeue decrease the size of the queue by 1
+  EXPECT_EQ(queue.size(), size - 1u);
+}
+
+TEST_F(mapped_queue_fixture, full_and_wraparound)
+{
+  ds::mapped_queue<int> queue {path("wrap"), 5};
+  auto next_in = 0, next_out = 0;
+  for (auto round = 0; round < 20; ++round) {
+    for (auto i = 0; i < 3; ++i)
+      queue.enqueue(next_in++);
+    for (auto i = 0; i < 3; ++i, ++next_out) {
+      EXPECT_EQ(queue.front(), next_out);
+      queue.dequeue();
+    }
+  }
+  std::vector<int> values {1, 2, 3, 4, 5};
+  queue.enqueue_range(values.begin(), values.end());
+  EXPECT_TRUE(queue.full());
+  EXPECT_THROW(queue.enqueue(6), ds::queue_full_error);
+  EXPECT_THROW(queue.enqueue_range(values.begin(), values.begin() + 1), ds::queue_full_error);
+  EXPECT_EQ(queue.to_vector(), values);
+  std::vector<int> out(3);
+  queue.dequeue_n(out.begin(), 3);
+  EXPECT_EQ(out, (std::vector<int>{1, 2, 3}));
+  EXPECT_THROW(queue.dequeue_n(out.begin(), 3), ds::queue_empty_error);
+  EXPECT_EQ(queue.size(), 2u);
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(mapped_queue_fixture, reopen)
+{
+  struct record {
+    std::int32_t id;
+    double value;
+  };
+  for (auto policy : {ds::sync_policy::none, ds::sync_policy::each, ds::sync_policy::batch}) {
+    auto file = path("reopen" + std::to_string(static_cast<int>(policy)));
+    {
+      ds::mapped_queue<record> queue {file, 8, policy, 3};
+      for (auto i = 0; i < 6; ++i)
+        queue.enqueue({i, i * 0.5});
+      queue.dequeue();
+      queue.dequeue();
+    }
+    // the capacity of the file is taken with 0
+    ds::mapped_queue<record> queue {file, 0, policy};
+    EXPECT_EQ(queue.capacity(), 8u);
+    ASSERT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.front().id, 2);
+    EXPECT_EQ(queue.front().value, 1.0);
+    for (auto i = 6; i < 10; ++i)
+      queue.enqueue({i, i * 0.5});
+    EXPECT_TRUE(queue.full());
+    auto items = queue.to_vector();
+    for (std::size_t i = 0; i < items.size(); ++i)
+      EXPECT_EQ(items[i].id, static_cast<std::int32_t>(i + 2));
+  }
+}
+
+TEST_F(mapped_queue_fixture, crash_with_batch)
+{
+  auto file = path("batch");
+  auto crashed = path("crashed");
+  ds::mapped_queue<int> queue {file, 16, ds::sync_policy::batch, 4};
+  for (auto i = 0; i < 6; ++i)
+    queue.enqueue(i);
+  // the copy of the file is what is left by a crash: the commit of the first 4 enqueues
+  fs::copy_file(file, crashed);
+  {
+    ds::mapped_queue<int> recovered {crashed, 16};
+    EXPECT_EQ(recovered.to_vector(), (std::vector<int>{0, 1, 2, 3}));
+  }
+  fs::remove(crashed);
+
+  queue.dequeue();
+  queue.dequeue();
+  queue.sync();
+  queue.dequeue();
+  fs::copy_file(file, crashed);
+  {
+    // the dequeue not committed is lost and the item comes back
+    ds::mapped_queue<int> recovered {crashed, 16};
+    EXPECT_EQ(recovered.to_vector(), (std::vector<int>{2, 3, 4, 5}));
+  }
+
+  // the room of an item dequeued is reused only after its dequeue is committed, the commit happens before the
+  // enqueue that overwrites it, so the crash finds the items before that enqueue
+  ds::mapped_queue<int> small {path("small"), 4, ds::sync_policy::batch, 100};
+  for (auto i = 0; i < 4; ++i)
+    small.enqueue(i);
+  small.dequeue();
+  small.enqueue(4);
+  fs::copy_file(path("small"), path("small_crashed"));
+  ds::mapped_queue<int> recovered {path("small_crashed"), 4};
+  EXPECT_EQ(recovered.to_vector(), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(mapped_queue_fixture, invalid_file)
+{
+  {
+    ds::mapped_queue<int> queue {path("ints"), 16};
+    queue.enqueue(1);
+  }
+  // another capacity or record size
+  EXPECT_THROW((ds::mapped_queue<int> {path("ints"), 8}), ds::mapped_queue_error);
+  EXPECT_THROW((ds::mapped_queue<std::int64_t> {path("ints"), 8}), ds::mapped_queue_error);
+  EXPECT_THROW((ds::mapped_record_queue {path("ints"), 0}), ds::mapped_queue_error);
+  EXPECT_THROW((ds::mapped_queue<int> {path("new"), 0}), ds::mapped_queue_error);
+
+  // a file that is not a queue
+  {
+    std::ofstream text {path("text")};
+    text << std::string(10000, 'x');
+  }
+  EXPECT_THROW((ds::mapped_queue<int> {path("text"), 0}), ds::mapped_queue_error);
+
+  // a corrupted tail
+  fs::copy_file(path("ints"), path("corrupt"));
+  {
+    std::fstream corrupt {path("corrupt"), std::ios::in | std::ios::out | std::ios::binary};
+    std::uint64_t tail = 1000;
+    corrupt.seekp(32);
+    corrupt.write(reinterpret_cast<char const*>(&tail), sizeof(tail));
+  }
+  EXPECT_THROW((ds::mapped_queue<int> {path("corrupt"), 16}), ds::mapped_queue_error);
+  EXPECT_THROW((ds::mapped_queue<int> {path("missing/file"), 16}), std::system_error);
+
+  ds::mapped_queue<int> queue {path("ints"), 16};
+  EXPECT_EQ(queue.front(), 1);
+}
+
+TEST_F(mapped_queue_fixture, records)
+{
+  auto file = path("records");
+  {
+    ds::mapped_record_queue queue {file, 60, ds::sync_policy::each};
+    EXPECT_EQ(queue.capacity(), 64u);
+    EXPECT_THROW(queue.front(), ds::queue_empty_error);
+    EXPECT_THROW(queue.dequeue(), ds::queue_empty_error);
+    queue.enqueue("");
+    queue.enqueue("hello");
+    queue.enqueue("a longer record");
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.front(), "");
+    queue.dequeue();
+    EXPECT_EQ(queue.front(), "hello");
+    EXPECT_FALSE(queue.try_enqueue(std::string(64, 'x')));
+    EXPECT_THROW(queue.enqueue(std::string(40, 'x')), ds::queue_full_error);
+  }
+  ds::mapped_record_queue queue {file, 0};
+  EXPECT_EQ(queue.size(), 2u);
+  EXPECT_EQ(queue.to_vector(), (std::vector<std::string>{"hello", "a longer record"}));
+  queue.dequeue();
+  // the bytes from 24 to 48 are used, a record of 20 takes 24 and does not fit before the end: it starts at 0
+  EXPECT_TRUE(queue.try_enqueue(std::string(20, 'y')));
+  EXPECT_EQ(queue.size(), 2u);
+  queue.dequeue();
+  EXPECT_EQ(queue.front(), std::string(20, 'y'));
+  queue.enqueue("z");
+  queue.dequeue();
+  EXPECT_EQ(queue.front(), "z");
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(mapped_queue_fixture, records_wraparound)
+{
+  auto file = path("records_wrap");
+  std::vector<std::string> expected;
+  {
+    ds::mapped_record_queue queue {file, 256, ds::sync_policy::batch, 7};
+    auto next_in = 0;
+    std::size_t next_out = 0;
+    std::vector<std::string> all;
+    auto make = [] (int i) {
+      return std::string(static_cast<std::size_t>(i % 37), static_cast<char>('a' + i % 26));
+    };
+    for (auto round = 0; round < 50; ++round) {
+      while (queue.try_enqueue(make(next_in)))
+        all.push_back(make(next_in++));
+      for (auto i = 0; i < 3; ++i, ++next_out) {
+        ASSERT_EQ(queue.front(), all[next_out]);
+        queue.dequeue();
+      }
+    }
+    expected.assign(all.begin() + static_cast<std::ptrdiff_t>(next_out), all.end());
+    EXPECT_EQ(queue.to_vector(), expected);
+  }
+  ds::mapped_record_queue queue {file, 256};
+  EXPECT_EQ(queue.to_vector(), expected);
+}
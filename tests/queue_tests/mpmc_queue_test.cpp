@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "algol/ds/queue/mpmc_queue.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+TEST(mpmc_queue_test, empty)
+{
+  ds::mpmc_queue<int, 8> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.full());
+  EXPECT_EQ(queue.size(), 0u);
+  int value = 42;
+  EXPECT_FALSE(queue.try_dequeue(value));
+  EXPECT_EQ(value, 42);
+  EXPECT_THROW(queue.dequeue(), ds::queue_empty_error);
+}
+
+TEST(mpmc_queue_test, full)
+{
+  ds::mpmc_queue<int, 3> queue;
+  for (auto i = 0; i < 3; ++i)
+    EXPECT_TRUE(queue.try_enqueue(i));
+  EXPECT_TRUE(queue.full());
+  EXPECT_EQ(queue.size(), 3u);
+  EXPECT_FALSE(queue.try_enqueue(3));
+  EXPECT_THROW(queue.enqueue(3), ds::queue_full_error);
+  EXPECT_EQ(queue.dequeue(), 0);
+  EXPECT_FALSE(queue.full());
+}
+
+TEST(mpmc_queue_test, fifo_wraparound)
+{
+  // power of two capacity uses the mask, the other one the modulo
+  ds::mpmc_queue<int, 4> pow2;
+  ds::mpmc_queue<int, 5> other;
+  auto next_in = 0, next_out = 0;
+  for (auto round = 0; round < 100; ++round) {
+    for (auto i = 0; i < 3; ++i, ++next_in) {
+      pow2.enqueue(next_in);
+      other.wait_enqueue(next_in);
+    }
+    for (auto i = 0; i < 3; ++i, ++next_out) {
+      int value = -1;
+      EXPECT_TRUE(pow2.try_dequeue(value));
+      EXPECT_EQ(value, next_out);
+      other.wait_dequeue(value);
+      EXPECT_EQ(value, next_out);
+    }
+  }
+  EXPECT_TRUE(pow2.empty());
+  EXPECT_TRUE(other.empty());
+}
+
+TEST(mpmc_queue_test, move_only)
+{
+  ds::mpmc_queue<std::unique_ptr<int>, 4> queue;
+  auto item = std::make_unique<int>(1);
+  EXPECT_TRUE(queue.try_enqueue(std::move(item)));
+  EXPECT_EQ(item, nullptr);
+  queue.enqueue(std::make_unique<int>(2));
+  EXPECT_EQ(*queue.dequeue(), 1);
+  std::unique_ptr<int> value;
+  queue.wait_dequeue(value);
+  EXPECT_EQ(*value, 2);
+}
+
+TEST(mpmc_queue_test, failed_enqueue_does_not_move)
+{
+  ds::mpmc_queue<std::unique_ptr<int>, 2> queue;
+  queue.enqueue(std::make_unique<int>(1));
+  queue.enqueue(std::make_unique<int>(1));
+  auto item = std::make_unique<int>(2);
+  EXPECT_FALSE(queue.try_enqueue(std::move(item)));
+  ASSERT_NE(item, nullptr);
+  EXPECT_EQ(*item, 2);
+}
+
+TEST(mpmc_queue_test, destroy)
+{
+  auto item = std::make_shared<int>(0);
+  {
+    ds::mpmc_queue<std::shared_ptr<int>, 4> queue;
+    for (auto i = 0; i < 6; ++i) {
+      queue.enqueue(item);
+      if (i % 2 == 0)
+        queue.dequeue();
+    }
+    EXPECT_EQ(item.use_count(), 4);
+  }
+  EXPECT_EQ(item.use_count(), 1);
+}
+
+// every producer enqueues the values producer * items + i, every value must be dequeued exactly once
+// and the values of a producer seen by a consumer must be increasing
+template <typename Enqueue, typename Dequeue>
+void producers_consumers (int producers, int consumers, int items, Enqueue enqueue, Dequeue dequeue)
+{
+  std::vector<std::vector<int>> dequeued(static_cast<std::size_t>(consumers));
+  std::vector<std::thread> threads;
+  for (auto p = 0; p < producers; ++p)
+    threads.emplace_back([p, items, &enqueue] {
+      for (auto i = 0; i < items; ++i)
+        enqueue(p * items + i);
+    });
+  auto total = producers * items;
+  for (auto c = 0; c < consumers; ++c)
+    threads.emplace_back([c, total, consumers, &dequeue, &dequeued] {
+      auto& out = dequeued[static_cast<std::size_t>(c)];
+      // the consumers share the items evenly, the first takes the remainder
+      auto count = total / consumers + (c == 0 ? total % consumers : 0);
+      for (auto i = 0; i < count; ++i)
+        out.push_back(dequeue());
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  auto in_order = true;
+  std::vector<int> all;
+  for (auto const& out : dequeued) {
+    std::vector<int> last(static_cast<std::size_t>(producers), -1);
+    for (auto value : out) {
+      auto& previous = last[static_cast<std::size_t>(value / items)];
+      in_order = in_order && previous < value;
+      previous = value;
+    }
+    all.insert(std::end(all), std::begin(out), std::end(out));
+  }
+  EXPECT_TRUE(in_order);
+  std::sort(std::begin(all), std::end(all));
+  ASSERT_EQ(all.size(), static_cast<std::size_t>(total));
+  for (auto i = 0; i < total; ++i)
+    EXPECT_EQ(all[static_cast<std::size_t>(i)], i);
+}
+
+TEST(mpmc_queue_test, try_producers_consumers)
+{
+  ds::mpmc_queue<int, 64> queue;
+  producers_consumers(4, 4, 20000,
+                      [&queue] (int value) {
+                        while (!queue.try_enqueue(value))
+                          std::this_thread::yield();
+                      },
+                      [&queue] {
+                        int value;
+                        while (!queue.try_dequeue(value))
+                          std::this_thread::yield();
+                        return value;
+                      });
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(mpmc_queue_test, wait_producers_consumers)
+{
+  // a small queue makes the producers and the consumers block often
+  ds::mpmc_queue<int, 2> queue;
+  producers_consumers(3, 5, 20000,
+                      [&queue] (int value) { queue.wait_enqueue(value); },
+                      [&queue] {
+                        int value;
+                        queue.wait_dequeue(value);
+                        return value;
+                      });
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,181 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algol/ds/queue/fixed_queue.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+#include "algol/ds/queue/mpmc_queue.hpp"
+#include "algol/ds/queue/spsc_queue.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+namespace {
+  struct queue_allocation_log {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+  };
+
+  // the allocators with different ids are not equal, they do not propagate
+  template <typename T>
+  struct queue_tracking_allocator {
+    using value_type = T;
+
+    queue_tracking_allocator (int id, queue_allocation_log* log) noexcept : id {id}, log {log}
+    {}
+
+    template <typename U>
+    queue_tracking_allocator (queue_tracking_allocator<U> const& other) noexcept : id {other.id}, log {other.log}
+    {}
+
+    T* allocate (std::size_t n)
+    {
+      ++log->allocations;
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate (T* p, std::size_t n) noexcept
+    {
+      ++log->deallocations;
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator== (queue_tracking_allocator<U> const& rhs) const noexcept
+    {
+      return id == rhs.id;
+    }
+
+    template <typename U>
+    bool operator!= (queue_tracking_allocator<U> const& rhs) const noexcept
+    {
+      return id != rhs.id;
+    }
+
+    int id;
+    queue_allocation_log* log;
+  };
+}
+
+class queue_allocator_fixture : public ::testing::Test {
+protected:
+  using allocator = queue_tracking_allocator<int>;
+
+  queue_allocation_log log1;
+  queue_allocation_log log2;
+};
+
+TEST_F(queue_allocator_fixture, linked_queue_nodes)
+{
+  {
+    ds::linked_queue<int, allocator> queue {allocator{1, &log1}};
+    // the front and rear sentinel nodes
+    EXPECT_EQ(log1.allocations, 2u);
+    for (auto i = 0; i < 10; ++i)
+      queue.enqueue(i);
+    EXPECT_EQ(log1.allocations, 12u);
+    queue.dequeue();
+    EXPECT_EQ(log1.deallocations, 1u);
+    EXPECT_EQ(queue.front(), 1);
+    EXPECT_EQ(queue.get_allocator().id, 1);
+  }
+  EXPECT_EQ(log1.allocations, log1.deallocations);
+}
+
+TEST_F(queue_allocator_fixture, fixed_queue_array)
+{
+  {
+    ds::fixed_queue<int, 100, allocator> queue {{1, 2, 3}, allocator{1, &log1}};
+    EXPECT_EQ(log1.allocations, 1u);
+    queue.enqueue(4);
+    EXPECT_EQ(log1.allocations, 1u);
+    EXPECT_EQ(queue.front(), 1);
+  }
+  EXPECT_EQ(log1.deallocations, 1u);
+}
+
+TEST_F(queue_allocator_fixture, copy_and_move)
+{
+  ds::linked_queue<int, allocator> queue {{1, 2, 3}, allocator{1, &log1}};
+  ds::linked_queue<int, allocator> copy {queue, allocator{2, &log2}};
+  EXPECT_EQ(copy.get_allocator().id, 2);
+  EXPECT_EQ(log2.allocations, 5u);
+  EXPECT_EQ(copy, queue);
+
+  // the nodes cannot be stolen, the items are moved into nodes allocated by copy
+  copy = std::move(queue);
+  EXPECT_EQ(copy.get_allocator().id, 2);
+  EXPECT_EQ(copy.to_vector(), (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(queue.empty());
+
+  // wrap the fixed queue around before moving it
+  ds::fixed_queue<int, 4, allocator> fixed {{0, 0, 1, 2}, allocator{1, &log1}};
+  fixed.dequeue();
+  fixed.dequeue();
+  fixed.enqueue(3);
+  ds::fixed_queue<int, 4, allocator> fixed_other {std::move(fixed), allocator{2, &log2}};
+  EXPECT_EQ(fixed_other.get_allocator().id, 2);
+  EXPECT_EQ(fixed_other.to_vector(), (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(fixed.empty());
+
+  // the array is stolen
+  auto allocations = log2.allocations;
+  ds::fixed_queue<int, 4, allocator> fixed_moved {std::move(fixed_other), allocator{2, &log2}};
+  EXPECT_EQ(log2.allocations, allocations);
+  EXPECT_EQ(fixed_moved.to_vector(), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(queue_allocator_fixture, ring_buffers)
+{
+  {
+    ds::spsc_queue<int, 16, allocator> spsc {{1, 2, 3}, allocator{1, &log1}};
+    ds::mpmc_queue<int, 16, allocator> mpmc {allocator{1, &log1}};
+    EXPECT_EQ(log1.allocations, 2u);
+    EXPECT_EQ(spsc.front(), 1);
+    spsc.dequeue();
+    mpmc.enqueue(4);
+    EXPECT_EQ(mpmc.dequeue(), 4);
+    EXPECT_EQ(spsc.get_allocator().id, 1);
+    EXPECT_EQ(mpmc.get_allocator().id, 1);
+  }
+  EXPECT_EQ(log1.deallocations, 2u);
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+TEST_F(queue_allocator_fixture, pmr_pool)
+{
+  std::pmr::unsynchronized_pool_resource pool;
+  ds::pmr::linked_queue<int> queue {&pool};
+  for (auto round = 0; round < 3; ++round) {
+    for (auto i = 0; i < 100; ++i)
+      queue.enqueue(i);
+    for (auto i = 0; i < 100; ++i) {
+      EXPECT_EQ(queue.front(), i);
+      queue.dequeue();
+    }
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.get_allocator().resource(), &pool);
+
+  ds::pmr::spsc_queue<int, 8> spsc {&pool};
+  ds::pmr::mpmc_queue<int, 8> mpmc {&pool};
+  EXPECT_EQ(spsc.get_allocator().resource(), &pool);
+  EXPECT_EQ(mpmc.get_allocator().resource(), &pool);
+}
+
+TEST_F(queue_allocator_fixture, pmr_uses_allocator)
+{
+  std::pmr::monotonic_buffer_resource arena;
+  ds::pmr::linked_queue<std::pmr::string> queue {&arena};
+  queue.enqueue(std::pmr::string {"an item long enough to be allocated from the resource"});
+  // the item is constructed with the allocator of the queue
+  EXPECT_EQ(queue.front().get_allocator().resource(), &arena);
+
+  ds::pmr::fixed_queue<std::pmr::string, 4> fixed {&arena};
+  fixed.emplace("an item long enough to be allocated from the resource");
+  EXPECT_EQ(fixed.front().get_allocator().resource(), &arena);
+}
+#endif
@@ -0,0 +1,198 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "algol/ds/queue/fixed_queue.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+#include "algol/algorithms/queue/sort.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+// dequeue every item, the first dequeued is the front
+template <typename Q>
+std::vector<typename Q::value_type> dequeue_all (Q& queue)
+{
+  std::vector<typename Q::value_type> values;
+  while (!queue.empty()) {
+    values.push_back(queue.front());
+    queue.dequeue();
+  }
+  return values;
+}
+
+class queue_sort_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-100000, 100000);
+    random.resize(1000);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted = random;
+    std::sort(std::begin(sorted), std::end(sorted));
+  }
+
+  std::vector<int> random;
+  std::vector<int> sorted;
+};
+
+TEST_F(queue_sort_fixture, radix_sort_empty_and_single)
+{
+  ds::linked_queue<int> queue;
+  algol::algorithms::queue::radix_sort(queue);
+  EXPECT_TRUE(queue.empty());
+
+  queue.enqueue(-7);
+  algol::algorithms::queue::radix_sort(queue);
+  EXPECT_EQ(queue.size(), 1u);
+  EXPECT_EQ(queue.front(), -7);
+}
+
+TEST_F(queue_sort_fixture, radix_sort_signed)
+{
+  ds::linked_queue<int> queue;
+  for (auto v : random)
+    queue.enqueue(v);
+
+  algol::algorithms::queue::radix_sort(queue);
+  EXPECT_EQ(dequeue_all(queue), sorted);
+}
+
+TEST_F(queue_sort_fixture, radix_sort_unsigned_small_radix)
+{
+  ds::fixed_queue<std::uint16_t, 1000> queue;
+  std::vector<std::uint16_t> expected;
+  for (auto v : random) {
+    queue.enqueue(static_cast<std::uint16_t>(v));
+    expected.push_back(static_cast<std::uint16_t>(v));
+  }
+  std::sort(std::begin(expected), std::end(expected));
+
+  algol::algorithms::queue::radix_sort<4>(queue);
+  EXPECT_EQ(dequeue_all(queue), expected);
+}
+
+TEST_F(queue_sort_fixture, radix_sort_key_is_stable)
+{
+  ds::linked_queue<std::pair<char, int>> queue;
+  for (auto i = 0; i < 100; ++i)
+    queue.enqueue({static_cast<char>('a' + (i * 7) % 5), i});
+
+  algol::algorithms::queue::radix_sort(queue, [] (auto const& p) { return p.first; });
+  auto values = dequeue_all(queue);
+  EXPECT_TRUE(std::is_sorted(std::begin(values), std::end(values)));
+}
+
+TEST_F(queue_sort_fixture, radix_sort_moves)
+{
+  ds::linked_queue<operation_counter> queue;
+  for (auto v : random)
+    queue.enqueue(v);
+
+  operation_counter::reset();
+  algol::algorithms::queue::radix_sort(queue, [] (operation_counter const& v) { return static_cast<int>(v); });
+  // 4 passes of 8 bits, each item is moved in a bucket and back
+  EXPECT_EQ(operation_counter::moves(), 1000u * 4u * 2u);
+  EXPECT_EQ(operation_counter::assignments(), 0u);
+  EXPECT_EQ(operation_counter::less_comparisons(), 0u);
+
+  std::vector<operation_counter> expected(std::begin(sorted), std::end(sorted));
+  EXPECT_EQ(dequeue_all(queue), expected);
+}
+
+TEST_F(queue_sort_fixture, merge_sort_empty_and_single)
+{
+  ds::linked_queue<int> queue;
+  algol::algorithms::queue::merge_sort(queue);
+  EXPECT_TRUE(queue.empty());
+
+  queue.enqueue(42);
+  algol::algorithms::queue::merge_sort(queue);
+  EXPECT_EQ(queue.size(), 1u);
+  EXPECT_EQ(queue.front(), 42);
+}
+
+TEST_F(queue_sort_fixture, merge_sort_linked_queue)
+{
+  ds::linked_queue<int> queue;
+  for (auto v : random)
+    queue.enqueue(v);
+
+  algol::algorithms::queue::merge_sort(queue);
+  EXPECT_EQ(dequeue_all(queue), sorted);
+}
+
+TEST_F(queue_sort_fixture, merge_sort_fixed_queue)
+{
+  ds::fixed_queue<int, 1000> queue;
+  for (auto v : random)
+    queue.enqueue(v);
+
+  algol::algorithms::queue::merge_sort(queue, std::greater<>{});
+  std::reverse(std::begin(sorted), std::end(sorted));
+  EXPECT_EQ(dequeue_all(queue), sorted);
+}
+
+TEST_F(queue_sort_fixture, merge_sort_odd_sizes)
+{
+  for (auto n : {2, 3, 5, 7, 31, 33, 100}) {
+    ds::linked_queue<int> queue;
+    for (auto i = 0; i < n; ++i)
+      queue.enqueue(random[i]);
+    std::vector<int> expected(std::begin(random), std::begin(random) + n);
+    std::sort(std::begin(expected), std::end(expected));
+
+    algol::algorithms::queue::merge_sort(queue);
+    EXPECT_EQ(dequeue_all(queue), expected);
+  }
+}
+
+TEST_F(queue_sort_fixture, merge_sort_is_stable)
+{
+  ds::linked_queue<std::pair<int, int>> queue;
+  for (auto i = 0; i < 100; ++i)
+    queue.enqueue({(i * 7) % 5, i});
+
+  algol::algorithms::queue::merge_sort(queue, [] (auto const& x, auto const& y) { return x.first < y.first; });
+  auto values = dequeue_all(queue);
+  EXPECT_TRUE(std::is_sorted(std::begin(values), std::end(values)));
+}
+
+TEST_F(queue_sort_fixture, merge_sort_strings)
+{
+  ds::linked_queue<std::string> queue;
+  std::vector<std::string> expected;
+  for (auto v : random) {
+    queue.enqueue(std::to_string(v));
+    expected.push_back(std::to_string(v));
+  }
+  std::sort(std::begin(expected), std::end(expected));
+
+  algol::algorithms::queue::merge_sort(queue);
+  EXPECT_EQ(dequeue_all(queue), expected);
+}
+
+TEST_F(queue_sort_fixture, merge_sort_moves_and_comparisons)
+{
+  ds::linked_queue<operation_counter> queue;
+  for (auto v : random)
+    queue.enqueue(v);
+
+  operation_counter::reset();
+  algol::algorithms::queue::merge_sort(queue);
+  // n = 1000, 10 passes, each item is moved twice for each pass
+  EXPECT_LE(operation_counter::less_comparisons(), 1000u * 10u);
+  EXPECT_EQ(operation_counter::moves(), 1000u * 10u * 2u);
+  EXPECT_EQ(operation_counter::assignments(), 0u);
+
+  std::vector<operation_counter> expected(std::begin(sorted), std::end(sorted));
+  EXPECT_EQ(dequeue_all(queue), expected);
+}
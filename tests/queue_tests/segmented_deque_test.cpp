@@ -0,0 +1,309 @@
+#include <vector>
+#include <iterator>
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+
+#include "algol/ds/queue/segmented_deque.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+namespace {
+  // counts the chunks allocated
+  template <typename T>
+  struct chunk_counting_allocator {
+    using value_type = T;
+
+    explicit chunk_counting_allocator (std::size_t* allocations) noexcept : allocations {allocations}
+    {}
+
+    template <typename U>
+    chunk_counting_allocator (chunk_counting_allocator<U> const& rhs) noexcept : allocations {rhs.allocations}
+    {}
+
+    T* allocate (std::size_t n)
+    {
+      ++*allocations;
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate (T* p, std::size_t n) noexcept
+    {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator== (chunk_counting_allocator<U> const& rhs) const noexcept
+    {
+      return allocations == rhs.allocations;
+    }
+
+    template <typename U>
+    bool operator!= (chunk_counting_allocator<U> const& rhs) const noexcept
+    {
+      return allocations != rhs.allocations;
+    }
+
+    std::size_t* allocations;
+  };
+}
+
+// three items per chunk, the chunk boundaries are crossed often
+class segmented_deque_fixture : public ::testing::Test {
+protected:
+  ds::segmented_deque<operation_counter, 3> op_count_deque;
+};
+
+TEST_F(segmented_deque_fixture, axioms)
+{
+  // Note: Axioms for the ADT queue
+  // new queue is empty and not full
+  EXPECT_TRUE(op_count_deque.empty());
+  EXPECT_FALSE(op_count_deque.full());
+  // new queue is throws queue_empty_error on dequeue
+  EXPECT_THROW(op_count_deque.dequeue(), ds::queue_empty_error);
+  // new queue is throws queue_empty_error on front
+  EXPECT_THROW(op_count_deque.front(), ds::queue_empty_error);
+  op_count_deque.enqueue(1);
+  // a queue with one item is not empty
+  EXPECT_FALSE(op_count_deque.empty());
+  // a queue with one item on front return that item
+  EXPECT_EQ(op_count_deque.front(), 1);
+  // a queue with one item does not throw on dequeue
+  EXPECT_NO_THROW(op_count_deque.dequeue());
+  op_count_deque.enqueue(1);
+  auto size = op_count_deque.size();
+  op_count_deque.enqueue(2);
+  // an enqueue increase the size of the queue by 1
+  EXPECT_EQ(op_count_deque.size(), size + 1u);
+  // the front is the item least recently enqueued
+  EXPECT_EQ(op_count_deque.front(), 1);
+  size = op_count_deque.size();
+  op_count_deque.dequeue();
+  // a dequeue decrease the size of the queue by 1
+  EXPECT_EQ(op_count_deque.size(), size - 1u);
+}
+
+TEST_F(segmented_deque_fixture, both_ends)
+{
+  EXPECT_THROW(op_count_deque.back(), ds::queue_empty_error);
+  EXPECT_THROW(op_count_deque.pop_back(), ds::queue_empty_error);
+  EXPECT_THROW(op_count_deque.pop_front(), ds::queue_empty_error);
+
+  for (operation_counter i = 0; i < 5; ++i) {
+    op_count_deque.push_back(i);
+    op_count_deque.push_front(-i - 1);
+  }
+  EXPECT_EQ(op_count_deque.size(), 10u);
+  EXPECT_EQ(op_count_deque.front(), -5);
+  EXPECT_EQ(op_count_deque.back(), 4);
+  EXPECT_EQ(op_count_deque.to_vector(), (std::vector<operation_counter>{-5, -4, -3, -2, -1, 0, 1, 2, 3, 4}));
+
+  // loop invariant: the items popped at the back are the most recently pushed at the back
+  for (auto i = 4; i >= 0; --i) {
+    EXPECT_EQ(op_count_deque.back(), i);
+    op_count_deque.pop_back();
+  }
+  // the front chunks hold the rest of the items
+  EXPECT_EQ(op_count_deque.back(), -1);
+  op_count_deque.pop_front();
+  EXPECT_EQ(op_count_deque.front(), -4);
+  op_count_deque.emplace_back(7);
+  op_count_deque.emplace_front(-7);
+  EXPECT_EQ(op_count_deque.to_vector(), (std::vector<operation_counter>{-7, -4, -3, -2, -1, 7}));
+  op_count_deque.clear();
+  EXPECT_TRUE(op_count_deque.empty());
+
+  // an empty deque grows at the front as well
+  op_count_deque.push_front(1);
+  op_count_deque.push_front(0);
+  op_count_deque.push_back(2);
+  EXPECT_EQ(op_count_deque.to_vector(), (std::vector<operation_counter>{0, 1, 2}));
+}
+
+TEST_F(segmented_deque_fixture, stable_references)
+{
+  op_count_deque.enqueue(0);
+  auto const* first = &op_count_deque.front();
+  for (operation_counter i = 1; i < 100; ++i) {
+    if (i % 2 == 0)
+      op_count_deque.push_back(i);
+    else
+      op_count_deque.push_front(i);
+  }
+  // the items are never moved while the deque grows at either end
+  EXPECT_EQ(*first, 0);
+  while (op_count_deque.back() != 0)
+    op_count_deque.pop_back();
+  EXPECT_EQ(&op_count_deque.back(), first);
+  while (op_count_deque.front() != 0)
+    op_count_deque.pop_front();
+  EXPECT_EQ(&op_count_deque.front(), first);
+  EXPECT_EQ(op_count_deque.size(), 1u);
+}
+
+TEST_F(segmented_deque_fixture, chunks_recycled)
+{
+  std::size_t allocations = 0;
+  ds::segmented_deque<int, 4, chunk_counting_allocator<int>> deque {chunk_counting_allocator<int>{&allocations}};
+
+  for (auto i = 0; i < 16; ++i)
+    deque.enqueue(i);
+  EXPECT_EQ(allocations, 4u);
+  // a queue in steady state takes the chunks emptied at the front for the back
+  for (auto i = 16; i < 1000; ++i) {
+    deque.enqueue(i);
+    EXPECT_EQ(deque.front(), i - 16);
+    deque.dequeue();
+  }
+  EXPECT_LE(allocations, 5u);
+  EXPECT_EQ(deque.size(), 16u);
+
+  deque.clear();
+  deque.shrink_to_fit();
+  EXPECT_EQ(deque.capacity(), 0u);
+  deque.reserve(9);
+  EXPECT_EQ(deque.capacity(), 12u);
+  auto reserved = allocations;
+  for (auto i = 0; i < 12; ++i)
+    deque.push_front(i);
+  EXPECT_EQ(allocations, reserved);
+}
+
+TEST_F(segmented_deque_fixture, copy_move_swap)
+{
+  ds::segmented_deque<std::string, 2> deque {"one", "two", "three", "four", "five"};
+  auto copy = deque;
+  EXPECT_TRUE(copy == deque);
+  EXPECT_EQ(copy.to_vector(), (std::vector<std::string>{"one", "two", "three", "four", "five"}));
+
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(moved == deque);
+
+  ds::segmented_deque<std::string, 2> other {"six"};
+  swap(other, moved);
+  EXPECT_EQ(other.size(), 5u);
+  EXPECT_EQ(moved.front(), "six");
+
+  moved = other;
+  EXPECT_TRUE(moved == other);
+  other = ds::segmented_deque<std::string, 2> {"seven"};
+  EXPECT_EQ(other.front(), "seven");
+  EXPECT_EQ(other.size(), 1u);
+}
+
+TEST_F(segmented_deque_fixture, comparisons)
+{
+  ds::segmented_deque<int, 2> deque {1, 2, 3};
+  ds::segmented_deque<int, 2> other {2, 3};
+  // equal items held at different positions of the chunks
+  other.push_front(1);
+  EXPECT_TRUE(deque == other);
+  EXPECT_FALSE(deque < other);
+  EXPECT_TRUE(deque <= other);
+  other.push_back(4);
+  // a prefix is less than the longer deque
+  EXPECT_TRUE(deque != other);
+  EXPECT_TRUE(deque < other);
+  other.pop_front();
+  // the items are compared from the front
+  EXPECT_TRUE(deque < other);
+  EXPECT_TRUE(other > deque);
+  EXPECT_TRUE(other >= deque);
+}
+
+TEST_F(segmented_deque_fixture, using_interface)
+{
+  ds::queue<operation_counter>& queue = op_count_deque;
+  for (operation_counter i = 0; i < 7; ++i)
+    queue.enqueue(i);
+  EXPECT_EQ(queue.size(), 7u);
+  EXPECT_EQ(queue.front(), 0);
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_THROW(queue.dequeue(), ds::queue_empty_error);
+}
+
+namespace {
+  // the copy constructor throws when countdown reaches 0
+  struct throwing_item {
+    explicit throwing_item (int value) : value {value}
+    {}
+
+    throwing_item (throwing_item const& rhs) : value {rhs.value}
+    {
+      if (countdown-- == 0)
+        throw std::runtime_error{"copy"};
+    }
+
+    int value;
+    static inline int countdown = -1;
+  };
+}
+
+TEST_F(segmented_deque_fixture, bulk)
+{
+  std::vector<operation_counter> items {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  op_count_deque.push_front(-1);
+  // the range is copied a chunk at a time at the back
+  op_count_deque.enqueue_range(items.begin(), items.end());
+  EXPECT_EQ(op_count_deque.size(), 11u);
+  EXPECT_EQ(op_count_deque.back(), 9);
+
+  std::vector<operation_counter> dequeued;
+  op_count_deque.dequeue_n(std::back_inserter(dequeued), 8);
+  EXPECT_EQ(dequeued, (std::vector<operation_counter>{-1, 0, 1, 2, 3, 4, 5, 6}));
+  EXPECT_THROW(op_count_deque.dequeue_n(std::back_inserter(dequeued), 4), ds::queue_empty_error);
+  EXPECT_EQ(op_count_deque.to_vector(), (std::vector<operation_counter>{7, 8, 9}));
+  op_count_deque.dequeue_n(std::back_inserter(dequeued), 3);
+  EXPECT_TRUE(op_count_deque.empty());
+  // the chunks emptied by dequeue_n are on the free list
+  EXPECT_EQ(op_count_deque.capacity(), 15u);
+
+  // a copy that throws in a later chunk leaves the deque unchanged
+  ds::segmented_deque<throwing_item, 2> deque {throwing_item{0}};
+  std::vector<throwing_item> throwing_items {throwing_item{1}, throwing_item{2}, throwing_item{3}, throwing_item{4}};
+  throwing_item::countdown = 2;
+  EXPECT_THROW(deque.enqueue_range(throwing_items.begin(), throwing_items.end()), std::runtime_error);
+  throwing_item::countdown = -1;
+  EXPECT_EQ(deque.size(), 1u);
+  EXPECT_EQ(deque.back().value, 0);
+  deque.enqueue_range(throwing_items.begin(), throwing_items.end());
+  EXPECT_EQ(deque.size(), 5u);
+  EXPECT_EQ(deque.back().value, 4);
+}
+
+namespace {
+  struct const_item {
+    explicit const_item (int v) : value {v}
+    {}
+
+    int const value;
+  };
+}
+
+TEST_F(segmented_deque_fixture, const_member)
+{
+  // a slot reused by an item with a const member is reached through std::launder
+  ds::segmented_deque<const_item, 2> deque;
+  deque.emplace_back(1);
+  deque.emplace_back(2);
+  deque.pop_back();
+  deque.emplace_back(3);
+  EXPECT_EQ(deque.back().value, 3);
+  deque.pop_front();
+  deque.emplace_front(4);
+  EXPECT_EQ(deque.front().value, 4);
+  deque.emplace_back(5);
+  std::vector<const_item> dequeued;
+  deque.dequeue_n(std::back_inserter(dequeued), 3);
+  ASSERT_EQ(dequeued.size(), 3u);
+  EXPECT_EQ(dequeued[0].value, 4);
+  EXPECT_EQ(dequeued[1].value, 3);
+  EXPECT_EQ(dequeued[2].value, 5);
+}
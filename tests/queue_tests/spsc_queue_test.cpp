@@ -0,0 +1,231 @@
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "algol/ds/queue/concepts.hpp"
+#include "algol/ds/queue/spsc_queue.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+static_assert(algol::concepts::Queue<ds::spsc_queue<int, 8>>());
+static_assert(alignof(ds::spsc_queue<int, 8>) == ds::cache_line_size);
+
+class spsc_queue_fixture : public ::testing::Test {
+protected:
+  ds::spsc_queue<operation_counter, 100> op_count_queue;
+};
+
+TEST_F(spsc_queue_fixture, axioms)
+{
+  // Note: Axioms for the ADT queue
+  // new queue is empty and not full
+  EXPECT_TRUE(op_count_queue.empty());
+  EXPECT_FALSE(op_count_queue.full());
+  // new queue is throws queue_empty_error on dequeue
+  EXPECT_THROW(op_count_queue.dequeue(), ds::queue_empty_error);
+  // new queue is throws queue_empty_error on front
+  EXPECT_THROW(op_count_queue.front(), ds::queue_empty_error);
+  op_count_queue.enqueue(1);
+  // a queue with one item is not empty
+  EXPECT_FALSE(op_count_queue.empty());
+  // a queue with one item on front return that item
+  EXPECT_EQ(op_count_queue.front(), 1);
+  // a queue with one item does not throw on dequeue
+  EXPECT_NO_THROW(op_count_queue.dequeue());
+  op_count_queue.enqueue(1);
+  auto size = op_count_queue.size();
+  op_count_queue.enqueue(2);
+  // an enqueue increase the size of the queue by 1
+  EXPECT_EQ(op_count_queue.size(), size + 1u);
+  size = op_count_queue.size();
+  op_count_queue.dequeue();
+  // a dequeue decrease the size of the queue by 1
+  EXPECT_EQ(op_count_queue.size(), size - 1u);
+}
+
+TEST_F(spsc_queue_fixture, initializer_list)
+{
+  ds::spsc_queue<int, 6> queue {1, 2, 3, 4, 5, 6};
+  EXPECT_TRUE(queue.full());
+  EXPECT_EQ(queue.size(), 6u);
+  for (auto i = 1; i <= 6; ++i) {
+    EXPECT_EQ(queue.front(), i);
+    queue.dequeue();
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_THROW((ds::spsc_queue<int, 2> {1, 2, 3}), ds::queue_full_error);
+}
+
+TEST_F(spsc_queue_fixture, full)
+{
+  ds::spsc_queue<int, 4> queue;
+  for (auto i = 0; i < 4; ++i)
+    EXPECT_TRUE(queue.try_enqueue(i));
+  EXPECT_TRUE(queue.full());
+  EXPECT_FALSE(queue.try_enqueue(4));
+  EXPECT_THROW(queue.enqueue(4), ds::queue_full_error);
+  EXPECT_EQ(queue.size(), 4u);
+  EXPECT_EQ(queue.front(), 0);
+}
+
+TEST_F(spsc_queue_fixture, wraparound)
+{
+  // power of two capacity uses the mask, the other one the modulo
+  ds::spsc_queue<int, 8> pow2;
+  ds::spsc_queue<int, 5> other;
+  auto next_in = 0, next_out = 0;
+  for (auto round = 0; round < 100; ++round) {
+    for (auto i = 0; i < 3; ++i, ++next_in) {
+      pow2.enqueue(next_in);
+      other.enqueue(next_in);
+    }
+    for (auto i = 0; i < 3; ++i, ++next_out) {
+      int a = -1, b = -1;
+      EXPECT_TRUE(pow2.try_dequeue(a));
+      EXPECT_TRUE(other.try_dequeue(b));
+      EXPECT_EQ(a, next_out);
+      EXPECT_EQ(b, next_out);
+    }
+  }
+  EXPECT_TRUE(pow2.empty());
+  EXPECT_TRUE(other.empty());
+  int value = 42;
+  EXPECT_FALSE(other.try_dequeue(value));
+  EXPECT_EQ(value, 42);
+}
+
+TEST_F(spsc_queue_fixture, batch)
+{
+  ds::spsc_queue<int, 5> queue;
+  std::vector<int> in {0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(queue.try_enqueue_n(std::begin(in), in.size()), 5u);
+  EXPECT_TRUE(queue.full());
+  EXPECT_EQ(queue.try_enqueue_n(std::begin(in), in.size()), 0u);
+
+  std::vector<int> out;
+  EXPECT_EQ(queue.try_dequeue_n(std::back_inserter(out), 3), 3u);
+  EXPECT_EQ(out, (std::vector<int> {0, 1, 2}));
+  // the batch wraps around the end of the buffer
+  EXPECT_EQ(queue.try_enqueue_n(std::begin(in) + 5, 3), 3u);
+  EXPECT_EQ(queue.try_dequeue_n(std::back_inserter(out), 10), 5u);
+  EXPECT_EQ(out, in);
+  EXPECT_EQ(queue.try_dequeue_n(std::back_inserter(out), 10), 0u);
+}
+
+TEST_F(spsc_queue_fixture, bulk)
+{
+  ds::spsc_queue<int, 5> queue {0, 1};
+  std::vector<int> in {2, 3, 4, 5};
+  // the room is checked once for the whole range
+  EXPECT_THROW(queue.enqueue_range(in.begin(), in.end()), ds::queue_full_error);
+  EXPECT_EQ(queue.size(), 2u);
+  queue.enqueue_range(in.begin(), in.begin() + 3);
+  EXPECT_TRUE(queue.full());
+
+  std::vector<int> out;
+  EXPECT_THROW(queue.dequeue_n(std::back_inserter(out), 6), ds::queue_empty_error);
+  queue.dequeue_n(std::back_inserter(out), 4);
+  EXPECT_EQ(out, (std::vector<int> {0, 1, 2, 3}));
+  EXPECT_EQ(queue.front(), 4);
+}
+
+TEST_F(spsc_queue_fixture, move_only)
+{
+  ds::spsc_queue<std::unique_ptr<int>, 4> queue;
+  EXPECT_TRUE(queue.try_enqueue(std::make_unique<int>(1)));
+  EXPECT_TRUE(queue.try_emplace(new int {2}));
+  std::vector<std::unique_ptr<int>> in;
+  in.push_back(std::make_unique<int>(3));
+  EXPECT_EQ(queue.try_enqueue_n(std::make_move_iterator(std::begin(in)), 1), 1u);
+
+  std::unique_ptr<int> value;
+  EXPECT_TRUE(queue.try_dequeue(value));
+  EXPECT_EQ(*value, 1);
+  EXPECT_EQ(*queue.front(), 2);
+}
+
+TEST_F(spsc_queue_fixture, destroy)
+{
+  // the items left in the queue are destroyed by clear and by the destructor
+  auto item = std::make_shared<int>(0);
+  {
+    ds::spsc_queue<std::shared_ptr<int>, 3> queue;
+    queue.enqueue(item);
+    queue.enqueue(item);
+    EXPECT_EQ(item.use_count(), 3);
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(item.use_count(), 1);
+    queue.enqueue(item);
+    queue.enqueue(item);
+    queue.dequeue();
+    queue.enqueue(item);
+    queue.enqueue(item);
+    EXPECT_EQ(item.use_count(), 4);
+  }
+  EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST_F(spsc_queue_fixture, producer_consumer)
+{
+  constexpr auto items = 200000;
+  ds::spsc_queue<int, 64> queue;
+
+  std::thread producer {[&queue] {
+    for (auto i = 0; i < items; ++i)
+      while (!queue.try_enqueue(i))
+        std::this_thread::yield();
+  }};
+
+  auto in_order = true;
+  for (auto expected = 0; expected < items; ++expected) {
+    int value;
+    while (!queue.try_dequeue(value))
+      std::this_thread::yield();
+    in_order = in_order && value == expected;
+  }
+  producer.join();
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(spsc_queue_fixture, producer_consumer_batch)
+{
+  constexpr auto items = 200000;
+  ds::spsc_queue<int, 100> queue;
+
+  std::thread producer {[&queue] {
+    std::vector<int> batch(37);
+    for (auto i = 0; i < items;) {
+      auto count = std::min<std::size_t>(batch.size(), static_cast<std::size_t>(items - i));
+      for (std::size_t j = 0; j < count; ++j)
+        batch[j] = i + static_cast<int>(j);
+      auto first = std::begin(batch);
+      while (count > 0) {
+        auto done = queue.try_enqueue_n(first, count);
+        if (done == 0)
+          std::this_thread::yield();
+        first += static_cast<std::ptrdiff_t>(done);
+        count -= done;
+        i += static_cast<int>(done);
+      }
+    }
+  }};
+
+  std::vector<int> out;
+  out.reserve(items);
+  while (out.size() < static_cast<std::size_t>(items))
+    if (queue.try_dequeue_n(std::back_inserter(out), 50) == 0)
+      std::this_thread::yield();
+  producer.join();
+
+  auto in_order = true;
+  for (auto i = 0; i < items; ++i)
+    in_order = in_order && out[static_cast<std::size_t>(i)] == i;
+  EXPECT_TRUE(in_order);
+}
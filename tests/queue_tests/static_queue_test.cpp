@@ -0,0 +1,73 @@
+#include <vector>
+#include <type_traits>
+
+#include "algol/ds/queue/concepts.hpp"
+#include "algol/ds/queue/fixed_queue.hpp"
+#include "algol/ds/queue/linked_queue.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using fixed = ds::fixed_queue<int, 4>;
+using linked = ds::linked_queue<int>;
+
+static_assert(algol::concepts::Queue<fixed>());
+static_assert(algol::concepts::Queue<linked>());
+static_assert(std::is_base_of_v<ds::static_queue<fixed, int>, fixed>);
+static_assert(std::is_base_of_v<ds::queue<int>, fixed>);
+static_assert(std::is_base_of_v<ds::static_queue<linked, int>, linked>);
+
+namespace {
+  // the same operations through the static and the dynamic interface give the same results
+  template <typename S>
+  void same_behaviour ()
+  {
+    S direct;
+    S dynamic_queue;
+    ds::queue<int>& dynamic = dynamic_queue;
+
+    EXPECT_THROW(direct.front(), ds::queue_empty_error);
+    EXPECT_THROW(dynamic.front(), ds::queue_empty_error);
+    EXPECT_THROW(direct.dequeue(), ds::queue_empty_error);
+    EXPECT_THROW(dynamic.dequeue(), ds::queue_empty_error);
+
+    for (auto i = 1; i <= 3; ++i) {
+      direct.enqueue(i);
+      dynamic.enqueue(i);
+    }
+    auto const four = 4;
+    direct.enqueue(four);
+    dynamic.enqueue(four);
+    EXPECT_EQ(direct.size(), dynamic.size());
+    EXPECT_EQ(direct.full(), dynamic.full());
+    EXPECT_EQ(direct.front(), dynamic.front());
+    EXPECT_EQ(direct.to_vector(), dynamic.to_vector());
+
+    direct.dequeue();
+    dynamic.dequeue();
+    EXPECT_EQ(direct.to_vector(), (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(dynamic.to_vector(), (std::vector<int>{2, 3, 4}));
+
+    direct.clear();
+    dynamic.clear();
+    EXPECT_TRUE(direct.empty());
+    EXPECT_TRUE(dynamic.empty());
+  }
+}
+
+TEST(static_queue, fixed_queue)
+{
+  same_behaviour<fixed>();
+
+  // the full queue throws through both interfaces
+  fixed queue {1, 2, 3, 4};
+  ds::queue<int>& dynamic = queue;
+  EXPECT_THROW(queue.enqueue(5), ds::queue_full_error);
+  EXPECT_THROW(dynamic.enqueue(5), ds::queue_full_error);
+  EXPECT_EQ(queue.size(), 4u);
+}
+
+TEST(static_queue, linked_queue)
+{
+  same_behaviour<linked>();
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "algol/ds/queue/work_stealing_deque.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+TEST(work_stealing_deque_test, empty)
+{
+  ds::work_stealing_deque<int> deque;
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(deque.size(), 0u);
+  EXPECT_EQ(deque.capacity(), 64u);
+  EXPECT_FALSE(deque.try_pop().has_value());
+  EXPECT_FALSE(deque.try_steal().has_value());
+  // a failed pop leaves the deque usable
+  deque.push(1);
+  EXPECT_EQ(deque.try_pop(), 1);
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(work_stealing_deque_test, owner_lifo_thief_fifo)
+{
+  ds::work_stealing_deque<int> deque {3};
+  EXPECT_EQ(deque.capacity(), 4u);
+  for (auto i = 0; i < 5; ++i)
+    deque.push(i);
+  EXPECT_EQ(deque.size(), 5u);
+  // the owner takes the last pushed, the thieves the first pushed
+  EXPECT_EQ(deque.try_pop(), 4);
+  EXPECT_EQ(deque.try_steal(), 0);
+  EXPECT_EQ(deque.try_steal(), 1);
+  EXPECT_EQ(deque.try_pop(), 3);
+  EXPECT_EQ(deque.try_pop(), 2);
+  EXPECT_FALSE(deque.try_pop().has_value());
+  EXPECT_FALSE(deque.try_steal().has_value());
+}
+
+TEST(work_stealing_deque_test, growth)
+{
+  ds::work_stealing_deque<int> deque {2};
+  // the positions wrap around the array before it grows
+  for (auto round = 0; round < 3; ++round) {
+    deque.push(round);
+    EXPECT_EQ(deque.try_steal(), round);
+  }
+  for (auto i = 0; i < 1000; ++i)
+    deque.push(i);
+  EXPECT_EQ(deque.capacity(), 1024u);
+  EXPECT_EQ(deque.size(), 1000u);
+  EXPECT_EQ(deque.try_steal(), 0);
+  // loop invariant: the items [1, i] are still in the deque
+  for (auto i = 999; i > 0; --i)
+    EXPECT_EQ(deque.try_pop(), i);
+  EXPECT_TRUE(deque.empty());
+}
+
+// the owner pushes and pops while the thieves steal, every item is taken exactly once
+TEST(work_stealing_deque_test, concurrent_steal)
+{
+  constexpr auto items = 100000;
+  constexpr auto thieves = 3;
+  ds::work_stealing_deque<int> deque {4};
+  std::vector<std::atomic<int>> taken(items);
+  std::atomic<bool> done {false};
+
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < thieves; ++t)
+    threads.emplace_back([&] {
+      while (!done.load(std::memory_order_acquire) || !deque.empty())
+        if (auto value = deque.try_steal())
+          taken[*value].fetch_add(1, std::memory_order_relaxed);
+    });
+  for (auto i = 0; i < items; ++i) {
+    deque.push(i);
+    // the owner pops one item every three pushes, the deque grows and shrinks
+    if (i % 3 == 0)
+      if (auto value = deque.try_pop())
+        taken[*value].fetch_add(1, std::memory_order_relaxed);
+  }
+  while (auto value = deque.try_pop())
+    taken[*value].fetch_add(1, std::memory_order_relaxed);
+  done.store(true, std::memory_order_release);
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_TRUE(deque.empty());
+  EXPECT_TRUE(std::all_of(std::begin(taken), std::end(taken), [] (auto const& count) {
+    return count.load() == 1;
+  }));
+}
@@ -0,0 +1,82 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "algol/algorithms/selection/floyd_rivest.hpp"
+
+#include "gtest/gtest.h"
+
+class floyd_rivest_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-5000, 5000);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted_random = random;
+    std::sort(std::begin(sorted_random), std::end(sorted_random));
+  }
+
+  std::vector<int> vec {-3, 6, 5, 10, -2};
+  std::vector<int> random = std::vector<int>(10000);
+  std::vector<int> sorted_random;
+  std::vector<int> equal = std::vector<int>(5000, 7);
+  std::string str {"BCA"};
+  std::array<char, 10> x {'a', 'b', 'd', 'c', 'h', 'z', 'a', 'y', 'w', 'm'};
+};
+
+TEST_F(floyd_rivest_fixture, select_vec)
+{
+  algol::algorithms::selection::floyd_rivest_select(std::begin(vec), std::begin(vec) + 2, std::end(vec));
+  ASSERT_EQ(vec[2], 5);
+}
+
+TEST_F(floyd_rivest_fixture, select_string)
+{
+  algol::algorithms::selection::floyd_rivest_select(std::begin(str), std::begin(str) + 2, std::end(str));
+  ASSERT_EQ(str[2], 'C');
+}
+
+TEST_F(floyd_rivest_fixture, select_char)
+{
+  algol::algorithms::selection::floyd_rivest_select(std::begin(x), std::begin(x) + 1, std::end(x));
+  ASSERT_EQ(x[1], 'a');
+}
+
+TEST_F(floyd_rivest_fixture, select_greater)
+{
+  algol::algorithms::selection::floyd_rivest_select(std::begin(vec), std::begin(vec), std::end(vec),
+                                                    std::greater<>{});
+  ASSERT_EQ(vec[0], 10);
+}
+
+TEST_F(floyd_rivest_fixture, select_random)
+{
+  for (auto k : {0u, 1u, 17u, 600u, 4999u, 5000u, 9000u, 9999u}) {
+    auto values = random;
+    auto nth = std::begin(values) + k;
+    algol::algorithms::selection::floyd_rivest_select(std::begin(values), nth, std::end(values));
+    ASSERT_EQ(*nth, sorted_random[k]);
+    ASSERT_TRUE(std::all_of(std::begin(values), nth, [nth] (auto v) { return v <= *nth; }));
+    ASSERT_TRUE(std::all_of(nth, std::end(values), [nth] (auto v) { return v >= *nth; }));
+  }
+}
+
+TEST_F(floyd_rivest_fixture, select_sorted)
+{
+  auto values = sorted_random;
+  auto nth = std::begin(values) + 1234;
+  algol::algorithms::selection::floyd_rivest_select(std::begin(values), nth, std::end(values));
+  ASSERT_EQ(*nth, sorted_random[1234]);
+  ASSERT_TRUE(std::all_of(std::begin(values), nth, [nth] (auto v) { return v <= *nth; }));
+  ASSERT_TRUE(std::all_of(nth, std::end(values), [nth] (auto v) { return v >= *nth; }));
+}
+
+TEST_F(floyd_rivest_fixture, select_equal)
+{
+  algol::algorithms::selection::floyd_rivest_select(std::begin(equal), std::begin(equal) + 2500, std::end(equal));
+  ASSERT_EQ(equal[2500], 7);
+}
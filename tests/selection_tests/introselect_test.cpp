@@ -0,0 +1,115 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "algol/algorithms/selection/introselect.hpp"
+
+#include "gtest/gtest.h"
+
+class introselect_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-500, 500);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted_random = random;
+    std::sort(std::begin(sorted_random), std::end(sorted_random));
+  }
+
+  template <typename Select>
+  void check_every_position (Select select)
+  {
+    for (auto k = 0u; k < random.size(); k += 37) {
+      auto vec = random;
+      auto nth = std::begin(vec) + k;
+      select(std::begin(vec), nth, std::end(vec));
+      ASSERT_EQ(*nth, sorted_random[k]);
+      ASSERT_TRUE(std::all_of(std::begin(vec), nth, [nth] (auto v) { return v <= *nth; }));
+      ASSERT_TRUE(std::all_of(nth, std::end(vec), [nth] (auto v) { return v >= *nth; }));
+    }
+  }
+
+  std::vector<int> vec {-3, 6, 5, 10, -2};
+  std::vector<int> random = std::vector<int>(2000);
+  std::vector<int> sorted_random;
+  std::vector<int> equal = std::vector<int>(1000, 7);
+  std::string str {"BCA"};
+  std::array<char, 10> x {'a', 'b', 'd', 'c', 'h', 'z', 'a', 'y', 'w', 'm'};
+};
+
+TEST_F(introselect_fixture, select_vec)
+{
+  algol::algorithms::selection::introselect(std::begin(vec), std::begin(vec) + 2, std::end(vec));
+  ASSERT_EQ(vec[2], 5);
+}
+
+TEST_F(introselect_fixture, select_string)
+{
+  algol::algorithms::selection::introselect(std::begin(str), std::begin(str), std::end(str));
+  ASSERT_EQ(str[0], 'A');
+}
+
+TEST_F(introselect_fixture, select_char)
+{
+  algol::algorithms::selection::introselect(std::begin(x), std::begin(x) + 9, std::end(x));
+  ASSERT_EQ(x[9], 'z');
+}
+
+TEST_F(introselect_fixture, select_greater)
+{
+  algol::algorithms::selection::introselect(std::begin(vec), std::begin(vec) + 1, std::end(vec), std::greater<>{});
+  ASSERT_EQ(vec[1], 6);
+}
+
+TEST_F(introselect_fixture, select_nth_last)
+{
+  auto copy = vec;
+  algol::algorithms::selection::introselect(std::begin(vec), std::end(vec), std::end(vec));
+  ASSERT_EQ(vec, copy);
+}
+
+TEST_F(introselect_fixture, select_random)
+{
+  check_every_position([] (auto first, auto nth, auto last) {
+    algol::algorithms::selection::introselect(first, nth, last);
+  });
+}
+
+TEST_F(introselect_fixture, select_sorted)
+{
+  random = sorted_random;
+  check_every_position([] (auto first, auto nth, auto last) {
+    algol::algorithms::selection::introselect(first, nth, last);
+  });
+}
+
+TEST_F(introselect_fixture, select_equal)
+{
+  algol::algorithms::selection::introselect(std::begin(equal), std::begin(equal) + 500, std::end(equal));
+  ASSERT_EQ(equal[500], 7);
+}
+
+TEST_F(introselect_fixture, quickselect_random)
+{
+  check_every_position([] (auto first, auto nth, auto last) {
+    algol::algorithms::selection::quickselect(first, nth, last);
+  });
+}
+
+TEST_F(introselect_fixture, median_of_medians_random)
+{
+  check_every_position([] (auto first, auto nth, auto last) {
+    algol::algorithms::selection::median_of_medians_select(first, nth, last);
+  });
+}
+
+TEST_F(introselect_fixture, median_of_medians_equal)
+{
+  algol::algorithms::selection::median_of_medians_select(std::begin(equal), std::begin(equal) + 999,
+                                                          std::end(equal));
+  ASSERT_EQ(equal[999], 7);
+}
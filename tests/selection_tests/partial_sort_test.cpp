@@ -0,0 +1,78 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "algol/algorithms/selection/partial_sort.hpp"
+
+#include "gtest/gtest.h"
+
+class partial_sort_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-500, 500);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted_random = random;
+    std::sort(std::begin(sorted_random), std::end(sorted_random));
+  }
+
+  std::array<int, 5> array {-3, 6, 5, 10, -2};
+  std::array<int, 5> sorted_array {-3, -2, 5, 6, 10};
+  std::vector<int> vec {-3, 6, 5, 10, -2};
+  std::vector<int> random = std::vector<int>(1000);
+  std::vector<int> sorted_random;
+  std::string str {"BCA"};
+  std::string sorted_str {"ABC"};
+};
+
+TEST_F(partial_sort_fixture, heap_sort_array)
+{
+  algol::algorithms::selection::heap_sort(std::begin(array), std::end(array));
+  ASSERT_EQ(array, sorted_array);
+}
+
+TEST_F(partial_sort_fixture, heap_sort_string)
+{
+  algol::algorithms::selection::heap_sort(std::begin(str), std::end(str));
+  ASSERT_EQ(str, sorted_str);
+}
+
+TEST_F(partial_sort_fixture, heap_sort_random)
+{
+  algol::algorithms::selection::heap_sort(std::begin(random), std::end(random));
+  ASSERT_EQ(random, sorted_random);
+}
+
+TEST_F(partial_sort_fixture, partial_sort_vec)
+{
+  algol::algorithms::selection::partial_sort(std::begin(vec), std::begin(vec) + 3, std::end(vec));
+  ASSERT_EQ(std::vector<int>(std::begin(vec), std::begin(vec) + 3), (std::vector<int>{-3, -2, 5}));
+}
+
+TEST_F(partial_sort_fixture, partial_sort_greater)
+{
+  algol::algorithms::selection::partial_sort(std::begin(vec), std::begin(vec) + 2, std::end(vec), std::greater<>{});
+  ASSERT_EQ(std::vector<int>(std::begin(vec), std::begin(vec) + 2), (std::vector<int>{10, 6}));
+}
+
+TEST_F(partial_sort_fixture, partial_sort_random)
+{
+  for (auto k : {0u, 1u, 10u, 100u, 999u, 1000u}) {
+    auto values = random;
+    algol::algorithms::selection::partial_sort(std::begin(values), std::begin(values) + k, std::end(values));
+    ASSERT_TRUE(std::equal(std::begin(values), std::begin(values) + k, std::begin(sorted_random)));
+  }
+}
+
+TEST_F(partial_sort_fixture, heap_partial_sort_random)
+{
+  for (auto k : {0u, 1u, 10u, 100u, 999u, 1000u}) {
+    auto values = random;
+    algol::algorithms::selection::heap_partial_sort(std::begin(values), std::begin(values) + k, std::end(values));
+    ASSERT_TRUE(std::equal(std::begin(values), std::begin(values) + k, std::begin(sorted_random)));
+  }
+}
@@ -0,0 +1,97 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include "algol/algorithms/selection/top_k.hpp"
+#include "algol/perf/operation_counter.hpp"
+
+#include "gtest/gtest.h"
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+class top_k_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-500, 500);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted_random = random;
+    std::sort(std::begin(sorted_random), std::end(sorted_random), std::greater<>{});
+  }
+
+  std::vector<int> vec {-3, 6, 5, 10, -2};
+  std::vector<int> random = std::vector<int>(1000);
+  std::vector<int> sorted_random;
+};
+
+TEST_F(top_k_fixture, accumulator)
+{
+  algol::algorithms::selection::top_k_accumulator<int, std::greater<int>> accumulator {3};
+  EXPECT_TRUE(accumulator.empty());
+  EXPECT_EQ(accumulator.capacity(), 3u);
+  EXPECT_TRUE(accumulator.push(1));
+  EXPECT_TRUE(accumulator.push(5));
+  EXPECT_TRUE(accumulator.push(3));
+  EXPECT_TRUE(accumulator.full());
+  EXPECT_EQ(accumulator.top(), 1);
+  EXPECT_FALSE(accumulator.push(0));
+  EXPECT_TRUE(accumulator.push(4));
+  EXPECT_EQ(accumulator.top(), 3);
+  EXPECT_EQ(accumulator.size(), 3u);
+  ASSERT_EQ(accumulator.sorted(), (std::vector<int>{5, 4, 3}));
+  accumulator.clear();
+  EXPECT_TRUE(accumulator.empty());
+}
+
+TEST_F(top_k_fixture, zero_k)
+{
+  algol::algorithms::selection::top_k_accumulator<int> accumulator {0};
+  EXPECT_FALSE(accumulator.push(1));
+  EXPECT_TRUE(accumulator.empty());
+  ASSERT_TRUE(algol::algorithms::selection::top_k(std::begin(vec), std::end(vec), 0).empty());
+}
+
+TEST_F(top_k_fixture, top_k_vec)
+{
+  auto top = algol::algorithms::selection::top_k(std::begin(vec), std::end(vec), 2, std::greater<>{});
+  ASSERT_EQ(top, (std::vector<int>{10, 6}));
+  auto bottom = algol::algorithms::selection::top_k(std::begin(vec), std::end(vec), 2);
+  ASSERT_EQ(bottom, (std::vector<int>{-3, -2}));
+}
+
+TEST_F(top_k_fixture, top_k_greater_than_size)
+{
+  auto top = algol::algorithms::selection::top_k(std::begin(vec), std::end(vec), 10, std::greater<>{});
+  ASSERT_EQ(top, (std::vector<int>{10, 6, 5, -2, -3}));
+}
+
+TEST_F(top_k_fixture, top_k_input_iterator)
+{
+  std::istringstream is {"4 8 15 16 23 42"};
+  auto top = algol::algorithms::selection::top_k(std::istream_iterator<int>{is}, std::istream_iterator<int>{}, 3,
+                                                 std::greater<>{});
+  ASSERT_EQ(top, (std::vector<int>{42, 23, 16}));
+}
+
+TEST_F(top_k_fixture, top_k_random)
+{
+  auto top = algol::algorithms::selection::top_k(std::begin(random), std::end(random), 50, std::greater<>{});
+  ASSERT_TRUE(std::equal(std::begin(top), std::end(top), std::begin(sorted_random)));
+}
+
+TEST_F(top_k_fixture, top_k_operation_counter)
+{
+  std::vector<operation_counter> values(std::begin(random), std::end(random));
+  operation_counter::reset();
+  auto top = algol::algorithms::selection::top_k(std::begin(values), std::end(values), 10, std::greater<>{});
+  ASSERT_EQ(top.size(), 10u);
+  EXPECT_EQ(top[0], sorted_random[0]);
+  // every element is compared at least once with the heap top
+  EXPECT_GE(operation_counter::great_comparisons(), values.size() - 10);
+  EXPECT_LT(operation_counter::great_comparisons(), values.size() * 10);
+}
@@ -0,0 +1,137 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include "algol/algorithms/sort/cached_key_sort.hpp"
+
+#include "gtest/gtest.h"
+
+// element counting its moves, the key is the value
+struct heavy {
+  heavy (int v) : value {v}
+  {}
+
+  heavy (heavy const&) = default;
+
+  heavy (heavy&& other) noexcept : value {other.value}
+  {
+    ++moves;
+  }
+
+  heavy& operator= (heavy const&) = default;
+
+  heavy& operator= (heavy&& other) noexcept
+  {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+
+  int value;
+  static std::size_t moves;
+};
+
+std::size_t heavy::moves = 0;
+
+class cached_key_sort_fixture : public ::testing::Test {
+protected:
+  std::vector<int> vec {-3, 6, 5, 10, -2};
+  std::vector<int> sorted_vec {-3, -2, 5, 6, 10};
+  std::vector<std::string> str {"10", "9", "200", "1", "33"};
+  std::vector<std::string> sorted_str {"1", "9", "10", "33", "200"};
+};
+
+TEST_F(cached_key_sort_fixture, sort_vec)
+{
+  algol::algorithms::sort::cached_key_sort(std::begin(vec), std::end(vec), [] (int x) { return x; });
+  ASSERT_EQ(vec, sorted_vec);
+}
+
+TEST_F(cached_key_sort_fixture, sort_vec_descending)
+{
+  algol::algorithms::sort::cached_key_sort(std::begin(vec), std::end(vec), [] (int x) { return x; },
+                                           std::greater<>{});
+  std::reverse(std::begin(sorted_vec), std::end(sorted_vec));
+  ASSERT_EQ(vec, sorted_vec);
+}
+
+TEST_F(cached_key_sort_fixture, sort_parsed_key)
+{
+  std::size_t calls = 0;
+  algol::algorithms::sort::cached_key_sort(std::begin(str), std::end(str),
+                                           [&calls] (std::string const& s) {
+                                             ++calls;
+                                             return std::stoi(s);
+                                           });
+  ASSERT_EQ(str, sorted_str);
+  ASSERT_EQ(calls, str.size());
+}
+
+TEST_F(cached_key_sort_fixture, sort_empty_and_single)
+{
+  std::vector<int> empty;
+  algol::algorithms::sort::cached_key_sort(std::begin(empty), std::end(empty), [] (int x) { return x; });
+  ASSERT_TRUE(empty.empty());
+
+  std::array<int, 1> single {42};
+  algol::algorithms::sort::cached_key_sort(std::begin(single), std::end(single), [] (int x) { return x; });
+  ASSERT_EQ(single[0], 42);
+}
+
+TEST_F(cached_key_sort_fixture, sort_is_stable)
+{
+  std::vector<std::pair<int, int>> pairs {{2, 0}, {1, 1}, {2, 2}, {1, 3}, {0, 4}, {2, 5}, {1, 6}};
+  std::vector<std::pair<int, int>> sorted_pairs {{0, 4}, {1, 1}, {1, 3}, {1, 6}, {2, 0}, {2, 2}, {2, 5}};
+  algol::algorithms::sort::cached_key_sort(std::begin(pairs), std::end(pairs), &std::pair<int, int>::first);
+  ASSERT_EQ(pairs, sorted_pairs);
+}
+
+TEST_F(cached_key_sort_fixture, sort_random)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> distribution(0, 100);
+  std::vector<int> values(1000);
+  for (auto& v : values)
+    v = distribution(gen);
+  auto expected = values;
+  std::sort(std::begin(expected), std::end(expected));
+
+  algol::algorithms::sort::cached_key_sort(std::begin(values), std::end(values), [] (int x) { return x; });
+  ASSERT_EQ(values, expected);
+}
+
+TEST_F(cached_key_sort_fixture, sorted_input_is_not_moved)
+{
+  std::vector<heavy> values;
+  for (auto i = 0; i < 100; ++i)
+    values.emplace_back(i);
+
+  heavy::moves = 0;
+  algol::algorithms::sort::cached_key_sort(std::begin(values), std::end(values), &heavy::value);
+  ASSERT_EQ(heavy::moves, 0u);
+}
+
+TEST_F(cached_key_sort_fixture, moves_follow_cycles)
+{
+  // reversed range: N/2 cycles of length 2, each costs 3 moves
+  std::vector<heavy> values;
+  for (auto i = 100; i > 0; --i)
+    values.emplace_back(i);
+
+  heavy::moves = 0;
+  algol::algorithms::sort::cached_key_sort(std::begin(values), std::end(values), &heavy::value);
+  ASSERT_EQ(heavy::moves, 150u);
+  for (auto i = 0; i < 100; ++i)
+    ASSERT_EQ(values[i].value, i + 1);
+
+  // rotation by one: a single cycle of length N costs N + 1 moves
+  std::rotate(std::begin(values), std::begin(values) + 1, std::end(values));
+  heavy::moves = 0;
+  algol::algorithms::sort::cached_key_sort(std::begin(values), std::end(values), &heavy::value);
+  ASSERT_EQ(heavy::moves, 101u);
+  for (auto i = 0; i < 100; ++i)
+    ASSERT_EQ(values[i].value, i + 1);
+}
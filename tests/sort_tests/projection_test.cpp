@@ -0,0 +1,115 @@
+#include <vector>
+#include <string>
+#include <functional>
+#include <forward_list>
+#include "algol/algorithms/sort/bogo_sort.hpp"
+#include "algol/algorithms/sort/bubble_sort.hpp"
+#include "algol/algorithms/sort/insertion_sort.hpp"
+#include "algol/algorithms/sort/selection_sort.hpp"
+#include "algol/algorithms/sort/shell_sort.hpp"
+
+#include "gtest/gtest.h"
+
+struct employee {
+  std::string name;
+  int age;
+
+  bool operator== (employee const& other) const
+  {
+    return name == other.name && age == other.age;
+  }
+};
+
+class projection_fixture : public ::testing::Test {
+protected:
+  std::vector<employee> vec {{"carl", 41}, {"anna", 27}, {"bob", 35}, {"dave", 19}, {"eve", 52}};
+  std::vector<employee> sorted_by_age {{"dave", 19}, {"anna", 27}, {"bob", 35}, {"carl", 41}, {"eve", 52}};
+  std::vector<employee> sorted_by_name {{"anna", 27}, {"bob", 35}, {"carl", 41}, {"dave", 19}, {"eve", 52}};
+  std::forward_list<employee> lst {{"carl", 41}, {"anna", 27}, {"bob", 35}, {"dave", 19}, {"eve", 52}};
+  std::forward_list<employee> lst_sorted_by_age {{"dave", 19}, {"anna", 27}, {"bob", 35}, {"carl", 41}, {"eve", 52}};
+};
+
+TEST_F(projection_fixture, bogo_sort_deterministic_member)
+{
+  algol::algorithms::sort::bogo_sort_deterministic(std::begin(vec), std::end(vec), std::less<>{}, &employee::age);
+  ASSERT_EQ(vec, sorted_by_age);
+}
+
+TEST_F(projection_fixture, bubble_sort_member)
+{
+  algol::algorithms::sort::bubble_sort(std::begin(vec), std::end(vec), std::less<>{}, &employee::age);
+  ASSERT_EQ(vec, sorted_by_age);
+}
+
+TEST_F(projection_fixture, bubble_sort_optimized_member)
+{
+  algol::algorithms::sort::bubble_sort_optimized(std::begin(vec), std::end(vec), std::less<>{}, &employee::name);
+  ASSERT_EQ(vec, sorted_by_name);
+}
+
+TEST_F(projection_fixture, bubble_sort_fast_list)
+{
+  algol::algorithms::sort::bubble_sort_fast(std::begin(lst), std::end(lst), std::less<>{}, &employee::age);
+  ASSERT_EQ(lst, lst_sorted_by_age);
+}
+
+TEST_F(projection_fixture, comb_sort_member)
+{
+  algol::algorithms::sort::comb_sort(std::begin(vec), std::end(vec), std::less<>{}, &employee::age);
+  ASSERT_EQ(vec, sorted_by_age);
+}
+
+TEST_F(projection_fixture, insertion_sort_lambda)
+{
+  algol::algorithms::sort::insertion_sort(std::begin(vec), std::end(vec), std::greater<>{},
+                                          [] (employee const& e) { return -e.age; });
+  ASSERT_EQ(vec, sorted_by_age);
+}
+
+TEST_F(projection_fixture, insertion_sort_stl_list)
+{
+  algol::algorithms::sort::insertion_sort_stl(std::begin(lst), std::end(lst), std::less<>{}, &employee::age);
+  ASSERT_EQ(lst, lst_sorted_by_age);
+}
+
+TEST_F(projection_fixture, selection_sort_member)
+{
+  algol::algorithms::sort::selection_sort(std::begin(vec), std::end(vec), std::less<>{}, &employee::name);
+  ASSERT_EQ(vec, sorted_by_name);
+}
+
+TEST_F(projection_fixture, selection_sort_stl_member)
+{
+  algol::algorithms::sort::selection_sort_stl(std::begin(vec), std::end(vec), std::less<>{}, &employee::age);
+  ASSERT_EQ(vec, sorted_by_age);
+}
+
+TEST_F(projection_fixture, shell_sort_member)
+{
+  algol::algorithms::sort::shell_sort(std::begin(vec), std::end(vec), std::less<>{}, &employee::age);
+  ASSERT_EQ(vec, sorted_by_age);
+}
+
+TEST_F(projection_fixture, shell_sort_gaps_member)
+{
+  auto v1 = vec;
+  auto v2 = vec;
+  algol::algorithms::sort::shell_sort_ciura_gaps(std::begin(vec), std::end(vec), std::less<>{}, &employee::age);
+  algol::algorithms::sort::shell_sort_hibbard_gaps(std::begin(v1), std::end(v1), std::less<>{}, &employee::age);
+  algol::algorithms::sort::shell_sort_sedgewick_gaps(std::begin(v2), std::end(v2), std::less<>{}, &employee::age);
+  ASSERT_EQ(vec, sorted_by_age);
+  ASSERT_EQ(v1, sorted_by_age);
+  ASSERT_EQ(v2, sorted_by_age);
+}
+
+TEST_F(projection_fixture, projection_called_per_comparison)
+{
+  std::size_t calls = 0;
+  algol::algorithms::sort::insertion_sort(std::begin(vec), std::end(vec), std::less<>{},
+                                          [&calls] (employee const& e) {
+                                            ++calls;
+                                            return e.age;
+                                          });
+  ASSERT_EQ(vec, sorted_by_age);
+  ASSERT_GT(calls, vec.size());
+}
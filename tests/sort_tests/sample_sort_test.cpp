@@ -0,0 +1,102 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "algol/algorithms/sort/sample_sort.hpp"
+
+#include "gtest/gtest.h"
+
+class sample_sort_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-1000000, 1000000);
+    random.resize(100000);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted = random;
+    std::sort(std::begin(sorted), std::end(sorted));
+  }
+
+  std::vector<int> vec {-3, 6, 5, 10, -2};
+  std::vector<int> sorted_vec {-3, -2, 5, 6, 10};
+  std::vector<int> random;
+  std::vector<int> sorted;
+};
+
+TEST_F(sample_sort_fixture, sort_small_vec)
+{
+  algol::algorithms::sort::parallel_sample_sort(std::begin(vec), std::end(vec));
+  ASSERT_EQ(vec, sorted_vec);
+}
+
+TEST_F(sample_sort_fixture, sort_empty)
+{
+  std::vector<int> empty;
+  algol::algorithms::sort::parallel_sample_sort(std::begin(empty), std::end(empty), std::less<>{}, 4);
+  ASSERT_TRUE(empty.empty());
+}
+
+TEST_F(sample_sort_fixture, sort_random)
+{
+  for (std::size_t threads : {1u, 2u, 3u, 4u, 8u, 64u}) {
+    auto values = random;
+    algol::algorithms::sort::parallel_sample_sort(std::begin(values), std::end(values), std::less<>{}, threads);
+    ASSERT_EQ(values, sorted);
+  }
+}
+
+TEST_F(sample_sort_fixture, sort_random_descending)
+{
+  std::reverse(std::begin(sorted), std::end(sorted));
+  algol::algorithms::sort::parallel_sample_sort(std::begin(random), std::end(random), std::greater<>{}, 4);
+  ASSERT_EQ(random, sorted);
+}
+
+TEST_F(sample_sort_fixture, sort_sorted_and_reversed)
+{
+  auto values = sorted;
+  algol::algorithms::sort::parallel_sample_sort(std::begin(values), std::end(values), std::less<>{}, 4);
+  ASSERT_EQ(values, sorted);
+
+  std::reverse(std::begin(values), std::end(values));
+  algol::algorithms::sort::parallel_sample_sort(std::begin(values), std::end(values), std::less<>{}, 4);
+  ASSERT_EQ(values, sorted);
+}
+
+TEST_F(sample_sort_fixture, sort_duplicates)
+{
+  std::vector<int> equal(50000, 7);
+  algol::algorithms::sort::parallel_sample_sort(std::begin(equal), std::end(equal), std::less<>{}, 4);
+  ASSERT_TRUE(std::all_of(std::begin(equal), std::end(equal), [] (int x) { return x == 7; }));
+
+  for (auto& v : random)
+    v %= 3;
+  sorted = random;
+  std::sort(std::begin(sorted), std::end(sorted));
+  algol::algorithms::sort::parallel_sample_sort(std::begin(random), std::end(random), std::less<>{}, 8);
+  ASSERT_EQ(random, sorted);
+}
+
+TEST_F(sample_sort_fixture, sort_strings)
+{
+  std::vector<std::string> strings;
+  for (auto v : random)
+    strings.push_back(std::to_string(v));
+  auto expected = strings;
+  std::sort(std::begin(expected), std::end(expected));
+
+  algol::algorithms::sort::parallel_sample_sort(std::begin(strings), std::end(strings), std::less<>{}, 4);
+  ASSERT_EQ(strings, expected);
+}
+
+TEST_F(sample_sort_fixture, sort_array)
+{
+  auto values = std::make_unique<std::array<int, 20000>>();
+  std::copy_n(std::begin(random), values->size(), std::begin(*values));
+  algol::algorithms::sort::parallel_sample_sort(std::begin(*values), std::end(*values), std::less<>{}, 2);
+  ASSERT_TRUE(std::is_sorted(std::begin(*values), std::end(*values)));
+}
@@ -0,0 +1,125 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include "algol/algorithms/sort/sort_network.hpp"
+
+#include "gtest/gtest.h"
+
+using algol::algorithms::sort::sort_network;
+
+static_assert(sort_network<0>::comparators.size() == 0);
+static_assert(sort_network<1>::comparators.size() == 0);
+static_assert(sort_network<2>::comparators.size() == 1);
+static_assert(sort_network<3>::comparators.size() == 3);
+static_assert(sort_network<4>::comparators.size() == 5);
+static_assert(sort_network<8>::comparators.size() == 19);
+static_assert(sort_network<16>::comparators.size() == 63);
+static_assert(sort_network<32>::comparators.size() == 191);
+
+constexpr auto constexpr_sorted ()
+{
+  std::array<int, 7> values {7, -1, 4, 4, 0, 12, 3};
+  sort_network<7>{}(values);
+  return values;
+}
+
+// std::array::operator== is not constexpr in C++17
+template <typename T, std::size_t N>
+constexpr bool constexpr_equal (std::array<T, N> const& lhs, std::array<T, N> const& rhs)
+{
+  for (std::size_t i = 0; i < N; ++i)
+    if (lhs[i] != rhs[i])
+      return false;
+  return true;
+}
+
+static_assert(constexpr_equal(constexpr_sorted(), std::array<int, 7> {-1, 0, 3, 4, 4, 7, 12}));
+
+// 0-1 principle: a network sorts every input if and only if it sorts every sequence of zeros and ones
+template <std::size_t N>
+bool sorts_all_binary_sequences ()
+{
+  for (std::size_t bits = 0; bits < (std::size_t{1} << N); ++bits) {
+    std::array<int, N> values {};
+    for (std::size_t i = 0; i < N; ++i)
+      values[i] = static_cast<int>((bits >> i) & 1u);
+    sort_network<N>{}(values);
+    if (!std::is_sorted(std::begin(values), std::end(values)))
+      return false;
+  }
+  return true;
+}
+
+template <std::size_t ...N>
+bool sorts_all_binary_sequences (std::index_sequence<N...>)
+{
+  return (sorts_all_binary_sequences<N>() && ...);
+}
+
+template <std::size_t N, typename URBG>
+bool sorts_random_arrays (URBG& gen)
+{
+  std::uniform_int_distribution<int> distribution(-100, 100);
+  for (auto run = 0; run < 100; ++run) {
+    std::array<int, N> values;
+    for (auto& v : values)
+      v = distribution(gen);
+    auto expected = values;
+    std::sort(std::begin(expected), std::end(expected));
+    sort_network<N>{}(values);
+    if (values != expected)
+      return false;
+  }
+  return true;
+}
+
+template <typename URBG, std::size_t ...N>
+bool sorts_random_arrays (URBG& gen, std::index_sequence<N...>)
+{
+  return (sorts_random_arrays<N>(gen) && ...);
+}
+
+TEST(sort_network_test, constexpr_sort)
+{
+  constexpr auto values = constexpr_sorted();
+  ASSERT_TRUE(std::is_sorted(std::begin(values), std::end(values)));
+}
+
+TEST(sort_network_test, zero_one_principle)
+{
+  ASSERT_TRUE(sorts_all_binary_sequences(std::make_index_sequence<17>{}));
+}
+
+TEST(sort_network_test, sort_random)
+{
+  std::mt19937 gen(42);
+  ASSERT_TRUE(sorts_random_arrays(gen, std::make_index_sequence<33>{}));
+}
+
+TEST(sort_network_test, sort_descending)
+{
+  std::array<double, 5> values {1.5, -2.0, 3.25, 0.0, 3.25};
+  std::array<double, 5> expected {3.25, 3.25, 1.5, 0.0, -2.0};
+  algol::algorithms::sort::network_sort(values, std::greater<>{});
+  ASSERT_EQ(values, expected);
+}
+
+TEST(sort_network_test, sort_strings)
+{
+  std::array<std::string, 4> values {"delta", "alpha", "charlie", "bravo"};
+  std::array<std::string, 4> expected {"alpha", "bravo", "charlie", "delta"};
+  algol::algorithms::sort::network_sort(values);
+  ASSERT_EQ(values, expected);
+}
+
+TEST(sort_network_test, sort_range)
+{
+  std::vector<int> values {9, 8, 7, 3, 2, 1, 6, 5, 4, 0};
+  sort_network<6>{}(std::begin(values) + 3);
+  std::vector<int> expected {9, 8, 7, 1, 2, 3, 4, 5, 6, 0};
+  ASSERT_EQ(values, expected);
+}
@@ -1,4 +1,6 @@
 #include <vector>
+#include <iterator>
+#include <string>
 #include <memory>
 
 #include "algol/ds/stack/stack.hpp"
@@ -468,4 +470,165 @@ TEST_F(fixed_stack_fixture, to_vector)
   EXPECT_EQ(op_count_stack.top(), 9);
 
   ASSERT_EQ(op_count_stack.to_vector(), val);
-}
\ No newline at end of file
+}
+
+namespace {
+  // counts the live objects and has no default constructor
+  struct live_item {
+    explicit live_item (int value) : value {value}
+    {
+      ++live;
+    }
+
+    live_item (live_item const& rhs) : value {rhs.value}
+    {
+      ++live;
+    }
+
+    ~live_item ()
+    {
+      --live;
+    }
+
+    bool operator== (live_item const& rhs) const
+    {
+      return value == rhs.value;
+    }
+
+    bool operator!= (live_item const& rhs) const
+    {
+      return value != rhs.value;
+    }
+
+    int value;
+    static inline int live = 0;
+  };
+}
+
+TEST(fixed_stack, uninitialized_storage)
+{
+  {
+    ds::fixed_stack<live_item, 100> stack;
+    // the items are constructed on push, not when the stack is
+    EXPECT_EQ(live_item::live, 0);
+    stack.emplace(1);
+    stack.push(live_item{2});
+    stack.emplace(3);
+    EXPECT_EQ(live_item::live, 3);
+    // the items are destroyed on pop and on clear
+    stack.pop();
+    EXPECT_EQ(live_item::live, 2);
+    auto copy = stack;
+    EXPECT_EQ(live_item::live, 4);
+    EXPECT_TRUE(copy == stack);
+    copy.clear();
+    EXPECT_EQ(live_item::live, 2);
+    EXPECT_EQ(stack.top().value, 2);
+  }
+  // the items left are destroyed with the stack
+  EXPECT_EQ(live_item::live, 0);
+}
+
+TEST(fixed_stack, inline_storage)
+{
+  using inline_stack = ds::fixed_stack<std::string, 4, ds::inline_storage>;
+  static_assert(sizeof(inline_stack) >= 4 * sizeof(std::string));
+
+  inline_stack stack {"one", "two", "three"};
+  EXPECT_EQ(stack.top(), "three");
+  inline_stack copy {stack};
+  EXPECT_TRUE(copy == stack);
+
+  // an inline stack is moved item by item, the moved stack becomes empty
+  inline_stack moved {std::move(copy)};
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.to_vector(), (std::vector<std::string>{"three", "two", "one"}));
+
+  inline_stack other {"four"};
+  swap(other, moved);
+  EXPECT_EQ(other.size(), 3u);
+  EXPECT_EQ(moved.to_vector(), (std::vector<std::string>{"four"}));
+
+  moved = other;
+  EXPECT_TRUE(moved == other);
+  other = inline_stack{"five", "six"};
+  EXPECT_EQ(other.top(), "six");
+  other.push("seven");
+  other.push("eight");
+  EXPECT_TRUE(other.full());
+  EXPECT_THROW(other.push("nine"), ds::stack_full_error);
+}
+
+TEST(fixed_stack, inline_storage_lifetime)
+{
+  {
+    ds::fixed_stack<live_item, 8, ds::inline_storage> stack;
+    EXPECT_EQ(live_item::live, 0);
+    stack.emplace(1);
+    stack.emplace(2);
+    ds::fixed_stack<live_item, 8, ds::inline_storage> other;
+    other.emplace(3);
+    swap(stack, other);
+    EXPECT_EQ(live_item::live, 3);
+    EXPECT_EQ(stack.top().value, 3);
+    EXPECT_EQ(other.top().value, 2);
+  }
+  EXPECT_EQ(live_item::live, 0);
+}
+
+namespace {
+  struct const_item {
+    explicit const_item (int v) : value {v}
+    {}
+
+    int const value;
+  };
+}
+
+TEST(fixed_stack, inline_storage_const_member)
+{
+  // a slot reused by an item with a const member is reached through std::launder
+  ds::fixed_stack<const_item, 2, ds::inline_storage> stack;
+  stack.emplace(1);
+  stack.emplace(2);
+  EXPECT_EQ(stack.top().value, 2);
+  stack.pop();
+  stack.emplace(3);
+  EXPECT_EQ(stack.top().value, 3);
+  stack.pop();
+  EXPECT_EQ(stack.top().value, 1);
+}
+
+TEST(fixed_stack, bulk)
+{
+  ds::fixed_stack<int, 8> stack {1, 2};
+  std::vector<int> items {3, 4, 5, 6};
+  stack.push_range(items.begin(), items.end());
+  EXPECT_EQ(stack.size(), 6u);
+  EXPECT_EQ(stack.top(), 6);
+  // the room is checked once for the whole range
+  EXPECT_THROW(stack.push_range(items.begin(), items.end()), ds::stack_full_error);
+  EXPECT_EQ(stack.size(), 6u);
+
+  std::vector<int> popped;
+  stack.pop_n(std::back_inserter(popped), 4);
+  EXPECT_EQ(popped, (std::vector<int>{6, 5, 4, 3}));
+  EXPECT_THROW(stack.pop_n(std::back_inserter(popped), 3), ds::stack_empty_error);
+  EXPECT_EQ(stack.to_vector(), (std::vector<int>{2, 1}));
+  // too many values for the initializer_list constructor
+  EXPECT_THROW((ds::fixed_stack<operation_counter, 2> {1, 2, 3}), ds::stack_full_error);
+
+  {
+    ds::fixed_stack<live_item, 4> live_stack;
+    std::vector<live_item> live_items {live_item{1}, live_item{2}, live_item{3}};
+    live_stack.push_range(live_items.cbegin(), live_items.cend());
+    EXPECT_EQ(live_item::live, 6);
+    live_item out[2] {live_item{0}, live_item{0}};
+    live_stack.pop_n(out, 2);
+    EXPECT_EQ(out[0].value, 3);
+    EXPECT_EQ(out[1].value, 2);
+    // the items popped are destroyed
+    EXPECT_EQ(live_item::live, 6);
+  }
+  EXPECT_EQ(live_item::live, 0);
+}
@@ -0,0 +1,179 @@
+#include <vector>
+
+#include "algol/ds/stack/intrusive_stack.hpp"
+#include "algol/ds/queue/intrusive_queue.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+namespace {
+  struct stack_tag;
+  struct queue_tag;
+
+  // an item that can be in a stack and in a queue at the same time
+  struct task : ds::intrusive_hook<stack_tag>, ds::intrusive_hook<queue_tag> {
+    explicit task (int id) : id {id}
+    {}
+
+    int id;
+  };
+
+  using task_stack = ds::intrusive_stack<task, stack_tag>;
+  using task_queue = ds::intrusive_queue<task, queue_tag>;
+
+  bool linked_in_stack (task const& t)
+  {
+    return static_cast<ds::intrusive_hook<stack_tag> const&>(t).is_linked();
+  }
+
+  std::vector<int> ids (task_stack const& stack)
+  {
+    std::vector<int> ids;
+    for (auto t : stack.to_vector())
+      ids.push_back(t->id);
+    return ids;
+  }
+}
+
+class intrusive_stack_fixture : public ::testing::Test {
+protected:
+  std::vector<task> tasks {task{0}, task{1}, task{2}, task{3}, task{4}};
+  task_stack stack;
+};
+
+TEST_F(intrusive_stack_fixture, axioms)
+{
+  // Note: Axioms for the ADT stack
+  // new stack is empty and not full
+  EXPECT_TRUE(stack.empty());
+  EXPECT_FALSE(stack.full());
+  // new stack is throws stack_empty_error on pop
+  EXPECT_THROW(stack.pop(), ds::stack_empty_error);
+  // new stack is throws stack_empty_error on top
+  EXPECT_THROW(stack.top(), ds::stack_empty_error);
+  stack.push(tasks[0]);
+  // a stack with one item is not empty
+  EXPECT_FALSE(stack.empty());
+  // a stack with one item on top return that item
+  EXPECT_EQ(&stack.top(), &tasks[0]);
+  // a stack with one item does not throw on pop
+  EXPECT_NO_THROW(stack.pop());
+  stack.push(tasks[0]);
+  auto size = stack.size();
+  stack.push(tasks[1]);
+  // a push increase the size of the stack by 1
+  EXPECT_EQ(stack.size(), size + 1u);
+  size = stack.size();
+  stack.pop();
+  // a pop decrease the size of the stack by 1
+  EXPECT_EQ(stack.size(), size - 1u);
+  stack.clear();
+}
+
+TEST_F(intrusive_stack_fixture, no_copies)
+{
+  for (auto& t : tasks)
+    stack.push(t);
+  EXPECT_EQ(ids(stack), (std::vector<int>{4, 3, 2, 1, 0}));
+
+  // the items popped are the objects pushed
+  for (auto i = 4; i >= 0; --i) {
+    auto& t = stack.pop();
+    EXPECT_EQ(&t, &tasks[static_cast<std::size_t>(i)]);
+    EXPECT_FALSE(linked_in_stack(t));
+  }
+  EXPECT_EQ(stack.try_pop(), nullptr);
+}
+
+TEST_F(intrusive_stack_fixture, splice)
+{
+  task_stack other;
+  stack.push(tasks[0]);
+  stack.push(tasks[1]);
+  other.push(tasks[2]);
+  other.push(tasks[3]);
+
+  stack.splice(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(stack.size(), 4u);
+  EXPECT_EQ(ids(stack), (std::vector<int>{3, 2, 1, 0}));
+
+  // splicing into an empty stack
+  other.splice(stack);
+  EXPECT_EQ(ids(other), (std::vector<int>{3, 2, 1, 0}));
+  other.push(tasks[4]);
+  EXPECT_EQ(other.top().id, 4);
+  other.clear();
+}
+
+TEST_F(intrusive_stack_fixture, move_and_swap)
+{
+  stack.push(tasks[0]);
+  stack.push(tasks[1]);
+
+  task_stack moved {std::move(stack)};
+  EXPECT_TRUE(stack.empty());
+  EXPECT_EQ(ids(moved), (std::vector<int>{1, 0}));
+  // the moved items can be popped from their new stack
+  EXPECT_EQ(moved.pop().id, 1);
+
+  stack.push(tasks[2]);
+  swap(stack, moved);
+  EXPECT_EQ(stack.top().id, 0);
+  EXPECT_EQ(moved.top().id, 2);
+
+  // the items of the assigned stack are unlinked
+  stack = std::move(moved);
+  EXPECT_FALSE(linked_in_stack(tasks[0]));
+  EXPECT_EQ(stack.top().id, 2);
+  stack.clear();
+}
+
+TEST_F(intrusive_stack_fixture, many_containers)
+{
+  task_queue queue;
+  for (auto& t : tasks) {
+    stack.push(t);
+    queue.enqueue(t);
+  }
+  EXPECT_EQ(stack.top().id, 4);
+  EXPECT_EQ(queue.front().id, 0);
+
+  // the stack and the queue link different hooks of the same objects
+  stack.clear();
+  EXPECT_EQ(queue.size(), 5u);
+  EXPECT_EQ(queue.dequeue().id, 0);
+}
+
+TEST_F(intrusive_stack_fixture, destruction_unlinks)
+{
+  {
+    task_stack scoped;
+    scoped.push(tasks[0]);
+    EXPECT_TRUE(linked_in_stack(tasks[0]));
+  }
+  EXPECT_FALSE(linked_in_stack(tasks[0]));
+  // an unlinked item can be pushed again
+  stack.push(tasks[0]);
+  stack.clear();
+}
+
+#ifndef NDEBUG
+TEST_F(intrusive_stack_fixture, ownership_checks)
+{
+  stack.push(tasks[0]);
+  // an item is linked in one stack at a time
+  EXPECT_DEATH(stack.push(tasks[0]), "already linked");
+  task_stack other;
+  EXPECT_DEATH(other.push(tasks[0]), "already linked");
+  // an item cannot be destroyed while it is linked
+  EXPECT_DEATH({
+    task_stack s;
+    {
+      task t {5};
+      s.push(t);
+    }
+  }, "destroyed while it is linked");
+  stack.clear();
+}
+#endif
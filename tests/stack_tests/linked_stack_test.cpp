@@ -1,4 +1,5 @@
 #include <vector>
+#include <iterator>
 #include <memory>
 
 #include "algol/ds/stack/stack.hpp"
@@ -473,4 +474,22 @@ TEST_F(linked_stack_fixture, to_vector)
   EXPECT_EQ(op_count_stack.top(), 9);
 
   ASSERT_EQ(op_count_stack.to_vector(), val);
-}
\ No newline at end of file
+}
+TEST_F(linked_stack_fixture, bulk)
+{
+  std::vector<operation_counter> items {1, 2, 3, 4, 5};
+  op_count_stack.push_range(items.begin(), items.end());
+  EXPECT_EQ(op_count_stack.size(), 5u);
+  EXPECT_EQ(op_count_stack.top(), 5);
+
+  std::vector<operation_counter> popped;
+  popped.reserve(3);
+  operation_counter::reset();
+  op_count_stack.pop_n(std::back_inserter(popped), 3);
+  // the default hook moves the items out
+  EXPECT_EQ(operation_counter::moves(), 3u);
+  EXPECT_EQ(operation_counter::constructions(), 0u);
+  EXPECT_EQ(popped, (std::vector<operation_counter>{5, 4, 3}));
+  EXPECT_THROW(op_count_stack.pop_n(std::back_inserter(popped), 3), ds::stack_empty_error);
+  EXPECT_EQ(op_count_stack.to_vector(), (std::vector<operation_counter>{2, 1}));
+}
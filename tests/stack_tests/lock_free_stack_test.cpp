@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "algol/ds/stack/concepts.hpp"
+#include "algol/ds/stack/lock_free_stack.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+static_assert(algol::concepts::Stack<ds::lock_free_stack<int>>());
+
+class lock_free_stack_fixture : public ::testing::Test {
+protected:
+  ds::lock_free_stack<operation_counter> op_count_stack;
+};
+
+TEST_F(lock_free_stack_fixture, axioms)
+{
+  // Note: Axioms for the ADT stack
+  // new stack is empty and not full
+  EXPECT_TRUE(op_count_stack.empty());
+  EXPECT_FALSE(op_count_stack.full());
+  // new stack is throws stack_empty_error on pop
+  EXPECT_THROW(op_count_stack.pop(), ds::stack_empty_error);
+  // new stack is throws stack_empty_error on top
+  EXPECT_THROW(op_count_stack.top(), ds::stack_empty_error);
+  op_count_stack.push(1);
+  // a stack with one item is not empty
+  EXPECT_FALSE(op_count_stack.empty());
+  // a stack with one item on top return that item
+  EXPECT_EQ(op_count_stack.top(), 1);
+  // a stack with one item does not throw on pop
+  EXPECT_NO_THROW(op_count_stack.pop());
+  op_count_stack.push(1);
+  auto size = op_count_stack.size();
+  op_count_stack.push(2);
+  // a push increase the size of the stack by 1
+  EXPECT_EQ(op_count_stack.size(), size + 1u);
+  size = op_count_stack.size();
+  op_count_stack.pop();
+  // a pop decrease the size of the stack by 1
+  EXPECT_EQ(op_count_stack.size(), size - 1u);
+}
+
+TEST_F(lock_free_stack_fixture, initializer_list)
+{
+  ds::lock_free_stack<int> stack {1, 2, 3, 4};
+  EXPECT_EQ(stack.size(), 4u);
+  for (auto i = 4; i >= 1; --i)
+    EXPECT_EQ(stack.try_pop(), i);
+  EXPECT_EQ(stack.try_pop(), std::nullopt);
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST_F(lock_free_stack_fixture, try_pop)
+{
+  EXPECT_FALSE(op_count_stack.try_pop().has_value());
+  op_count_stack.emplace(5);
+  op_count_stack.push(operation_counter{6});
+  EXPECT_EQ(op_count_stack.top(), 6);
+  auto value = op_count_stack.try_pop();
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(*value, 6);
+  value = op_count_stack.try_pop();
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(*value, 5);
+  EXPECT_FALSE(op_count_stack.try_pop().has_value());
+}
+
+TEST_F(lock_free_stack_fixture, clear)
+{
+  auto item = std::make_shared<int>(0);
+  // the items cleared are deleted when no thread protects them, at the latest when the thread exits
+  std::thread {[&item] {
+    ds::lock_free_stack<std::shared_ptr<int>> stack;
+    for (auto i = 0; i < 10; ++i)
+      stack.push(item);
+    EXPECT_EQ(stack.size(), 10u);
+    stack.clear();
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(stack.size(), 0u);
+    for (auto i = 0; i < 3; ++i)
+      stack.push(item);
+  }}.join();
+  EXPECT_EQ(item.use_count(), 1);
+}
+
+// every thread pushes the values thread * items + i and pops as many items,
+// every value must be popped exactly once
+template <typename Stack>
+void push_pop (Stack& stack, int threads, int items)
+{
+  std::vector<std::vector<int>> popped(static_cast<std::size_t>(threads));
+  std::vector<std::thread> workers;
+  for (auto t = 0; t < threads; ++t)
+    workers.emplace_back([&stack, &popped, t, items] {
+      auto& out = popped[static_cast<std::size_t>(t)];
+      for (auto i = 0; i < items; ++i) {
+        stack.push(t * items + i);
+        if (i % 3 == 2)
+          for (auto j = 0; j < 3; ++j) {
+            auto value = stack.try_pop();
+            while (!value)
+              value = stack.try_pop();
+            out.push_back(*value);
+          }
+      }
+      while (out.size() < static_cast<std::size_t>(items))
+        if (auto value = stack.try_pop())
+          out.push_back(*value);
+    });
+  for (auto& worker : workers)
+    worker.join();
+
+  std::vector<int> all;
+  for (auto const& out : popped)
+    all.insert(std::end(all), std::begin(out), std::end(out));
+  std::sort(std::begin(all), std::end(all));
+  ASSERT_EQ(all.size(), static_cast<std::size_t>(threads * items));
+  for (auto i = 0; i < threads * items; ++i)
+    EXPECT_EQ(all[static_cast<std::size_t>(i)], i);
+}
+
+TEST_F(lock_free_stack_fixture, concurrent)
+{
+  ds::lock_free_stack<int> stack;
+  push_pop(stack, 8, 20000);
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST_F(lock_free_stack_fixture, concurrent_without_elimination)
+{
+  ds::lock_free_stack<int, 0> stack;
+  push_pop(stack, 8, 20000);
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST_F(lock_free_stack_fixture, reclamation)
+{
+  // the popped items are destroyed while the threads run, not only at exit
+  auto item = std::make_shared<int>(0);
+  ds::lock_free_stack<std::shared_ptr<int>> stack;
+  std::vector<std::thread> workers;
+  for (auto t = 0; t < 4; ++t)
+    workers.emplace_back([&stack, &item] {
+      for (auto i = 0; i < 10000; ++i) {
+        stack.push(item);
+        stack.try_pop();
+      }
+    });
+  for (auto& worker : workers)
+    worker.join();
+  EXPECT_TRUE(stack.empty());
+  EXPECT_EQ(item.use_count(), 1);
+}
@@ -0,0 +1,166 @@
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "algol/ds/stack/persistent_stack.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+TEST(persistent_stack_test, axioms)
+{
+  ds::persistent_stack<int> empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_FALSE(empty.full());
+  EXPECT_EQ(empty.size(), 0u);
+  EXPECT_THROW(empty.top(), ds::stack_empty_error);
+  EXPECT_THROW(empty.pop(), ds::stack_empty_error);
+
+  auto one = empty.push(1);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(one.size(), 1u);
+  EXPECT_EQ(one.top(), 1);
+  EXPECT_EQ(one.pop(), empty);
+  EXPECT_TRUE(one.pop().empty());
+
+  ds::persistent_stack<int> stack {1, 2, 3};
+  EXPECT_EQ(stack.top(), 3);
+  EXPECT_EQ(stack.size(), 3u);
+  EXPECT_EQ(stack.to_vector(), (std::vector<int>{3, 2, 1}));
+  EXPECT_EQ(stack.pop().top(), 2);
+  EXPECT_EQ(stack.push(4).top(), 4);
+  EXPECT_EQ(stack.top(), 3);
+}
+
+TEST(persistent_stack_test, sharing)
+{
+  ds::persistent_stack<std::string> base {"a", "b"};
+  auto left = base.push("l");
+  auto right = base.push("r");
+  // the two versions share the nodes of base
+  EXPECT_TRUE(left.pop().shares(base));
+  EXPECT_TRUE(right.pop().shares(base));
+  EXPECT_FALSE(left.shares(right));
+  EXPECT_EQ(left.to_vector(), (std::vector<std::string>{"l", "b", "a"}));
+  EXPECT_EQ(right.to_vector(), (std::vector<std::string>{"r", "b", "a"}));
+
+  // copies share all the nodes and the items compare equal
+  auto copy = left;
+  EXPECT_TRUE(copy.shares(left));
+  EXPECT_EQ(copy, left);
+  EXPECT_NE(left, right);
+  // equal items in different nodes
+  EXPECT_EQ(base.push("l"), left);
+
+  // the nodes of base stay alive through the other versions
+  base = ds::persistent_stack<std::string>{};
+  EXPECT_EQ(left.pop().top(), "b");
+  EXPECT_EQ(right.pop().pop().top(), "a");
+
+  std::vector<std::string> items(std::begin(right), std::end(right));
+  EXPECT_EQ(items, right.to_vector());
+}
+
+TEST(persistent_stack_test, reclamation)
+{
+  auto item = std::make_shared<int>(42);
+  {
+    ds::persistent_stack<std::shared_ptr<int>> stack;
+    stack = stack.push(item).push(item);
+    auto other = stack.push(item);
+    EXPECT_EQ(item.use_count(), 4);
+    stack = ds::persistent_stack<std::shared_ptr<int>>{};
+    // other still reaches the two shared nodes
+    EXPECT_EQ(item.use_count(), 4);
+    other = other.pop();
+    EXPECT_EQ(item.use_count(), 3);
+  }
+  EXPECT_EQ(item.use_count(), 1);
+
+  // a long stack is released without recursion
+  ds::persistent_stack<int> deep;
+  for (auto i = 0; i < 1000000; ++i)
+    deep = deep.push(i);
+  EXPECT_EQ(deep.size(), 1000000u);
+}
+
+TEST(persistent_stack_test, swap_move)
+{
+  ds::persistent_stack<int> a {1, 2};
+  ds::persistent_stack<int> b {3};
+  swap(a, b);
+  EXPECT_EQ(a.top(), 3);
+  EXPECT_EQ(b.top(), 2);
+  auto c = std::move(b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(c.size(), 2u);
+}
+
+TEST(persistent_stack_test, arena)
+{
+  std::pmr::unsynchronized_pool_resource arena;
+  ds::pmr::persistent_stack<int, false> stack(&arena);
+  std::vector<ds::pmr::persistent_stack<int, false>> versions;
+  for (auto i = 0; i < 100; ++i) {
+    stack = stack.push(i);
+    versions.push_back(stack);
+  }
+  EXPECT_EQ(stack.get_allocator().resource(), &arena);
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(versions[static_cast<std::size_t>(i)].top(), i);
+    EXPECT_EQ(versions[static_cast<std::size_t>(i)].size(), static_cast<std::size_t>(i + 1));
+  }
+  auto popped = versions.back().pop().pop();
+  EXPECT_TRUE(popped.shares(versions[97]));
+}
+
+TEST(persistent_stack_test, pmr_assignment)
+{
+  // the polymorphic allocator does not propagate, the items are copied into nodes of this stack's resource
+  std::pmr::monotonic_buffer_resource arena;
+  ds::pmr::persistent_stack<std::pmr::string> stack {&arena};
+  ds::pmr::persistent_stack<std::pmr::string> other;
+  for (auto i = 0; i < 50; ++i)
+    other = other.push(std::pmr::string(static_cast<std::size_t>(i), 'x'));
+
+  stack = other;
+  EXPECT_EQ(stack, other);
+  EXPECT_FALSE(stack.shares(other));
+  EXPECT_EQ(stack.get_allocator().resource(), &arena);
+  EXPECT_EQ(stack.top().get_allocator().resource(), &arena);
+
+  auto same_resource = stack;
+  stack = same_resource.pop();
+  EXPECT_TRUE(stack.shares(same_resource.pop()));
+
+  other = std::move(stack);
+  EXPECT_TRUE(stack.empty());
+  EXPECT_EQ(stack.get_allocator().resource(), &arena);
+  EXPECT_EQ(other.size(), 49u);
+  EXPECT_EQ(other.top(), std::pmr::string(48, 'x'));
+  EXPECT_EQ(other.get_allocator().resource(), std::pmr::get_default_resource());
+}
+
+TEST(persistent_stack_test, threads)
+{
+  // the versions sharing nodes are copied and destroyed by many threads
+  ds::persistent_stack<std::string> base;
+  for (auto i = 0; i < 100; ++i)
+    base = base.push(std::to_string(i));
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < 4; ++t)
+    threads.emplace_back([base, t] {
+      for (auto round = 0; round < 2000; ++round) {
+        auto version = base;
+        for (auto i = 0; i < 10; ++i)
+          version = version.push(std::to_string(t)).pop().pop();
+        EXPECT_EQ(version.size(), 90u);
+        EXPECT_EQ(version.top(), "89");
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+  EXPECT_EQ(base.size(), 100u);
+}
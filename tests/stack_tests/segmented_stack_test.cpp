@@ -0,0 +1,227 @@
+#include <vector>
+#include <iterator>
+#include <string>
+#include <cstddef>
+
+#include "algol/ds/stack/segmented_stack.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+namespace {
+  // counts the chunks allocated and deallocated
+  template <typename T>
+  struct chunk_counting_allocator {
+    using value_type = T;
+
+    explicit chunk_counting_allocator (std::size_t* allocations) noexcept : allocations {allocations}
+    {}
+
+    template <typename U>
+    chunk_counting_allocator (chunk_counting_allocator<U> const& rhs) noexcept : allocations {rhs.allocations}
+    {}
+
+    T* allocate (std::size_t n)
+    {
+      ++*allocations;
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate (T* p, std::size_t n) noexcept
+    {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator== (chunk_counting_allocator<U> const& rhs) const noexcept
+    {
+      return allocations == rhs.allocations;
+    }
+
+    template <typename U>
+    bool operator!= (chunk_counting_allocator<U> const& rhs) const noexcept
+    {
+      return allocations != rhs.allocations;
+    }
+
+    std::size_t* allocations;
+  };
+}
+
+// three items per chunk, the chunk boundaries are crossed often
+class segmented_stack_fixture : public ::testing::Test {
+protected:
+  ds::segmented_stack<operation_counter, 3> op_count_stack;
+};
+
+TEST_F(segmented_stack_fixture, axioms)
+{
+  // Note: Axioms for the ADT stack
+  // new stack is empty and not full
+  EXPECT_TRUE(op_count_stack.empty());
+  EXPECT_FALSE(op_count_stack.full());
+  // new stack is throws stack_empty_error on pop
+  EXPECT_THROW(op_count_stack.pop(), ds::stack_empty_error);
+  // new stack is throws stack_empty_error on top
+  EXPECT_THROW(op_count_stack.top(), ds::stack_empty_error);
+  op_count_stack.push(1);
+  // a stack with one item is not empty
+  EXPECT_FALSE(op_count_stack.empty());
+  // a stack with one item on top return that item
+  EXPECT_EQ(op_count_stack.top(), 1);
+  // a stack with one item does not throw on pop
+  EXPECT_NO_THROW(op_count_stack.pop());
+  op_count_stack.push(1);
+  auto size = op_count_stack.size();
+  op_count_stack.push(2);
+  // a push increase the size of the stack by 1
+  EXPECT_EQ(op_count_stack.size(), size + 1u);
+  size = op_count_stack.size();
+  op_count_stack.pop();
+  // a pop decrease the size of the stack by 1
+  EXPECT_EQ(op_count_stack.size(), size - 1u);
+}
+
+TEST_F(segmented_stack_fixture, across_chunks)
+{
+  for (operation_counter i = 0; i < 10; ++i)
+    op_count_stack.push(i);
+  EXPECT_EQ(op_count_stack.size(), 10u);
+  EXPECT_EQ(op_count_stack.to_vector(), (std::vector<operation_counter>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+  EXPECT_EQ(op_count_stack.capacity(), 12u);
+
+  // loop invariant: the items below i are on the stack in order
+  for (auto i = 9; i >= 0; --i) {
+    EXPECT_EQ(op_count_stack.top(), i);
+    op_count_stack.pop();
+  }
+  EXPECT_TRUE(op_count_stack.empty());
+}
+
+TEST_F(segmented_stack_fixture, stable_references)
+{
+  op_count_stack.push(0);
+  auto const* bottom = &op_count_stack.top();
+  std::vector<operation_counter const*> addresses {bottom};
+  for (operation_counter i = 1; i < 100; ++i) {
+    op_count_stack.push(i);
+    addresses.push_back(&op_count_stack.top());
+  }
+  // the items are never moved while the stack grows
+  EXPECT_EQ(*bottom, 0);
+  for (auto i = 99; i > 0; --i) {
+    EXPECT_EQ(&op_count_stack.top(), addresses[static_cast<std::size_t>(i)]);
+    op_count_stack.pop();
+  }
+  EXPECT_EQ(&op_count_stack.top(), bottom);
+}
+
+TEST_F(segmented_stack_fixture, chunks_recycled)
+{
+  std::size_t allocations = 0;
+  ds::segmented_stack<int, 4, chunk_counting_allocator<int>> stack {chunk_counting_allocator<int>{&allocations}};
+
+  for (auto i = 0; i < 16; ++i)
+    stack.push(i);
+  EXPECT_EQ(allocations, 4u);
+  // the chunks emptied stay on the free list, growing again does not allocate
+  stack.clear();
+  EXPECT_EQ(stack.capacity(), 16u);
+  for (auto round = 0; round < 3; ++round) {
+    for (auto i = 0; i < 16; ++i)
+      stack.push(i);
+    while (!stack.empty())
+      stack.pop();
+  }
+  EXPECT_EQ(allocations, 4u);
+
+  stack.shrink_to_fit();
+  EXPECT_EQ(stack.capacity(), 0u);
+  stack.reserve(9);
+  EXPECT_EQ(stack.capacity(), 12u);
+  EXPECT_EQ(allocations, 7u);
+  for (auto i = 0; i < 12; ++i)
+    stack.push(i);
+  EXPECT_EQ(allocations, 7u);
+}
+
+TEST_F(segmented_stack_fixture, copy_move_swap)
+{
+  ds::segmented_stack<std::string, 2> stack {"one", "two", "three", "four", "five"};
+  auto copy = stack;
+  EXPECT_TRUE(copy == stack);
+  EXPECT_EQ(copy.to_vector(), (std::vector<std::string>{"five", "four", "three", "two", "one"}));
+
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(moved == stack);
+
+  ds::segmented_stack<std::string, 2> other {"six"};
+  swap(other, moved);
+  EXPECT_EQ(other.size(), 5u);
+  EXPECT_EQ(moved.top(), "six");
+
+  moved = other;
+  EXPECT_TRUE(moved == other);
+  other = ds::segmented_stack<std::string, 2> {"seven"};
+  EXPECT_EQ(other.top(), "seven");
+  EXPECT_EQ(other.size(), 1u);
+}
+
+TEST_F(segmented_stack_fixture, comparisons)
+{
+  ds::segmented_stack<int, 2> stack {1, 2, 3};
+  ds::segmented_stack<int, 2> other {1, 2, 3};
+  EXPECT_TRUE(stack == other);
+  EXPECT_FALSE(stack < other);
+  EXPECT_TRUE(stack <= other);
+  other.push(0);
+  // a prefix is less than the longer stack
+  EXPECT_TRUE(stack != other);
+  EXPECT_TRUE(stack < other);
+  other.pop();
+  other.pop();
+  other.push(4);
+  // the items are compared from the bottom
+  EXPECT_TRUE(stack < other);
+  EXPECT_TRUE(other > stack);
+  EXPECT_TRUE(other >= stack);
+}
+
+TEST_F(segmented_stack_fixture, using_interface)
+{
+  ds::stack<operation_counter>& stack = op_count_stack;
+  for (operation_counter i = 0; i < 7; ++i)
+    stack.push(i);
+  EXPECT_EQ(stack.size(), 7u);
+  EXPECT_EQ(stack.top(), 6);
+  stack.clear();
+  EXPECT_TRUE(stack.empty());
+  EXPECT_THROW(stack.pop(), ds::stack_empty_error);
+}
+
+TEST_F(segmented_stack_fixture, bulk)
+{
+  std::size_t allocations = 0;
+  ds::segmented_stack<int, 4, chunk_counting_allocator<int>> stack {chunk_counting_allocator<int>{&allocations}};
+  std::vector<int> items {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  stack.push(-1);
+  // the range is copied a chunk at a time
+  stack.push_range(items.begin(), items.end());
+  EXPECT_EQ(stack.size(), 11u);
+  EXPECT_EQ(allocations, 3u);
+  EXPECT_EQ(stack.top(), 9);
+
+  std::vector<int> popped;
+  stack.pop_n(std::back_inserter(popped), 8);
+  EXPECT_EQ(popped, (std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2}));
+  EXPECT_THROW(stack.pop_n(std::back_inserter(popped), 4), ds::stack_empty_error);
+  EXPECT_EQ(stack.to_vector(), (std::vector<int>{1, 0, -1}));
+  // the two chunks emptied by pop_n are reused, one more chunk is allocated
+  stack.push_range(items.begin(), items.end());
+  EXPECT_EQ(allocations, 4u);
+  EXPECT_EQ(stack.size(), 13u);
+}
@@ -0,0 +1,214 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algol/ds/stack/fixed_stack.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+namespace {
+  struct allocation_log {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+  };
+
+  // the allocators with different ids are not equal, they do not propagate
+  template <typename T>
+  struct tracking_allocator {
+    using value_type = T;
+
+    tracking_allocator (int id, allocation_log* log) noexcept : id {id}, log {log}
+    {}
+
+    template <typename U>
+    tracking_allocator (tracking_allocator<U> const& other) noexcept : id {other.id}, log {other.log}
+    {}
+
+    T* allocate (std::size_t n)
+    {
+      ++log->allocations;
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate (T* p, std::size_t n) noexcept
+    {
+      ++log->deallocations;
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator== (tracking_allocator<U> const& rhs) const noexcept
+    {
+      return id == rhs.id;
+    }
+
+    template <typename U>
+    bool operator!= (tracking_allocator<U> const& rhs) const noexcept
+    {
+      return id != rhs.id;
+    }
+
+    int id;
+    allocation_log* log;
+  };
+}
+
+class stack_allocator_fixture : public ::testing::Test {
+protected:
+  using allocator = tracking_allocator<int>;
+
+  allocation_log log1;
+  allocation_log log2;
+};
+
+TEST_F(stack_allocator_fixture, linked_stack_nodes)
+{
+  {
+    ds::linked_stack<int, allocator> stack {allocator{1, &log1}};
+    // the sentinel node
+    EXPECT_EQ(log1.allocations, 1u);
+    for (auto i = 0; i < 10; ++i)
+      stack.push(i);
+    EXPECT_EQ(log1.allocations, 11u);
+    stack.pop();
+    EXPECT_EQ(log1.deallocations, 1u);
+    EXPECT_EQ(stack.get_allocator().id, 1);
+  }
+  EXPECT_EQ(log1.allocations, log1.deallocations);
+}
+
+TEST_F(stack_allocator_fixture, fixed_stack_array)
+{
+  {
+    ds::fixed_stack<int, 100, allocator> stack {{1, 2, 3}, allocator{1, &log1}};
+    EXPECT_EQ(log1.allocations, 1u);
+    stack.push(4);
+    EXPECT_EQ(log1.allocations, 1u);
+    EXPECT_EQ(stack.top(), 4);
+  }
+  EXPECT_EQ(log1.deallocations, 1u);
+}
+
+TEST_F(stack_allocator_fixture, copy)
+{
+  ds::linked_stack<int, allocator> stack {{1, 2, 3}, allocator{1, &log1}};
+  auto copy = stack;
+  EXPECT_EQ(copy.get_allocator().id, 1);
+  EXPECT_EQ(copy, stack);
+
+  ds::linked_stack<int, allocator> other {copy, allocator{2, &log2}};
+  EXPECT_EQ(other.get_allocator().id, 2);
+  EXPECT_EQ(log2.allocations, 4u);
+  EXPECT_EQ(other, stack);
+
+  // the allocator does not propagate on copy assignment
+  other = ds::linked_stack<int, allocator> {{4, 5}, allocator{1, &log1}};
+  EXPECT_EQ(other.get_allocator().id, 2);
+  EXPECT_EQ(other.size(), 2u);
+  EXPECT_EQ(other.top(), 5);
+}
+
+TEST_F(stack_allocator_fixture, move_unequal_allocators)
+{
+  ds::linked_stack<int, allocator> stack {{1, 2, 3}, allocator{1, &log1}};
+  ds::linked_stack<int, allocator> other {allocator{2, &log2}};
+
+  // the nodes cannot be stolen, the items are moved into nodes allocated by other
+  other = std::move(stack);
+  EXPECT_EQ(other.get_allocator().id, 2);
+  // the two sentinels, the one replaced included, and the three items
+  EXPECT_EQ(log2.allocations, 5u);
+  EXPECT_EQ(other.to_vector(), (std::vector<int>{3, 2, 1}));
+  EXPECT_TRUE(stack.empty());
+
+  ds::fixed_stack<int, 10, allocator> fixed {{1, 2, 3}, allocator{1, &log1}};
+  ds::fixed_stack<int, 10, allocator> fixed_other {std::move(fixed), allocator{2, &log2}};
+  EXPECT_EQ(fixed_other.get_allocator().id, 2);
+  EXPECT_EQ(fixed_other.to_vector(), (std::vector<int>{3, 2, 1}));
+  EXPECT_TRUE(fixed.empty());
+}
+
+TEST_F(stack_allocator_fixture, move_equal_allocators)
+{
+  ds::fixed_stack<int, 10, allocator> stack {{1, 2, 3}, allocator{1, &log1}};
+  ds::fixed_stack<int, 10, allocator> other {allocator{1, &log1}};
+  EXPECT_EQ(log1.allocations, 2u);
+
+  // the array is stolen
+  other = std::move(stack);
+  EXPECT_EQ(log1.allocations, 2u);
+  EXPECT_EQ(log1.deallocations, 1u);
+  EXPECT_EQ(other.to_vector(), (std::vector<int>{3, 2, 1}));
+
+  ds::fixed_stack<int, 10, allocator> swapped {{4}, allocator{1, &log1}};
+  swap(other, swapped);
+  EXPECT_EQ(other.top(), 4);
+  EXPECT_EQ(swapped.top(), 3);
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace {
+  class counting_resource : public std::pmr::memory_resource {
+  public:
+    std::size_t allocations () const noexcept
+    {
+      return allocations_;
+    }
+
+  private:
+    void* do_allocate (std::size_t bytes, std::size_t alignment) override
+    {
+      ++allocations_;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate (void* p, std::size_t bytes, std::size_t alignment) override
+    {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal (memory_resource const& other) const noexcept override
+    {
+      return this == &other;
+    }
+
+    std::size_t allocations_ = 0;
+  };
+}
+
+TEST_F(stack_allocator_fixture, pmr_monotonic)
+{
+  counting_resource upstream;
+  std::pmr::monotonic_buffer_resource arena {&upstream};
+  {
+    ds::pmr::linked_stack<int> stack {&arena};
+    for (auto i = 0; i < 1000; ++i)
+      stack.push(i);
+    EXPECT_EQ(stack.size(), 1000u);
+    EXPECT_EQ(stack.get_allocator().resource(), &arena);
+    // the arena grows geometrically, far less than a call per node
+    EXPECT_LT(upstream.allocations(), 20u);
+
+    ds::pmr::fixed_stack<int, 100> fixed {{1, 2, 3}, &arena};
+    EXPECT_EQ(fixed.top(), 3);
+  }
+}
+
+TEST_F(stack_allocator_fixture, pmr_uses_allocator)
+{
+  counting_resource resource;
+  ds::pmr::linked_stack<std::pmr::string> stack {&resource};
+  stack.push(std::pmr::string {"an item long enough to be allocated from the resource"});
+  // the item is constructed with the allocator of the stack
+  EXPECT_EQ(stack.top().get_allocator().resource(), &resource);
+
+  ds::pmr::fixed_stack<std::pmr::string, 4> fixed {&resource};
+  fixed.emplace("an item long enough to be allocated from the resource");
+  EXPECT_EQ(fixed.top().get_allocator().resource(), &resource);
+}
+#endif
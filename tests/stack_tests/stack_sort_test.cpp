@@ -0,0 +1,135 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+
+#include "algol/ds/stack/array_stack.hpp"
+#include "algol/ds/stack/fixed_stack.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "algol/algorithms/stack/sort.hpp"
+#include "algol/perf/operation_counter.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using operation_counter = algol::perf::operation_counter<std::int32_t, std::uint64_t>;
+
+// pop every item, the first popped is the top
+template <typename S>
+std::vector<typename S::value_type> pop_all (S& stack)
+{
+  std::vector<typename S::value_type> values;
+  while (!stack.empty()) {
+    values.push_back(stack.top());
+    stack.pop();
+  }
+  return values;
+}
+
+class stack_sort_fixture : public ::testing::Test {
+protected:
+  void SetUp () override
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> distribution(-500, 500);
+    random.resize(1000);
+    for (auto& v : random)
+      v = distribution(gen);
+    sorted = random;
+    std::sort(std::begin(sorted), std::end(sorted));
+  }
+
+  std::vector<int> random;
+  std::vector<int> sorted;
+};
+
+TEST_F(stack_sort_fixture, merge_sort_empty_and_single)
+{
+  ds::linked_stack<int> stack;
+  algol::algorithms::stack::merge_sort(stack);
+  EXPECT_TRUE(stack.empty());
+
+  stack.push(42);
+  algol::algorithms::stack::merge_sort(stack);
+  EXPECT_EQ(stack.size(), 1u);
+  EXPECT_EQ(stack.top(), 42);
+}
+
+TEST_F(stack_sort_fixture, merge_sort_linked_stack)
+{
+  ds::linked_stack<int> stack;
+  for (auto v : random)
+    stack.push(v);
+
+  algol::algorithms::stack::merge_sort(stack);
+  EXPECT_EQ(pop_all(stack), sorted);
+}
+
+TEST_F(stack_sort_fixture, merge_sort_fixed_stack)
+{
+  ds::fixed_stack<int, 1000> stack;
+  for (auto v : random)
+    stack.push(v);
+
+  algol::algorithms::stack::merge_sort(stack, std::greater<>{});
+  std::reverse(std::begin(sorted), std::end(sorted));
+  EXPECT_EQ(pop_all(stack), sorted);
+}
+
+TEST_F(stack_sort_fixture, merge_sort_array_stack)
+{
+  ds::array_stack<int, 7> stack {3, 1, 4, 1, 5, 9, 2};
+  algol::algorithms::stack::merge_sort(stack);
+  EXPECT_EQ(pop_all(stack), (std::vector<int> {1, 1, 2, 3, 4, 5, 9}));
+}
+
+TEST_F(stack_sort_fixture, merge_sort_same_order_as_insertion_sort)
+{
+  ds::linked_stack<int> merge;
+  ds::linked_stack<int> insertion;
+  for (auto i = 0; i < 100; ++i) {
+    merge.push(random[i]);
+    insertion.push(random[i]);
+  }
+
+  algol::algorithms::stack::merge_sort(merge);
+  algol::algorithms::stack::insertion_sort(insertion);
+  EXPECT_EQ(pop_all(merge), pop_all(insertion));
+}
+
+TEST_F(stack_sort_fixture, merge_sort_strings)
+{
+  ds::linked_stack<std::string> stack;
+  for (auto v : random)
+    stack.push(std::to_string(v));
+  std::vector<std::string> expected;
+  for (auto v : random)
+    expected.push_back(std::to_string(v));
+  std::sort(std::begin(expected), std::end(expected));
+
+  algol::algorithms::stack::merge_sort(stack);
+  EXPECT_EQ(pop_all(stack), expected);
+}
+
+TEST_F(stack_sort_fixture, merge_sort_moves_and_comparisons)
+{
+  ds::linked_stack<operation_counter> stack;
+  for (auto v : random)
+    stack.push(v);
+
+  operation_counter::reset();
+  algol::algorithms::stack::merge_sort(stack);
+
+  // n = 1000, ceil(log2 n) = 10
+  // at most n - 1 comparisons for each level of the recursion
+  // each item is moved once for each level, once for the base case and once back onto the input stack
+  EXPECT_LE(operation_counter::less_comparisons(), 1000u * 10u);
+  EXPECT_LE(operation_counter::moves(), 1000u * 12u);
+  // no copies, the only items constructed are the sentinels of the three temporary linked stacks
+  EXPECT_EQ(operation_counter::constructions(), 3u);
+  EXPECT_EQ(operation_counter::assignments(), 0u);
+
+  std::vector<operation_counter> expected(std::begin(sorted), std::end(sorted));
+  EXPECT_EQ(pop_all(stack), expected);
+}
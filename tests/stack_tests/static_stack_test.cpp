@@ -0,0 +1,73 @@
+#include <vector>
+#include <type_traits>
+
+#include "algol/ds/stack/concepts.hpp"
+#include "algol/ds/stack/fixed_stack.hpp"
+#include "algol/ds/stack/linked_stack.hpp"
+#include "gtest/gtest.h"
+
+namespace ds = algol::ds;
+
+using fixed = ds::fixed_stack<int, 4>;
+using linked = ds::linked_stack<int>;
+
+static_assert(algol::concepts::Stack<fixed>());
+static_assert(algol::concepts::Stack<linked>());
+static_assert(std::is_base_of_v<ds::static_stack<fixed, int>, fixed>);
+static_assert(std::is_base_of_v<ds::stack<int>, fixed>);
+static_assert(std::is_base_of_v<ds::static_stack<linked, int>, linked>);
+
+namespace {
+  // the same operations through the static and the dynamic interface give the same results
+  template <typename S>
+  void same_behaviour ()
+  {
+    S direct;
+    S dynamic_stack;
+    ds::stack<int>& dynamic = dynamic_stack;
+
+    EXPECT_THROW(direct.top(), ds::stack_empty_error);
+    EXPECT_THROW(dynamic.top(), ds::stack_empty_error);
+    EXPECT_THROW(direct.pop(), ds::stack_empty_error);
+    EXPECT_THROW(dynamic.pop(), ds::stack_empty_error);
+
+    for (auto i = 1; i <= 3; ++i) {
+      direct.push(i);
+      dynamic.push(i);
+    }
+    auto const four = 4;
+    direct.push(four);
+    dynamic.push(four);
+    EXPECT_EQ(direct.size(), dynamic.size());
+    EXPECT_EQ(direct.full(), dynamic.full());
+    EXPECT_EQ(direct.top(), dynamic.top());
+    EXPECT_EQ(direct.to_vector(), dynamic.to_vector());
+
+    direct.pop();
+    dynamic.pop();
+    EXPECT_EQ(direct.to_vector(), (std::vector<int>{3, 2, 1}));
+    EXPECT_EQ(dynamic.to_vector(), (std::vector<int>{3, 2, 1}));
+
+    direct.clear();
+    dynamic.clear();
+    EXPECT_TRUE(direct.empty());
+    EXPECT_TRUE(dynamic.empty());
+  }
+}
+
+TEST(static_stack, fixed_stack)
+{
+  same_behaviour<fixed>();
+
+  // the full stack throws through both interfaces
+  fixed stack {1, 2, 3, 4};
+  ds::stack<int>& dynamic = stack;
+  EXPECT_THROW(stack.push(5), ds::stack_full_error);
+  EXPECT_THROW(dynamic.push(5), ds::stack_full_error);
+  EXPECT_EQ(stack.size(), 4u);
+}
+
+TEST(static_stack, linked_stack)
+{
+  same_behaviour<linked>();
+}